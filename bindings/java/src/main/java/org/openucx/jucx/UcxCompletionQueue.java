@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) Mellanox Technologies Ltd. 2019. ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+package org.openucx.jucx;
+
+import java.io.Closeable;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.Arrays;
+
+/**
+ * Batched completion delivery for requests posted on a worker.
+ * Instead of calling back to java for each completed request, native code writes
+ * (requestId, status) records to a preallocated direct ring buffer, which is drained by
+ * {@link org.openucx.jucx.ucp.UcpWorker#progress()} in a single JNI call.
+ * Requests tracked by the queue do not hold any JNI global references, and their
+ * callbacks are always invoked from the thread calling
+ * {@link org.openucx.jucx.ucp.UcpWorker#progress()}, also for operations which completed
+ * immediately.
+ */
+public class UcxCompletionQueue extends UcxNativeStruct implements Closeable {
+    static {
+        NativeLibs.load();
+    }
+
+    /**
+     * Must match JUCX_CQ_HEADER_SIZE and sizeof(jucx_cq_record) in jucx_common_def.h.
+     */
+    private static final int HEADER_SIZE = 16;
+    private static final int RECORD_SIZE = 16;
+
+    private static final int UCS_OK = 0;
+
+    private final ByteBuffer ring;
+
+    private final int mask;
+
+    private long consumed;
+
+    private UcxRequest[] requests;
+
+    private UcxCallback[] callbacks;
+
+    private int[] freeIds;
+
+    private int numFreeIds;
+
+    /**
+     * @param size - number of records in the ring, must be a power of 2. Completions which
+     *               do not fit in the ring are kept by native code until the ring is drained.
+     */
+    public UcxCompletionQueue(int size) {
+        if ((size <= 0) || (Integer.bitCount(size) != 1)) {
+            throw new UcxException("Completion queue size must be a power of 2: " + size);
+        }
+
+        ring = ByteBuffer.allocateDirect(HEADER_SIZE + size * RECORD_SIZE)
+            .order(ByteOrder.nativeOrder());
+        mask = size - 1;
+        requests = new UcxRequest[size];
+        callbacks = new UcxCallback[size];
+        freeIds = new int[size];
+        for (int i = 0; i < size; i++) {
+            freeIds[i] = size - 1 - i;
+        }
+        numFreeIds = size;
+        setNativeId(createCompletionQueueNative(ring, size));
+    }
+
+    @Override
+    public void close() {
+        releaseCompletionQueueNative(getNativeId());
+        setNativeId(null);
+    }
+
+    /**
+     * Registers a request, whose completion will be reported to this queue.
+     * @return request id to pass to native code.
+     */
+    public synchronized long add(UcxRequest request, UcxCallback callback) {
+        if (numFreeIds == 0) {
+            int size = requests.length;
+            requests = Arrays.copyOf(requests, size * 2);
+            callbacks = Arrays.copyOf(callbacks, size * 2);
+            freeIds = Arrays.copyOf(freeIds, size * 2);
+            for (int i = 0; i < size; i++) {
+                freeIds[i] = size * 2 - 1 - i;
+            }
+            numFreeIds = size;
+        }
+
+        int id = freeIds[--numFreeIds];
+        requests[id] = request;
+        callbacks[id] = callback;
+        return id;
+    }
+
+    /**
+     * @return number of records consumed so far, to report to native code.
+     */
+    public synchronized long getConsumed() {
+        return consumed;
+    }
+
+    /**
+     * Completes the requests of all records published by native code and invokes
+     * their callbacks.
+     * @return number of completed requests.
+     */
+    public int drain() {
+        long produced = ring.getLong(0);
+        int count = 0;
+
+        while (true) {
+            UcxRequest request;
+            UcxCallback callback;
+            int status;
+
+            synchronized (this) {
+                if (consumed >= produced) {
+                    break;
+                }
+
+                int offset = HEADER_SIZE + (int)(consumed & mask) * RECORD_SIZE;
+                int id = (int)ring.getLong(offset);
+                status = ring.getInt(offset + 8);
+                consumed++;
+
+                request = requests[id];
+                callback = callbacks[id];
+                requests[id] = null;
+                callbacks[id] = null;
+                freeIds[numFreeIds++] = id;
+            }
+
+            request.setCompleted();
+            if (callback != null) {
+                if (status == UCS_OK) {
+                    callback.onSuccess(request);
+                } else {
+                    callback.onError(status, statusStringNative(status));
+                }
+            }
+            count++;
+        }
+
+        return count;
+    }
+
+    private static native long createCompletionQueueNative(ByteBuffer ring, int size);
+
+    private static native void releaseCompletionQueueNative(long completionQueueId);
+
+    private static native String statusStringNative(int status);
+}
@@ -19,4 +19,8 @@ public class UcxRequest {
     public boolean isCompleted() {
         return completed;
     }
+
+    void setCompleted() {
+        completed = true;
+    }
 }
@@ -11,8 +11,11 @@ import java.nio.ByteBuffer;
 
 public class UcpEndpoint extends UcxNativeStruct implements Closeable {
 
+    private final UcxCompletionQueue completionQueue;
+
     public UcpEndpoint(UcpWorker worker, UcpEndpointParams params) {
         setNativeId(createEndpointNative(params, worker.getNativeId()));
+        completionQueue = worker.getCompletionQueue();
     }
 
     @Override
@@ -56,17 +59,23 @@ public class UcpEndpoint extends UcxNativeStruct implements Closeable {
 
         checkRemoteAccessParams(src, remoteKey);
 
-        return putNonBlockingNative(getNativeId(), UcxUtils.getAddress(src),
-            src.remaining(), remoteAddress,
-            remoteKey.getNativeId(), callback);
+        return putNonBlocking(UcxUtils.getAddress(src), src.remaining(), remoteAddress,
+            remoteKey, callback);
     }
 
     public UcxRequest putNonBlocking(long localAddress, long size,
                                      long remoteAddress, UcpRemoteKey remoteKey,
                                      UcxCallback callback) {
+        if (completionQueue != null) {
+            UcxRequest request = new UcxRequest();
+            putNonBlockingNative(getNativeId(), localAddress, size, remoteAddress,
+                remoteKey.getNativeId(), null, completionQueue.getNativeId(),
+                completionQueue.add(request, callback));
+            return request;
+        }
 
         return putNonBlockingNative(getNativeId(), localAddress,
-            size, remoteAddress, remoteKey.getNativeId(), callback);
+            size, remoteAddress, remoteKey.getNativeId(), callback, 0, 0);
     }
 
     /**
@@ -84,15 +93,22 @@ public class UcpEndpoint extends UcxNativeStruct implements Closeable {
 
         checkRemoteAccessParams(dst, remoteKey);
 
-        return getNonBlockingNative(getNativeId(), remoteAddress, remoteKey.getNativeId(),
-            UcxUtils.getAddress(dst), dst.remaining(), callback);
+        return getNonBlocking(remoteAddress, remoteKey, UcxUtils.getAddress(dst),
+            dst.remaining(), callback);
     }
 
     public UcxRequest getNonBlocking(long remoteAddress, UcpRemoteKey remoteKey,
                                      long localAddress, long size, UcxCallback callback) {
+        if (completionQueue != null) {
+            UcxRequest request = new UcxRequest();
+            getNonBlockingNative(getNativeId(), remoteAddress, remoteKey.getNativeId(),
+                localAddress, size, null, completionQueue.getNativeId(),
+                completionQueue.add(request, callback));
+            return request;
+        }
 
         return getNonBlockingNative(getNativeId(), remoteAddress, remoteKey.getNativeId(),
-            localAddress, size, callback);
+            localAddress, size, callback, 0, 0);
     }
 
     /**
@@ -111,15 +127,21 @@ public class UcpEndpoint extends UcxNativeStruct implements Closeable {
         if (!sendBuffer.isDirect()) {
             throw new UcxException("Send buffer must be direct.");
         }
-        return sendTaggedNonBlockingNative(getNativeId(),
-            UcxUtils.getAddress(sendBuffer), sendBuffer.remaining(), tag, callback);
+        return sendTaggedNonBlocking(UcxUtils.getAddress(sendBuffer), sendBuffer.remaining(),
+            tag, callback);
     }
 
     public UcxRequest sendTaggedNonBlocking(long localAddress, long size,
                                             long tag, UcxCallback callback) {
+        if (completionQueue != null) {
+            UcxRequest request = new UcxRequest();
+            sendTaggedNonBlockingNative(getNativeId(), localAddress, size, tag, null,
+                completionQueue.getNativeId(), completionQueue.add(request, callback));
+            return request;
+        }
 
         return sendTaggedNonBlockingNative(getNativeId(),
-            localAddress, size, tag, callback);
+            localAddress, size, tag, callback, 0, 0);
     }
 
 
@@ -137,7 +159,13 @@ public class UcpEndpoint extends UcxNativeStruct implements Closeable {
      * are completed both at the origin and at the target.
      */
     public UcxRequest flushNonBlocking(UcxCallback callback) {
-        return flushNonBlockingNative(getNativeId(), callback);
+        if (completionQueue != null) {
+            UcxRequest request = new UcxRequest();
+            flushNonBlockingNative(getNativeId(), null, completionQueue.getNativeId(),
+                completionQueue.add(request, callback));
+            return request;
+        }
+        return flushNonBlockingNative(getNativeId(), callback, 0, 0);
     }
 
     private static native long createEndpointNative(UcpEndpointParams params, long workerId);
@@ -148,15 +176,23 @@ public class UcpEndpoint extends UcxNativeStruct implements Closeable {
 
     private static native UcxRequest putNonBlockingNative(long enpointId, long localAddress,
                                                           long size, long remoteAddr,
-                                                          long ucpRkeyId, UcxCallback callback);
+                                                          long ucpRkeyId, UcxCallback callback,
+                                                          long completionQueueId,
+                                                          long requestId);
 
     private static native UcxRequest getNonBlockingNative(long enpointId, long remoteAddress,
                                                           long ucpRkeyId, long localAddress,
-                                                          long size, UcxCallback callback);
+                                                          long size, UcxCallback callback,
+                                                          long completionQueueId,
+                                                          long requestId);
 
     private static native UcxRequest sendTaggedNonBlockingNative(long enpointId, long localAddress,
                                                                  long size, long tag,
-                                                                 UcxCallback callback);
+                                                                 UcxCallback callback,
+                                                                 long completionQueueId,
+                                                                 long requestId);
 
-    private static native UcxRequest flushNonBlockingNative(long enpointId, UcxCallback callback);
+    private static native UcxRequest flushNonBlockingNative(long enpointId, UcxCallback callback,
+                                                            long completionQueueId,
+                                                            long requestId);
 }
@@ -31,8 +31,13 @@ import org.openucx.jucx.*;
  */
 public class UcpWorker extends UcxNativeStruct implements Closeable {
 
+    private UcxCompletionQueue completionQueue;
+
     public UcpWorker(UcpContext context, UcpWorkerParams params) {
         setNativeId(createWorkerNative(params, context.getNativeId()));
+        if (params.getCompletionQueueSize() > 0) {
+            completionQueue = new UcxCompletionQueue(params.getCompletionQueueSize());
+        }
     }
 
     /**
@@ -53,14 +58,34 @@ public class UcpWorker extends UcxNativeStruct implements Closeable {
     public void close() {
         releaseWorkerNative(getNativeId());
         setNativeId(null);
+        if (completionQueue != null) {
+            completionQueue.close();
+            completionQueue = null;
+        }
+    }
+
+    /**
+     * @return completion queue of this worker, or null if completions are delivered
+     * by calling back to java on every completed request.
+     */
+    UcxCompletionQueue getCompletionQueue() {
+        return completionQueue;
     }
 
     /**
      * This routine explicitly progresses all communication operations on a worker.
+     * If the worker was created with {@link UcpWorkerParams#setCompletionQueueSize(int)},
+     * it also invokes the callbacks of all requests completed so far.
      * @return Non-zero if any communication was progressed, zero otherwise.
      */
     public int progress() {
-        return progressWorkerNative(getNativeId());
+        if (completionQueue == null) {
+            return progressWorkerNative(getNativeId());
+        }
+
+        int count = progressWorkerBatchedNative(getNativeId(), completionQueue.getNativeId(),
+                                                completionQueue.getConsumed());
+        return count + completionQueue.drain();
     }
 
     /**
@@ -69,7 +94,13 @@ public class UcpWorker extends UcxNativeStruct implements Closeable {
      * are completed both at the origin and at the target when this call returns.
      */
     public UcxRequest flushNonBlocking(UcxCallback callback) {
-        return flushNonBlockingNative(getNativeId(), callback);
+        if (completionQueue != null) {
+            UcxRequest request = new UcxRequest();
+            flushNonBlockingNative(getNativeId(), null, completionQueue.getNativeId(),
+                completionQueue.add(request, callback));
+            return request;
+        }
+        return flushNonBlockingNative(getNativeId(), callback, 0, 0);
     }
 
     /**
@@ -119,14 +150,20 @@ public class UcpWorker extends UcxNativeStruct implements Closeable {
         if (!recvBuffer.isDirect()) {
             throw new UcxException("Recv buffer must be direct.");
         }
-        return recvTaggedNonBlockingNative(getNativeId(), UcxUtils.getAddress(recvBuffer),
-            recvBuffer.remaining(), tag, tagMask, callback);
+        return recvTaggedNonBlocking(UcxUtils.getAddress(recvBuffer), recvBuffer.remaining(),
+            tag, tagMask, callback);
     }
 
     public UcxRequest recvTaggedNonBlocking(long localAddress, long size, long tag, long tagMask,
                                             UcxCallback callback) {
+        if (completionQueue != null) {
+            UcxRequest request = new UcxRequest();
+            recvTaggedNonBlockingNative(getNativeId(), localAddress, size, tag, tagMask, null,
+                completionQueue.getNativeId(), completionQueue.add(request, callback));
+            return request;
+        }
         return recvTaggedNonBlockingNative(getNativeId(), localAddress, size,
-            tag, tagMask, callback);
+            tag, tagMask, callback, 0, 0);
     }
 
     /**
@@ -167,7 +204,12 @@ public class UcpWorker extends UcxNativeStruct implements Closeable {
 
     private static native int progressWorkerNative(long workerId);
 
-    private static native UcxRequest flushNonBlockingNative(long workerId, UcxCallback callback);
+    private static native int progressWorkerBatchedNative(long workerId, long completionQueueId,
+                                                          long consumed);
+
+    private static native UcxRequest flushNonBlockingNative(long workerId, UcxCallback callback,
+                                                            long completionQueueId,
+                                                            long requestId);
 
     private static native void waitWorkerNative(long workerId);
 
@@ -175,5 +217,7 @@ public class UcpWorker extends UcxNativeStruct implements Closeable {
 
     private static native UcxRequest recvTaggedNonBlockingNative(long workerId, long localAddress,
                                                                  long size, long tag, long tagMask,
-                                                                 UcxCallback callback);
+                                                                 UcxCallback callback,
+                                                                 long completionQueueId,
+                                                                 long requestId);
 }
@@ -9,6 +9,7 @@ import java.nio.ByteBuffer;
 import java.util.BitSet;
 
 import org.openucx.jucx.ucs.UcsConstants;
+import org.openucx.jucx.UcxCompletionQueue;
 import org.openucx.jucx.UcxException;
 import org.openucx.jucx.UcxParams;
 
@@ -24,6 +25,8 @@ public class UcpWorkerParams extends UcxParams {
 
     private int eventFD;
 
+    private int completionQueueSize;
+
     @Override
     public UcpWorkerParams clear() {
         super.clear();
@@ -32,6 +35,7 @@ public class UcpWorkerParams extends UcxParams {
         events = 0;
         userData = null;
         eventFD = 0;
+        completionQueueSize = 0;
         return this;
     }
 
@@ -159,4 +163,23 @@ public class UcpWorkerParams extends UcxParams {
         this.eventFD = eventFD;
         return this;
     }
+
+    /**
+     * Deliver request completions in batches through a {@link UcxCompletionQueue} of
+     * {@code size} records, instead of calling back to java on every completed request.
+     * Callbacks of requests posted on the worker are then invoked from
+     * {@link UcpWorker#progress()}.
+     * @param size - number of records in the completion queue ring, must be a power of 2.
+     */
+    public UcpWorkerParams setCompletionQueueSize(int size) {
+        if ((size <= 0) || (Integer.bitCount(size) != 1)) {
+            throw new UcxException("Completion queue size must be a power of 2: " + size);
+        }
+        this.completionQueueSize = size;
+        return this;
+    }
+
+    int getCompletionQueueSize() {
+        return completionQueueSize;
+    }
 }
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) Mellanox Technologies Ltd. 2019. ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "jucx_common_def.h"
+#include "org_openucx_jucx_UcxCompletionQueue.h"
+
+JNIEXPORT jlong JNICALL
+Java_org_openucx_jucx_UcxCompletionQueue_createCompletionQueueNative(JNIEnv *env, jclass cls,
+                                                                     jobject ring, jint size)
+{
+    jucx_completion_queue *cq = jucx_cq_create(env->GetDirectBufferAddress(ring), size);
+
+    if (cq == NULL) {
+        JNU_ThrowExceptionByStatus(env, UCS_ERR_NO_MEMORY);
+    }
+    return (native_ptr)cq;
+}
+
+JNIEXPORT void JNICALL
+Java_org_openucx_jucx_UcxCompletionQueue_releaseCompletionQueueNative(JNIEnv *env, jclass cls,
+                                                                      jlong cq_ptr)
+{
+    jucx_cq_destroy((jucx_completion_queue *)cq_ptr);
+}
+
+JNIEXPORT jstring JNICALL
+Java_org_openucx_jucx_UcxCompletionQueue_statusStringNative(JNIEnv *env, jclass cls,
+                                                            jint status)
+{
+    return env->NewStringUTF(ucs_status_string(static_cast<ucs_status_t>(status)));
+}
@@ -113,50 +113,58 @@ JNIEXPORT jobject JNICALL
 Java_org_openucx_jucx_ucp_UcpEndpoint_putNonBlockingNative(JNIEnv *env, jclass cls,
                                                            jlong ep_ptr, jlong laddr,
                                                            jlong size, jlong raddr,
-                                                           jlong rkey_ptr, jobject callback)
+                                                           jlong rkey_ptr, jobject callback,
+                                                           jlong cq_ptr, jlong request_id)
 {
     ucs_status_ptr_t request = ucp_put_nb((ucp_ep_h)ep_ptr, (void *)laddr, size, raddr,
                                           (ucp_rkey_h)rkey_ptr, jucx_request_callback);
 
     ucs_trace_req("JUCX: put_nb request %p to %s, of size: %zu, raddr: %zu",
                   request, ucp_ep_peer_name((ucp_ep_h)ep_ptr), size, raddr);
-    return process_request(request, callback);
+    return process_request(request, callback, (jucx_completion_queue *)cq_ptr,
+                           request_id);
 }
 
 JNIEXPORT jobject JNICALL
 Java_org_openucx_jucx_ucp_UcpEndpoint_getNonBlockingNative(JNIEnv *env, jclass cls,
                                                            jlong ep_ptr, jlong raddr,
                                                            jlong rkey_ptr, jlong laddr,
-                                                           jlong size, jobject callback)
+                                                           jlong size, jobject callback,
+                                                           jlong cq_ptr, jlong request_id)
 {
     ucs_status_ptr_t request = ucp_get_nb((ucp_ep_h)ep_ptr, (void *)laddr, size,
                                           raddr, (ucp_rkey_h)rkey_ptr, jucx_request_callback);
 
     ucs_trace_req("JUCX: get_nb request %p to %s, raddr: %zu, size: %zu, result address: %zu",
                   request, ucp_ep_peer_name((ucp_ep_h)ep_ptr), raddr, size, laddr);
-    return process_request(request, callback);
+    return process_request(request, callback, (jucx_completion_queue *)cq_ptr,
+                           request_id);
 }
 
 JNIEXPORT jobject JNICALL
 Java_org_openucx_jucx_ucp_UcpEndpoint_sendTaggedNonBlockingNative(JNIEnv *env, jclass cls,
                                                                   jlong ep_ptr, jlong addr,
                                                                   jlong size, jlong tag,
-                                                                  jobject callback)
+                                                                  jobject callback,
+                                                                  jlong cq_ptr, jlong request_id)
 {
     ucs_status_ptr_t request = ucp_tag_send_nb((ucp_ep_h)ep_ptr, (void *)addr, size,
                                                ucp_dt_make_contig(1), tag, jucx_request_callback);
 
     ucs_trace_req("JUCX: send_nb request %p to %s, size: %zu, tag: %ld",
                   request, ucp_ep_peer_name((ucp_ep_h)ep_ptr), size, tag);
-    return process_request(request, callback);
+    return process_request(request, callback, (jucx_completion_queue *)cq_ptr,
+                           request_id);
 }
 
 JNIEXPORT jobject JNICALL
 Java_org_openucx_jucx_ucp_UcpEndpoint_flushNonBlockingNative(JNIEnv *env, jclass cls,
                                                              jlong ep_ptr,
-                                                             jobject callback)
+                                                             jobject callback,
+                                                             jlong cq_ptr, jlong request_id)
 {
     ucs_status_ptr_t request = ucp_ep_flush_nb((ucp_ep_h)ep_ptr, 0, jucx_request_callback);
 
-    return process_request(request, callback);
+    return process_request(request, callback, (jucx_completion_queue *)cq_ptr,
+                           request_id);
 }
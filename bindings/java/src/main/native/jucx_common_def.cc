@@ -6,8 +6,11 @@
 #include "jucx_common_def.h"
 extern "C" {
   #include <ucs/arch/cpu.h>
+  #include <ucs/datastruct/queue.h>
   #include <ucs/debug/assert.h>
   #include <ucs/debug/debug.h>
+  #include <ucs/debug/memtrack.h>
+  #include <ucs/sys/math.h>
 }
 
 #include <string.h>    /* memset */
@@ -21,6 +24,12 @@ static jfieldID completed_field;
 static jmethodID on_success;
 static jmethodID jucx_request_constructor;
 
+/* Completion record which did not fit in the ring of a completion queue */
+struct jucx_cq_overflow_elem {
+    ucs_queue_elem_t queue;
+    jucx_cq_record   record;
+};
+
 extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void* reserved) {
     ucs_debug_disable_signals();
     jvm_global = jvm;
@@ -153,6 +162,8 @@ void jucx_request_init(void *request)
      struct jucx_context *ctx = (struct jucx_context *)request;
      ctx->callback = NULL;
      ctx->jucx_request = NULL;
+     ctx->cq = NULL;
+     ctx->request_id = 0;
 }
 
 JNIEnv* get_jni_env()
@@ -184,13 +195,112 @@ static inline void call_on_error(jobject callback, ucs_status_t status)
     env->CallVoidMethod(callback, on_error, status, error_msg);
 }
 
+jucx_completion_queue *jucx_cq_create(void *buffer, jlong size)
+{
+    jucx_completion_queue *cq;
+
+    ucs_assert(ucs_is_pow2(size));
+
+    cq = (jucx_completion_queue *)ucs_malloc(sizeof(*cq), "jucx_cq");
+    if (cq == NULL) {
+        return NULL;
+    }
+
+    ucs_spinlock_init(&cq->lock);
+    cq->produced  = (volatile jlong *)buffer;
+    cq->records   = (jucx_cq_record *)UCS_PTR_BYTE_OFFSET(buffer, JUCX_CQ_HEADER_SIZE);
+    cq->size_mask = size - 1;
+    cq->head      = 0;
+    cq->tail      = 0;
+    *cq->produced = 0;
+    ucs_queue_head_init(&cq->overflow);
+    return cq;
+}
+
+void jucx_cq_destroy(jucx_completion_queue *cq)
+{
+    jucx_cq_overflow_elem *elem;
+
+    ucs_queue_for_each_extract(elem, &cq->overflow, queue, 1) {
+        ucs_free(elem);
+    }
+    ucs_spinlock_destroy(&cq->lock);
+    ucs_free(cq);
+}
+
+static inline int jucx_cq_is_full(jucx_completion_queue *cq)
+{
+    return (cq->head - cq->tail) > cq->size_mask;
+}
+
+static inline void jucx_cq_write(jucx_completion_queue *cq, jlong request_id,
+                                 jint status)
+{
+    jucx_cq_record *record = &cq->records[cq->head & cq->size_mask];
+
+    record->request_id = request_id;
+    record->status     = status;
+    ++cq->head;
+}
+
+static void jucx_cq_push(jucx_completion_queue *cq, jlong request_id,
+                         ucs_status_t status)
+{
+    jucx_cq_overflow_elem *elem;
+
+    ucs_spin_lock(&cq->lock);
+    if (ucs_likely(!jucx_cq_is_full(cq) && ucs_queue_is_empty(&cq->overflow))) {
+        jucx_cq_write(cq, request_id, status);
+    } else {
+        elem = (jucx_cq_overflow_elem *)ucs_malloc(sizeof(*elem), "jucx_cq_overflow");
+        if (elem == NULL) {
+            ucs_fatal("JUCX: failed to allocate completion queue overflow record");
+        }
+        elem->record.request_id = request_id;
+        elem->record.status     = status;
+        ucs_queue_push(&cq->overflow, &elem->queue);
+    }
+    ucs_spin_unlock(&cq->lock);
+}
+
+void jucx_cq_release(jucx_completion_queue *cq, jlong consumed)
+{
+    jucx_cq_overflow_elem *elem;
+
+    ucs_spin_lock(&cq->lock);
+    cq->tail = ucs_max(cq->tail, consumed);
+    while (!ucs_queue_is_empty(&cq->overflow) && !jucx_cq_is_full(cq)) {
+        elem = ucs_queue_pull_elem_non_empty(&cq->overflow, jucx_cq_overflow_elem,
+                                             queue);
+        jucx_cq_write(cq, elem->record.request_id, elem->record.status);
+        ucs_free(elem);
+    }
+    ucs_spin_unlock(&cq->lock);
+}
+
+void jucx_cq_publish(jucx_completion_queue *cq)
+{
+    ucs_spin_lock(&cq->lock);
+    ucs_memory_cpu_store_fence();
+    *cq->produced = cq->head;
+    ucs_spin_unlock(&cq->lock);
+}
+
 UCS_PROFILE_FUNC_VOID(jucx_request_callback, (request, status), void *request, ucs_status_t status)
 {
     struct jucx_context *ctx = (struct jucx_context *)request;
-    while (ctx->jucx_request == NULL) {
+    while ((ctx->jucx_request == NULL) && (ctx->cq == NULL)) {
         pthread_yield();
     }
     ucs_memory_cpu_load_fence();
+
+    if (ctx->cq != NULL) {
+        jucx_cq_push(ctx->cq, ctx->request_id, status);
+        ctx->cq = NULL;
+        ucp_request_free(request);
+        return;
+    }
+
     JNIEnv *env = get_jni_env();
     set_jucx_request_completed(env, ctx->jucx_request);
 
@@ -214,8 +324,21 @@ void recv_callback(void *request, ucs_status_t status, ucp_tag_recv_info_t *info
     jucx_request_callback(request, status);
 }
 
-UCS_PROFILE_FUNC(jobject, process_request, (request, callback), void *request, jobject callback)
+UCS_PROFILE_FUNC(jobject, process_request, (request, callback, cq, request_id),
+                 void *request, jobject callback, jucx_completion_queue *cq,
+                 jlong request_id)
 {
+    if (cq != NULL) {
+        if (UCS_PTR_IS_PTR(request)) {
+            ((struct jucx_context *)request)->request_id = request_id;
+            ucs_memory_cpu_store_fence();
+            ((struct jucx_context *)request)->cq = cq;
+        } else {
+            jucx_cq_push(cq, request_id, UCS_PTR_STATUS(request));
+        }
+        return NULL;
+    }
+
     JNIEnv *env = get_jni_env();
     jobject jucx_request = env->NewObject(jucx_request_cls, jucx_request_constructor);
 
@@ -6,8 +6,10 @@
 #define HELPER_H_
 
 #include <ucp/api/ucp.h>
+#include <ucs/datastruct/queue_types.h>
 #include <ucs/debug/log.h>
 #include <ucs/profile/profile.h>
+#include <ucs/type/spinlock.h>
 
 #include <jni.h>
 
@@ -36,9 +38,42 @@ void JNU_ThrowExceptionByStatus(JNIEnv *, ucs_status_t);
  */
 bool j2cInetSockAddr(JNIEnv *env, jobject sock_addr, sockaddr_storage& ss, socklen_t& sa_len);
 
+#define JUCX_CQ_HEADER_SIZE 16
+
+/**
+ * @brief Completion record, written by native code to the ring of a batched
+ * completion queue and read by UcxCompletionQueue.java. The layout must match
+ * UcxCompletionQueue.RECORD_SIZE.
+ */
+struct jucx_cq_record {
+    jlong request_id;
+    jint  status;
+    jint  reserved;
+};
+
+/**
+ * @brief Batched completion queue. Instead of calling back to java on every
+ * completed request, completions are stored in a ring located in a java direct
+ * ByteBuffer, which is drained by UcpWorker.progress(). The buffer starts with
+ * a header of JUCX_CQ_HEADER_SIZE bytes, holding the number of records produced
+ * so far, followed by the ring. Records which do not fit in the ring are kept in the overflow queue until
+ * java consumes enough of them.
+ */
+struct jucx_completion_queue {
+    ucs_spinlock_t   lock;
+    volatile jlong   *produced;   /* Published producer index, read by java */
+    jucx_cq_record   *records;    /* Ring of records */
+    jlong            size_mask;   /* Ring size - 1, size is a power of 2 */
+    jlong            head;        /* Producer index */
+    jlong            tail;        /* Consumer index, as reported by java */
+    ucs_queue_head_t overflow;    /* Records waiting for free space in the ring */
+};
+
 struct jucx_context {
     jobject callback;
     volatile jobject jucx_request;
+    jucx_completion_queue * volatile cq;
+    jlong request_id;
 };
 
 void jucx_request_init(void *request);
@@ -62,7 +97,29 @@ void recv_callback(void *request, ucs_status_t status, ucp_tag_recv_info_t *info
  * @brief Utility to process request logic: if request is pointer - set callback to request context.
  * If request is status - call callback directly.
  * Returns jucx_request object, that could be monitored on completion.
+ * If completion queue @a cq is not NULL, the completion of the request is reported to @a cq
+ * as @a request_id instead, no java objects or global references are created and NULL is returned.
+ */
+jobject process_request(void *request, jobject callback, jucx_completion_queue *cq,
+                        jlong request_id);
+
+/**
+ * @brief Create a completion queue over a ring buffer of @a size records,
+ * located in @a buffer.
+ */
+jucx_completion_queue *jucx_cq_create(void *buffer, jlong size);
+
+void jucx_cq_destroy(jucx_completion_queue *cq);
+
+/**
+ * @brief Release ring records up to @a consumed index, which were read by java,
+ * and move overflow records to the freed space.
+ */
+void jucx_cq_release(jucx_completion_queue *cq, jlong consumed);
+
+/**
+ * @brief Publish the records produced so far to java.
  */
-jobject process_request(void *request, jobject callback);
+void jucx_cq_publish(jucx_completion_queue *cq);
 
 #endif
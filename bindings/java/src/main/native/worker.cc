@@ -109,15 +109,31 @@ Java_org_openucx_jucx_ucp_UcpWorker_progressWorkerNative(JNIEnv *env, jclass cls
     return ucp_worker_progress((ucp_worker_h)ucp_worker_ptr);
 }
 
+JNIEXPORT jint JNICALL
+Java_org_openucx_jucx_ucp_UcpWorker_progressWorkerBatchedNative(JNIEnv *env, jclass cls,
+                                                                jlong ucp_worker_ptr,
+                                                                jlong cq_ptr, jlong consumed)
+{
+    jucx_completion_queue *cq = (jucx_completion_queue *)cq_ptr;
+    unsigned count;
+
+    jucx_cq_release(cq, consumed);
+    count = ucp_worker_progress((ucp_worker_h)ucp_worker_ptr);
+    jucx_cq_publish(cq);
+    return count;
+}
+
 JNIEXPORT jobject JNICALL
 Java_org_openucx_jucx_ucp_UcpWorker_flushNonBlockingNative(JNIEnv *env, jclass cls,
                                                            jlong ucp_worker_ptr,
-                                                           jobject callback)
+                                                           jobject callback,
+                                                           jlong cq_ptr, jlong request_id)
 {
     ucs_status_ptr_t request = ucp_worker_flush_nb((ucp_worker_h)ucp_worker_ptr, 0,
                                                    jucx_request_callback);
 
-    return process_request(request, callback);
+    return process_request(request, callback, (jucx_completion_queue *)cq_ptr,
+                           request_id);
 }
 
 JNIEXPORT void JNICALL
@@ -145,7 +161,8 @@ Java_org_openucx_jucx_ucp_UcpWorker_recvTaggedNonBlockingNative(JNIEnv *env, jcl
                                                                 jlong ucp_worker_ptr,
                                                                 jlong laddr, jlong size,
                                                                 jlong tag, jlong tagMask,
-                                                                jobject callback)
+                                                                jobject callback,
+                                                                jlong cq_ptr, jlong request_id)
 {
     ucs_status_ptr_t request = ucp_tag_recv_nb((ucp_worker_h)ucp_worker_ptr,
                                                 (void *)laddr, size,
@@ -154,5 +171,6 @@ Java_org_openucx_jucx_ucp_UcpWorker_recvTaggedNonBlockingNative(JNIEnv *env, jcl
 
     ucs_trace_req("JUCX: recv_nb request %p, msg size: %zu, tag: %ld", request, size, tag);
 
-    return process_request(request, callback);
+    return process_request(request, callback, (jucx_completion_queue *)cq_ptr,
+                           request_id);
 }
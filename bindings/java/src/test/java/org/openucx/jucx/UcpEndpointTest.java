@@ -292,6 +292,64 @@ public class UcpEndpointTest {
         context2.close();
     }
 
+    @Test
+    public void testSendRecvCompletionQueue() {
+        int numMessages = 64;
+        int msgSize = 16;
+        // Ring of the completion queue is smaller than number of outstanding requests.
+        UcpParams params = new UcpParams().requestTagFeature();
+        UcpWorkerParams workerParams = new UcpWorkerParams().setCompletionQueueSize(4);
+        UcpContext context1 = new UcpContext(params);
+        UcpContext context2 = new UcpContext(params);
+        UcpWorker worker1 = context1.newWorker(workerParams);
+        UcpWorker worker2 = context2.newWorker(workerParams);
+
+        ByteBuffer src = ByteBuffer.allocateDirect(numMessages * msgSize);
+        ByteBuffer dst = ByteBuffer.allocateDirect(numMessages * msgSize);
+        for (int i = 0; i < numMessages * msgSize; i++) {
+            src.put(i, (byte)i);
+        }
+
+        AtomicInteger completed = new AtomicInteger(0);
+        UcxCallback callback = new UcxCallback() {
+            @Override
+            public void onSuccess(UcxRequest request) {
+                assertTrue(request.isCompleted());
+                completed.incrementAndGet();
+            }
+        };
+
+        UcxRequest[] requests = new UcxRequest[numMessages * 2];
+        for (int i = 0; i < numMessages; i++) {
+            requests[i] = worker2.recvTaggedNonBlocking(UcxUtils.getAddress(dst) + i * msgSize,
+                msgSize, i, -1, callback);
+        }
+
+        UcpEndpoint ep = worker1.newEndpoint(new UcpEndpointParams()
+            .setUcpAddress(worker2.getAddress()));
+
+        for (int i = 0; i < numMessages; i++) {
+            requests[numMessages + i] = ep.sendTaggedNonBlocking(
+                UcxUtils.getAddress(src) + i * msgSize, msgSize, i, callback);
+        }
+
+        while (completed.get() != numMessages * 2) {
+            worker1.progress();
+            worker2.progress();
+        }
+
+        for (UcxRequest request : requests) {
+            assertTrue(request.isCompleted());
+        }
+        assertEquals(src, dst);
+
+        ep.close();
+        worker1.close();
+        worker2.close();
+        context1.close();
+        context2.close();
+    }
+
     @Test
     public void testFlushEp() {
         int numRequests = 10;
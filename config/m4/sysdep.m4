@@ -94,6 +94,14 @@ AC_CHECK_DECLS([ethtool_cmd_speed, SPEED_UNKNOWN], [], [],
                [#include <linux/ethtool.h>])
 
 
+#
+# Zero-copy socket send
+#
+AC_CHECK_DECLS([MSG_ZEROCOPY, SO_ZEROCOPY, SO_EE_ORIGIN_ZEROCOPY], [], [],
+               [#include <sys/socket.h>
+#include <linux/errqueue.h>])
+
+
 #
 # PowerPC query for TB frequency
 #
@@ -253,6 +261,20 @@ AC_CHECK_HEADERS([sys/eventfd.h])
 AC_CHECK_HEADERS([sys/event.h])
 
 
+#
+# io_uring
+#
+AC_CHECK_HEADERS([linux/io_uring.h],
+                 [AC_CHECK_DECLS([IORING_OP_RECV, IORING_OP_POLL_ADD,
+                                  IORING_OP_ASYNC_CANCEL, IOSQE_BUFFER_SELECT,
+                                  IORING_REGISTER_PBUF_RING,
+                                  IORING_REGISTER_SYNC_CANCEL],
+                                 [], [], [#include <linux/io_uring.h>])
+                  AC_CHECK_DECLS([__NR_io_uring_setup, __NR_io_uring_enter,
+                                  __NR_io_uring_register],
+                                 [], [], [#include <sys/syscall.h>])])
+
+
 #
 # FreeBSD-specific threading functions
 #
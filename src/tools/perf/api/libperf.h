@@ -113,6 +113,13 @@ typedef struct ucx_perf_result {
         double              total_average;  /* Average of the whole test */
     }
     latency, bandwidth, msgrate;
+    struct {
+        double              p50;
+        double              p90;
+        double              p99;
+        double              p999;
+        double              max;
+    } latency_tail; /* Latency percentiles of the whole test */
 } ucx_perf_result_t;
 
 
@@ -159,6 +159,48 @@ static ucs_time_t __find_median_quick_select(ucs_time_t arr[], int n)
     }
 }
 
+/* Smallest value which falls into the bucket following 'bucket' */
+static ucs_time_t ucx_perf_histogram_bucket_end(unsigned bucket)
+{
+    unsigned group = (bucket / UCX_PERF_HIST_SUB_COUNT) + 1;
+    ucs_time_t mantissa;
+
+    if (group == 1) {
+        return bucket + 1;
+    }
+
+    mantissa = UCX_PERF_HIST_SUB_COUNT + (bucket % UCX_PERF_HIST_SUB_COUNT) + 1;
+    return mantissa << (group - 2);
+}
+
+/* Upper bound of the smallest value which at least 'percentile' of the samples
+ * do not exceed */
+static ucs_time_t ucx_perf_histogram_percentile(const ucx_perf_histogram_t *hist,
+                                                double percentile)
+{
+    ucx_perf_counter_t target, acc;
+    unsigned bucket;
+
+    if (hist->count == 0) {
+        return 0;
+    }
+
+    /* round up, so that at least 'percentile' of the samples are counted */
+    target  = hist->count * percentile;
+    target += (target < (hist->count * percentile));
+    target  = ucs_max(target, 1);
+    acc     = 0;
+    for (bucket = 0; bucket < UCX_PERF_HIST_NUM_BUCKETS; ++bucket) {
+        acc += hist->buckets[bucket];
+        if (acc >= target) {
+            return ucs_min(ucx_perf_histogram_bucket_end(bucket) - 1,
+                           hist->max);
+        }
+    }
+
+    return hist->max;
+}
+
 static ucs_status_t uct_perf_test_alloc_mem(ucx_perf_context_t *perf)
 {
     ucx_perf_params_t *params = &perf->params;
@@ -267,6 +309,7 @@ static void ucx_perf_test_prepare_new_run(ucx_perf_context_t *perf,
     for (i = 0; i < TIMING_QUEUE_SIZE; ++i) {
         perf->timing_queue[i] = 0;
     }
+    memset(&perf->latency_hist, 0, sizeof(perf->latency_hist));
     ucx_perf_test_start_clock(perf);
 }
 
@@ -309,6 +352,16 @@ void ucx_perf_calc_result(ucx_perf_context_t *perf, ucx_perf_result_t *result)
         / perf->current.iters
         / factor;
 
+    result->latency_tail.p50  = ucs_time_to_sec(
+        ucx_perf_histogram_percentile(&perf->latency_hist, 0.5)) / factor;
+    result->latency_tail.p90  = ucs_time_to_sec(
+        ucx_perf_histogram_percentile(&perf->latency_hist, 0.9)) / factor;
+    result->latency_tail.p99  = ucs_time_to_sec(
+        ucx_perf_histogram_percentile(&perf->latency_hist, 0.99)) / factor;
+    result->latency_tail.p999 = ucs_time_to_sec(
+        ucx_perf_histogram_percentile(&perf->latency_hist, 0.999)) / factor;
+    result->latency_tail.max  = ucs_time_to_sec(perf->latency_hist.max) /
+                                factor;
 
     /* Bandwidth */
 
@@ -17,6 +17,7 @@ BEGIN_C_DECLS
 
 #include <ucs/time/time.h>
 #include <ucs/async/async.h>
+#include <ucs/arch/bitops.h>
 
 #if _OPENMP
 #include <omp.h>
@@ -26,6 +27,13 @@ BEGIN_C_DECLS
 #define TIMING_QUEUE_SIZE    2048
 #define UCT_PERF_TEST_AM_ID  5
 
+/* Latency histogram: every power of 2 is split into 2^SUB_BITS linear
+ * sub-buckets, so a sample is recorded with relative error < 2^-SUB_BITS */
+#define UCX_PERF_HIST_SUB_BITS     4
+#define UCX_PERF_HIST_SUB_COUNT    UCS_BIT(UCX_PERF_HIST_SUB_BITS)
+#define UCX_PERF_HIST_NUM_BUCKETS  ((64 - UCX_PERF_HIST_SUB_BITS + 1) * \
+                                    UCX_PERF_HIST_SUB_COUNT)
+
 
 typedef struct ucx_perf_context  ucx_perf_context_t;
 typedef struct uct_peer          uct_peer_t;
@@ -33,6 +41,13 @@ typedef struct ucp_peer          ucp_peer_t;
 typedef struct ucp_perf_request  ucp_perf_request_t;
 
 
+typedef struct ucx_perf_histogram {
+    ucx_perf_counter_t           count;   /* Total number of samples */
+    ucs_time_t                   max;     /* Largest sample */
+    ucx_perf_counter_t           buckets[UCX_PERF_HIST_NUM_BUCKETS];
+} ucx_perf_histogram_t;
+
+
 struct ucx_perf_allocator {
     ucs_status_t (*init)(ucx_perf_context_t *perf);
     ucs_status_t (*ucp_alloc)(ucx_perf_context_t *perf, size_t length,
@@ -69,6 +84,7 @@ struct ucx_perf_context {
 
     ucs_time_t                   timing_queue[TIMING_QUEUE_SIZE];
     unsigned                     timing_queue_head;
+    ucx_perf_histogram_t         latency_hist;    /* all iteration times */
     const ucx_perf_allocator_t   *allocator;
 
     union {
@@ -151,6 +167,31 @@ static UCS_F_ALWAYS_INLINE int ucx_perf_context_done(ucx_perf_context_t *perf)
 }
 
 
+static UCS_F_ALWAYS_INLINE unsigned
+ucx_perf_histogram_bucket(ucs_time_t value)
+{
+    unsigned shift;
+
+    if (value < UCX_PERF_HIST_SUB_COUNT) {
+        return value;
+    }
+
+    /* keep SUB_BITS bits below the most significant one */
+    shift = ucs_ilog2(value) - UCX_PERF_HIST_SUB_BITS;
+    return ((shift + 1) * UCX_PERF_HIST_SUB_COUNT) +
+           (value >> shift) - UCX_PERF_HIST_SUB_COUNT;
+}
+
+
+static UCS_F_ALWAYS_INLINE void
+ucx_perf_histogram_add(ucx_perf_histogram_t *hist, ucs_time_t value)
+{
+    ++hist->buckets[ucx_perf_histogram_bucket(value)];
+    ++hist->count;
+    hist->max = ucs_max(hist->max, value);
+}
+
+
 static inline void ucx_perf_get_time(ucx_perf_context_t *perf)
 {
     perf->current.time_acc = ucs_get_accurate_time();
@@ -168,6 +209,8 @@ static inline void ucx_perf_update(ucx_perf_context_t *perf,
 
     perf->timing_queue[perf->timing_queue_head] =
                     perf->current.time - perf->prev_time;
+    ucx_perf_histogram_add(&perf->latency_hist,
+                           perf->current.time - perf->prev_time);
     ++perf->timing_queue_head;
     if (perf->timing_queue_head == TIMING_QUEUE_SIZE) {
         perf->timing_queue_head = 0;
@@ -48,7 +48,8 @@ enum {
     TEST_FLAG_SET_AFFINITY  = UCS_BIT(8),
     TEST_FLAG_NUMERIC_FMT   = UCS_BIT(9),
     TEST_FLAG_PRINT_FINAL   = UCS_BIT(10),
-    TEST_FLAG_PRINT_CSV     = UCS_BIT(11)
+    TEST_FLAG_PRINT_CSV     = UCS_BIT(11),
+    TEST_FLAG_PRINT_JSON    = UCS_BIT(12)
 };
 
 typedef struct sock_rte_group {
@@ -204,21 +205,54 @@ static int safe_recv(int sock, void *data, size_t size,
     return sock_io(sock, recv, POLLIN, data, size, progress, arg, "recv");
 }
 
+static void print_progress_json(char **test_names, unsigned num_names,
+                                const ucx_perf_result_t *result)
+{
+    unsigned i;
+
+    printf("{\"tests\":[");
+    for (i = 0; i < num_names; ++i) {
+        printf("%s\"%s\"", (i == 0) ? "" : ",", test_names[i]);
+    }
+    printf("],\"iterations\":%.0f,"
+           "\"latency_usec\":{\"typical\":%.3f,\"overall\":%.3f,"
+           "\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"p99.9\":%.3f,"
+           "\"max\":%.3f},"
+           "\"bandwidth_mbs\":%.2f,\"msgrate\":%.0f}\n",
+           (double)result->iters,
+           result->latency.typical * 1000000.0,
+           result->latency.total_average * 1000000.0,
+           result->latency_tail.p50 * 1000000.0,
+           result->latency_tail.p90 * 1000000.0,
+           result->latency_tail.p99 * 1000000.0,
+           result->latency_tail.p999 * 1000000.0,
+           result->latency_tail.max * 1000000.0,
+           result->bandwidth.total_average / (1024.0 * 1024.0),
+           result->msgrate.total_average);
+}
+
 static void print_progress(char **test_names, unsigned num_names,
                            const ucx_perf_result_t *result, unsigned flags,
                            int final)
 {
-    static const char *fmt_csv     =  "%.0f,%.3f,%.3f,%.3f,%.2f,%.2f,%.0f,%.0f\n";
+    static const char *fmt_csv     =  "%.0f,%.3f,%.3f,%.3f,%.2f,%.2f,%.0f,%.0f,"
+                                      "%.3f,%.3f,%.3f,%.3f,%.3f\n";
     static const char *fmt_numeric =  "%'14.0f %9.3f %9.3f %9.3f %10.2f %10.2f %'11.0f %'11.0f\n";
     static const char *fmt_plain   =  "%14.0f %9.3f %9.3f %9.3f %10.2f %10.2f %11.0f %11.0f\n";
     unsigned i;
 
     if (!(flags & TEST_FLAG_PRINT_RESULTS) ||
-        (!final && (flags & TEST_FLAG_PRINT_FINAL)))
+        (!final && (flags & (TEST_FLAG_PRINT_FINAL | TEST_FLAG_PRINT_JSON))))
     {
         return;
     }
 
+    if (flags & TEST_FLAG_PRINT_JSON) {
+        print_progress_json(test_names, num_names, result);
+        fflush(stdout);
+        return;
+    }
+
     if (flags & TEST_FLAG_PRINT_CSV) {
         for (i = 0; i < num_names; ++i) {
             printf("%s,", test_names[i]);
@@ -235,7 +269,22 @@ static void print_progress(char **test_names, unsigned num_names,
            result->bandwidth.moment_average / (1024.0 * 1024.0),
            result->bandwidth.total_average / (1024.0 * 1024.0),
            result->msgrate.moment_average,
-           result->msgrate.total_average);
+           result->msgrate.total_average,
+           result->latency_tail.p50 * 1000000.0,
+           result->latency_tail.p90 * 1000000.0,
+           result->latency_tail.p99 * 1000000.0,
+           result->latency_tail.p999 * 1000000.0,
+           result->latency_tail.max * 1000000.0);
+
+    if (final && !(flags & TEST_FLAG_PRINT_CSV)) {
+        printf("  latency percentiles (usec): 50%%: %.3f  90%%: %.3f  "
+               "99%%: %.3f  99.9%%: %.3f  max: %.3f\n",
+               result->latency_tail.p50 * 1000000.0,
+               result->latency_tail.p90 * 1000000.0,
+               result->latency_tail.p99 * 1000000.0,
+               result->latency_tail.p999 * 1000000.0,
+               result->latency_tail.max * 1000000.0);
+    }
     fflush(stdout);
 }
 
@@ -284,12 +333,15 @@ static void print_header(struct perftest_context *ctx)
         }
     }
 
-    if (ctx->flags & TEST_FLAG_PRINT_CSV) {
+    if (ctx->flags & TEST_FLAG_PRINT_JSON) {
+        /* every result is a self-describing JSON object */
+    } else if (ctx->flags & TEST_FLAG_PRINT_CSV) {
         if (ctx->flags & TEST_FLAG_PRINT_RESULTS) {
             for (i = 0; i < ctx->num_batch_files; ++i) {
                 printf("%s,", basename(ctx->batch_files[i]));
             }
-            printf("iterations,typical_lat,avg_lat,overall_lat,avg_bw,overall_bw,avg_mr,overall_mr\n");
+            printf("iterations,typical_lat,avg_lat,overall_lat,avg_bw,overall_bw,avg_mr,overall_mr,"
+                   "p50_lat,p90_lat,p99_lat,p999_lat,max_lat\n");
         }
     } else {
         if (ctx->flags & TEST_FLAG_PRINT_RESULTS) {
@@ -309,7 +361,8 @@ static void print_test_name(struct perftest_context *ctx)
     char buf[200];
     unsigned i, pos;
 
-    if (!(ctx->flags & TEST_FLAG_PRINT_CSV) && (ctx->num_batch_files > 0)) {
+    if (!(ctx->flags & (TEST_FLAG_PRINT_CSV | TEST_FLAG_PRINT_JSON)) &&
+        (ctx->num_batch_files > 0)) {
         strcpy(buf, "+--------------+---------+---------+---------+----------+----------+-----------+-----------+");
 
         pos = 1;
@@ -387,6 +440,7 @@ static void usage(const struct perftest_context *ctx, const char *program)
     printf("     -N             use numeric formatting (thousands separator)\n");
     printf("     -f             print only final numbers\n");
     printf("     -v             print CSV-formatted output\n");
+    printf("     -j             print final results as JSON, one object per line\n");
     printf("\n");
     printf("  UCT only:\n");
     printf("     -d <device>    device to use for testing\n");
@@ -742,7 +796,7 @@ static ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized
     ctx->mpi                    = mpi_initialized;
 
     optind = 1;
-    while ((c = getopt (argc, argv, "p:b:Nfvc:P:h" TEST_PARAMS_ARGS)) != -1) {
+    while ((c = getopt (argc, argv, "p:b:Nfvjc:P:h" TEST_PARAMS_ARGS)) != -1) {
         switch (c) {
         case 'p':
             ctx->port = atoi(optarg);
@@ -761,6 +815,9 @@ static ucs_status_t parse_opts(struct perftest_context *ctx, int mpi_initialized
         case 'v':
             ctx->flags |= TEST_FLAG_PRINT_CSV;
             break;
+        case 'j':
+            ctx->flags |= TEST_FLAG_PRINT_JSON;
+            break;
         case 'c':
             ctx->flags |= TEST_FLAG_SET_AFFINITY;
             ctx->cpu = atoi(optarg);
@@ -107,9 +107,10 @@ static void ucm_cudafree_dispatch_events(void *dptr)
 
 CUresult ucm_cuMemFree(CUdeviceptr dptr)
 {
+    ucm_event_token_t token;
     CUresult ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_cuMemFree(dptr=%p)",(void *)dptr);
 
@@ -117,15 +118,16 @@ CUresult ucm_cuMemFree(CUdeviceptr dptr)
 
     ret = ucm_orig_cuMemFree(dptr);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 CUresult ucm_cuMemFreeHost(void *p)
 {
+    ucm_event_token_t token;
     CUresult ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_cuMemFreeHost(ptr=%p)", p);
 
@@ -133,15 +135,16 @@ CUresult ucm_cuMemFreeHost(void *p)
 
     ret = ucm_orig_cuMemFreeHost(p);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 CUresult ucm_cuMemAlloc(CUdeviceptr *dptr, size_t size)
 {
+    ucm_event_token_t token;
     CUresult ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ret = ucm_orig_cuMemAlloc(dptr, size);
     if (ret == CUDA_SUCCESS) {
@@ -149,15 +152,16 @@ CUresult ucm_cuMemAlloc(CUdeviceptr *dptr, size_t size)
         ucm_dispatch_mem_type_alloc((void *)*dptr, size, UCS_MEMORY_TYPE_CUDA);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 CUresult ucm_cuMemAllocManaged(CUdeviceptr *dptr, size_t size, unsigned int flags)
 {
+    ucm_event_token_t token;
     CUresult ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ret = ucm_orig_cuMemAllocManaged(dptr, size, flags);
     if (ret == CUDA_SUCCESS) {
@@ -167,7 +171,7 @@ CUresult ucm_cuMemAllocManaged(CUdeviceptr *dptr, size_t size, unsigned int flag
                                     UCS_MEMORY_TYPE_CUDA_MANAGED);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
@@ -175,9 +179,10 @@ CUresult ucm_cuMemAllocPitch(CUdeviceptr *dptr, size_t *pPitch,
                              size_t WidthInBytes, size_t Height,
                              unsigned int ElementSizeBytes)
 {
+    ucm_event_token_t token;
     CUresult ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ret = ucm_orig_cuMemAllocPitch(dptr, pPitch, WidthInBytes, Height, ElementSizeBytes);
     if (ret == CUDA_SUCCESS) {
@@ -187,44 +192,47 @@ CUresult ucm_cuMemAllocPitch(CUdeviceptr *dptr, size_t *pPitch,
                                     UCS_MEMORY_TYPE_CUDA);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 CUresult ucm_cuMemHostGetDevicePointer(CUdeviceptr *pdptr, void *p, unsigned int Flags)
 {
+    ucm_event_token_t token;
     CUresult ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ret = ucm_orig_cuMemHostGetDevicePointer(pdptr, p, Flags);
     if (ret == CUDA_SUCCESS) {
         ucm_trace("ucm_cuMemHostGetDevicePointer(pdptr=%p p=%p)",(void *)*pdptr, p);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 CUresult ucm_cuMemHostUnregister(void *p)
 {
+    ucm_event_token_t token;
     CUresult ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_cuMemHostUnregister(ptr=%p)", p);
 
     ret = ucm_orig_cuMemHostUnregister(p);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 cudaError_t ucm_cudaFree(void *devPtr)
 {
+    ucm_event_token_t token;
     cudaError_t ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_cudaFree(devPtr=%p)", devPtr);
 
@@ -232,16 +240,17 @@ cudaError_t ucm_cudaFree(void *devPtr)
 
     ret = ucm_orig_cudaFree(devPtr);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return ret;
 }
 
 cudaError_t ucm_cudaFreeHost(void *ptr)
 {
+    ucm_event_token_t token;
     cudaError_t ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_cudaFreeHost(ptr=%p)", ptr);
 
@@ -249,15 +258,16 @@ cudaError_t ucm_cudaFreeHost(void *ptr)
 
     ret = ucm_orig_cudaFreeHost(ptr);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 cudaError_t ucm_cudaMalloc(void **devPtr, size_t size)
 {
+    ucm_event_token_t token;
     cudaError_t ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ret = ucm_orig_cudaMalloc(devPtr, size);
     if (ret == cudaSuccess) {
@@ -265,16 +275,17 @@ cudaError_t ucm_cudaMalloc(void **devPtr, size_t size)
         ucm_dispatch_mem_type_alloc(*devPtr, size, UCS_MEMORY_TYPE_CUDA);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return ret;
 }
 
 cudaError_t ucm_cudaMallocManaged(void **devPtr, size_t size, unsigned int flags)
 {
+    ucm_event_token_t token;
     cudaError_t ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ret = ucm_orig_cudaMallocManaged(devPtr, size, flags);
     if (ret == cudaSuccess) {
@@ -283,7 +294,7 @@ cudaError_t ucm_cudaMallocManaged(void **devPtr, size_t size, unsigned int flags
         ucm_dispatch_mem_type_alloc(*devPtr, size, UCS_MEMORY_TYPE_CUDA_MANAGED);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return ret;
 }
@@ -291,9 +302,10 @@ cudaError_t ucm_cudaMallocManaged(void **devPtr, size_t size, unsigned int flags
 cudaError_t ucm_cudaMallocPitch(void **devPtr, size_t *pitch,
                                 size_t width, size_t height)
 {
+    ucm_event_token_t token;
     cudaError_t ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ret = ucm_orig_cudaMallocPitch(devPtr, pitch, width, height);
     if (ret == cudaSuccess) {
@@ -301,36 +313,38 @@ cudaError_t ucm_cudaMallocPitch(void **devPtr, size_t *pitch,
         ucm_dispatch_mem_type_alloc(*devPtr, (width * height), UCS_MEMORY_TYPE_CUDA);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 cudaError_t ucm_cudaHostGetDevicePointer(void **pDevice, void *pHost, unsigned int flags)
 {
+    ucm_event_token_t token;
     cudaError_t ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ret = ucm_orig_cudaHostGetDevicePointer(pDevice, pHost, flags);
     if (ret == cudaSuccess) {
         ucm_trace("ucm_cuMemHostGetDevicePointer(pDevice=%p pHost=%p)", pDevice, pHost);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
 cudaError_t ucm_cudaHostUnregister(void *ptr)
 {
+    ucm_event_token_t token;
     cudaError_t ret;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_cudaHostUnregister(ptr=%p)", ptr);
 
     ret = ucm_orig_cudaHostUnregister(ptr);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return ret;
 }
 
@@ -397,6 +411,7 @@ static int ucm_cudamem_scan_regions_cb(void *arg, void *addr, size_t length,
 {
     static const char *cuda_path_pattern = "/dev/nvidia";
     ucm_event_handler_t *handler         = arg;
+    ucm_event_token_t token;
     ucm_event_t event;
 
     /* we are interested in blocks which don't have any access permissions, or
@@ -414,9 +429,9 @@ static int ucm_cudamem_scan_regions_cb(void *arg, void *addr, size_t length,
     event.mem_type.size     = length;
     event.mem_type.mem_type = UCS_MEMORY_TYPE_LAST; /* unknown memory type */
 
-    ucm_event_enter();
+    token = ucm_event_enter();
     handler->cb(UCM_EVENT_MEM_TYPE_ALLOC, &event, handler->arg);
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return 0;
 }
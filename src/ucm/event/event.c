@@ -13,15 +13,18 @@
 #include <ucm/mmap/mmap.h>
 #include <ucm/malloc/malloc_hook.h>
 #include <ucm/util/sys.h>
+#include <ucs/arch/atomic.h>
 #include <ucs/arch/cpu.h>
 #include <ucs/datastruct/khash.h>
 #include <ucs/sys/compiler.h>
+#include <ucs/sys/math.h>
 #include <ucs/sys/module.h>
 #include <ucs/type/init_once.h>
 #include <ucs/type/spinlock.h>
 
 #include <sys/mman.h>
 #include <pthread.h>
+#include <sched.h>
 #include <sys/shm.h>
 #include <sys/ipc.h>
 #include <stdlib.h>
@@ -35,7 +38,43 @@ static ucs_spinlock_t ucm_kh_lock;
 #define ucm_ptr_hash(_ptr)  kh_int64_hash_func((uintptr_t)(_ptr))
 KHASH_INIT(ucm_ptr_size, const void*, size_t, 1, ucm_ptr_hash, kh_int64_hash_equal)
 
-static pthread_rwlock_t ucm_event_lock = PTHREAD_RWLOCK_INITIALIZER;
+/* Number of reader counters, must be a power of 2 */
+#define UCM_EVENT_READER_SHARDS_LOG  6
+#define UCM_EVENT_READER_SHARDS      UCS_BIT(UCM_EVENT_READER_SHARDS_LOG)
+
+
+/*
+ * Immutable snapshot of the handlers list, which is traversed by event
+ * dispatch without taking any lock.
+ */
+typedef struct ucm_event_handler_entry {
+    int                       events;
+    ucm_event_callback_t      cb;
+    void                      *arg;
+} ucm_event_handler_entry_t;
+
+
+typedef struct ucm_event_handler_array {
+    unsigned                  count;
+    ucm_event_handler_entry_t *entries;
+    size_t                    alloc_size; /* 0 for the initial static array */
+} ucm_event_handler_array_t;
+
+
+/*
+ * Count of threads dispatching events, per grace period phase. Threads are
+ * spread over several counters on separate cache lines, so concurrent readers
+ * rarely write the same cache line.
+ */
+typedef struct ucm_event_reader {
+    volatile uint32_t         count[2];
+} UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) ucm_event_reader_t;
+
+
+/* Serializes handlers list updates */
+static pthread_mutex_t ucm_event_writer_lock = PTHREAD_MUTEX_INITIALIZER;
+static ucm_event_reader_t ucm_event_readers[UCM_EVENT_READER_SHARDS];
+static volatile uint32_t ucm_event_phase = 0;
 static ucs_list_link_t ucm_event_handlers;
 static int ucm_external_events = 0;
 static khash_t(ucm_ptr_size) ucm_shmat_ptrs;
@@ -127,52 +166,156 @@ static ucs_list_link_t ucm_event_handlers =
                 UCS_LIST_INITIALIZER(&ucm_event_orig_handler.list,
                                      &ucm_event_orig_handler.list);
 
+static ucm_event_handler_entry_t ucm_event_orig_entry = {
+    .events   = UCM_EVENT_MMAP | UCM_EVENT_MUNMAP | UCM_EVENT_MREMAP |
+                UCM_EVENT_SHMAT | UCM_EVENT_SHMDT | UCM_EVENT_SBRK |
+                UCM_EVENT_MADVISE,
+    .cb       = ucm_event_call_orig,
+    .arg      = NULL
+};
+static ucm_event_handler_array_t ucm_event_orig_array = {
+    .count      = 1,
+    .entries    = &ucm_event_orig_entry,
+    .alloc_size = 0
+};
+static ucm_event_handler_array_t * volatile ucm_event_handler_array =
+                &ucm_event_orig_array;
+
 
 void ucm_event_dispatch(ucm_event_type_t event_type, ucm_event_t *event)
 {
-    ucm_event_handler_t *handler;
+    ucm_event_handler_array_t *array = ucm_event_handler_array;
+    ucm_event_handler_entry_t *entry;
 
-    ucs_list_for_each(handler, &ucm_event_handlers, list) {
-        if (handler->events & event_type) {
-            handler->cb(event_type, event, handler->arg);
+    for (entry = array->entries; entry < array->entries + array->count;
+         ++entry) {
+        if (entry->events & event_type) {
+            entry->cb(event_type, event, entry->arg);
         }
     }
 }
 
-#define ucm_event_lock(_lock_func) \
-    { \
-        int ret; \
-        do { \
-            ret = _lock_func(&ucm_event_lock); \
-        } while (ret == EAGAIN); \
-        if (ret != 0) { \
-            ucm_fatal("%s() failed: %s", #_lock_func, strerror(ret)); \
-        } \
-    }
+static UCS_F_ALWAYS_INLINE unsigned ucm_event_reader_shard()
+{
+    uint64_t key = (uintptr_t)pthread_self();
+
+    return (key * 0x9e3779b97f4a7c15ul) >> (64 - UCM_EVENT_READER_SHARDS_LOG);
+}
 
-void ucm_event_enter()
+ucm_event_token_t ucm_event_enter()
 {
-    ucm_event_lock(pthread_rwlock_rdlock);
+    unsigned shard = ucm_event_reader_shard();
+    unsigned phase = ucm_event_phase;
+
+    ucs_atomic_add32(&ucm_event_readers[shard].count[phase], 1);
+    /* Make sure the handlers array is read after the counter is updated */
+    ucs_memory_cpu_fence();
+    return (shard << 1) | phase;
+}
+
+void ucm_event_leave(ucm_event_token_t token)
+{
+    ucs_memory_cpu_fence();
+    ucs_atomic_add32(&ucm_event_readers[token >> 1].count[token & 1], -1);
 }
 
 void ucm_event_enter_exclusive()
 {
-    ucm_event_lock(pthread_rwlock_wrlock);
+    int ret;
+
+    ret = pthread_mutex_lock(&ucm_event_writer_lock);
+    if (ret != 0) {
+        ucm_fatal("pthread_mutex_lock() failed: %s", strerror(ret));
+    }
 }
 
-void ucm_event_leave()
+void ucm_event_leave_exclusive()
 {
-    pthread_rwlock_unlock(&ucm_event_lock);
+    pthread_mutex_unlock(&ucm_event_writer_lock);
+}
+
+static void ucm_event_wait_readers(unsigned phase)
+{
+    unsigned shard;
+
+    for (shard = 0; shard < UCM_EVENT_READER_SHARDS; ++shard) {
+        while (ucm_event_readers[shard].count[phase] != 0) {
+            sched_yield();
+        }
+    }
+}
+
+/*
+ * Wait until all threads which could see the previous handlers array are done
+ * dispatching events. The phase is flipped twice, since a reader could read the
+ * phase before the first flip and increment its counter only after the writer
+ * started waiting.
+ * Must be called with the writer lock held.
+ */
+static void ucm_event_synchronize()
+{
+    uint32_t phase;
+
+    /* Atomic swap also orders publishing the handlers array before reading the
+     * reader counters */
+    phase = ucs_atomic_swap32(&ucm_event_phase, !ucm_event_phase);
+    ucm_event_wait_readers(phase);
+    ucs_atomic_swap32(&ucm_event_phase, phase);
+    ucm_event_wait_readers(!phase);
+}
+
+/*
+ * Publish a new snapshot of the handlers list, and release the previous one
+ * when no one is using it anymore.
+ * Must be called with the writer lock held.
+ */
+static void ucm_event_handler_array_update()
+{
+    ucm_event_handler_array_t *array, *old_array;
+    ucm_event_handler_t *handler;
+    unsigned count;
+    size_t size;
+
+    count = ucs_list_length(&ucm_event_handlers);
+    size  = ucs_align_up_pow2(sizeof(*array) + (count * sizeof(*array->entries)),
+                              ucm_get_page_size());
+
+    /* Don't use malloc, since it may be hooked by ourselves */
+    array = ucm_orig_mmap(NULL, size, PROT_READ|PROT_WRITE,
+                          MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (array == MAP_FAILED) {
+        ucm_fatal("failed to allocate event handlers array of %zu bytes: %m",
+                  size);
+    }
+
+    array->count      = 0;
+    array->entries    = (ucm_event_handler_entry_t*)(array + 1);
+    array->alloc_size = size;
+    ucs_list_for_each(handler, &ucm_event_handlers, list) {
+        array->entries[array->count].events = handler->events;
+        array->entries[array->count].cb     = handler->cb;
+        array->entries[array->count].arg    = handler->arg;
+        ++array->count;
+    }
+
+    old_array               = ucm_event_handler_array;
+    ucm_event_handler_array = array;
+    ucm_event_synchronize();
+
+    if (old_array->alloc_size != 0) {
+        ucm_orig_munmap(old_array, old_array->alloc_size);
+    }
 }
 
 void *ucm_mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset)
 {
     ucm_event_t event;
+    ucm_event_token_t token;
 
     ucm_trace("ucm_mmap(addr=%p length=%lu prot=0x%x flags=0x%x fd=%d offset=%ld)",
               addr, length, prot, flags, fd, offset);
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     if ((flags & MAP_FIXED) && (addr != NULL)) {
         ucm_dispatch_vm_munmap(addr, length);
@@ -192,7 +335,7 @@ void *ucm_mmap(void *addr, size_t length, int prot, int flags, int fd, off_t off
         ucm_dispatch_vm_mmap(event.mmap.result, length);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return event.mmap.result;
 }
@@ -200,8 +343,9 @@ void *ucm_mmap(void *addr, size_t length, int prot, int flags, int fd, off_t off
 int ucm_munmap(void *addr, size_t length)
 {
     ucm_event_t event;
+    ucm_event_token_t token;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_munmap(addr=%p length=%lu)", addr, length);
 
@@ -212,36 +356,41 @@ int ucm_munmap(void *addr, size_t length)
     event.munmap.size    = length;
     ucm_event_dispatch(UCM_EVENT_MUNMAP, &event);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return event.munmap.result;
 }
 
 void ucm_vm_mmap(void *addr, size_t length)
 {
-    ucm_event_enter();
+    ucm_event_token_t token;
+
+    token = ucm_event_enter();
 
     ucm_trace("ucm_vm_mmap(addr=%p length=%lu)", addr, length);
     ucm_dispatch_vm_mmap(addr, length);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 }
 
 void ucm_vm_munmap(void *addr, size_t length)
 {
-    ucm_event_enter();
+    ucm_event_token_t token;
+
+    token = ucm_event_enter();
 
     ucm_trace("ucm_vm_munmap(addr=%p length=%lu)", addr, length);
     ucm_dispatch_vm_munmap(addr, length);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 }
 
 void *ucm_mremap(void *old_address, size_t old_size, size_t new_size, int flags)
 {
     ucm_event_t event;
+    ucm_event_token_t token;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_mremap(old_address=%p old_size=%lu new_size=%ld flags=0x%x)",
               old_address, old_size, new_size, flags);
@@ -260,7 +409,7 @@ void *ucm_mremap(void *old_address, size_t old_size, size_t new_size, int flags)
         ucm_dispatch_vm_mmap(event.mremap.result, new_size);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return event.mremap.result;
 }
@@ -272,8 +421,9 @@ void *ucm_shmat(int shmid, const void *shmaddr, int shmflg)
     khiter_t iter;
     size_t size;
     int result;
+    ucm_event_token_t token;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_shmat(shmid=%d shmaddr=%p shmflg=0x%x)",
               shmid, shmaddr, shmflg);
@@ -306,7 +456,7 @@ void *ucm_shmat(int shmid, const void *shmaddr, int shmflg)
         ucs_spin_unlock(&ucm_kh_lock);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return event.shmat.result;
 }
@@ -316,8 +466,9 @@ int ucm_shmdt(const void *shmaddr)
     ucm_event_t event;
     khiter_t iter;
     size_t size;
+    ucm_event_token_t token;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_debug("ucm_shmdt(shmaddr=%p)", shmaddr);
 
@@ -337,7 +488,7 @@ int ucm_shmdt(const void *shmaddr)
     event.shmdt.shmaddr = shmaddr;
     ucm_event_dispatch(UCM_EVENT_SHMDT, &event);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return event.shmdt.result;
 }
@@ -345,8 +496,9 @@ int ucm_shmdt(const void *shmaddr)
 void *ucm_sbrk(intptr_t increment)
 {
     ucm_event_t event;
+    ucm_event_token_t token;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_sbrk(increment=%+ld)", increment);
 
@@ -362,7 +514,7 @@ void *ucm_sbrk(intptr_t increment)
         ucm_dispatch_vm_mmap(ucm_orig_sbrk(0) - increment, increment);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return event.sbrk.result;
 }
@@ -370,6 +522,7 @@ void *ucm_sbrk(intptr_t increment)
 int ucm_brk(void *addr)
 {
 #if UCM_BISTRO_HOOKS
+    ucm_event_token_t token;
     void *old_addr;
     intptr_t increment;
     ucm_event_t event;
@@ -378,7 +531,7 @@ int ucm_brk(void *addr)
     /* in case if addr == NULL - it just returns current pointer */
     increment = addr ? ((intptr_t)addr - (intptr_t)old_addr) : 0;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_brk(addr=%p)", addr);
 
@@ -394,7 +547,7 @@ int ucm_brk(void *addr)
         ucm_dispatch_vm_mmap(old_addr, increment);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return event.sbrk.result == MAP_FAILED ? -1 : 0;
 #else
@@ -405,8 +558,9 @@ int ucm_brk(void *addr)
 int ucm_madvise(void *addr, size_t length, int advice)
 {
     ucm_event_t event;
+    ucm_event_token_t token;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_madvise(addr=%p length=%zu advice=%d)", addr, length, advice);
 
@@ -431,7 +585,7 @@ int ucm_madvise(void *addr, size_t length, int advice)
     event.madvise.advice = advice;
     ucm_event_dispatch(UCM_EVENT_MADVISE, &event);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
 
     return event.madvise.result;
 }
@@ -444,20 +598,22 @@ void ucm_event_handler_add(ucm_event_handler_t *handler)
     ucs_list_for_each(elem, &ucm_event_handlers, list) {
         if (handler->priority < elem->priority) {
             ucs_list_insert_before(&elem->list, &handler->list);
-            ucm_event_leave();
-            return;
+            goto out;
         }
     }
 
     ucs_list_add_tail(&ucm_event_handlers, &handler->list);
-    ucm_event_leave();
+out:
+    ucm_event_handler_array_update();
+    ucm_event_leave_exclusive();
 }
 
 void ucm_event_handler_remove(ucm_event_handler_t *handler)
 {
     ucm_event_enter_exclusive();
     ucs_list_del(&handler->list);
-    ucm_event_leave();
+    ucm_event_handler_array_update();
+    ucm_event_leave_exclusive();
 }
 
 static int ucm_events_to_native_events(int events)
@@ -588,14 +744,14 @@ void ucm_set_external_event(int events)
 {
     ucm_event_enter_exclusive();
     ucm_external_events |= events;
-    ucm_event_leave();
+    ucm_event_leave_exclusive();
 }
 
 void ucm_unset_external_event(int events)
 {
     ucm_event_enter_exclusive();
     ucm_external_events &= ~events;
-    ucm_event_leave();
+    ucm_event_leave_exclusive();
 }
 
 void ucm_unset_event_handler(int events, ucm_event_callback_t cb, void *arg)
@@ -613,9 +769,12 @@ void ucm_unset_event_handler(int events, ucm_event_callback_t cb, void *arg)
             }
         }
     }
-    ucm_event_leave();
+    ucm_event_handler_array_update();
+    ucm_event_leave_exclusive();
 
-    /* Do not release memory while we hold event lock - may deadlock */
+    /* Do not release memory while we hold event lock - may deadlock. The
+     * handlers are not used by event dispatch anymore, since the array update
+     * waits for all readers of the previous array. */
     ucs_list_for_each_safe(elem, tmp, &gc_list, list) {
         free(elem);
     }
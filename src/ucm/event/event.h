@@ -30,6 +30,13 @@ typedef struct ucm_event_handler {
 } ucm_event_handler_t;
 
 
+/*
+ * Identifies the reader counter taken by @ref ucm_event_enter, should be passed
+ * to the matching @ref ucm_event_leave.
+ */
+typedef unsigned ucm_event_token_t;
+
+
 typedef struct ucm_event_installer {
     ucs_status_t          (*install)(int events);
     void                  (*get_existing_alloc)(ucm_event_handler_t *handler);
@@ -46,11 +53,13 @@ void ucm_event_handler_remove(ucm_event_handler_t *handler);
 
 void ucm_event_dispatch(ucm_event_type_t event_type, ucm_event_t *event);
 
-void ucm_event_enter();
+ucm_event_token_t ucm_event_enter();
+
+void ucm_event_leave(ucm_event_token_t token);
 
 void ucm_event_enter_exclusive();
 
-void ucm_event_leave();
+void ucm_event_leave_exclusive();
 
 static UCS_F_ALWAYS_INLINE void
 ucm_dispatch_vm_mmap(void *addr, size_t length)
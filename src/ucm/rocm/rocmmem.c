@@ -95,9 +95,10 @@ static void ucm_hsa_amd_memory_pool_free_dispatch_events(void *ptr)
 
 hsa_status_t ucm_hsa_amd_memory_pool_free(void* ptr)
 {
+    ucm_event_token_t token;
     hsa_status_t status;
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     ucm_trace("ucm_hsa_amd_memory_pool_free(ptr=%p)", ptr);
 
@@ -105,7 +106,7 @@ hsa_status_t ucm_hsa_amd_memory_pool_free(void* ptr)
 
     status = ucm_orig_hsa_amd_memory_pool_free(ptr);
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return status;
 }
 
@@ -113,6 +114,7 @@ hsa_status_t ucm_hsa_amd_memory_pool_allocate(
     hsa_amd_memory_pool_t memory_pool, size_t size,
     uint32_t flags, void** ptr)
 {
+    ucm_event_token_t token;
     hsa_status_t status;
     uint32_t pool_flags = 0;
     int type = UCS_MEMORY_TYPE_ROCM;
@@ -125,7 +127,7 @@ hsa_status_t ucm_hsa_amd_memory_pool_allocate(
         type = UCS_MEMORY_TYPE_ROCM_MANAGED;
     }
 
-    ucm_event_enter();
+    token = ucm_event_enter();
 
     status = ucm_orig_hsa_amd_memory_pool_allocate(memory_pool, size, flags, ptr);
     if (status == HSA_STATUS_SUCCESS) {
@@ -133,7 +135,7 @@ hsa_status_t ucm_hsa_amd_memory_pool_allocate(
         ucm_dispatch_mem_type_alloc(*ptr, size, type);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(token);
     return status;
 }
 
@@ -164,8 +164,10 @@ enum ucp_worker_params_field {
     UCP_WORKER_PARAM_FIELD_CPU_MASK     = UCS_BIT(1), /**< Worker's CPU bitmap */
     UCP_WORKER_PARAM_FIELD_EVENTS       = UCS_BIT(2), /**< Worker's events bitmap */
     UCP_WORKER_PARAM_FIELD_USER_DATA    = UCS_BIT(3), /**< User data */
-    UCP_WORKER_PARAM_FIELD_EVENT_FD     = UCS_BIT(4)  /**< External event file
+    UCP_WORKER_PARAM_FIELD_EVENT_FD     = UCS_BIT(4), /**< External event file
                                                            descriptor */
+    UCP_WORKER_PARAM_FIELD_CQ_SIZE      = UCS_BIT(5)  /**< Completion queue
+                                                           size */
 };
 
 
@@ -914,9 +916,73 @@ typedef struct ucp_worker_params {
      */
     int                     event_fd;
 
+    /**
+     * Initial number of entries in the worker completion queue.
+     * This value is optional.
+     * If @ref UCP_WORKER_PARAM_FIELD_CQ_SIZE is set in the field_mask and the
+     * value is nonzero, the worker maintains a completion queue: requests
+     * which were started with a NULL completion callback are appended to it
+     * when they complete, and can be retrieved in batches by
+     * @ref ucp_worker_poll_cq. The queue grows together with the pool of
+     * requests of the worker, so it never overflows and this value is only a
+     * sizing hint. Otherwise, the worker has no completion queue.
+     */
+    unsigned                cq_size;
+
 } ucp_worker_params_t;
 
 
+/**
+ * @ingroup UCP_WORKER
+ * @brief Completion queue entry.
+ *
+ * The structure describes a completed request returned by
+ * @ref ucp_worker_poll_cq.
+ */
+typedef struct ucp_cq_entry {
+    void                    *request; /**< Completed request handle */
+    ucs_status_t            status;   /**< Completion status of the request */
+} ucp_cq_entry_t;
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Tagged receive operation descriptor.
+ *
+ * The structure describes a single receive posted by
+ * @ref ucp_tag_recv_nbr_batch. The fields have the same meaning as the
+ * arguments of @ref ucp_tag_recv_nbr.
+ */
+typedef struct ucp_tag_recv_op {
+    void                    *buffer;   /**< Buffer to receive the data to */
+    size_t                  count;     /**< Number of elements to receive */
+    ucp_datatype_t          datatype;  /**< Datatype of the elements */
+    ucp_tag_t               tag;       /**< Message tag to expect */
+    ucp_tag_t               tag_mask;  /**< Bits of the tag to match */
+    void                    *request;  /**< Request handle allocated by the
+                                            user */
+} ucp_tag_recv_op_t;
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Tagged send operation descriptor.
+ *
+ * The structure describes a single send posted by
+ * @ref ucp_tag_send_nbr_batch. The fields have the same meaning as the
+ * arguments of @ref ucp_tag_send_nbr.
+ */
+typedef struct ucp_tag_send_op {
+    ucp_ep_h                ep;        /**< Destination endpoint */
+    const void              *buffer;   /**< Buffer to send */
+    size_t                  count;     /**< Number of elements to send */
+    ucp_datatype_t          datatype;  /**< Datatype of the elements */
+    ucp_tag_t               tag;       /**< Message tag */
+    void                    *request;  /**< Request handle allocated by the
+                                            user */
+} ucp_tag_send_op_t;
+
+
 /**
  * @ingroup UCP_WORKER
  * @brief UCP listener attributes.
@@ -1430,6 +1496,35 @@ void ucp_worker_release_address(ucp_worker_h worker, ucp_address_t *address);
 unsigned ucp_worker_progress(ucp_worker_h worker);
 
 
+/**
+ * @ingroup UCP_WORKER
+ * @brief Retrieve completed requests from the worker completion queue.
+ *
+ * This routine removes up to @a max_entries completed requests from the
+ * completion queue of the worker, in the order they were completed, and
+ * stores them in @a entries. Only requests which were started with a NULL
+ * completion callback on a worker created with
+ * @ref UCP_WORKER_PARAM_FIELD_CQ_SIZE are reported. This routine does not
+ * progress the worker; @ref ucp_worker_progress should be called to advance
+ * outstanding operations.
+ *
+ * @note Requests reported by this routine are still owned by the user, and
+ *       must be released by @ref ucp_request_free. A request which is
+ *       released before it completes is not reported. A request which is
+ *       released after it completes, but before it is retrieved, is removed
+ *       from the queue by this routine without being reported.
+ *
+ * @param [in]  worker       Worker to retrieve completions from.
+ * @param [out] entries      Array of at least @a max_entries entries, filled
+ *                           with the completed requests and their statuses.
+ * @param [in]  max_entries  Maximal number of entries to retrieve.
+ *
+ * @return Number of entries stored in @a entries.
+ */
+unsigned ucp_worker_poll_cq(ucp_worker_h worker, ucp_cq_entry_t *entries,
+                            unsigned max_entries);
+
+
 /**
  * @ingroup UCP_WORKER
  * @brief Poll for endpoints that are ready to consume streaming data.
@@ -2421,6 +2516,30 @@ ucs_status_ptr_t ucp_tag_send_nb(ucp_ep_h ep, const void *buffer, size_t count,
 ucs_status_t ucp_tag_send_nbr(ucp_ep_h ep, const void *buffer, size_t count,
                               ucp_datatype_t datatype, ucp_tag_t tag, void *req);
 
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Post a batch of non-blocking tagged-send operations.
+ *
+ * This routine posts the sends described by @a ops, in order, as if
+ * @ref ucp_tag_send_nbr was called for each of them, but enters the worker
+ * critical section only once for the whole batch. All endpoints in @a ops
+ * must belong to @a worker.
+ *
+ * @param [in]  worker      UCP worker the endpoints belong to.
+ * @param [in]  ops         Array of @a num_ops send descriptors.
+ * @param [in]  num_ops     Number of sends to post.
+ * @param [out] statuses    Array of @a num_ops entries, filled with the value
+ *                          @ref ucp_tag_send_nbr would have returned for the
+ *                          corresponding send.
+ *
+ * @return UCS_OK if all sends were posted, otherwise the error of the first
+ *         send which failed. Sends following a failed one are still posted.
+ */
+ucs_status_t ucp_tag_send_nbr_batch(ucp_worker_h worker,
+                                    const ucp_tag_send_op_t *ops,
+                                    unsigned num_ops, ucs_status_t *statuses);
+
 /**
  * @ingroup UCP_COMM
  * @brief Non-blocking synchronous tagged-send operation.
@@ -2616,6 +2735,29 @@ ucs_status_t ucp_tag_recv_nbr(ucp_worker_h worker, void *buffer, size_t count,
                               ucp_tag_t tag_mask, void *req);
 
 
+/**
+ * @ingroup UCP_COMM
+ * @brief Post a batch of non-blocking tagged-receive operations.
+ *
+ * This routine posts the receives described by @a ops, in order, as if
+ * @ref ucp_tag_recv_nbr was called for each of them, but enters the worker
+ * critical section only once for the whole batch. Receives are matched in
+ * array order, so a message is delivered to the first matching entry. In
+ * order to monitor completion of the operations
+ * @ref ucp_request_check_status or @ref ucp_tag_recv_request_test should be
+ * used on each request.
+ *
+ * @param [in]  worker      UCP worker that is used for the receive operations.
+ * @param [in]  ops         Array of @a num_ops receive descriptors.
+ * @param [in]  num_ops     Number of receives to post.
+ *
+ * @return Error code as defined by @ref ucs_status_t
+ */
+ucs_status_t ucp_tag_recv_nbr_batch(ucp_worker_h worker,
+                                    const ucp_tag_recv_op_t *ops,
+                                    unsigned num_ops);
+
+
 /**
  * @ingroup UCP_COMM
  * @brief Non-blocking probe and return a message.
@@ -2851,6 +2993,168 @@ ucs_status_ptr_t ucp_get_nb(ucp_ep_h ep, void *buffer, size_t length,
                             uint64_t remote_addr, ucp_rkey_h rkey,
                             ucp_send_callback_t cb);
 
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Non-blocking remote memory put operation from a local I/O vector.
+ *
+ * This routine initiates a storage of the local data blocks described by the
+ * @a iov array in the remote contiguous memory region described by
+ * @a remote_addr address and the @ref ucp_rkey_h "memory handle" @a rkey.
+ * The blocks are stored one after another, in the order of the array. When
+ * supported by the transport, the blocks are gathered by a single network
+ * operation, otherwise they are sent as separate fragments. Completion
+ * semantics are the same as of @ref ucp_put_nb "ucp_put_nb()".
+ *
+ * @note The @a iov array and the buffers it points to must not be modified
+ *       until the operation completes.
+ *
+ * @param [in]  ep           Remote endpoint handle.
+ * @param [in]  iov          Array of local source blocks.
+ * @param [in]  iovcnt       Number of elements in @a iov.
+ * @param [in]  remote_addr  Pointer to the destination remote memory address
+ *                           to write to.
+ * @param [in]  rkey         Remote memory key associated with the
+ *                           remote memory address.
+ * @param [in]  cb           Call-back function that is invoked whenever the
+ *                           put operation is completed and the local buffers
+ *                           can be modified. Does not guarantee remote
+ *                           completion.
+ *
+ * @return UCS_OK               - The operation was completed immediately.
+ * @return UCS_PTR_IS_ERR(_ptr) - The operation failed.
+ * @return otherwise            - Operation was scheduled and can be
+ *                              completed at any point in time. The request handle
+ *                              is returned to the application in order to track
+ *                              progress of the operation. The application is
+ *                              responsible for releasing the handle using
+ *                              @ref ucp_request_free "ucp_request_free()" routine.
+ */
+ucs_status_ptr_t ucp_put_iov_nb(ucp_ep_h ep, const ucp_dt_iov_t *iov,
+                                size_t iovcnt, uint64_t remote_addr,
+                                ucp_rkey_h rkey, ucp_send_callback_t cb);
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Non-blocking remote memory get operation to a local I/O vector.
+ *
+ * This routine initiates a load of a contiguous block of data that is
+ * described by the remote memory address @a remote_addr and the
+ * @ref ucp_rkey_h "memory handle" @a rkey, and scatters it to the local
+ * blocks described by the @a iov array, in the order of the array.
+ * Completion semantics are the same as of @ref ucp_get_nb "ucp_get_nb()".
+ *
+ * @note The @a iov array must not be modified until the operation completes.
+ *
+ * @param [in]  ep           Remote endpoint handle.
+ * @param [in]  iov          Array of local destination blocks.
+ * @param [in]  iovcnt       Number of elements in @a iov.
+ * @param [in]  remote_addr  Pointer to the source remote memory address
+ *                           to read from.
+ * @param [in]  rkey         Remote memory key associated with the
+ *                           remote memory address.
+ * @param [in]  cb           Call-back function that is invoked whenever the
+ *                           get operation is completed and the data is
+ *                           visible to the local process.
+ *
+ * @return UCS_OK               - The operation was completed immediately.
+ * @return UCS_PTR_IS_ERR(_ptr) - The operation failed.
+ * @return otherwise            - Operation was scheduled and can be
+ *                              completed at any point in time. The request handle
+ *                              is returned to the application in order to track
+ *                              progress of the operation. The application is
+ *                              responsible for releasing the handle using
+ *                              @ref ucp_request_free "ucp_request_free()" routine.
+ */
+ucs_status_ptr_t ucp_get_iov_nb(ucp_ep_h ep, const ucp_dt_iov_t *iov,
+                                size_t iovcnt, uint64_t remote_addr,
+                                ucp_rkey_h rkey, ucp_send_callback_t cb);
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Non-blocking strided remote memory put operation.
+ *
+ * This routine initiates a storage of @a count blocks of @a length bytes each.
+ * Block @e i is read from the local address
+ * @a buffer + @e i * @a local_stride and is written to the remote address
+ * @a remote_addr + @e i * @a remote_stride, which is described by the
+ * @ref ucp_rkey_h "memory handle" @a rkey. If @a remote_stride is equal to
+ * @a length, the local blocks are gathered to a contiguous remote region,
+ * using a single network operation when supported by the transport.
+ * Completion semantics are the same as of @ref ucp_put_nb "ucp_put_nb()".
+ *
+ * @param [in]  ep            Remote endpoint handle.
+ * @param [in]  buffer        Pointer to the first local source block.
+ * @param [in]  length        Length of every block, in bytes.
+ * @param [in]  count         Number of blocks.
+ * @param [in]  local_stride  Distance between local blocks, in bytes.
+ * @param [in]  remote_addr   Remote address of the first block.
+ * @param [in]  remote_stride Distance between remote blocks, in bytes.
+ * @param [in]  rkey          Remote memory key associated with the
+ *                            remote memory address.
+ * @param [in]  cb            Call-back function that is invoked whenever the
+ *                            put operation is completed and the local buffer
+ *                            can be modified. Does not guarantee remote
+ *                            completion.
+ *
+ * @return UCS_OK               - The operation was completed immediately.
+ * @return UCS_PTR_IS_ERR(_ptr) - The operation failed.
+ * @return otherwise            - Operation was scheduled and can be
+ *                              completed at any point in time. The request handle
+ *                              is returned to the application in order to track
+ *                              progress of the operation. The application is
+ *                              responsible for releasing the handle using
+ *                              @ref ucp_request_free "ucp_request_free()" routine.
+ */
+ucs_status_ptr_t ucp_put_strided_nb(ucp_ep_h ep, const void *buffer,
+                                    size_t length, size_t count,
+                                    size_t local_stride, uint64_t remote_addr,
+                                    size_t remote_stride, ucp_rkey_h rkey,
+                                    ucp_send_callback_t cb);
+
+
+/**
+ * @ingroup UCP_COMM
+ * @brief Non-blocking strided remote memory get operation.
+ *
+ * This routine initiates a load of @a count blocks of @a length bytes each.
+ * Block @e i is read from the remote address
+ * @a remote_addr + @e i * @a remote_stride, which is described by the
+ * @ref ucp_rkey_h "memory handle" @a rkey, and is written to the local address
+ * @a buffer + @e i * @a local_stride. If @a remote_stride is equal to
+ * @a length, the contiguous remote region is scattered to the local blocks,
+ * using a single network operation when supported by the transport.
+ * Completion semantics are the same as of @ref ucp_get_nb "ucp_get_nb()".
+ *
+ * @param [in]  ep            Remote endpoint handle.
+ * @param [in]  buffer        Pointer to the first local destination block.
+ * @param [in]  length        Length of every block, in bytes.
+ * @param [in]  count         Number of blocks.
+ * @param [in]  local_stride  Distance between local blocks, in bytes.
+ * @param [in]  remote_addr   Remote address of the first block.
+ * @param [in]  remote_stride Distance between remote blocks, in bytes.
+ * @param [in]  rkey          Remote memory key associated with the
+ *                            remote memory address.
+ * @param [in]  cb            Call-back function that is invoked whenever the
+ *                            get operation is completed and the data is
+ *                            visible to the local process.
+ *
+ * @return UCS_OK               - The operation was completed immediately.
+ * @return UCS_PTR_IS_ERR(_ptr) - The operation failed.
+ * @return otherwise            - Operation was scheduled and can be
+ *                              completed at any point in time. The request handle
+ *                              is returned to the application in order to track
+ *                              progress of the operation. The application is
+ *                              responsible for releasing the handle using
+ *                              @ref ucp_request_free "ucp_request_free()" routine.
+ */
+ucs_status_ptr_t ucp_get_strided_nb(ucp_ep_h ep, void *buffer, size_t length,
+                                    size_t count, size_t local_stride,
+                                    uint64_t remote_addr, size_t remote_stride,
+                                    ucp_rkey_h rkey, ucp_send_callback_t cb);
+
 /**
  * @ingroup UCP_COMM
  * @brief Post an atomic memory operation.
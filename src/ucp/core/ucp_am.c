@@ -20,6 +20,122 @@
 #include <ucp/proto/proto_am.inl>
 #include <ucp/dt/dt.h>
 #include <ucp/dt/dt.inl>
+#include <ucs/sys/string.h>
+
+extern ucs_mpool_ops_t ucp_am_mpool_ops;
+
+static ucs_mpool_ops_t ucp_am_unfinished_mpool_ops = {
+    .chunk_alloc   = ucs_mpool_chunk_malloc,
+    .chunk_release = ucs_mpool_chunk_free,
+    .obj_init      = NULL,
+    .obj_cleanup   = NULL
+};
+
+ucs_status_t ucp_am_worker_init(ucp_worker_h worker)
+{
+    ucp_am_worker_ctx_t *am_ctx = &worker->am;
+    ucs_status_t status;
+
+    kh_init_inplace(ucp_am_unfinished_hash, &am_ctx->unfinished_hash);
+    am_ctx->reasm_mp_map = 0;
+
+    status = ucs_mpool_init(&am_ctx->unfinished_mp, 0,
+                            sizeof(ucp_am_unfinished_t), 0,
+                            UCS_SYS_CACHE_LINE_SIZE, 128, UINT_MAX,
+                            &ucp_am_unfinished_mpool_ops, "ucp_am_unfinished");
+    if (status != UCS_OK) {
+        kh_destroy_inplace(ucp_am_unfinished_hash, &am_ctx->unfinished_hash);
+    }
+
+    return status;
+}
+
+void ucp_am_worker_cleanup(ucp_worker_h worker)
+{
+    ucp_am_worker_ctx_t *am_ctx = &worker->am;
+    unsigned mp_index;
+
+    ucs_for_each_bit(mp_index, am_ctx->reasm_mp_map) {
+        ucs_mpool_cleanup(&am_ctx->reasm_mp[mp_index], 1);
+    }
+
+    ucs_mpool_cleanup(&am_ctx->unfinished_mp, 1);
+    kh_destroy_inplace(ucp_am_unfinished_hash, &am_ctx->unfinished_hash);
+}
+
+static ucp_recv_desc_t *ucp_am_reasm_buffer_get(ucp_worker_h worker,
+                                                size_t total_size)
+{
+    ucp_am_worker_ctx_t *am_ctx = &worker->am;
+    ucp_recv_desc_t *rdesc;
+    unsigned shift, mp_index;
+    ucs_status_t status;
+    char name[32];
+
+    if (ucs_unlikely(total_size > UCS_BIT(UCP_AM_REASM_MAX_SHIFT))) {
+        rdesc = ucs_malloc(total_size + sizeof(ucp_recv_desc_t),
+                           "ucp recv desc for long AM");
+        if (ucs_unlikely(rdesc == NULL)) {
+            return NULL;
+        }
+
+        rdesc->flags = UCP_RECV_DESC_FLAG_MALLOC;
+        return rdesc;
+    }
+
+    shift    = ucs_max(ucs_ilog2(ucs_roundup_pow2(total_size)),
+                       UCP_AM_REASM_MIN_SHIFT);
+    mp_index = shift - UCP_AM_REASM_MIN_SHIFT;
+
+    /* Size class pools are created on first use */
+    if (ucs_unlikely(!(am_ctx->reasm_mp_map & UCS_BIT(mp_index)))) {
+        ucs_snprintf_zero(name, sizeof(name), "ucp_am_reasm_%zu",
+                          UCS_BIT(shift));
+        status = ucs_mpool_init(&am_ctx->reasm_mp[mp_index], 0,
+                                UCS_BIT(shift) + sizeof(ucp_recv_desc_t),
+                                sizeof(ucp_recv_desc_t),
+                                UCS_SYS_CACHE_LINE_SIZE,
+                                ucs_max(1, UCS_MBYTE >> shift), UINT_MAX,
+                                &ucp_am_mpool_ops, name);
+        if (status != UCS_OK) {
+            return NULL;
+        }
+
+        am_ctx->reasm_mp_map |= UCS_BIT(mp_index);
+    }
+
+    rdesc = ucs_mpool_get_inline(&am_ctx->reasm_mp[mp_index]);
+    if (ucs_unlikely(rdesc == NULL)) {
+        return NULL;
+    }
+
+    /* Released by ucp_recv_desc_release() back to the size class pool */
+    rdesc->flags = 0;
+    return rdesc;
+}
+
+static void ucp_am_reasm_buffer_put(ucp_recv_desc_t *rdesc)
+{
+    if (ucs_unlikely(rdesc->flags & UCP_RECV_DESC_FLAG_MALLOC)) {
+        ucs_free(rdesc);
+    } else {
+        ucs_mpool_put_inline(rdesc);
+    }
+}
+
+static void ucp_am_unfinished_release(ucp_worker_h worker,
+                                      ucp_am_unfinished_t *unfinished)
+{
+    khiter_t iter;
+
+    iter = kh_get(ucp_am_unfinished_hash, &worker->am.unfinished_hash,
+                  unfinished->key);
+    ucs_assert(iter != kh_end(&worker->am.unfinished_hash));
+    kh_del(ucp_am_unfinished_hash, &worker->am.unfinished_hash, iter);
+
+    ucs_list_del(&unfinished->list);
+    ucs_mpool_put_inline(unfinished);
+}
 
 void ucp_am_ep_init(ucp_ep_h ep)
 {
@@ -33,12 +149,19 @@ void ucp_am_ep_init(ucp_ep_h ep)
 void ucp_am_ep_cleanup(ucp_ep_h ep)
 {
     ucp_ep_ext_proto_t *ep_ext = ucp_ep_ext_proto(ep);
+    ucp_am_unfinished_t *unfinished, *tmp;
 
     if (ep->worker->context->config.features & UCP_FEATURE_AM) {
         if (ucs_unlikely(!ucs_list_is_empty(&ep_ext->am.started_ams))) {
             ucs_warn("worker : %p not all UCP active messages have been" 
                      "run to completion", ep->worker);
         }
+
+        ucs_list_for_each_safe(unfinished, tmp, &ep_ext->am.started_ams,
+                               list) {
+            ucp_am_reasm_buffer_put(unfinished->all_data);
+            ucp_am_unfinished_release(ep->worker, unfinished);
+        }
     }
 }
 
@@ -553,20 +676,17 @@ ucp_am_handler(void *am_arg, void *am_data, size_t am_length,
                                  am_flags);    
 }
 
-static ucp_am_unfinished_t *
-ucp_am_find_unfinished(ucp_worker_h worker, ucp_ep_h ep, 
-                       ucp_ep_ext_proto_t *ep_ext, 
-                       ucp_am_long_hdr_t *hdr, size_t am_length)
+static UCS_F_ALWAYS_INLINE ucp_am_unfinished_t *
+ucp_am_find_unfinished(ucp_worker_h worker, ucp_am_unfinished_key_t key)
 {
-    ucp_am_unfinished_t *unfinished;
-    /* TODO make this hash table for faster lookup */
-    ucs_list_for_each(unfinished, &ep_ext->am.started_ams, list) {
-        if (unfinished->msg_id == hdr->msg_id) {
-            return unfinished;
-        }
+    khiter_t iter;
+
+    iter = kh_get(ucp_am_unfinished_hash, &worker->am.unfinished_hash, key);
+    if (iter == kh_end(&worker->am.unfinished_hash)) {
+        return NULL;
     }
-    
-    return NULL;
+
+    return kh_value(&worker->am.unfinished_hash, iter);
 }
 
 static ucs_status_t
@@ -590,11 +710,10 @@ ucp_am_handle_unfinished(ucp_worker_h worker,
                                           UCP_CB_PARAM_FLAG_DATA);
 
         if (status != UCS_INPROGRESS) {
-            ucs_free(unfinished->all_data);
+            ucp_am_reasm_buffer_put(unfinished->all_data);
         }
 
-        ucs_list_del(&unfinished->list);
-        ucs_free(unfinished);
+        ucp_am_unfinished_release(worker, unfinished);
     }
     
     return UCS_OK;
@@ -612,6 +731,9 @@ ucp_am_long_handler_common(void *am_arg, void *am_data, size_t am_length,
     ucp_recv_desc_t *all_data;
     size_t left;
     ucp_am_unfinished_t *unfinished;
+    ucp_am_unfinished_key_t key;
+    khiter_t iter;
+    int ret;
 
     if (ucs_unlikely((long_hdr->am_id >= worker->am_cb_array_len) ||
                      (worker->am_cbs[long_hdr->am_id].cb == NULL))) {
@@ -625,7 +747,9 @@ ucp_am_long_handler_common(void *am_arg, void *am_data, size_t am_length,
      * have arrived. If any messages have arrived,
      * we copy ourselves into the buffer and leave
      */
-    unfinished = ucp_am_find_unfinished(worker, ep, ep_ext, long_hdr, am_length);
+    key.ep     = (uintptr_t)ep;
+    key.msg_id = long_hdr->msg_id;
+    unfinished = ucp_am_find_unfinished(worker, key);
     
     if (unfinished) {
         return ucp_am_handle_unfinished(worker, unfinished, 
@@ -636,14 +760,11 @@ ucp_am_long_handler_common(void *am_arg, void *am_data, size_t am_length,
     /* If I am first, I make the buffer for everyone to go into,
      * copy myself in, and put myself on the list so people can find me
      */
-    all_data = ucs_malloc(long_hdr->total_size + sizeof(ucp_recv_desc_t),
-                          "ucp recv desc for long AM");
+    all_data = ucp_am_reasm_buffer_get(worker, long_hdr->total_size);
     if (ucs_unlikely(all_data == NULL)) {
         return UCS_ERR_NO_MEMORY;
     }
 
-    all_data->flags = UCP_RECV_DESC_FLAG_MALLOC;
-
     left = long_hdr->total_size - (am_length -
                                    sizeof(ucp_am_long_hdr_t));
     
@@ -651,16 +772,26 @@ ucp_am_long_handler_common(void *am_arg, void *am_data, size_t am_length,
            long_hdr + 1, am_length - sizeof(ucp_am_long_hdr_t));
     
     /* Can't use a desc for this because of the buffer */
-    unfinished           = ucs_malloc(sizeof(ucp_am_unfinished_t),
-                                         "unfinished UCP AM");
+    unfinished = ucs_mpool_get_inline(&worker->am.unfinished_mp);
     if (ucs_unlikely(unfinished == NULL)) {
-        ucs_free(all_data);
+        ucp_am_reasm_buffer_put(all_data);
         return UCS_ERR_NO_MEMORY;
     }
 
+    iter = kh_put(ucp_am_unfinished_hash, &worker->am.unfinished_hash, key,
+                  &ret);
+    if (ucs_unlikely(ret == -1)) {
+        ucs_mpool_put_inline(unfinished);
+        ucp_am_reasm_buffer_put(all_data);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    ucs_assert(ret != 0);
+    kh_value(&worker->am.unfinished_hash, iter) = unfinished;
+
     unfinished->all_data = all_data;
     unfinished->left     = left;
-    unfinished->msg_id   = long_hdr->msg_id;
+    unfinished->key      = key;
 
     ucs_list_add_head(&ep_ext->am.started_ams, &unfinished->list);
 
@@ -4,10 +4,24 @@
  * See file LICENSE for terms.
  */
 
+#ifndef UCP_AM_H_
+#define UCP_AM_H_
+
 #include "ucp_ep.h"
 
+#include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/mpool.h>
+
 #define UCP_AM_CB_BLOCK_SIZE 16
 
+/* Long AM reassembly buffers of up to 2^UCP_AM_REASM_MAX_SHIFT bytes are taken
+ * from per-worker memory pools, one per power-of-2 size class. Larger messages
+ * fall back to malloc. */
+#define UCP_AM_REASM_MIN_SHIFT  12
+#define UCP_AM_REASM_MAX_SHIFT  20
+#define UCP_AM_REASM_NUM_MPOOLS (UCP_AM_REASM_MAX_SHIFT - \
+                                 UCP_AM_REASM_MIN_SHIFT + 1)
+
 
 typedef union {
     struct {
@@ -42,12 +56,51 @@ typedef struct {
 } UCS_S_PACKED ucp_am_long_hdr_t;
 
 typedef struct {
-    ucs_list_link_t   list;       /* entry into list of unfinished AM's */
-    ucp_recv_desc_t  *all_data;   /* buffer for all parts of the AM */
-    uint64_t          msg_id;     /* way to match up all parts of AM */
-    size_t            left;
+    uintptr_t         ep;         /* end point the AM arrives on */
+    uint64_t          msg_id;     /* sender's id of the AM */
+} ucp_am_unfinished_key_t;
+
+typedef struct {
+    ucs_list_link_t         list;     /* entry into ep list of unfinished AM's */
+    ucp_recv_desc_t         *all_data; /* buffer for all parts of the AM */
+    ucp_am_unfinished_key_t key;      /* way to match up all parts of AM */
+    size_t                  left;
 } ucp_am_unfinished_t;
 
+
+static UCS_F_ALWAYS_INLINE khint32_t
+ucp_am_unfinished_key_hash(ucp_am_unfinished_key_t key)
+{
+    return kh_int64_hash_func(key.ep ^ key.msg_id);
+}
+
+#define ucp_am_unfinished_key_equal(_key1, _key2) \
+    (((_key1).ep == (_key2).ep) && ((_key1).msg_id == (_key2).msg_id))
+
+KHASH_INIT(ucp_am_unfinished_hash, ucp_am_unfinished_key_t,
+           ucp_am_unfinished_t*, 1, ucp_am_unfinished_key_hash,
+           ucp_am_unfinished_key_equal);
+
+
+/**
+ * Per-worker long AM reassembly context
+ */
+typedef struct {
+    khash_t(ucp_am_unfinished_hash) unfinished_hash; /* Unfinished AM's by
+                                                        (ep, msg_id) */
+    ucs_mpool_t       unfinished_mp;  /* Memory pool for unfinished AM's */
+    ucs_mpool_t       reasm_mp[UCP_AM_REASM_NUM_MPOOLS]; /* Reassembly buffer
+                                                            pools, by size class */
+    unsigned          reasm_mp_map;   /* Bitmap of initialized reasm_mp */
+} ucp_am_worker_ctx_t;
+
+
+ucs_status_t ucp_am_worker_init(ucp_worker_h worker);
+
+void ucp_am_worker_cleanup(ucp_worker_h worker);
+
 void ucp_am_ep_init(ucp_ep_h ep);
 
 void ucp_am_ep_cleanup(ucp_ep_h ep);
+
+#endif
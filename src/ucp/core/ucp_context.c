@@ -261,6 +261,12 @@ static ucs_config_field_t ucp_config_table[] = {
    "require out of band synchronization before destroying UCP resources.",
    ucs_offsetof(ucp_config_t, ctx.sockaddr_cm_enable), UCS_CONFIG_TYPE_TERNARY},
 
+  {"MPOOL_SHRINK_INTERVAL", "0",
+   "Interval for releasing idle memory pool chunks, when the worker progress\n"
+   "finds no events. A chunk is released when all its elements remained unused\n"
+   "for a whole interval. 0 disables releasing pool memory.",
+   ucs_offsetof(ucp_config_t, ctx.mpool_shrink_interval), UCS_CONFIG_TYPE_TIME},
+
   {NULL}
 };
 UCS_CONFIG_REGISTER_TABLE(ucp_config_table, "UCP context", NULL, ucp_config_t)
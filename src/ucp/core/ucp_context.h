@@ -87,6 +87,8 @@ typedef struct ucp_context_config {
     int                                    unified_mode;
     /** Enable cm wireup-and-close protocol for client-server connections */
     ucs_ternary_value_t                    sockaddr_cm_enable;
+    /** Interval for releasing idle memory pool chunks, 0 - never */
+    double                                 mpool_shrink_interval;
 } ucp_context_config_t;
 
 
@@ -21,6 +21,8 @@
 #include <ucp/tag/offload.h>
 #include <ucp/stream/stream.h>
 #include <ucp/core/ucp_listener.h>
+#include <ucp/rma/rma.h>
+#include <ucs/algorithm/crc.h>
 #include <ucs/datastruct/queue.h>
 #include <ucs/debug/memtrack.h>
 #include <ucs/debug/log.h>
@@ -141,6 +143,7 @@ void ucp_ep_delete(ucp_ep_h ep)
 {
     ucs_callbackq_remove_if(&ep->worker->uct->progress_q,
                             ucp_wireup_msg_ack_cb_pred, ep);
+    ucp_rma_sw_ep_cleanup(ep);
     UCS_STATS_NODE_FREE(ep->stats);
     ucs_list_del(&ucp_ep_ext_gen(ep)->ep_list);
     ucs_strided_alloc_put(&ep->worker->ep_alloc, ep);
@@ -887,6 +890,39 @@ int ucp_ep_config_is_equal(const ucp_ep_config_key_t *key1,
     return 1;
 }
 
+uint32_t ucp_ep_config_key_hash(const ucp_ep_config_key_t *key)
+{
+    ucp_lane_index_t lane;
+    uint32_t crc;
+
+    /* Must cover exactly the fields compared by ucp_ep_config_is_equal() */
+    crc = ucs_crc32(0, &key->num_lanes, sizeof(key->num_lanes));
+    for (lane = 0; lane < key->num_lanes; ++lane) {
+        crc = ucs_crc32(crc, &key->lanes[lane].rsc_index,
+                        sizeof(key->lanes[lane].rsc_index));
+        crc = ucs_crc32(crc, &key->lanes[lane].proxy_lane,
+                        sizeof(key->lanes[lane].proxy_lane));
+        crc = ucs_crc32(crc, &key->lanes[lane].dst_md_index,
+                        sizeof(key->lanes[lane].dst_md_index));
+    }
+
+    crc = ucs_crc32(crc, key->rma_lanes,         sizeof(key->rma_lanes));
+    crc = ucs_crc32(crc, key->am_bw_lanes,       sizeof(key->am_bw_lanes));
+    crc = ucs_crc32(crc, key->rma_bw_lanes,      sizeof(key->rma_bw_lanes));
+    crc = ucs_crc32(crc, key->amo_lanes,         sizeof(key->amo_lanes));
+    crc = ucs_crc32(crc, &key->rma_bw_md_map,    sizeof(key->rma_bw_md_map));
+    crc = ucs_crc32(crc, &key->reachable_md_map, sizeof(key->reachable_md_map));
+    crc = ucs_crc32(crc, &key->am_lane,          sizeof(key->am_lane));
+    crc = ucs_crc32(crc, &key->tag_lane,         sizeof(key->tag_lane));
+    crc = ucs_crc32(crc, &key->wireup_lane,      sizeof(key->wireup_lane));
+    crc = ucs_crc32(crc, &key->err_mode,         sizeof(key->err_mode));
+    crc = ucs_crc32(crc, &key->status,           sizeof(key->status));
+    crc = ucs_crc32(crc, key->dst_md_cmpts,
+                    ucs_popcount(key->reachable_md_map) *
+                    sizeof(*key->dst_md_cmpts));
+    return crc;
+}
+
 static void ucp_ep_config_calc_params(ucp_worker_h worker,
                                       const ucp_ep_config_t *config,
                                       const ucp_lane_index_t *lanes,
@@ -1375,8 +1411,15 @@ ucs_status_t ucp_ep_config_init(ucp_worker_h worker, ucp_ep_config_t *config,
         rma_config->max_get_short    = SIZE_MAX;
         rma_config->max_put_bcopy    = SIZE_MAX;
         rma_config->max_get_bcopy    = SIZE_MAX;
+        rma_config->max_put_iov      = 1;
+        rma_config->max_get_iov      = 1;
 
         if (ucp_ep_config_get_multi_lane_prio(config->key.rma_lanes, lane) == -1) {
+            if (lane == config->key.am_lane) {
+                /* Software RMA over active messages may send PUT data with
+                 * AM zcopy */
+                rma_config->put_zcopy_thresh = config->am.zcopy_thresh[0];
+            }
             continue;
         }
 
@@ -1387,6 +1430,7 @@ ucs_status_t ucp_ep_config_init(ucp_worker_h worker, ucp_ep_config_t *config,
             /* PUT */
             if (iface_attr->cap.flags & UCT_IFACE_FLAG_PUT_ZCOPY) {
                 rma_config->max_put_zcopy    = iface_attr->cap.put.max_zcopy;
+                rma_config->max_put_iov      = ucs_max(iface_attr->cap.put.max_iov, 1);
                 /* TODO: formula */
                 if (context->config.ext.zcopy_thresh == UCS_MEMUNITS_AUTO) {
                     rma_config->put_zcopy_thresh = 16384; 
@@ -1409,6 +1453,7 @@ ucs_status_t ucp_ep_config_init(ucp_worker_h worker, ucp_ep_config_t *config,
             if (iface_attr->cap.flags & UCT_IFACE_FLAG_GET_ZCOPY) {
                 /* TODO: formula */
                 rma_config->max_get_zcopy = iface_attr->cap.get.max_zcopy;
+                rma_config->max_get_iov   = ucs_max(iface_attr->cap.get.max_iov, 1);
                 if (context->config.ext.zcopy_thresh == UCS_MEMUNITS_AUTO) {
                     rma_config->get_zcopy_thresh = 16384;
                 } else {
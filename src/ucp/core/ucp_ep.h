@@ -156,6 +156,8 @@ typedef struct ucp_ep_rma_config {
     size_t                 max_get_zcopy;
     size_t                 put_zcopy_thresh;
     size_t                 get_zcopy_thresh;
+    size_t                 max_put_iov;      /* Maximal iov count of put zcopy */
+    size_t                 max_get_iov;      /* Maximal iov count of get zcopy */
 } ucp_ep_rma_config_t;
 
 
@@ -454,6 +456,8 @@ void ucp_ep_config_cleanup(ucp_worker_h worker, ucp_ep_config_t *config);
 int ucp_ep_config_is_equal(const ucp_ep_config_key_t *key1,
                            const ucp_ep_config_key_t *key2);
 
+uint32_t ucp_ep_config_key_hash(const ucp_ep_config_key_t *key);
+
 int ucp_ep_config_get_multi_lane_prio(const ucp_lane_index_t *lanes,
                                       ucp_lane_index_t lane);
 
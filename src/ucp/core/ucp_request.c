@@ -79,7 +79,10 @@ ucp_request_release_common(void *request, uint8_t cb_flag, const char *debug_nam
     ucs_assert(!(flags & UCP_REQUEST_DEBUG_FLAG_EXTERNAL));
     ucs_assert(!(flags & UCP_REQUEST_FLAG_RELEASED));
 
-    if (ucs_likely(flags & UCP_REQUEST_FLAG_COMPLETED)) {
+    /* A request on the completion queue is put when it is polled */
+    if (ucs_likely((flags & (UCP_REQUEST_FLAG_COMPLETED |
+                             UCP_REQUEST_FLAG_CQ_QUEUED)) ==
+                   UCP_REQUEST_FLAG_COMPLETED)) {
         ucp_request_put(req);
     } else {
         req->flags = (flags | UCP_REQUEST_FLAG_RELEASED) & ~cb_flag;
@@ -144,8 +147,29 @@ static void ucp_worker_request_fini_proxy(ucs_mpool_t *mp, void *obj)
     }
 }
 
+static ucs_status_t
+ucp_worker_request_chunk_alloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
+{
+    ucp_worker_h worker = ucs_container_of(mp, ucp_worker_t, req_mp);
+    ucs_status_t status;
+
+    status = ucs_mpool_hugetlb_malloc(mp, size_p, chunk_p);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* Make room on the completion queue for every request of the chunk, so
+     * a request can always be queued when it completes */
+    status = ucp_worker_cq_reserve(worker, *size_p / mp->data->elem_size);
+    if (status != UCS_OK) {
+        ucs_mpool_hugetlb_free(mp, *chunk_p);
+    }
+
+    return status;
+}
+
 ucs_mpool_ops_t ucp_request_mpool_ops = {
-    .chunk_alloc   = ucs_mpool_hugetlb_malloc,
+    .chunk_alloc   = ucp_worker_request_chunk_alloc,
     .chunk_release = ucs_mpool_hugetlb_free,
     .obj_init      = ucp_worker_request_init_proxy,
     .obj_cleanup   = ucp_worker_request_fini_proxy
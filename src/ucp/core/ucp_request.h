@@ -44,6 +44,7 @@ enum {
     UCP_REQUEST_FLAG_STREAM_RECV_WAITALL  = UCS_BIT(12),
     UCP_REQUEST_FLAG_SEND_AM              = UCS_BIT(13),
     UCP_REQUEST_FLAG_SEND_TAG             = UCS_BIT(14),
+    UCP_REQUEST_FLAG_CQ_QUEUED            = UCS_BIT(15),
 #if UCS_ENABLE_ASSERT
     UCP_REQUEST_FLAG_STREAM_RECV          = UCS_BIT(16),
     UCP_REQUEST_DEBUG_FLAG_EXTERNAL       = UCS_BIT(17)
@@ -130,8 +131,20 @@ struct ucp_request {
                 struct {
                     uint64_t      remote_addr; /* Remote address */
                     ucp_rkey_h    rkey;     /* Remote memory key */
+                    ucp_request_t *super_req; /* Vector operation which this
+                                                 fragment is part of, or NULL */
+                    size_t        block_length; /* Length of a local block of
+                                                   a strided fragment */
+                    size_t        block_stride; /* Distance between local blocks
+                                                   of a strided fragment */
                 } rma;
 
+                struct {
+                    ucp_rkey_h    rkey;     /* Remote memory key */
+                    unsigned      frag_count; /* Fragments in flight, plus one
+                                                 until all are sent */
+                } rma_vec;
+
                 struct {
                     uintptr_t     remote_request; /* pointer to the send request on receiver side */
                     uint8_t       am_id;
@@ -202,6 +215,11 @@ struct ucp_request {
                     uintptr_t              req;  /* Remote get request pointer */
                 } get_reply;
 
+                struct {
+                    uint32_t               count; /* Number of acknowledged
+                                                     remote operations */
+                } rma_cmpl;
+
                 struct {
                     uintptr_t              req;  /* Remote atomic request pointer */
                     ucp_atomic_reply_t     data; /* Atomic reply data */
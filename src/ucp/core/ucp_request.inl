@@ -63,7 +63,11 @@
     { \
         (_req)->status = (_status); \
         if (ucs_likely((_req)->flags & UCP_REQUEST_FLAG_CALLBACK)) { \
-            (_req)->_cb((_req) + 1, (_status), ## __VA_ARGS__); \
+            if (ucs_likely((_req)->_cb != NULL)) { \
+                (_req)->_cb((_req) + 1, (_status), ## __VA_ARGS__); \
+            } else { \
+                ucp_request_complete_cq(_req); \
+            } \
         } \
         if (ucs_unlikely(((_req)->flags  |= UCP_REQUEST_FLAG_COMPLETED) & \
                          UCP_REQUEST_FLAG_RELEASED)) { \
@@ -87,6 +91,30 @@ ucp_request_put(ucp_request_t *req)
     ucs_mpool_put_inline(req);
 }
 
+/* Report a request which has no completion callback on the worker completion
+ * queue, if the worker has one */
+static UCS_F_ALWAYS_INLINE void
+ucp_request_complete_cq(ucp_request_t *req)
+{
+    ucp_worker_h worker = ucs_container_of(ucs_mpool_obj_owner(req),
+                                           ucp_worker_t, req_mp);
+    ucp_worker_cq_t *cq = &worker->cq;
+
+    /* Only requests of the worker pool are started with a callback */
+    ucs_assert(ucs_mpool_obj_owner(req)->data->ops == &ucp_request_mpool_ops);
+
+    if ((cq->ring == NULL) || (req->flags & UCP_REQUEST_FLAG_RELEASED)) {
+        return;
+    }
+
+    /* The ring has room for every request of the pool */
+    ucs_assert((cq->tail - cq->head) <= cq->size_mask);
+
+    ucs_trace_req("worker %p: queued completion of request %p", worker, req);
+    req->flags                          |= UCP_REQUEST_FLAG_CQ_QUEUED;
+    cq->ring[cq->tail++ & cq->size_mask] = req;
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucp_request_complete_send(ucp_request_t *req, ucs_status_t status)
 {
@@ -270,7 +298,8 @@ ucp_request_send_state_reset(ucp_request_t *req,
 {
     switch (proto) {
     case UCP_REQUEST_SEND_PROTO_RMA:
-        ucs_assert(UCP_DT_IS_CONTIG(req->send.datatype));
+        ucs_assert(UCP_DT_IS_CONTIG(req->send.datatype) ||
+                   UCP_DT_IS_IOV(req->send.datatype));
         /* Fall through */
     case UCP_REQUEST_SEND_PROTO_RNDV_GET:
     case UCP_REQUEST_SEND_PROTO_RNDV_PUT:
@@ -91,6 +91,8 @@ enum {
     UCP_AM_ID_SINGLE_REPLY      =  25, /* For user defined AM when a reply
                                           is needed */
     UCP_AM_ID_MULTI_REPLY       =  26,
+    UCP_AM_ID_CMPL_COUNT        =  27, /* Completion of several remote memory
+                                          operations */
     UCP_AM_ID_LAST
 };
 
@@ -1494,6 +1494,15 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
         goto out;
     }
 
+    if (worker->flags & UCP_WORKER_FLAG_MT) {
+        /* ucp_am_data_release() may be called from any thread without the
+         * worker lock */
+        status = ucs_mpool_enable_mt(&worker->am_mp);
+        if (status != UCS_OK) {
+            goto err_release_am_mpool;
+        }
+    }
+
     status = ucs_mpool_init(&worker->reg_mp, 0,
                             context->config.ext.seg_size + sizeof(ucp_mem_desc_t),
                             sizeof(ucp_mem_desc_t), UCS_SYS_CACHE_LINE_SIZE,
@@ -1510,8 +1519,21 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
         goto err_release_reg_mpool;
     }
 
+    if (context->config.features & UCP_FEATURE_AM) {
+        status = ucp_am_worker_init(worker);
+        if (status != UCS_OK) {
+            goto err_release_frag_mpool;
+        }
+    }
+
+    worker->mpool_shrink_interval =
+            ucs_time_from_sec(context->config.ext.mpool_shrink_interval);
+    worker->mpool_shrink_time     = ucs_get_time() +
+                                    worker->mpool_shrink_interval;
     return UCS_OK;
 
+err_release_frag_mpool:
+    ucs_mpool_cleanup(&worker->rndv_frag_mp, 0);
 err_release_reg_mpool:
     ucs_mpool_cleanup(&worker->reg_mp, 0);
 err_release_am_mpool:
@@ -1532,27 +1554,60 @@ ucs_status_t ucp_worker_get_ep_config(ucp_worker_h worker,
                                       ucp_ep_cfg_index_t *config_idx_p)
 {
     ucp_ep_cfg_index_t config_idx;
+    ucp_ep_config_t *config, **ep_config;
+    unsigned ep_config_max;
     ucs_status_t status;
+    khiter_t iter;
+    int ret;
 
     /* Search for the given key in the ep_config array */
-    for (config_idx = 0; config_idx < worker->ep_config_count; ++config_idx) {
-        if (ucp_ep_config_is_equal(&worker->ep_config[config_idx].key, key)) {
-            goto out;
+    iter = kh_get(ucp_worker_ep_config_hash, &worker->ep_config_hash, key);
+    if (iter != kh_end(&worker->ep_config_hash)) {
+        config_idx = kh_value(&worker->ep_config_hash, iter);
+        goto out;
+    }
+
+    if (worker->ep_config_count >= UCS_MASK(sizeof(ucp_ep_cfg_index_t) * 8)) {
+        ucs_error("too many ep configurations: %d", worker->ep_config_count);
+        return UCS_ERR_EXCEEDS_LIMIT;
+    }
+
+    if (worker->ep_config_count == worker->ep_config_max) {
+        ep_config_max = ucs_max(worker->ep_config_max * 2, 16);
+        ep_config     = ucs_realloc(worker->ep_config,
+                                    sizeof(*ep_config) * ep_config_max,
+                                    "ucp_ep_config");
+        if (ep_config == NULL) {
+            return UCS_ERR_NO_MEMORY;
         }
+
+        worker->ep_config     = ep_config;
+        worker->ep_config_max = ep_config_max;
     }
 
-    if (worker->ep_config_count >= worker->ep_config_max) {
-        /* TODO support larger number of configurations */
-        ucs_fatal("too many ep configurations: %d", worker->ep_config_count);
+    /* Create new configuration. It's allocated separately, so pointers to
+     * existing configurations stay valid when the array grows. */
+    config = ucs_malloc(sizeof(*config), "ucp_ep_config");
+    if (config == NULL) {
+        return UCS_ERR_NO_MEMORY;
     }
 
-    /* Create new configuration */
-    config_idx = worker->ep_config_count++;
-    status = ucp_ep_config_init(worker, &worker->ep_config[config_idx], key);
+    status = ucp_ep_config_init(worker, config, key);
     if (status != UCS_OK) {
-        return status;
+        goto err_free_config;
+    }
+
+    iter = kh_put(ucp_worker_ep_config_hash, &worker->ep_config_hash,
+                  &config->key, &ret);
+    if (ret == -1) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err_cleanup_config;
     }
 
+    config_idx                              = worker->ep_config_count++;
+    worker->ep_config[config_idx]           = config;
+    kh_value(&worker->ep_config_hash, iter) = config_idx;
+
     if (print_cfg) {
         ucp_worker_print_used_tls(key, worker->context, config_idx);
     }
@@ -1560,6 +1615,12 @@ ucs_status_t ucp_worker_get_ep_config(ucp_worker_h worker,
 out:
     *config_idx_p = config_idx;
     return UCS_OK;
+
+err_cleanup_config:
+    ucp_ep_config_cleanup(worker, config);
+err_free_config:
+    ucs_free(config);
+    return status;
 }
 
 static ucs_mpool_ops_t ucp_rkey_mpool_ops = {
@@ -1569,22 +1630,102 @@ static ucs_mpool_ops_t ucp_rkey_mpool_ops = {
     .obj_cleanup   = NULL
 };
 
+static ucs_status_t ucp_worker_cq_resize(ucp_worker_h worker, unsigned size)
+{
+    ucp_worker_cq_t *cq = &worker->cq;
+    unsigned count      = cq->tail - cq->head;
+    ucp_request_t **ring;
+    unsigned i;
+
+    ring = ucs_malloc(size * sizeof(*ring), "ucp worker cq");
+    if (ring == NULL) {
+        ucs_error("failed to allocate worker completion queue of %u entries",
+                  size);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    /* unwrap the queue so that the oldest entry is placed first */
+    for (i = 0; i < count; ++i) {
+        ring[i] = cq->ring[(cq->head + i) & cq->size_mask];
+    }
+
+    ucs_free(cq->ring);
+    cq->ring      = ring;
+    cq->size_mask = size - 1;
+    cq->head      = 0;
+    cq->tail      = count;
+    ucs_debug("worker %p: completion queue resized to %u entries", worker,
+              size);
+    return UCS_OK;
+}
+
+static ucs_status_t ucp_worker_cq_init(ucp_worker_h worker,
+                                       const ucp_worker_params_t *params)
+{
+    unsigned size;
+
+    worker->cq.ring      = NULL;
+    worker->cq.size_mask = 0;
+    worker->cq.head      = 0;
+    worker->cq.tail      = 0;
+    worker->cq.num_reqs  = 0;
+
+    if (!(params->field_mask & UCP_WORKER_PARAM_FIELD_CQ_SIZE) ||
+        (params->cq_size == 0)) {
+        return UCS_OK;
+    }
+
+    size = params->cq_size;
+    return ucp_worker_cq_resize(worker, ucs_roundup_pow2(size));
+}
+
+ucs_status_t ucp_worker_cq_reserve(ucp_worker_h worker, unsigned num_reqs)
+{
+    ucp_worker_cq_t *cq = &worker->cq;
+    unsigned size       = cq->num_reqs + num_reqs;
+    ucs_status_t status;
+
+    if (cq->ring == NULL) {
+        return UCS_OK;
+    }
+
+    if (size > (cq->size_mask + 1)) {
+        status = ucp_worker_cq_resize(worker, ucs_roundup_pow2(size));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    cq->num_reqs = size;
+    return UCS_OK;
+}
+
+static void ucp_worker_destroy_ep_configs(ucp_worker_h worker)
+{
+    unsigned i;
+
+    kh_clear(ucp_worker_ep_config_hash, &worker->ep_config_hash);
+    for (i = 0; i < worker->ep_config_count; ++i) {
+        ucp_ep_config_cleanup(worker, worker->ep_config[i]);
+        ucs_free(worker->ep_config[i]);
+    }
+
+    ucs_free(worker->ep_config);
+    worker->ep_config       = NULL;
+    worker->ep_config_count = 0;
+    worker->ep_config_max   = 0;
+}
+
 ucs_status_t ucp_worker_create(ucp_context_h context,
                                const ucp_worker_params_t *params,
                                ucp_worker_h *worker_p)
 {
     ucs_thread_mode_t uct_thread_mode;
-    unsigned config_count;
     unsigned name_length;
     ucp_worker_h worker;
     ucs_status_t status;
 
-    config_count = ucs_min((context->num_tls + 1) * (context->num_tls + 1) * context->num_tls,
-                           UINT8_MAX);
-
-    worker = ucs_calloc(1, sizeof(*worker) +
-                           sizeof(*worker->ep_config) * config_count,
-                        "ucp worker");
+    worker = ucs_calloc(1, sizeof(*worker), "ucp worker");
     if (worker == NULL) {
         return UCS_ERR_NO_MEMORY;
     }
@@ -1613,14 +1754,18 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     worker->uuid              = ucs_generate_uuid((uintptr_t)worker);
     worker->flush_ops_count   = 0;
     worker->inprogress        = 0;
-    worker->ep_config_max     = config_count;
+    worker->ep_config_max     = 0;
     worker->ep_config_count   = 0;
+    worker->ep_config         = NULL;
     worker->num_active_ifaces = 0;
     worker->am_message_id     = ucs_generate_uuid(0);
     ucs_list_head_init(&worker->arm_ifaces);
     ucs_list_head_init(&worker->stream_ready_eps);
     ucs_list_head_init(&worker->all_eps);
     ucp_ep_match_init(&worker->ep_match_ctx);
+    kh_init_inplace(ucp_worker_rma_cmpl_hash, &worker->rma_cmpl_hash);
+    worker->rma_cmpl_cb_id = UCS_CALLBACKQ_ID_NULL;
+    kh_init_inplace(ucp_worker_ep_config_hash, &worker->ep_config_hash);
 
     UCS_STATIC_ASSERT(sizeof(ucp_ep_ext_gen_t) <= sizeof(ucp_ep_t));
     if (context->config.features & (UCP_FEATURE_STREAM | UCP_FEATURE_AM)) {
@@ -1636,6 +1781,11 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
         worker->user_data = NULL;
     }
 
+    status = ucp_worker_cq_init(worker, params);
+    if (status != UCS_OK) {
+        goto err_free;
+    }
+
     if (context->config.features & UCP_FEATURE_AM){
         worker->am_cbs            = NULL;
         worker->am_cb_array_len   = 0;
@@ -1765,7 +1915,11 @@ err_free_tm_offload_stats:
 err_free_stats:
     UCS_STATS_NODE_FREE(worker->stats);
 err_free:
+    ucp_worker_destroy_ep_configs(worker);
+    kh_destroy_inplace(ucp_worker_ep_config_hash, &worker->ep_config_hash);
+    kh_destroy_inplace(ucp_worker_rma_cmpl_hash, &worker->rma_cmpl_hash);
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
+    ucs_free(worker->cq.ring);
     ucs_free(worker);
     return status;
 }
@@ -1780,17 +1934,6 @@ static void ucp_worker_destroy_eps(ucp_worker_h worker)
     }
 }
 
-static void ucp_worker_destroy_ep_configs(ucp_worker_h worker)
-{
-    unsigned i;
-
-    for (i = 0; i < worker->ep_config_count; ++i) {
-        ucp_ep_config_cleanup(worker, &worker->ep_config[i]);
-    }
-
-    worker->ep_config_count = 0;
-}
-
 void ucp_worker_destroy(ucp_worker_h worker)
 {
     ucs_trace_func("worker=%p", worker);
@@ -1803,6 +1946,9 @@ void ucp_worker_destroy(ucp_worker_h worker)
     UCS_ASYNC_UNBLOCK(&worker->async);
 
     ucp_worker_destroy_ep_configs(worker);
+    if (worker->context->config.features & UCP_FEATURE_AM) {
+        ucp_am_worker_cleanup(worker);
+    }
     ucs_mpool_cleanup(&worker->am_mp, 1);
     ucs_mpool_cleanup(&worker->reg_mp, 1);
     ucs_mpool_cleanup(&worker->rndv_frag_mp, 1);
@@ -1811,12 +1957,16 @@ void ucp_worker_destroy(ucp_worker_h worker)
     ucp_worker_wakeup_cleanup(worker);
     ucs_mpool_cleanup(&worker->rkey_mp, 1);
     ucs_mpool_cleanup(&worker->req_mp, 1);
+    uct_worker_progress_unregister_safe(worker->uct, &worker->rma_cmpl_cb_id);
     uct_worker_destroy(worker->uct);
+    kh_destroy_inplace(ucp_worker_ep_config_hash, &worker->ep_config_hash);
+    kh_destroy_inplace(ucp_worker_rma_cmpl_hash, &worker->rma_cmpl_hash);
     ucs_async_context_cleanup(&worker->async);
     ucp_ep_match_cleanup(&worker->ep_match_ctx);
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
     UCS_STATS_NODE_FREE(worker->tm_offload_stats);
     UCS_STATS_NODE_FREE(worker->stats);
+    ucs_free(worker->cq.ring);
     ucs_free(worker);
 }
 
@@ -1860,6 +2010,55 @@ ucs_status_t ucp_worker_query(ucp_worker_h worker,
     return status;
 }
 
+unsigned ucp_worker_poll_cq(ucp_worker_h worker, ucp_cq_entry_t *entries,
+                            unsigned max_entries)
+{
+    ucp_worker_cq_t *cq = &worker->cq;
+    unsigned count      = 0;
+    ucp_request_t *req;
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+
+    while ((count < max_entries) && (cq->head != cq->tail)) {
+        req         = cq->ring[cq->head++ & cq->size_mask];
+        req->flags &= ~UCP_REQUEST_FLAG_CQ_QUEUED;
+        if (req->flags & UCP_REQUEST_FLAG_RELEASED) {
+            /* released by the user after it was queued */
+            ucp_request_put(req);
+            continue;
+        }
+
+        entries[count].request = req + 1;
+        entries[count].status  = req->status;
+        ++count;
+    }
+
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+
+    return count;
+}
+
+/* Release the pool memory which was left unused since the previous call */
+static UCS_F_NOINLINE void ucp_worker_mpools_shrink(ucp_worker_h worker)
+{
+    ucs_time_t now = ucs_get_time();
+    unsigned num_released;
+
+    if (now < worker->mpool_shrink_time) {
+        return;
+    }
+
+    worker->mpool_shrink_time = now + worker->mpool_shrink_interval;
+
+    num_released  = ucs_mpool_shrink(&worker->am_mp, 0);
+    num_released += ucs_mpool_shrink(&worker->reg_mp, 0);
+    num_released += ucs_mpool_shrink(&worker->rndv_frag_mp, 0);
+    if (num_released > 0) {
+        ucs_debug("worker %p: released %u idle memory pool chunks", worker,
+                  num_released);
+    }
+}
+
 unsigned ucp_worker_progress(ucp_worker_h worker)
 {
     unsigned count;
@@ -1874,6 +2073,10 @@ unsigned ucp_worker_progress(ucp_worker_h worker)
     count = uct_worker_progress(worker->uct);
     ucs_async_check_miss(&worker->async);
 
+    if ((count == 0) && (worker->mpool_shrink_interval != 0)) {
+        ucp_worker_mpools_shrink(worker);
+    }
+
     /* coverity[assert_side_effect] */
     ucs_assert(--worker->inprogress == 0);
 
@@ -9,6 +9,7 @@
 #define UCP_WORKER_H_
 
 #include "ucp_ep.h"
+#include "ucp_am.h"
 #include "ucp_context.h"
 #include "ucp_thread.h"
 
@@ -27,6 +28,16 @@
 #define UCP_WORKER_HEADROOM_PRIV_SIZE 24
 
 
+/* Endpoint configuration index, by configuration key */
+KHASH_INIT(ucp_worker_ep_config_hash, const ucp_ep_config_key_t*,
+           ucp_ep_cfg_index_t, 1, ucp_ep_config_key_hash,
+           ucp_ep_config_is_equal);
+
+/* Number of software RMA/AMO operations to acknowledge, by endpoint */
+KHASH_INIT(ucp_worker_rma_cmpl_hash, uint64_t, uint32_t, 1,
+           kh_int64_hash_func, kh_int64_hash_equal);
+
+
 #if ENABLE_MT
 
 #define UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(_worker)                 \
@@ -198,6 +209,23 @@ typedef struct ucp_worker_am_entry {
     uint32_t              flags;
 } ucp_worker_am_entry_t;
 
+/**
+ * Completion queue of requests which were started without a completion
+ * callback. The ring size is a power of 2; head and tail are free-running.
+ * The ring is grown with the request memory pool, so it always has room for
+ * every request of the worker and a completion is never dropped.
+ */
+typedef struct ucp_worker_cq {
+    ucp_request_t                 **ring;        /* Completed requests, or NULL
+                                                    if the queue is disabled */
+    unsigned                      size_mask;     /* Ring size minus 1 */
+    unsigned                      head;          /* Next entry to poll */
+    unsigned                      tail;          /* Next entry to fill */
+    unsigned                      num_reqs;      /* Requests allocated by the
+                                                    request memory pool */
+} ucp_worker_cq_t;
+
+
 /**
  * UCP worker (thread context).
  */
@@ -234,8 +262,17 @@ typedef struct ucp_worker {
     ucs_mpool_t                   am_mp;         /* Memory pool for AM receives */
     ucs_mpool_t                   reg_mp;        /* Registered memory pool */
     ucs_mpool_t                   rndv_frag_mp;  /* Memory pool for RNDV fragments */
+    ucs_time_t                    mpool_shrink_interval; /* Interval for releasing
+                                                            idle pool chunks */
+    ucs_time_t                    mpool_shrink_time; /* Next time to release
+                                                        idle pool chunks */
     ucp_tag_match_t               tm;            /* Tag-matching queues and offload info */
+    khash_t(ucp_worker_rma_cmpl_hash) rma_cmpl_hash; /* Endpoints with pending
+                                                        coalesced sw RMA acks */
+    uct_worker_cb_id_t            rma_cmpl_cb_id; /* Progress callback which
+                                                     sends the coalesced acks */
     uint64_t                      am_message_id; /* For matching long am's */
+    ucp_am_worker_ctx_t           am;            /* Long AM reassembly context */
     ucp_ep_h                      mem_type_ep[UCS_MEMORY_TYPE_LAST];/* memory type eps */
 
     UCS_STATS_NODE_DECLARE(stats);
@@ -245,9 +282,12 @@ typedef struct ucp_worker {
     size_t                        am_cb_array_len; /*len of callback array */
 
     ucs_cpu_set_t                 cpu_mask;        /* Save CPU mask for subsequent calls to ucp_worker_listen */
-    unsigned                      ep_config_max;   /* Maximal number of configurations */
+    unsigned                      ep_config_max;   /* Allocated length of ep_config */
     unsigned                      ep_config_count; /* Current number of configurations */
-    ucp_ep_config_t               ep_config[0];    /* Array of transport limits and thresholds */
+    ucp_ep_config_t               **ep_config;     /* Array of transport limits and thresholds;
+                                                      entries never move once created */
+    khash_t(ucp_worker_ep_config_hash) ep_config_hash; /* Index of ep_config by key */
+    ucp_worker_cq_t               cq;              /* Completion queue */
 } ucp_worker_t;
 
 
@@ -287,6 +327,8 @@ void ucp_worker_iface_activate(ucp_worker_iface_t *wiface, unsigned uct_flags);
 
 int ucp_worker_err_handle_remove_filter(const ucs_callbackq_elem_t *elem,
                                         void *arg);
+ucs_status_t ucp_worker_cq_reserve(ucp_worker_h worker, unsigned num_reqs);
+
 ucs_status_t ucp_worker_set_ep_failed(ucp_worker_h worker, ucp_ep_h ucp_ep,
                                       uct_ep_h uct_ep, ucp_lane_index_t lane,
                                       ucs_status_t status);
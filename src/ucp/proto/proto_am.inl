@@ -286,7 +286,11 @@ ucs_status_t ucp_do_am_zcopy_multi(uct_pending_req_t *self, uint8_t am_id_first,
                                          hdr_size_middle, iov, iovcnt, 0,
                                          &req->send.state.uct_comp);
             } else if (state.offset == req->send.length) {
-                /* Empty IOVs on last stage */
+                /* Empty IOVs on last stage. If all previous stages were
+                 * completed in place, there is no completion to wait for */
+                if (req->send.state.uct_comp.count == 0) {
+                    complete(req, UCS_OK);
+                }
                 return UCS_OK;
             } else {
                 ucs_assert(offset == state.offset);
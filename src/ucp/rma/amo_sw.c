@@ -255,7 +255,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_atomic_rep_handler, (arg, data, length, am_fl
 
     memcpy(req->send.buffer, hdr + 1, frag_length);
     ucp_request_complete_send(req, UCS_OK);
-    ucp_ep_rma_remote_request_completed(ep);
+    ucp_ep_rma_remote_request_completed(ep, 1);
     return UCS_OK;
 }
 
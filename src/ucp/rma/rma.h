@@ -7,6 +7,7 @@
 #ifndef UCP_RMA_H_
 #define UCP_RMA_H_
 
+#include <ucp/dt/dt.h>
 #include <ucp/proto/proto.h>
 
 
@@ -17,6 +18,10 @@ struct ucp_rma_proto {
     const char                 *name;
     uct_pending_callback_t     progress_put;
     uct_pending_callback_t     progress_get;
+    uct_pending_callback_t     progress_put_iov; /* Local iov to remote contig,
+                                                    NULL if not supported */
+    uct_pending_callback_t     progress_get_iov; /* Remote contig to local iov,
+                                                    NULL if not supported */
 };
 
 
@@ -50,6 +55,12 @@ typedef struct {
 } UCS_S_PACKED ucp_cmpl_hdr_t;
 
 
+typedef struct {
+    ucp_cmpl_hdr_t            super;
+    uint32_t                  count; /* Number of completed operations */
+} UCS_S_PACKED ucp_cmpl_count_hdr_t;
+
+
 typedef struct {
     uint64_t                  address;
     uint64_t                  length;
@@ -79,8 +90,14 @@ extern ucp_amo_proto_t ucp_amo_sw_proto;
 ucs_status_t ucp_rma_request_advance(ucp_request_t *req, ssize_t frag_length,
                                      ucs_status_t status);
 
+ucs_status_t ucp_rma_request_iov_advance(ucp_request_t *req,
+                                         const ucp_dt_state_t *new_dt_state,
+                                         ucs_status_t status);
+
 void ucp_ep_flush_remote_completed(ucp_request_t *req);
 
 void ucp_rma_sw_send_cmpl(ucp_ep_h ep);
 
+void ucp_rma_sw_ep_cleanup(ucp_ep_h ep);
+
 #endif
@@ -61,13 +61,14 @@ static inline void ucp_ep_rma_remote_request_sent(ucp_ep_t *ep)
     ++ep->worker->flush_ops_count;
 }
 
-static inline void ucp_ep_rma_remote_request_completed(ucp_ep_t *ep)
+static inline void ucp_ep_rma_remote_request_completed(ucp_ep_t *ep,
+                                                       uint32_t count)
 {
     ucp_ep_flush_state_t *flush_state = ucp_ep_flush_state(ep);
     ucp_request_t *req;
 
-    --ep->worker->flush_ops_count;
-    ++flush_state->cmpl_sn;
+    ep->worker->flush_ops_count -= count;
+    flush_state->cmpl_sn        += count;
 
     ucs_queue_for_each_extract(req, &flush_state->reqs, send.flush.queue,
                                UCS_CIRCULAR_COMPARE32(req->send.flush.cmpl_sn,
@@ -120,8 +120,189 @@ static ucs_status_t ucp_rma_basic_progress_get(uct_pending_req_t *self)
     return ucp_rma_request_advance(req, frag_length, status);
 }
 
+/**
+ * Context for packing a part of an iov request to a bcopy buffer.
+ */
+typedef struct {
+    ucp_request_t                 *req;
+    size_t                        length;
+} ucp_rma_iov_pack_context_t;
+
+
+/*
+ * A vector request has either an iov datatype, or a contig datatype over the
+ * local extent of strided blocks. In the latter case, dt.offset counts the
+ * data bytes and is translated to the local address by the block layout.
+ */
+static UCS_F_ALWAYS_INLINE void*
+ucp_rma_basic_strided_ptr(ucp_request_t *req, size_t offset)
+{
+    return UCS_PTR_BYTE_OFFSET(req->send.buffer,
+                               ((offset / req->send.rma.block_length) *
+                                req->send.rma.block_stride) +
+                               (offset % req->send.rma.block_length));
+}
+
+static size_t ucp_rma_basic_pack_iov(void *dest, void *arg)
+{
+    ucp_rma_iov_pack_context_t *pack_ctx = arg;
+    ucp_request_t *req                   = pack_ctx->req;
+    ucp_dt_state_t *state                = &req->send.state.dt;
+    size_t block_length                  = req->send.rma.block_length;
+    size_t packed_len, frag_length;
+
+    if (UCP_DT_IS_IOV(req->send.datatype)) {
+        return ucp_dt_pack(req->send.ep->worker, req->send.datatype,
+                           req->send.mem_type, dest, req->send.buffer,
+                           state, pack_ctx->length);
+    }
+
+    for (packed_len = 0; packed_len < pack_ctx->length;
+         packed_len += frag_length) {
+        frag_length = ucs_min(block_length - (state->offset % block_length),
+                              pack_ctx->length - packed_len);
+        memcpy(UCS_PTR_BYTE_OFFSET(dest, packed_len),
+               ucp_rma_basic_strided_ptr(req, state->offset), frag_length);
+        state->offset += frag_length;
+    }
+
+    return packed_len;
+}
+
+static void
+ucp_rma_basic_iov_copy_uct(ucp_request_t *req, uct_iov_t *iov, size_t *iovcnt,
+                           size_t max_iov, ucp_dt_state_t *state,
+                           size_t length_max)
+{
+    ucp_ep_h ep             = req->send.ep;
+    ucp_md_index_t md_index = ucp_ep_md_index(ep, req->send.lane);
+    size_t block_length     = req->send.rma.block_length;
+    size_t length_it        = 0;
+    uct_mem_h memh;
+    size_t dst_it;
+
+    if (UCP_DT_IS_IOV(req->send.datatype)) {
+        ucp_dt_iov_copy_uct(ep->worker->context, iov, iovcnt, max_iov, state,
+                            req->send.buffer, req->send.datatype, length_max,
+                            md_index, NULL);
+        return;
+    }
+
+    /* The whole extent is registered once, and every block of it is passed
+     * as a separate entry since transports do not honor uct_iov_t::stride */
+    if (ep->worker->context->tl_mds[md_index].attr.cap.flags & UCT_MD_FLAG_REG) {
+        memh = state->dt.contig.memh[ucs_bitmap2idx(state->dt.contig.md_map,
+                                                    md_index)];
+    } else {
+        memh = UCT_MEM_HANDLE_NULL;
+    }
+
+    for (dst_it = 0; (dst_it < max_iov) && (length_it < length_max); ++dst_it) {
+        iov[dst_it].buffer = ucp_rma_basic_strided_ptr(req, state->offset +
+                                                            length_it);
+        iov[dst_it].length = ucs_min(block_length -
+                                     ((state->offset + length_it) %
+                                      block_length),
+                                     length_max - length_it);
+        iov[dst_it].memh   = memh;
+        iov[dst_it].stride = 0;
+        iov[dst_it].count  = 1;
+        length_it         += iov[dst_it].length;
+    }
+
+    *iovcnt        = dst_it;
+    state->offset += length_it;
+}
+
+static ucs_status_t ucp_rma_basic_progress_put_iov(uct_pending_req_t *self)
+{
+    ucp_request_t *req              = ucs_container_of(self, ucp_request_t, send.uct);
+    ucp_ep_t *ep                    = req->send.ep;
+    ucp_rkey_h rkey                 = req->send.rma.rkey;
+    ucp_lane_index_t lane           = req->send.lane;
+    ucp_ep_rma_config_t *rma_config = &ucp_ep_config(ep)->rma[lane];
+    size_t offset                   = req->send.state.dt.offset;
+    ucp_rma_iov_pack_context_t pack_ctx;
+    ucp_dt_state_t state;
+    ucs_status_t status;
+    ssize_t packed_len;
+    size_t iovcnt;
+    uct_iov_t *iov;
+
+    ucs_assert(rkey->cache.ep_cfg_index == ep->cfg_index);
+    ucs_assert(rkey->cache.rma_lane == lane);
+    ucs_assert(UCP_DT_IS_IOV(req->send.datatype) ||
+               (req->send.rma.block_length > 0));
+
+    if (req->send.length < rma_config->put_zcopy_thresh) {
+        /* Gather the local blocks into a single bounce buffer */
+        pack_ctx.req    = req;
+        pack_ctx.length = ucs_min(req->send.length - offset,
+                                  rma_config->max_put_bcopy);
+        packed_len      = UCS_PROFILE_CALL(uct_ep_put_bcopy,
+                                           ep->uct_eps[lane],
+                                           ucp_rma_basic_pack_iov,
+                                           &pack_ctx,
+                                           req->send.rma.remote_addr + offset,
+                                           rkey->cache.rma_rkey);
+        status          = (packed_len > 0) ? UCS_OK : (ucs_status_t)packed_len;
+        return ucp_rma_request_iov_advance(req, NULL, status);
+    }
+
+    state = req->send.state.dt;
+    iov   = ucs_alloca(rma_config->max_put_iov * sizeof(*iov));
+    ucp_rma_basic_iov_copy_uct(req, iov, &iovcnt, rma_config->max_put_iov,
+                               &state, ucs_min(req->send.length - offset,
+                                               rma_config->max_put_zcopy));
+
+    status = UCS_PROFILE_CALL(uct_ep_put_zcopy,
+                              ep->uct_eps[lane],
+                              iov, iovcnt,
+                              req->send.rma.remote_addr + offset,
+                              rkey->cache.rma_rkey,
+                              &req->send.state.uct_comp);
+    return ucp_rma_request_iov_advance(req, &state, status);
+}
+
+static ucs_status_t ucp_rma_basic_progress_get_iov(uct_pending_req_t *self)
+{
+    ucp_request_t *req              = ucs_container_of(self, ucp_request_t, send.uct);
+    ucp_ep_t *ep                    = req->send.ep;
+    ucp_rkey_h rkey                 = req->send.rma.rkey;
+    ucp_lane_index_t lane           = req->send.lane;
+    ucp_ep_rma_config_t *rma_config = &ucp_ep_config(ep)->rma[lane];
+    size_t offset                   = req->send.state.dt.offset;
+    ucp_dt_state_t state;
+    ucs_status_t status;
+    size_t iovcnt;
+    uct_iov_t *iov;
+
+    ucs_assert(rkey->cache.ep_cfg_index == ep->cfg_index);
+    ucs_assert(rkey->cache.rma_lane == lane);
+    ucs_assert(UCP_DT_IS_IOV(req->send.datatype) ||
+               (req->send.rma.block_length > 0));
+    /* bcopy get does not scatter, short vectors are sent as contig fragments */
+    ucs_assert(req->send.length >= rma_config->get_zcopy_thresh);
+
+    state = req->send.state.dt;
+    iov   = ucs_alloca(rma_config->max_get_iov * sizeof(*iov));
+    ucp_rma_basic_iov_copy_uct(req, iov, &iovcnt, rma_config->max_get_iov,
+                               &state, ucs_min(req->send.length - offset,
+                                               rma_config->max_get_zcopy));
+
+    status = UCS_PROFILE_CALL(uct_ep_get_zcopy,
+                              ep->uct_eps[lane],
+                              iov, iovcnt,
+                              req->send.rma.remote_addr + offset,
+                              rkey->cache.rma_rkey,
+                              &req->send.state.uct_comp);
+    return ucp_rma_request_iov_advance(req, &state, status);
+}
+
 ucp_rma_proto_t ucp_rma_basic_proto = {
-    .name         = "basic_rma",
-    .progress_put = ucp_rma_basic_progress_put,
-    .progress_get = ucp_rma_basic_progress_get
+    .name             = "basic_rma",
+    .progress_put     = ucp_rma_basic_progress_put,
+    .progress_get     = ucp_rma_basic_progress_get,
+    .progress_put_iov = ucp_rma_basic_progress_put_iov,
+    .progress_get_iov = ucp_rma_basic_progress_get_iov
 };
@@ -14,6 +14,7 @@
 #include <ucp/core/ucp_mm.h>
 
 #include <ucp/dt/dt_contig.h>
+#include <ucp/dt/dt_iov.h>
 #include <ucs/profile/profile.h>
 #include <ucs/sys/stubs.h>
 
@@ -95,6 +96,40 @@ ucs_status_t ucp_rma_request_advance(ucp_request_t *req, ssize_t frag_length,
     return UCS_INPROGRESS;
 }
 
+/* Same as ucp_rma_request_advance, for requests with iov datatype whose
+ * progress is tracked by dt.offset */
+ucs_status_t ucp_rma_request_iov_advance(ucp_request_t *req,
+                                         const ucp_dt_state_t *new_dt_state,
+                                         ucs_status_t status)
+{
+    ucs_assert(status != UCS_ERR_NOT_IMPLEMENTED);
+
+    if (ucs_unlikely(UCS_STATUS_IS_ERR(status))) {
+        if (status != UCS_ERR_NO_RESOURCE) {
+            ucp_request_send_buffer_dereg(req);
+            ucp_request_complete_send(req, status);
+        }
+        return status;
+    }
+
+    ucp_request_send_state_advance(req, new_dt_state,
+                                   UCP_REQUEST_SEND_PROTO_RMA, status);
+    if (new_dt_state != NULL) {
+        req->send.state.dt = *new_dt_state;
+    }
+
+    ucs_assert(req->send.state.dt.offset <= req->send.length);
+    if (req->send.state.dt.offset < req->send.length) {
+        return UCS_INPROGRESS;
+    }
+
+    if (req->send.state.uct_comp.count == 0) {
+        ucp_request_send_buffer_dereg(req);
+        ucp_request_complete_send(req, UCS_OK);
+    }
+    return UCS_OK;
+}
+
 static void ucp_rma_request_bcopy_completion(uct_completion_t *self,
                                              ucs_status_t status)
 {
@@ -120,20 +155,22 @@ static void ucp_rma_request_zcopy_completion(uct_completion_t *self,
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_rma_request_init(ucp_request_t *req, ucp_ep_h ep, const void *buffer,
-                     size_t length, uint64_t remote_addr, ucp_rkey_h rkey,
+                     ucp_datatype_t datatype, size_t dt_count, size_t length,
+                     uint64_t remote_addr, ucp_rkey_h rkey,
                      uct_pending_callback_t cb, size_t zcopy_thresh, int flags)
 {
     req->flags                = flags; /* Implicit release */
     req->send.ep              = ep;
     req->send.buffer          = (void*)buffer;
-    req->send.datatype        = ucp_dt_make_contig(1);
+    req->send.datatype        = datatype;
     req->send.mem_type        = UCS_MEMORY_TYPE_HOST;
     req->send.length          = length;
     req->send.rma.remote_addr = remote_addr;
     req->send.rma.rkey        = rkey;
+    req->send.rma.super_req   = NULL;
     req->send.uct.func        = cb;
     req->send.lane            = rkey->cache.rma_lane;
-    ucp_request_send_state_init(req, ucp_dt_make_contig(1), length);
+    ucp_request_send_state_init(req, datatype, dt_count);
     ucp_request_send_state_reset(req,
                                  (length < zcopy_thresh) ?
                                  ucp_rma_request_bcopy_completion :
@@ -146,7 +183,17 @@ ucp_rma_request_init(ucp_request_t *req, ucp_ep_h ep, const void *buffer,
         return UCS_OK;
     }
 
-    return ucp_request_send_buffer_reg_lane(req, req->send.lane);
+    if (!UCP_DT_IS_CONTIG(datatype)) {
+        return ucp_request_send_buffer_reg_lane(req, req->send.lane);
+    }
+
+    /* The local extent of a strided fragment is longer than the data */
+    return ucp_request_memory_reg(ep->worker->context,
+                                  UCS_BIT(ucp_ep_md_index(ep, req->send.lane)),
+                                  (void*)buffer,
+                                  ucp_contig_dt_length(datatype, dt_count),
+                                  datatype, &req->send.state.dt,
+                                  req->send.mem_type, req, 0);
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
@@ -162,7 +209,8 @@ ucp_rma_nonblocking(ucp_ep_h ep, const void *buffer, size_t length,
         return UCS_ERR_NO_MEMORY;
     }
 
-    status = ucp_rma_request_init(req, ep, buffer, length, remote_addr, rkey,
+    status = ucp_rma_request_init(req, ep, buffer, ucp_dt_make_contig(1),
+                                  length, length, remote_addr, rkey,
                                   progress_cb, zcopy_thresh,
                                   UCP_REQUEST_FLAG_RELEASED);
     if (ucs_unlikely(status != UCS_OK)) {
@@ -186,7 +234,8 @@ ucp_rma_nonblocking_cb(ucp_ep_h ep, const void *buffer, size_t length,
         return UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);
     }
 
-    status = ucp_rma_request_init(req, ep, buffer, length, remote_addr, rkey,
+    status = ucp_rma_request_init(req, ep, buffer, ucp_dt_make_contig(1),
+                                  length, length, remote_addr, rkey,
                                   progress_cb, zcopy_thresh, 0);
     if (ucs_unlikely(status != UCS_OK)) {
         return UCS_STATUS_PTR(status);
@@ -325,6 +374,356 @@ out_unlock:
     return ptr_status;
 }
 
+static void ucp_rma_vec_request_put(ucp_request_t *req, ucs_status_t status)
+{
+    if (ucs_unlikely(status != UCS_OK) && (req->status == UCS_OK)) {
+        req->status = status;
+    }
+
+    ucs_assert(req->send.rma_vec.frag_count > 0);
+    if (--req->send.rma_vec.frag_count > 0) {
+        return;
+    }
+
+    ucp_request_complete_send(req, req->status);
+}
+
+static void ucp_rma_vec_frag_completed(void *request, ucs_status_t status)
+{
+    ucp_request_t *req = (ucp_request_t*)request - 1;
+
+    ucp_rma_vec_request_put(req->send.rma.super_req, status);
+}
+
+static ucs_status_t
+ucp_rma_vec_send_frag(ucp_request_t *super_req, const void *buffer,
+                      ucp_datatype_t datatype, size_t dt_count, size_t length,
+                      size_t block_length, size_t block_stride,
+                      uint64_t remote_addr, uct_pending_callback_t progress_cb,
+                      size_t zcopy_thresh)
+{
+    ucp_ep_h ep = super_req->send.ep;
+    ucs_status_t status;
+    ucp_request_t *req;
+
+    req = ucp_request_get(ep->worker);
+    if (req == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucp_rma_request_init(req, ep, buffer, datatype, dt_count, length,
+                                  remote_addr, super_req->send.rma_vec.rkey,
+                                  progress_cb, zcopy_thresh,
+                                  UCP_REQUEST_FLAG_RELEASED |
+                                  UCP_REQUEST_FLAG_CALLBACK);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucp_request_put(req);
+        return status;
+    }
+
+    req->send.cb               = ucp_rma_vec_frag_completed;
+    req->send.rma.super_req    = super_req;
+    req->send.rma.block_length = block_length;
+    req->send.rma.block_stride = block_stride;
+    ++super_req->send.rma_vec.frag_count;
+
+    /* Errors are reported to the super request by the completion callback */
+    ucp_request_send(req, 0);
+    return UCS_OK;
+}
+
+/*
+ * Select how @a length bytes in @a count local blocks are sent to a contiguous
+ * remote region. Returns the progress function of a single fragment which
+ * gathers the blocks to UCT iov operations, or NULL if the transport does not
+ * support it and every block has to be sent as a separate contiguous fragment
+ * by @a progress_cb_p.
+ */
+static uct_pending_callback_t
+ucp_rma_vec_proto_select(ucp_request_t *super_req, size_t length, size_t count,
+                         int is_put, uct_pending_callback_t *progress_cb_p,
+                         size_t *zcopy_thresh_p)
+{
+    ucp_rkey_h rkey                 = super_req->send.rma_vec.rkey;
+    ucp_ep_rma_config_t *rma_config = &ucp_ep_config(super_req->send.ep)->rma[rkey->cache.rma_lane];
+    uct_pending_callback_t progress_iov_cb;
+    size_t max_iov;
+
+    if (is_put) {
+        *progress_cb_p  = rkey->cache.rma_proto->progress_put;
+        progress_iov_cb = rkey->cache.rma_proto->progress_put_iov;
+        *zcopy_thresh_p = rma_config->put_zcopy_thresh;
+        max_iov         = rma_config->max_put_iov;
+    } else {
+        *progress_cb_p  = rkey->cache.rma_proto->progress_get;
+        progress_iov_cb = rkey->cache.rma_proto->progress_get_iov;
+        *zcopy_thresh_p = rma_config->get_zcopy_thresh;
+        max_iov         = rma_config->max_get_iov;
+    }
+
+    /* Short puts are gathered to a bcopy buffer; zcopy needs iov support */
+    if ((count > 1) &&
+        (((length >= *zcopy_thresh_p) && (max_iov > 1)) ||
+         ((length < *zcopy_thresh_p) && is_put))) {
+        return progress_iov_cb;
+    }
+
+    return NULL;
+}
+
+/*
+ * Send the local blocks described by @a iov to a contiguous remote region.
+ */
+static ucs_status_t
+ucp_rma_vec_send_run(ucp_request_t *super_req, const ucp_dt_iov_t *iov,
+                     size_t iovcnt, uint64_t remote_addr, int is_put)
+{
+    uct_pending_callback_t progress_cb, progress_iov_cb;
+    size_t zcopy_thresh, length, i;
+    ucs_status_t status;
+
+    length = ucp_dt_iov_length(iov, iovcnt);
+    if (length == 0) {
+        return UCS_OK;
+    }
+
+    progress_iov_cb = ucp_rma_vec_proto_select(super_req, length, iovcnt,
+                                               is_put, &progress_cb,
+                                               &zcopy_thresh);
+    if (progress_iov_cb != NULL) {
+        return ucp_rma_vec_send_frag(super_req, iov, ucp_dt_make_iov(), iovcnt,
+                                     length, 0, 0, remote_addr,
+                                     progress_iov_cb, zcopy_thresh);
+    }
+
+    for (i = 0; i < iovcnt; ++i) {
+        if (iov[i].length == 0) {
+            continue;
+        }
+
+        status = ucp_rma_vec_send_frag(super_req, iov[i].buffer,
+                                       ucp_dt_make_contig(1), iov[i].length,
+                                       iov[i].length, 0, 0, remote_addr,
+                                       progress_cb, zcopy_thresh);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        remote_addr += iov[i].length;
+    }
+
+    return UCS_OK;
+}
+
+/*
+ * Send @a count local blocks of @a length bytes, which are @a stride bytes
+ * apart, to a contiguous remote region.
+ */
+static ucs_status_t
+ucp_rma_vec_send_strided(ucp_request_t *super_req, void *buffer, size_t length,
+                         size_t count, size_t stride, uint64_t remote_addr,
+                         int is_put)
+{
+    uct_pending_callback_t progress_cb, progress_iov_cb;
+    size_t zcopy_thresh, i;
+    ucs_status_t status;
+
+    if (length == 0) {
+        return UCS_OK;
+    }
+
+    progress_iov_cb = ucp_rma_vec_proto_select(super_req, length * count,
+                                               count, is_put, &progress_cb,
+                                               &zcopy_thresh);
+    if (progress_iov_cb != NULL) {
+        /* One fragment over the whole local extent, which the protocol
+         * splits to blocks when it builds the UCT iov */
+        return ucp_rma_vec_send_frag(super_req, buffer, ucp_dt_make_contig(1),
+                                     ((count - 1) * stride) + length,
+                                     length * count, length, stride,
+                                     remote_addr, progress_iov_cb,
+                                     zcopy_thresh);
+    }
+
+    for (i = 0; i < count; ++i) {
+        status = ucp_rma_vec_send_frag(super_req,
+                                       UCS_PTR_BYTE_OFFSET(buffer, i * stride),
+                                       ucp_dt_make_contig(1), length, length,
+                                       0, 0, remote_addr + (i * length),
+                                       progress_cb, zcopy_thresh);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
+    return UCS_OK;
+}
+
+static ucp_request_t *ucp_rma_vec_request_get(ucp_ep_h ep, ucp_rkey_h rkey)
+{
+    ucp_request_t *req;
+
+    req = ucp_request_get(ep->worker);
+    if (req == NULL) {
+        return NULL;
+    }
+
+    req->flags                   = 0;
+    req->status                  = UCS_OK;
+    req->send.ep                 = ep;
+    req->send.rma_vec.rkey       = rkey;
+    req->send.rma_vec.frag_count = 1;
+    return req;
+}
+
+static ucs_status_ptr_t
+ucp_rma_vec_request_start(ucp_request_t *req, ucs_status_t status,
+                          ucp_send_callback_t cb)
+{
+    ucp_rma_vec_request_put(req, status);
+    if (req->flags & UCP_REQUEST_FLAG_COMPLETED) {
+        status = req->status;
+        ucs_trace_req("releasing vector rma request %p, returning status %s",
+                      req, ucs_status_string(status));
+        ucs_mpool_put(req);
+        return UCS_STATUS_PTR(status);
+    }
+
+    ucs_trace_req("returning vector rma request %p", req);
+    ucp_request_set_callback(req, send.cb, cb);
+    return req + 1;
+}
+
+static ucs_status_ptr_t
+ucp_rma_iov_nb(ucp_ep_h ep, const ucp_dt_iov_t *iov, size_t iovcnt,
+               uint64_t remote_addr, ucp_rkey_h rkey, ucp_send_callback_t cb,
+               int is_put)
+{
+    ucs_status_ptr_t ptr_status;
+    ucs_status_t status;
+    ucp_request_t *req;
+
+    UCP_RMA_CHECK_PTR(ep->worker->context, iov, iovcnt);
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
+
+    ucs_trace_req("%s_iov_nb iov %p iovcnt %zu remote_addr %"PRIx64" rkey %p "
+                  "%s %s cb %p", is_put ? "put" : "get", iov, iovcnt,
+                  remote_addr, rkey, is_put ? "to" : "from",
+                  ucp_ep_peer_name(ep), cb);
+
+    status = UCP_RKEY_RESOLVE(rkey, ep, rma);
+    if (status != UCS_OK) {
+        ptr_status = UCS_STATUS_PTR(status);
+        goto out_unlock;
+    }
+
+    req = ucp_rma_vec_request_get(ep, rkey);
+    if (req == NULL) {
+        ptr_status = UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);
+        goto out_unlock;
+    }
+
+    status     = ucp_rma_vec_send_run(req, iov, iovcnt, remote_addr, is_put);
+    ptr_status = ucp_rma_vec_request_start(req, status, cb);
+out_unlock:
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
+    return ptr_status;
+}
+
+static ucs_status_ptr_t
+ucp_rma_strided_nb(ucp_ep_h ep, void *buffer, size_t length, size_t count,
+                   size_t local_stride, uint64_t remote_addr,
+                   size_t remote_stride, ucp_rkey_h rkey,
+                   ucp_send_callback_t cb, int is_put)
+{
+    ucs_status_ptr_t ptr_status;
+    ucp_dt_iov_t block_iov;
+    ucs_status_t status;
+    ucp_request_t *req;
+    size_t i;
+
+    UCP_RMA_CHECK_PTR(ep->worker->context, buffer, length * count);
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
+
+    ucs_trace_req("%s_strided_nb buffer %p length %zu count %zu stride %zu "
+                  "remote_addr %"PRIx64" remote_stride %zu rkey %p %s %s cb %p",
+                  is_put ? "put" : "get", buffer, length, count, local_stride,
+                  remote_addr, remote_stride, rkey, is_put ? "to" : "from",
+                  ucp_ep_peer_name(ep), cb);
+
+    status = UCP_RKEY_RESOLVE(rkey, ep, rma);
+    if (status != UCS_OK) {
+        ptr_status = UCS_STATUS_PTR(status);
+        goto out_unlock;
+    }
+
+    req = ucp_rma_vec_request_get(ep, rkey);
+    if (req == NULL) {
+        ptr_status = UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);
+        goto out_unlock;
+    }
+
+    if ((count == 1) || ((local_stride == length) && (remote_stride == length))) {
+        /* Both sides are contiguous */
+        block_iov.buffer = buffer;
+        block_iov.length = length * count;
+        status = ucp_rma_vec_send_run(req, &block_iov, 1, remote_addr, is_put);
+    } else if (remote_stride == length) {
+        /* Remote side is contiguous - gather/scatter the local blocks */
+        status = ucp_rma_vec_send_strided(req, buffer, length, count,
+                                          local_stride, remote_addr, is_put);
+    } else {
+        /* UCT RMA is contiguous on the remote side, so send every block
+         * separately */
+        status = UCS_OK;
+        for (i = 0; (i < count) && (status == UCS_OK); ++i) {
+            block_iov.buffer = UCS_PTR_BYTE_OFFSET(buffer, i * local_stride);
+            block_iov.length = length;
+            status = ucp_rma_vec_send_run(req, &block_iov, 1,
+                                          remote_addr + (i * remote_stride),
+                                          is_put);
+        }
+    }
+
+    ptr_status = ucp_rma_vec_request_start(req, status, cb);
+out_unlock:
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
+    return ptr_status;
+}
+
+ucs_status_ptr_t ucp_put_iov_nb(ucp_ep_h ep, const ucp_dt_iov_t *iov,
+                                size_t iovcnt, uint64_t remote_addr,
+                                ucp_rkey_h rkey, ucp_send_callback_t cb)
+{
+    return ucp_rma_iov_nb(ep, iov, iovcnt, remote_addr, rkey, cb, 1);
+}
+
+ucs_status_ptr_t ucp_get_iov_nb(ucp_ep_h ep, const ucp_dt_iov_t *iov,
+                                size_t iovcnt, uint64_t remote_addr,
+                                ucp_rkey_h rkey, ucp_send_callback_t cb)
+{
+    return ucp_rma_iov_nb(ep, iov, iovcnt, remote_addr, rkey, cb, 0);
+}
+
+ucs_status_ptr_t ucp_put_strided_nb(ucp_ep_h ep, const void *buffer,
+                                    size_t length, size_t count,
+                                    size_t local_stride, uint64_t remote_addr,
+                                    size_t remote_stride, ucp_rkey_h rkey,
+                                    ucp_send_callback_t cb)
+{
+    return ucp_rma_strided_nb(ep, (void*)buffer, length, count, local_stride,
+                              remote_addr, remote_stride, rkey, cb, 1);
+}
+
+ucs_status_ptr_t ucp_get_strided_nb(ucp_ep_h ep, void *buffer, size_t length,
+                                    size_t count, size_t local_stride,
+                                    uint64_t remote_addr, size_t remote_stride,
+                                    ucp_rkey_h rkey, ucp_send_callback_t cb)
+{
+    return ucp_rma_strided_nb(ep, buffer, length, count, local_stride,
+                              remote_addr, remote_stride, rkey, cb, 0);
+}
+
 UCS_PROFILE_FUNC(ucs_status_t, ucp_put, (ep, buffer, length, remote_addr, rkey),
                  ucp_ep_h ep, const void *buffer, size_t length,
                  uint64_t remote_addr, ucp_rkey_h rkey)
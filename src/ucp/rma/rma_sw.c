@@ -15,6 +15,40 @@
 #include <ucp/core/ucp_request.inl>
 
 
+/* Maximal payload which can be sent with AM zcopy after a header of
+ * 'hdr_size' bytes, or 0 if the AM lane can't be used for zero-copy */
+static size_t ucp_rma_sw_max_zcopy(ucp_ep_h ep, size_t hdr_size)
+{
+    ucp_ep_config_t *config = ucp_ep_config(ep);
+    ucp_rsc_index_t rsc_index;
+    uct_iface_attr_t *iface_attr;
+
+    rsc_index = ucp_ep_get_rsc_index(ep, ucp_ep_get_am_lane(ep));
+    if ((config->am.zcopy_thresh[0] == SIZE_MAX) ||
+        (rsc_index == UCP_NULL_RESOURCE) ||
+        (config->am.max_zcopy <= hdr_size)) {
+        return 0;
+    }
+
+    iface_attr = ucp_worker_iface_get_attr(ep->worker, rsc_index);
+    if (iface_attr->cap.am.max_hdr < hdr_size) {
+        return 0;
+    }
+
+    return config->am.max_zcopy - hdr_size;
+}
+
+static void ucp_rma_sw_init_iov(ucp_request_t *req, uct_iov_t *iov,
+                                size_t length)
+{
+    iov->buffer = req->send.buffer;
+    iov->length = length;
+    iov->count  = 1;
+    iov->stride = 0;
+    iov->memh   = (req->send.state.dt.dt.contig.md_map == 0) ?
+                  UCT_MEM_HANDLE_NULL : req->send.state.dt.dt.contig.memh[0];
+}
+
 static size_t ucp_rma_sw_put_pack_cb(void *dest, void *arg)
 {
     ucp_request_t *req  = arg;
@@ -36,24 +70,47 @@ static size_t ucp_rma_sw_put_pack_cb(void *dest, void *arg)
 
 static ucs_status_t ucp_rma_sw_progress_put(uct_pending_req_t *self)
 {
-    ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
-    ucp_ep_t *ep       = req->send.ep;
+    ucp_request_t *req              = ucs_container_of(self, ucp_request_t, send.uct);
+    ucp_ep_t *ep                    = req->send.ep;
+    ucp_ep_rma_config_t *rma_config = &ucp_ep_config(ep)->rma[req->send.lane];
+    ucp_put_hdr_t puth;
     ssize_t packed_len;
+    size_t max_zcopy;
     ucs_status_t status;
+    uct_iov_t iov;
 
     ucs_assert(req->send.lane == ucp_ep_get_am_lane(ep));
 
-    packed_len = uct_ep_am_bcopy(ep->uct_eps[req->send.lane], UCP_AM_ID_PUT,
-                                 ucp_rma_sw_put_pack_cb, req, 0);
-    if (packed_len > 0) {
-        status = UCS_OK;
-        ucp_ep_rma_remote_request_sent(ep);
+    /* Before the remote endpoint is resolved, the header can't be filled, so
+     * let bcopy pack it once the lane is ready */
+    max_zcopy = ucp_rma_sw_max_zcopy(ep, sizeof(puth));
+    if ((req->send.length < rma_config->put_zcopy_thresh) || (max_zcopy == 0) ||
+        !(ep->flags & UCP_EP_FLAG_DEST_EP)) {
+        packed_len = uct_ep_am_bcopy(ep->uct_eps[req->send.lane], UCP_AM_ID_PUT,
+                                     ucp_rma_sw_put_pack_cb, req, 0);
+        if (packed_len > 0) {
+            status      = UCS_OK;
+            packed_len -= sizeof(ucp_put_hdr_t);
+        } else {
+            status = (ucs_status_t)packed_len;
+        }
     } else {
-        status = (ucs_status_t)packed_len;
+        puth.address = req->send.rma.remote_addr;
+        puth.ep_ptr  = ucp_ep_dest_ep_ptr(ep);
+        packed_len = ucs_min(req->send.length, max_zcopy);
+        ucp_rma_sw_init_iov(req, &iov, packed_len);
+        status     = uct_ep_am_zcopy(ep->uct_eps[req->send.lane],
+                                     UCP_AM_ID_PUT, &puth, sizeof(puth), &iov,
+                                     1, 0, &req->send.state.uct_comp);
+        ucp_request_send_state_advance(req, NULL, UCP_REQUEST_SEND_PROTO_RMA,
+                                       status);
     }
 
-    return ucp_rma_request_advance(req, packed_len - sizeof(ucp_put_hdr_t),
-                                   status);
+    if (!UCS_STATUS_IS_ERR(status)) {
+        ucp_ep_rma_remote_request_sent(ep);
+    }
+
+    return ucp_rma_request_advance(req, packed_len, status);
 }
 
 static size_t ucp_rma_sw_get_req_pack_cb(void *dest, void *arg)
@@ -96,9 +153,11 @@ static ucs_status_t ucp_rma_sw_progress_get(uct_pending_req_t *self)
 }
 
 ucp_rma_proto_t ucp_rma_sw_proto = {
-    .name         = "sw_rma",
-    .progress_put = ucp_rma_sw_progress_put,
-    .progress_get = ucp_rma_sw_progress_get
+    .name             = "sw_rma",
+    .progress_put     = ucp_rma_sw_progress_put,
+    .progress_get     = ucp_rma_sw_progress_get,
+    .progress_put_iov = NULL,
+    .progress_get_iov = NULL
 };
 
 static size_t ucp_rma_sw_pack_rma_ack(void *dest, void *arg)
@@ -110,6 +169,16 @@ static size_t ucp_rma_sw_pack_rma_ack(void *dest, void *arg)
     return sizeof(*hdr);
 }
 
+static size_t ucp_rma_sw_pack_rma_ack_count(void *dest, void *arg)
+{
+    ucp_cmpl_count_hdr_t *hdr = dest;
+    ucp_request_t *req        = arg;
+
+    hdr->super.ep_ptr = ucp_ep_dest_ep_ptr(req->send.ep);
+    hdr->count        = req->send.rma_cmpl.count;
+    return sizeof(*hdr);
+}
+
 static ucs_status_t ucp_progress_rma_cmpl(uct_pending_req_t *self)
 {
     ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
@@ -118,30 +187,107 @@ static ucs_status_t ucp_progress_rma_cmpl(uct_pending_req_t *self)
 
     req->send.lane = ucp_ep_get_am_lane(ep);
 
-    packed_len = uct_ep_am_bcopy(ep->uct_eps[req->send.lane], UCP_AM_ID_CMPL,
-                                 ucp_rma_sw_pack_rma_ack, req, 0);
+    /* a single completion is acknowledged with the original message */
+    if (req->send.rma_cmpl.count == 1) {
+        packed_len = uct_ep_am_bcopy(ep->uct_eps[req->send.lane],
+                                     UCP_AM_ID_CMPL, ucp_rma_sw_pack_rma_ack,
+                                     req, 0);
+    } else {
+        packed_len = uct_ep_am_bcopy(ep->uct_eps[req->send.lane],
+                                     UCP_AM_ID_CMPL_COUNT,
+                                     ucp_rma_sw_pack_rma_ack_count, req, 0);
+    }
     if (packed_len < 0) {
         return (ucs_status_t)packed_len;
     }
 
-    ucs_assert(packed_len == sizeof(ucp_cmpl_hdr_t));
     ucp_request_put(req);
     return UCS_OK;
 }
 
-void ucp_rma_sw_send_cmpl(ucp_ep_h ep)
+static unsigned ucp_rma_sw_cmpl_progress(void *arg)
 {
+    ucp_worker_h worker = arg;
+    unsigned count      = 0;
     ucp_request_t *req;
+    khiter_t iter;
 
-    req = ucp_request_get(ep->worker);
-    if (req == NULL) {
-        ucs_error("failed to allocate put completion");
+    /* the one-shot callback is removed after it is called */
+    worker->rma_cmpl_cb_id = UCS_CALLBACKQ_ID_NULL;
+
+    for (iter = kh_begin(&worker->rma_cmpl_hash);
+         iter != kh_end(&worker->rma_cmpl_hash); ++iter) {
+        if (!kh_exist(&worker->rma_cmpl_hash, iter)) {
+            continue;
+        }
+
+        req = ucp_request_get(worker);
+        if (req == NULL) {
+            /* keep the counts and retry on the next progress round */
+            uct_worker_progress_register_safe(worker->uct,
+                                              ucp_rma_sw_cmpl_progress, worker,
+                                              UCS_CALLBACKQ_FLAG_ONESHOT,
+                                              &worker->rma_cmpl_cb_id);
+            break;
+        }
+
+        req->send.ep             = (ucp_ep_h)kh_key(&worker->rma_cmpl_hash,
+                                                    iter);
+        req->send.rma_cmpl.count = kh_value(&worker->rma_cmpl_hash, iter);
+        req->send.uct.func       = ucp_progress_rma_cmpl;
+        kh_del(ucp_worker_rma_cmpl_hash, &worker->rma_cmpl_hash, iter);
+        ucp_request_send(req, 0);
+        ++count;
+    }
+
+    return count;
+}
+
+void ucp_rma_sw_send_cmpl(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+    khiter_t iter;
+    int ret;
+
+    iter = kh_put(ucp_worker_rma_cmpl_hash, &worker->rma_cmpl_hash,
+                  (uintptr_t)ep, &ret);
+    if (ucs_unlikely(ret == -1)) {
+        ucs_error("failed to add put completion");
         return;
     }
 
-    req->send.ep       = ep;
-    req->send.uct.func = ucp_progress_rma_cmpl;
-    ucp_request_send(req, 0);
+    if (ret != 0) {
+        kh_value(&worker->rma_cmpl_hash, iter) = 1;
+    } else {
+        ++kh_value(&worker->rma_cmpl_hash, iter);
+    }
+
+    /* Completions are coalesced: operations which are done during the same
+     * progress round are acknowledged with a single message per endpoint */
+    if (worker->rma_cmpl_cb_id == UCS_CALLBACKQ_ID_NULL) {
+        uct_worker_progress_register_safe(worker->uct,
+                                          ucp_rma_sw_cmpl_progress, worker,
+                                          UCS_CALLBACKQ_FLAG_ONESHOT,
+                                          &worker->rma_cmpl_cb_id);
+    }
+}
+
+void ucp_rma_sw_ep_cleanup(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+    khiter_t iter;
+
+    iter = kh_get(ucp_worker_rma_cmpl_hash, &worker->rma_cmpl_hash,
+                  (uintptr_t)ep);
+    if (iter == kh_end(&worker->rma_cmpl_hash)) {
+        return;
+    }
+
+    kh_del(ucp_worker_rma_cmpl_hash, &worker->rma_cmpl_hash, iter);
+    if (kh_size(&worker->rma_cmpl_hash) == 0) {
+        uct_worker_progress_unregister_safe(worker->uct,
+                                            &worker->rma_cmpl_cb_id);
+    }
 }
 
 UCS_PROFILE_FUNC(ucs_status_t, ucp_put_handler, (arg, data, length, am_flags),
@@ -162,7 +308,20 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rma_cmpl_handler, (arg, data, length, am_flag
     ucp_worker_h worker     = arg;
     ucp_ep_h ep             = ucp_worker_get_ep_by_ptr(worker, putackh->ep_ptr);
 
-    ucp_ep_rma_remote_request_completed(ep);
+    ucp_ep_rma_remote_request_completed(ep, 1);
+    return UCS_OK;
+}
+
+UCS_PROFILE_FUNC(ucs_status_t, ucp_rma_cmpl_count_handler,
+                 (arg, data, length, am_flags),
+                 void *arg, void *data, size_t length, unsigned am_flags)
+{
+    ucp_cmpl_count_hdr_t *putackh = data;
+    ucp_worker_h worker           = arg;
+    ucp_ep_h ep                   = ucp_worker_get_ep_by_ptr(worker,
+                                                             putackh->super.ep_ptr);
+
+    ucp_ep_rma_remote_request_completed(ep, putackh->count);
     return UCS_OK;
 }
 
@@ -196,7 +355,7 @@ static ucs_status_t ucp_progress_get_reply(uct_pending_req_t *self)
     payload_len = packed_len - sizeof(ucp_rma_rep_hdr_t);
     ucs_assert(payload_len >= 0);
 
-    req->send.buffer += payload_len;
+    req->send.buffer  = UCS_PTR_BYTE_OFFSET(req->send.buffer, payload_len);
     req->send.length -= payload_len;
 
     if (req->send.length == 0) {
@@ -207,6 +366,76 @@ static ucs_status_t ucp_progress_get_reply(uct_pending_req_t *self)
     }
 }
 
+static void ucp_rma_sw_get_reply_zcopy_completion(uct_completion_t *self,
+                                                  ucs_status_t status)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t,
+                                          send.state.uct_comp);
+
+    if (req->send.length == 0) {
+        ucp_request_send_buffer_dereg(req);
+        ucp_request_put(req);
+    }
+}
+
+static ucs_status_t ucp_progress_get_reply_zcopy(uct_pending_req_t *self)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
+    ucp_ep_t *ep       = req->send.ep;
+    ucp_rma_rep_hdr_t hdr;
+    size_t frag_length;
+    ucs_status_t status;
+    uct_iov_t iov;
+
+    hdr.req     = req->send.get_reply.req;
+    frag_length = ucs_min(req->send.length,
+                          ucp_rma_sw_max_zcopy(ep, sizeof(hdr)));
+    ucp_rma_sw_init_iov(req, &iov, frag_length);
+
+    status = uct_ep_am_zcopy(ep->uct_eps[req->send.lane], UCP_AM_ID_GET_REP,
+                             &hdr, sizeof(hdr), &iov, 1, 0,
+                             &req->send.state.uct_comp);
+    if (UCS_STATUS_IS_ERR(status)) {
+        return status;
+    }
+
+    ucp_request_send_state_advance(req, NULL, UCP_REQUEST_SEND_PROTO_RMA,
+                                   status);
+    req->send.buffer  = UCS_PTR_BYTE_OFFSET(req->send.buffer, frag_length);
+    req->send.length -= frag_length;
+
+    if (req->send.length != 0) {
+        return UCS_INPROGRESS;
+    }
+
+    /* release now if no zcopy fragments are in flight, otherwise the
+     * completion callback will do it */
+    if (req->send.state.uct_comp.count == 0) {
+        ucp_request_send_buffer_dereg(req);
+        ucp_request_put(req);
+    }
+    return UCS_OK;
+}
+
+static int ucp_rma_sw_get_reply_init_zcopy(ucp_request_t *req)
+{
+    ucp_ep_h ep = req->send.ep;
+
+    if ((req->send.length < ucp_ep_config(ep)->am.zcopy_thresh[0]) ||
+        (ucp_rma_sw_max_zcopy(ep, sizeof(ucp_rma_rep_hdr_t)) == 0)) {
+        return 0;
+    }
+
+    req->send.datatype = ucp_dt_make_contig(1);
+    req->send.mem_type = UCS_MEMORY_TYPE_HOST;
+    req->send.lane     = ucp_ep_get_am_lane(ep);
+    ucp_request_send_state_init(req, req->send.datatype, req->send.length);
+    ucp_request_send_state_reset(req, ucp_rma_sw_get_reply_zcopy_completion,
+                                 UCP_REQUEST_SEND_PROTO_RMA);
+
+    return ucp_request_send_buffer_reg_lane(req, req->send.lane) == UCS_OK;
+}
+
 UCS_PROFILE_FUNC(ucs_status_t, ucp_get_req_handler, (arg, data, length, am_flags),
                  void *arg, void *data, size_t length, unsigned am_flags)
 {
@@ -226,7 +455,9 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_get_req_handler, (arg, data, length, am_flags
     req->send.buffer        = (void*)getreqh->address;
     req->send.length        = getreqh->length;
     req->send.get_reply.req = getreqh->req.reqptr;
-    req->send.uct.func      = ucp_progress_get_reply;
+    req->send.uct.func      = ucp_rma_sw_get_reply_init_zcopy(req) ?
+                              ucp_progress_get_reply_zcopy :
+                              ucp_progress_get_reply;
 
     ucp_request_send(req, 0);
     return UCS_OK;
@@ -244,7 +475,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_get_rep_handler, (arg, data, length, am_flags
 
     /* complete get request on last fragment of the reply */
     if (ucp_rma_request_advance(req, frag_length, UCS_OK) == UCS_OK) {
-        ucp_ep_rma_remote_request_completed(ep);
+        ucp_ep_rma_remote_request_completed(ep, 1);
     }
 
     return UCS_OK;
@@ -256,6 +487,7 @@ static void ucp_rma_sw_dump_packet(ucp_worker_h worker, uct_am_trace_type_t type
 {
     const ucp_get_req_hdr_t *geth;
     const ucp_rma_rep_hdr_t *reph;
+    const ucp_cmpl_count_hdr_t *cmplch;
     const ucp_cmpl_hdr_t *cmplh;
     const ucp_put_hdr_t *puth;
     size_t header_len;
@@ -282,6 +514,11 @@ static void ucp_rma_sw_dump_packet(ucp_worker_h worker, uct_am_trace_type_t type
         cmplh = data;
         snprintf(buffer, max, "CMPL [ep_ptr 0x%lx]", cmplh->ep_ptr);
         return;
+    case UCP_AM_ID_CMPL_COUNT:
+        cmplch = data;
+        snprintf(buffer, max, "CMPL_COUNT [ep_ptr 0x%lx count %u]",
+                 cmplch->super.ep_ptr, cmplch->count);
+        return;
     default:
         return;
     }
@@ -299,6 +536,8 @@ UCP_DEFINE_AM(UCP_FEATURE_RMA, UCP_AM_ID_GET_REP, ucp_get_rep_handler,
               ucp_rma_sw_dump_packet, 0);
 UCP_DEFINE_AM(UCP_FEATURE_RMA|UCP_FEATURE_AMO, UCP_AM_ID_CMPL,
               ucp_rma_cmpl_handler, ucp_rma_sw_dump_packet, 0);
+UCP_DEFINE_AM(UCP_FEATURE_RMA|UCP_FEATURE_AMO, UCP_AM_ID_CMPL_COUNT,
+              ucp_rma_cmpl_count_handler, ucp_rma_sw_dump_packet, 0);
 
 UCP_DEFINE_AM_PROXY(UCP_AM_ID_PUT);
 UCP_DEFINE_AM_PROXY(UCP_AM_ID_GET_REQ);
@@ -83,10 +83,13 @@ UCS_PROFILE_FUNC_VOID(ucp_tag_offload_tag_consumed, (self),
                       uct_tag_context_t *self)
 {
     ucp_request_t *req = ucs_container_of(self, ucp_request_t, recv.uct_ctx);
-    ucs_queue_head_t *queue;
+    ucp_tag_match_t *tm = &req->recv.worker->tm;
+    ucp_request_queue_t *req_queue;
 
-    queue = &ucp_tag_exp_get_req_queue(&req->recv.worker->tm, req)->queue;
-    ucs_queue_remove(queue, &req->recv.queue);
+    req_queue = ucp_tag_exp_get_req_queue(tm, req);
+    tm->expected.wildcard_count -= (req->recv.tag.tag_mask != UCP_TAG_MASK_FULL);
+    ucs_queue_remove(&req_queue->queue, &req->recv.queue);
+    ucp_tag_exp_mask_hash_update(tm, req_queue, req->recv.tag.tag_mask, -1);
 }
 
 /* Message is scattered to user buffer by the transport, complete the request */
@@ -411,7 +414,7 @@ UCS_PROFILE_FUNC(int, ucp_tag_offload_post, (req, req_queue),
             UCP_WORKER_STAT_TAG_OFFLOAD(worker, BLOCK_SW_PEND);
             return 0;
         }
-    } else if (worker->tm.expected.wildcard.sw_count ||
+    } else if (worker->tm.expected.wildcard_sw_count ||
                (req_queue->sw_count && !ucp_tag_offload_post_sw_reqs(req, req_queue))) {
         /* There are some requests which must be completed in SW */
         UCP_WORKER_STAT_TAG_OFFLOAD(worker, BLOCK_SW_PEND);
@@ -83,6 +83,8 @@ ucp_tag_offload_try_post(ucp_worker_t *worker, ucp_request_t *req,
     }
 
     ++worker->tm.expected.sw_all_count;
+    worker->tm.expected.wildcard_sw_count +=
+            (req->recv.tag.tag_mask != UCP_TAG_MASK_FULL);
     ++req_queue->sw_count;
     req_queue->block_count += !!(req->flags & UCP_REQUEST_FLAG_BLOCK_OFFLOAD);
 }
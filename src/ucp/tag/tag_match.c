@@ -14,16 +14,25 @@
 
 ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
 {
+    ucp_request_queue_t *req_queue;
     size_t hash_size, bucket;
+    unsigned i;
 
     hash_size = ucs_roundup_pow2(UCP_TAG_MATCH_HASH_SIZE);
 
-    tm->expected.sn           = 0;
-    tm->expected.sw_all_count = 0;
+    tm->expected.sn                   = 0;
+    tm->expected.sw_all_count         = 0;
+    tm->expected.wildcard_count       = 0;
+    tm->expected.wildcard_sw_count    = 0;
+    tm->expected.num_masks            = 0;
+    tm->expected.wildcard.sw_count    = 0;
+    tm->expected.wildcard.block_count = 0;
     ucs_queue_head_init(&tm->expected.wildcard.queue);
     ucs_list_head_init(&tm->unexpected.all);
 
-    tm->expected.hash = ucs_malloc(sizeof(*tm->expected.hash) * hash_size,
+    /* the hash table of tags is followed by the hash tables of partial masks */
+    tm->expected.hash = ucs_malloc(sizeof(*tm->expected.hash) * hash_size *
+                                   (1 + UCP_TAG_MATCH_MAX_MASKS),
                                    "ucp_tm_exp_hash");
     if (tm->expected.hash == NULL) {
         return UCS_ERR_NO_MEMORY;
@@ -36,10 +45,22 @@ ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
         return UCS_ERR_NO_MEMORY;
     }
 
+    for (bucket = 0; bucket < hash_size * (1 + UCP_TAG_MATCH_MAX_MASKS);
+         ++bucket) {
+        req_queue              = &tm->expected.hash[bucket];
+        req_queue->sw_count    = 0;
+        req_queue->block_count = 0;
+        ucs_queue_head_init(&req_queue->queue);
+    }
+
+    for (i = 0; i < UCP_TAG_MATCH_MAX_MASKS; ++i) {
+        tm->expected.masks[i].tag_mask = 0;
+        tm->expected.masks[i].count    = 0;
+        tm->expected.masks[i].hash     = tm->expected.hash +
+                                         ((i + 1) * hash_size);
+    }
+
     for (bucket = 0; bucket < hash_size; ++bucket) {
-        tm->expected.hash[bucket].sw_count    = 0;
-        tm->expected.hash[bucket].block_count = 0;
-        ucs_queue_head_init(&tm->expected.hash[bucket].queue);
         ucs_list_head_init(&tm->unexpected.hash[bucket]);
     }
 
@@ -82,58 +103,69 @@ void ucp_tag_exp_remove(ucp_tag_match_t *tm, ucp_request_t *req)
     ucs_bug("expected request not found");
 }
 
-static inline uint64_t ucp_tag_exp_req_seq(ucs_queue_iter_t iter)
+/* Find the first request in the queue which matches the tag, if it was posted
+ * before the best match found so far */
+static UCS_F_ALWAYS_INLINE void
+ucp_tag_exp_search_queue(ucp_request_queue_t *req_queue, ucp_tag_t tag,
+                         ucp_request_queue_t **match_queue_p,
+                         ucs_queue_iter_t *match_iter_p, uint64_t *match_sn_p)
 {
-    return (*iter == NULL) ? ULONG_MAX :
-           ucs_container_of(*iter, ucp_request_t, recv.queue)->recv.tag.sn;
+    ucs_queue_iter_t iter;
+    ucp_request_t *req;
+
+    ucs_queue_for_each_safe(req, iter, &req_queue->queue, recv.queue) {
+        req = ucs_container_of(*iter, ucp_request_t, recv.queue);
+        if (req->recv.tag.sn >= *match_sn_p) {
+            /* the queue is ordered by sequence number */
+            return;
+        }
+
+        if (ucp_tag_is_match(tag, req->recv.tag.tag, req->recv.tag.tag_mask)) {
+            *match_queue_p = req_queue;
+            *match_iter_p  = iter;
+            *match_sn_p    = req->recv.tag.sn;
+            return;
+        }
+    }
 }
 
 ucp_request_t*
 ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                        ucp_tag_t tag)
 {
-    ucs_queue_head_t *hash_queue = &req_queue->queue;
-    ucp_request_queue_t *queue;
-    ucs_queue_iter_t hash_iter, wild_iter, *iter;
-    uint64_t hash_sn, wild_sn, *sn_p;
+    ucp_request_queue_t *match_queue = NULL;
+    uint64_t match_sn                = ULONG_MAX;
+    ucp_tag_exp_mask_hash_t *mask_hash;
+    ucp_request_queue_t *mask_queue;
+    ucs_queue_iter_t match_iter;
     ucp_request_t *req;
 
-    *hash_queue->ptail                 = NULL;
-    *tm->expected.wildcard.queue.ptail = NULL;
-
-    hash_iter = ucs_queue_iter_begin(hash_queue);
-    wild_iter = ucs_queue_iter_begin(&tm->expected.wildcard.queue);
-
-    hash_sn = ucp_tag_exp_req_seq(hash_iter);
-    wild_sn = ucp_tag_exp_req_seq(wild_iter);
-
-    while (hash_sn != wild_sn) {
-        if (hash_sn < wild_sn) {
-            iter  = &hash_iter;
-            sn_p  = &hash_sn;
-            queue = req_queue;
-        } else {
-            iter  = &wild_iter;
-            sn_p  = &wild_sn;
-            queue = &tm->expected.wildcard;
-        }
+    /* The oldest matching request is the first match in one of: the queue of
+     * the tag, the queue of the masked tag in every mask hash table, and the
+     * queue of wildcard requests without a hash table */
+    ucp_tag_exp_search_queue(req_queue, tag, &match_queue, &match_iter,
+                             &match_sn);
+
+    for (mask_hash = tm->expected.masks;
+         mask_hash < (tm->expected.masks + tm->expected.num_masks);
+         ++mask_hash) {
+        mask_queue = &mask_hash->hash[ucp_tag_match_calc_hash(tag &
+                                                              mask_hash->tag_mask)];
+        ucp_tag_exp_search_queue(mask_queue, tag, &match_queue, &match_iter,
+                                 &match_sn);
+    }
 
-        req = ucs_container_of(**iter, ucp_request_t, recv.queue);
-        if (ucp_tag_is_match(tag, req->recv.tag.tag, req->recv.tag.tag_mask)) {
-            ucs_trace_req("matched received tag %"PRIx64" to req %p", tag, req);
-            ucp_tag_exp_delete(req, tm, queue, *iter);
-            return req;
-        }
+    ucp_tag_exp_search_queue(&tm->expected.wildcard, tag, &match_queue,
+                             &match_iter, &match_sn);
 
-        *iter = ucs_queue_iter_next(*iter);
-        *sn_p = ucp_tag_exp_req_seq(*iter);
+    if (match_queue == NULL) {
+        return NULL;
     }
 
-    ucs_assertv((hash_sn == ULONG_MAX) && (wild_sn == ULONG_MAX),
-                "hash_seq=%lu wild_seq=%lu", hash_sn, wild_sn);
-    ucs_assert(ucs_queue_iter_end(hash_queue, hash_iter));
-    ucs_assert(ucs_queue_iter_end(&tm->expected.wildcard.queue, wild_iter));
-    return NULL;
+    req = ucs_container_of(*match_iter, ucp_request_t, recv.queue);
+    ucs_trace_req("matched received tag %"PRIx64" to req %p", tag, req);
+    ucp_tag_exp_delete(req, tm, match_queue, match_iter);
+    return req;
 }
 
 void ucp_tag_frag_list_process_queue(ucp_tag_match_t *tm, ucp_request_t *req,
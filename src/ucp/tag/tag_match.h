@@ -16,6 +16,8 @@
 
 
 #define UCP_TAG_MASK_FULL     0xffffffffffffffffUL  /* All 1-s */
+#define UCP_TAG_MATCH_MAX_MASKS  4  /* Maximal number of partial tag masks which
+                                       have a hash table of expected requests */
 
 
 KHASH_INIT(ucp_tag_offload_hash, ucp_tag_t, ucp_worker_iface_t *, 1,
@@ -42,6 +44,17 @@ typedef struct {
 } ucp_request_queue_t;
 
 
+/**
+ * Hash table of expected requests with the same partial tag mask, by the
+ * masked tag
+ */
+typedef struct {
+    ucp_tag_t             tag_mask;   /* Tag mask of the requests */
+    unsigned              count;      /* Number of requests in the table */
+    ucp_request_queue_t   *hash;      /* Hash table of the requests */
+} ucp_tag_exp_mask_hash_t;
+
+
 /**
  * Hash table entry for tag message fragments
  */
@@ -62,11 +75,22 @@ typedef struct ucp_tag_match {
 
     /* Expected queue */
     struct {
-        ucp_request_queue_t   wildcard;   /* Expected wildcard requests */
+        ucp_request_queue_t   wildcard;   /* Expected wildcard requests whose
+                                             tag mask has no hash table */
         ucp_request_queue_t   *hash;      /* Hash table of expected non-wild tags */
+        ucp_tag_exp_mask_hash_t masks[UCP_TAG_MATCH_MAX_MASKS]; /* Hash tables of
+                                             expected wildcard requests, by mask */
+        unsigned              num_masks;  /* Number of masks which have a hash
+                                             table, assigned on first use and
+                                             released when it is empty */
         uint64_t              sn;
         unsigned              sw_all_count; /* Number of all expected requests which
                                                are not posted to offload */
+        unsigned              wildcard_count; /* Number of all expected wildcard
+                                                 requests */
+        unsigned              wildcard_sw_count; /* Number of all expected wildcard
+                                                    requests which are not posted
+                                                    to offload */
     } expected;
 
     /* Unexpected queue */
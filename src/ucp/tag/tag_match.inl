@@ -54,11 +54,88 @@ ucp_tag_exp_get_queue_for_tag(ucp_tag_match_t *tm, ucp_tag_t tag)
     return &tm->expected.hash[ucp_tag_match_calc_hash(tag)];
 }
 
+static UCS_F_ALWAYS_INLINE ucp_tag_exp_mask_hash_t*
+ucp_tag_exp_find_mask_hash(ucp_tag_match_t *tm, ucp_tag_t tag_mask)
+{
+    ucp_tag_exp_mask_hash_t *mask_hash;
+
+    for (mask_hash = tm->expected.masks;
+         mask_hash < (tm->expected.masks + tm->expected.num_masks);
+         ++mask_hash) {
+        if (mask_hash->tag_mask == tag_mask) {
+            return mask_hash;
+        }
+    }
+
+    return NULL;
+}
+
+static UCS_F_ALWAYS_INLINE ucp_tag_exp_mask_hash_t*
+ucp_tag_exp_get_mask_hash(ucp_tag_match_t *tm, ucp_tag_t tag_mask)
+{
+    ucp_tag_exp_mask_hash_t *mask_hash;
+
+    mask_hash = ucp_tag_exp_find_mask_hash(tm, tag_mask);
+    if (mask_hash != NULL) {
+        return mask_hash;
+    }
+
+    /* A mask gets a hash table only if no request is in the wildcard queue,
+     * so that all requests with this mask are always found in the same queue.
+     * The table is released when its last request is removed. */
+    if ((tm->expected.num_masks == UCP_TAG_MATCH_MAX_MASKS) ||
+        !ucs_queue_is_empty(&tm->expected.wildcard.queue)) {
+        return NULL;
+    }
+
+    mask_hash           = &tm->expected.masks[tm->expected.num_masks++];
+    mask_hash->tag_mask = tag_mask;
+    ucs_assert(mask_hash->count == 0);
+    return mask_hash;
+}
+
+/* Update the number of requests in the mask hash table of the request queue */
+static UCS_F_ALWAYS_INLINE void
+ucp_tag_exp_mask_hash_update(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
+                             ucp_tag_t tag_mask, int delta)
+{
+    ucp_tag_exp_mask_hash_t *mask_hash, *last, empty;
+
+    if ((tag_mask == UCP_TAG_MASK_FULL) ||
+        (req_queue == &tm->expected.wildcard)) {
+        return;
+    }
+
+    mask_hash = ucp_tag_exp_find_mask_hash(tm, tag_mask);
+    ucs_assert(mask_hash != NULL);
+
+    mask_hash->count += delta;
+    if (mask_hash->count > 0) {
+        return;
+    }
+
+    /* the table is empty, move the last used slot in its place */
+    last = &tm->expected.masks[--tm->expected.num_masks];
+    if (mask_hash != last) {
+        ucs_assert(last->count > 0);
+        empty      = *mask_hash;
+        *mask_hash = *last;
+        *last      = empty;
+    }
+}
+
 static UCS_F_ALWAYS_INLINE ucp_request_queue_t*
 ucp_tag_exp_get_queue(ucp_tag_match_t *tm, ucp_tag_t tag, ucp_tag_t tag_mask)
 {
+    ucp_tag_exp_mask_hash_t *mask_hash;
+
     if (tag_mask == UCP_TAG_MASK_FULL) {
         return ucp_tag_exp_get_queue_for_tag(tm, tag);
+    }
+
+    mask_hash = ucp_tag_exp_get_mask_hash(tm, tag_mask);
+    if (mask_hash != NULL) {
+        return &mask_hash->hash[ucp_tag_match_calc_hash(tag & tag_mask)];
     } else {
         return &tm->expected.wildcard;
     }
@@ -75,6 +152,8 @@ ucp_tag_exp_push(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                  ucp_request_t *req)
 {
     req->recv.tag.sn = tm->expected.sn++;
+    tm->expected.wildcard_count += (req->recv.tag.tag_mask != UCP_TAG_MASK_FULL);
+    ucp_tag_exp_mask_hash_update(tm, req_queue, req->recv.tag.tag_mask, 1);
     ucs_queue_push(&req_queue->queue, &req->recv.queue);
 }
 
@@ -88,14 +167,19 @@ static UCS_F_ALWAYS_INLINE void
 ucp_tag_exp_delete(ucp_request_t *req, ucp_tag_match_t *tm,
                    ucp_request_queue_t *req_queue, ucs_queue_iter_t iter)
 {
+    int wildcard = (req->recv.tag.tag_mask != UCP_TAG_MASK_FULL);
+
     if (!(req->flags & UCP_REQUEST_FLAG_OFFLOADED)) {
         --tm->expected.sw_all_count;
+        tm->expected.wildcard_sw_count -= wildcard;
         --req_queue->sw_count;
         if (req->flags & UCP_REQUEST_FLAG_BLOCK_OFFLOAD) {
             --req_queue->block_count;
         }
     }
+    tm->expected.wildcard_count -= wildcard;
     ucs_queue_del_iter(&req_queue->queue, iter);
+    ucp_tag_exp_mask_hash_update(tm, req_queue, req->recv.tag.tag_mask, -1);
 }
 
 static UCS_F_ALWAYS_INLINE ucp_request_t *
@@ -105,12 +189,12 @@ ucp_tag_exp_search(ucp_tag_match_t *tm, ucp_tag_t tag)
     ucs_queue_iter_t iter;
     ucp_request_t *req;
 
-    if (ucs_unlikely(!ucs_queue_is_empty(&tm->expected.wildcard.queue))) {
+    if (ucs_unlikely(tm->expected.wildcard_count != 0)) {
         req_queue = ucp_tag_exp_get_queue_for_tag(tm, tag);
         return ucp_tag_exp_search_all(tm, req_queue, tag);
     }
 
-    /* fast path - wildcard queue is empty, search only the specific queue */
+    /* fast path - no wildcard requests, search only the specific queue */
     req_queue = ucp_tag_exp_get_queue_for_tag(tm, tag);
     ucs_queue_for_each_safe(req, iter, &req_queue->queue, recv.queue) {
         req = ucs_container_of(*iter, ucp_request_t, recv.queue);
@@ -19,6 +19,10 @@
 #include <ucs/datastruct/queue.h>
 
 
+/* How many receives ahead to prefetch when posting a batch */
+#define UCP_TAG_RECV_BATCH_PREFETCH    4
+
+
 static UCS_F_ALWAYS_INLINE void
 ucp_tag_recv_request_completed(ucp_request_t *req, ucs_status_t status,
                                ucp_tag_recv_info_t *info, const char *function)
@@ -76,7 +80,12 @@ ucp_tag_recv_common(ucp_worker_h worker, void *buffer, size_t count,
         ucp_recv_desc_release(rdesc);
 
         if (req_flags & UCP_REQUEST_FLAG_CALLBACK) {
-            cb(req + 1, status, &req->recv.tag.info);
+            if (ucs_likely(cb != NULL)) {
+                cb(req + 1, status, &req->recv.tag.info);
+            } else {
+                req->status = status;
+                ucp_request_complete_cq(req);
+            }
         }
         ucp_tag_recv_request_completed(req, status, &req->recv.tag.info,
                                        debug_name);
@@ -175,6 +184,43 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_recv_nbr,
     return UCS_OK;
 }
 
+UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_recv_nbr_batch, (worker, ops, num_ops),
+                 ucp_worker_h worker, const ucp_tag_recv_op_t *ops,
+                 unsigned num_ops)
+{
+    const ucp_tag_recv_op_t *op, *next_op;
+    ucp_recv_desc_t *rdesc;
+    ucp_request_t *req;
+
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_TAG,
+                                    return UCS_ERR_INVALID_PARAM);
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+
+    for (op = ops; op < ops + num_ops; ++op) {
+        /* warm up the request and the expected queue of a later receive,
+         * while the current one is being matched */
+        next_op = op + UCP_TAG_RECV_BATCH_PREFETCH;
+        if (next_op < ops + num_ops) {
+            ucs_prefetch((ucp_request_t*)next_op->request - 1);
+            if (next_op->tag_mask == UCP_TAG_MASK_FULL) {
+                ucs_prefetch(ucp_tag_exp_get_queue_for_tag(&worker->tm,
+                                                           next_op->tag));
+            }
+        }
+
+        req   = (ucp_request_t*)op->request - 1;
+        rdesc = ucp_tag_unexp_search(&worker->tm, op->tag, op->tag_mask, 1,
+                                     "recv_nbr_batch");
+        ucp_tag_recv_common(worker, op->buffer, op->count, op->datatype,
+                            op->tag, op->tag_mask, req,
+                            UCP_REQUEST_DEBUG_FLAG_EXTERNAL, NULL, rdesc,
+                            "recv_nbr_batch");
+    }
+
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+    return UCS_OK;
+}
+
 UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_tag_recv_nb,
                  (worker, buffer, count, datatype, tag, tag_mask, cb),
                  ucp_worker_h worker, void *buffer, size_t count,
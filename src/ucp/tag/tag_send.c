@@ -229,26 +229,22 @@ out:
     return ret;
 }
 
-UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_send_nbr,
-                 (ep, buffer, count, datatype, tag, request),
-                 ucp_ep_h ep, const void *buffer, size_t count,
-                 uintptr_t datatype, ucp_tag_t tag, void *request)
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_tag_send_nbr_common(ucp_ep_h ep, const void *buffer, size_t count,
+                        uintptr_t datatype, ucp_tag_t tag, void *request,
+                        const char *debug_name)
 {
     ucp_request_t *req = (ucp_request_t *)request - 1;
     ucs_status_t status;
     ucs_status_ptr_t ret;
 
-    UCP_CONTEXT_CHECK_FEATURE_FLAGS(ep->worker->context, UCP_FEATURE_TAG,
-                                    return UCS_ERR_INVALID_PARAM);
-    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
-
-    ucs_trace_req("send_nbr buffer %p count %zu tag %"PRIx64" to %s req %p",
-                  buffer, count, tag, ucp_ep_peer_name(ep), request);
+    ucs_trace_req("%s buffer %p count %zu tag %"PRIx64" to %s req %p",
+                  debug_name, buffer, count, tag, ucp_ep_peer_name(ep),
+                  request);
 
     status = UCS_PROFILE_CALL(ucp_tag_send_inline, ep, buffer, count,
                               datatype, tag);
     if (ucs_likely(status != UCS_ERR_NO_RESOURCE)) {
-        UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
         return status;
     }
 
@@ -258,15 +254,59 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_send_nbr,
                            ucp_ep_config(ep)->tag.rndv_send_nbr.rma_thresh,
                            ucp_ep_config(ep)->tag.rndv_send_nbr.am_thresh,
                            NULL, ucp_ep_config(ep)->tag.proto, 0);
-
-    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
-
     if (ucs_unlikely(UCS_PTR_IS_ERR(ret))) {
         return UCS_PTR_STATUS(ret);
     }
     return UCS_INPROGRESS;
 }
 
+UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_send_nbr,
+                 (ep, buffer, count, datatype, tag, request),
+                 ucp_ep_h ep, const void *buffer, size_t count,
+                 uintptr_t datatype, ucp_tag_t tag, void *request)
+{
+    ucs_status_t status;
+
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(ep->worker->context, UCP_FEATURE_TAG,
+                                    return UCS_ERR_INVALID_PARAM);
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
+
+    status = ucp_tag_send_nbr_common(ep, buffer, count, datatype, tag, request,
+                                     "send_nbr");
+
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
+    return status;
+}
+
+UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_send_nbr_batch,
+                 (worker, ops, num_ops, statuses),
+                 ucp_worker_h worker, const ucp_tag_send_op_t *ops,
+                 unsigned num_ops, ucs_status_t *statuses)
+{
+    ucs_status_t status = UCS_OK;
+    const ucp_tag_send_op_t *op;
+    unsigned i;
+
+    UCP_CONTEXT_CHECK_FEATURE_FLAGS(worker->context, UCP_FEATURE_TAG,
+                                    return UCS_ERR_INVALID_PARAM);
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+
+    for (i = 0; i < num_ops; ++i) {
+        op = &ops[i];
+        ucs_assert(op->ep->worker == worker);
+
+        statuses[i] = ucp_tag_send_nbr_common(op->ep, op->buffer, op->count,
+                                              op->datatype, op->tag,
+                                              op->request, "send_nbr_batch");
+        if (UCS_STATUS_IS_ERR(statuses[i]) && (status == UCS_OK)) {
+            status = statuses[i];
+        }
+    }
+
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+    return status;
+}
+
 UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_tag_send_sync_nb,
                  (ep, buffer, count, datatype, tag, cb),
                  ucp_ep_h ep, const void *buffer, size_t count,
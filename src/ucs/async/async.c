@@ -7,8 +7,8 @@
 #include "async_int.h"
 
 #include <ucs/arch/atomic.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/debug/debug.h>
-#include <ucs/datastruct/khash.h>
 #include <ucs/sys/stubs.h>
 
 
@@ -18,20 +18,35 @@
 #define UCS_ASYNC_HANDLER_FMT       "%p [id=%d] %s()"
 #define UCS_ASYNC_HANDLER_ARG(_h)   (_h), (_h)->id, ucs_debug_get_symbol_name((_h)->cb)
 
-/* Hash table for all event and timer handlers */
-KHASH_MAP_INIT_INT(ucs_async_handler, ucs_async_handler_t *);
+/*
+ * Handler table is a two-level array directly indexed by event/timer id.
+ * Pages are allocated on demand and are never released until global cleanup,
+ * so readers can look up a slot without taking any lock.
+ */
+#define UCS_ASYNC_HANDLER_PAGE_SHIFT 10
+#define UCS_ASYNC_HANDLER_PAGE_SIZE  UCS_BIT(UCS_ASYNC_HANDLER_PAGE_SHIFT)
+#define UCS_ASYNC_HANDLER_NUM_PAGES  \
+    ((UCS_ASYNC_TIMER_ID_MAX + UCS_ASYNC_HANDLER_PAGE_SIZE - 1) / \
+     UCS_ASYNC_HANDLER_PAGE_SIZE)
+
+
+typedef ucs_async_handler_t * volatile ucs_async_handler_slot_t;
 
 
 typedef struct ucs_async_global_context {
-    khash_t(ucs_async_handler)     handlers;
-    pthread_rwlock_t               handlers_lock;
+    ucs_async_handler_slot_t       *pages[UCS_ASYNC_HANDLER_NUM_PAGES];
+    pthread_mutex_t                handlers_lock;  /* Protects table updates */
+    ucs_list_link_t                free_list;      /* Released handlers */
+    volatile int                   max_fd;         /* Highest fd ever added + 1 */
+    volatile unsigned              num_timer_ids;  /* Size of timer id range in use */
+    volatile unsigned              num_handlers;
     volatile uint32_t              handler_id;
 } ucs_async_global_context_t;
 
 
 static ucs_async_global_context_t ucs_async_global_context = {
-    .handlers_lock   = PTHREAD_RWLOCK_INITIALIZER,
-    .handler_id      = UCS_ASYNC_TIMER_ID_MIN
+    .handlers_lock   = PTHREAD_MUTEX_INITIALIZER,
+    .handler_id      = 0
 };
 
 
@@ -77,131 +92,255 @@ static ucs_async_ops_t ucs_async_poll_ops = {
     .remove_timer       = ucs_empty_function_return_success,
 };
 
-static inline khiter_t ucs_async_handler_kh_get(int id)
+static inline ucs_async_handler_slot_t *ucs_async_handler_slot(int id)
+{
+    ucs_async_handler_slot_t *page;
+
+    if ((id < 0) || (id >= UCS_ASYNC_TIMER_ID_MAX)) {
+        return NULL;
+    }
+
+    page = ucs_async_global_context.pages[id >> UCS_ASYNC_HANDLER_PAGE_SHIFT];
+    if (page == NULL) {
+        return NULL;
+    }
+
+    return &page[id & (UCS_ASYNC_HANDLER_PAGE_SIZE - 1)];
+}
+
+/* return the slot of the given id, allocating its page if needed */
+static ucs_async_handler_slot_t *ucs_async_handler_slot_alloc(int id)
 {
-    return kh_get(ucs_async_handler, &ucs_async_global_context.handlers, id);
+    ucs_async_handler_slot_t *page;
+    unsigned page_index;
+
+    page_index = id >> UCS_ASYNC_HANDLER_PAGE_SHIFT;
+    page       = ucs_async_global_context.pages[page_index];
+    if (page == NULL) {
+        page = ucs_calloc(UCS_ASYNC_HANDLER_PAGE_SIZE, sizeof(*page),
+                          "async handler table");
+        if (page == NULL) {
+            return NULL;
+        }
+
+        /* make the zeroed page visible before publishing it */
+        ucs_memory_cpu_store_fence();
+        ucs_async_global_context.pages[page_index] = page;
+    }
+
+    return &page[id & (UCS_ASYNC_HANDLER_PAGE_SIZE - 1)];
+}
+
+/* increment reference count, unless the handler is already released */
+static int ucs_async_handler_try_hold(ucs_async_handler_t *handler)
+{
+    uint32_t refcount;
+
+    do {
+        refcount = handler->refcount;
+        if (refcount == 0) {
+            return 0;
+        }
+    } while (ucs_atomic_cswap32(&handler->refcount, refcount, refcount + 1) !=
+             refcount);
+
+    return 1;
 }
 
-static inline int ucs_async_handler_kh_is_end(khiter_t hash_it)
+/* decrement reference count and release the handler if reached 0 */
+static void ucs_async_handler_put(ucs_async_handler_t *handler)
 {
-    return hash_it == kh_end(&ucs_async_global_context.handlers);
+    if (ucs_atomic_fadd32(&handler->refcount, -1) > 1) {
+        return;
+    }
+
+    ucs_debug("release async handler " UCS_ASYNC_HANDLER_FMT,
+              UCS_ASYNC_HANDLER_ARG(handler));
+
+    /* Lock-free readers may still access the handler memory, so keep it as a
+     * handler object on the free list instead of releasing it */
+    pthread_mutex_lock(&ucs_async_global_context.handlers_lock);
+    ucs_list_add_head(&ucs_async_global_context.free_list, &handler->list);
+    pthread_mutex_unlock(&ucs_async_global_context.handlers_lock);
 }
 
-static void ucs_async_handler_hold(ucs_async_handler_t *handler)
+/* take a reference to a handler found in the given slot */
+static ucs_async_handler_t *
+ucs_async_handler_slot_get(ucs_async_handler_slot_t *slot)
 {
-    ucs_atomic_add32(&handler->refcount, 1);
+    ucs_async_handler_t *handler;
+
+    for (;;) {
+        handler = *slot;
+        if ((handler == NULL) || !ucs_async_handler_try_hold(handler)) {
+            return NULL;
+        }
+
+        /* Handler memory could have been released and reused for a different
+         * id after we read the slot, so check the slot still points to it */
+        ucs_memory_cpu_load_fence();
+        if (ucs_likely(*slot == handler)) {
+            return handler;
+        }
+
+        ucs_async_handler_put(handler);
+    }
 }
 
 /* incremented reference count and return the handler */
 static ucs_async_handler_t *ucs_async_handler_get(int id)
 {
+    ucs_async_handler_slot_t *slot;
     ucs_async_handler_t *handler;
-    khiter_t hash_it;
 
-    pthread_rwlock_rdlock(&ucs_async_global_context.handlers_lock);
-    hash_it = ucs_async_handler_kh_get(id);
-    if (ucs_async_handler_kh_is_end(hash_it)) {
-        handler = NULL;
-        goto out_unlock;
+    slot = ucs_async_handler_slot(id);
+    if (slot == NULL) {
+        return NULL;
     }
 
-    handler = kh_value(&ucs_async_global_context.handlers, hash_it);
-    ucs_assert_always(handler->id == id);
-    ucs_async_handler_hold(handler);
-
-out_unlock:
-    pthread_rwlock_unlock(&ucs_async_global_context.handlers_lock);
+    handler = ucs_async_handler_slot_get(slot);
+    ucs_assert((handler == NULL) || (handler->id == id));
     return handler;
 }
 
-/* remove from hash and return the handler */
+/* remove from the table and return the handler */
 static ucs_async_handler_t *ucs_async_handler_extract(int id)
 {
+    ucs_async_handler_slot_t *slot;
     ucs_async_handler_t *handler;
-    khiter_t hash_it;
 
-    pthread_rwlock_wrlock(&ucs_async_global_context.handlers_lock);
-    hash_it = ucs_async_handler_kh_get(id);
-    if (ucs_async_handler_kh_is_end(hash_it)) {
-        ucs_debug("async handler [id=%d] not found in hash table", id);
+    pthread_mutex_lock(&ucs_async_global_context.handlers_lock);
+    slot = ucs_async_handler_slot(id);
+    if ((slot == NULL) || (*slot == NULL)) {
+        ucs_debug("async handler [id=%d] not found in handler table", id);
         handler = NULL;
     } else {
-        handler = kh_value(&ucs_async_global_context.handlers, hash_it);
+        handler = *slot;
         ucs_assert_always(handler->id == id);
-        kh_del(ucs_async_handler, &ucs_async_global_context.handlers, hash_it);
-        ucs_debug("removed async handler " UCS_ASYNC_HANDLER_FMT " from hash",
+        *slot = NULL;
+        --ucs_async_global_context.num_handlers;
+        ucs_debug("removed async handler " UCS_ASYNC_HANDLER_FMT " from table",
                   UCS_ASYNC_HANDLER_ARG(handler));
     }
-    pthread_rwlock_unlock(&ucs_async_global_context.handlers_lock);
+    pthread_mutex_unlock(&ucs_async_global_context.handlers_lock);
 
     return handler;
 }
 
-/* decrement reference count and release the handler if reached 0 */
-static void ucs_async_handler_put(ucs_async_handler_t *handler)
+static ucs_async_handler_t *ucs_async_handler_alloc()
 {
-    if (ucs_atomic_fadd32(&handler->refcount, -1) > 1) {
-        return;
+    ucs_async_handler_t *handler;
+
+    pthread_mutex_lock(&ucs_async_global_context.handlers_lock);
+    if (ucs_list_is_empty(&ucs_async_global_context.free_list)) {
+        handler = NULL;
+    } else {
+        handler = ucs_list_extract_head(&ucs_async_global_context.free_list,
+                                        ucs_async_handler_t, list);
     }
+    pthread_mutex_unlock(&ucs_async_global_context.handlers_lock);
 
-    ucs_debug("release async handler " UCS_ASYNC_HANDLER_FMT,
-              UCS_ASYNC_HANDLER_ARG(handler));
-    ucs_free(handler);
+    if (handler == NULL) {
+        handler = ucs_malloc(sizeof *handler, "async handler");
+    }
+
+    return handler;
 }
 
 /* add new handler to the table */
 static ucs_status_t ucs_async_handler_add(int min_id, int max_id,
                                           ucs_async_handler_t *handler)
 {
-    int hash_extra_status;
+    ucs_async_handler_slot_t *slot;
     ucs_status_t status;
-    khiter_t hash_it;
-    int i, id;
+    unsigned i, range;
+    int id;
 
-    pthread_rwlock_wrlock(&ucs_async_global_context.handlers_lock);
+    pthread_mutex_lock(&ucs_async_global_context.handlers_lock);
 
     handler->id = -1;
-    ucs_assert_always(handler->refcount == 1);
+    ucs_assert_always(handler->refcount >= 1);
 
     /*
-     * Search for an empty key in the range [min_id, max_id)
-     * ucs_async_global_context.handler_id is used to generate "unique" keys.
+     * Search for an empty slot in the range [min_id, max_id). Timer ids are
+     * taken from a window which grows only when it is full, to keep the table
+     * dense. ucs_async_global_context.handler_id is used to rotate the ids.
      */
-    for (i = min_id; i < max_id; ++i) {
-        id = min_id + (ucs_atomic_fadd32(&ucs_async_global_context.handler_id, 1) %
-                       (max_id - min_id));
-        hash_it = kh_put(ucs_async_handler, &ucs_async_global_context.handlers,
-                         id, &hash_extra_status);
-        if (hash_extra_status == -1) {
-            ucs_error("Failed to add async handler " UCS_ASYNC_HANDLER_FMT
-                      " to hash", UCS_ASYNC_HANDLER_ARG(handler));
-            status = UCS_ERR_NO_MEMORY;
-            goto out_unlock;
-        } else if (hash_extra_status != 0) {
-            handler->id = id;
-            ucs_assert(id != -1);
+    for (;;) {
+        range = max_id - min_id;
+        if (min_id == UCS_ASYNC_TIMER_ID_MIN) {
+            range = ucs_min(range, ucs_async_global_context.num_timer_ids);
+        }
+
+        for (i = 0; i < range; ++i) {
+            id   = min_id + (ucs_atomic_fadd32(&ucs_async_global_context.handler_id, 1) %
+                             range);
+            slot = ucs_async_handler_slot_alloc(id);
+            if (slot == NULL) {
+                ucs_error("Failed to add async handler " UCS_ASYNC_HANDLER_FMT
+                          " to table", UCS_ASYNC_HANDLER_ARG(handler));
+                status = UCS_ERR_NO_MEMORY;
+                goto out_unlock;
+            } else if (*slot == NULL) {
+                handler->id = id;
+                ucs_assert(id != -1);
+                goto out_found;
+            }
+        }
+
+        if (range == (max_id - min_id)) {
             break;
         }
+
+        ucs_async_global_context.num_timer_ids =
+                ucs_min(range + UCS_ASYNC_HANDLER_PAGE_SIZE, max_id - min_id);
     }
 
-    if (handler->id == -1) {
-        ucs_error("Cannot add async handler %s() - id range [%d..%d) is full",
-                  ucs_debug_get_symbol_name(handler->cb), min_id, max_id);
-        status = UCS_ERR_ALREADY_EXISTS;
-        goto out_unlock;
+    ucs_error("Cannot add async handler %s() - id range [%d..%d) is full",
+              ucs_debug_get_symbol_name(handler->cb), min_id, max_id);
+    status = UCS_ERR_ALREADY_EXISTS;
+    goto out_unlock;
+
+out_found:
+    if (id < UCS_ASYNC_TIMER_ID_MIN) {
+        ucs_async_global_context.max_fd = ucs_max(ucs_async_global_context.max_fd,
+                                                  id + 1);
     }
 
-    ucs_assert_always(!ucs_async_handler_kh_is_end(hash_it));
-    kh_value(&ucs_async_global_context.handlers, hash_it) = handler;
-    ucs_debug("added async handler " UCS_ASYNC_HANDLER_FMT " to hash",
+    /* make handler fields visible before publishing it to readers */
+    ucs_memory_cpu_store_fence();
+    *slot = handler;
+    ++ucs_async_global_context.num_handlers;
+    ucs_debug("added async handler " UCS_ASYNC_HANDLER_FMT " to table",
               UCS_ASYNC_HANDLER_ARG(handler));
     status = UCS_OK;
 
 out_unlock:
-    pthread_rwlock_unlock(&ucs_async_global_context.handlers_lock);
+    pthread_mutex_unlock(&ucs_async_global_context.handlers_lock);
     return status;
 }
 
+/* call a function for every slot in the table which may hold a handler */
+#define ucs_async_handler_table_for_each(_slot, _code) \
+    { \
+        int _first[2] = {0, UCS_ASYNC_TIMER_ID_MIN}; \
+        int _last[2]  = {ucs_async_global_context.max_fd, \
+                         UCS_ASYNC_TIMER_ID_MIN + \
+                         ucs_async_global_context.num_timer_ids}; \
+        int _i, _id; \
+        for (_i = 0; _i < 2; ++_i) { \
+            for (_id = _first[_i]; _id < _last[_i]; ++_id) { \
+                (_slot) = ucs_async_handler_slot(_id); \
+                if ((_slot) == NULL) { \
+                    /* skip to the next page */ \
+                    _id |= UCS_ASYNC_HANDLER_PAGE_SIZE - 1; \
+                    continue; \
+                } \
+                _code; \
+            } \
+        } \
+    }
+
 static ucs_status_t ucs_async_handler_dispatch(ucs_async_handler_t *handler)
 {
     ucs_async_context_t *async;
@@ -334,21 +473,23 @@ err:
 
 void ucs_async_context_cleanup(ucs_async_context_t *async)
 {
+    ucs_async_handler_slot_t *slot;
     ucs_async_handler_t *handler;
 
     ucs_trace_func("async=%p", async);
 
     if (async->num_handlers > 0) {
-        pthread_rwlock_rdlock(&ucs_async_global_context.handlers_lock);
-        kh_foreach_value(&ucs_async_global_context.handlers, handler, {
-            if (async == handler->async) {
+        pthread_mutex_lock(&ucs_async_global_context.handlers_lock);
+        ucs_async_handler_table_for_each(slot, {
+            handler = *slot;
+            if ((handler != NULL) && (async == handler->async)) {
                 ucs_warn("async %p handler "UCS_ASYNC_HANDLER_FMT" %s() not released",
                          async, UCS_ASYNC_HANDLER_ARG(handler),
                          ucs_debug_get_symbol_name(handler->cb));
             }
         });
         ucs_warn("releasing async context with %d handlers", async->num_handlers);
-        pthread_rwlock_unlock(&ucs_async_global_context.handlers_lock);
+        pthread_mutex_unlock(&ucs_async_global_context.handlers_lock);
     }
 
     ucs_async_method_call(async->mode, context_cleanup, async);
@@ -386,7 +527,7 @@ ucs_async_alloc_handler(int min_id, int max_id, ucs_async_mode_t mode,
         }
     }
 
-    handler = ucs_malloc(sizeof *handler, "async handler");
+    handler = ucs_async_handler_alloc();
     if (handler == NULL) {
         status = UCS_ERR_NO_MEMORY;
         goto err_dec_num_handlers;
@@ -411,7 +552,7 @@ ucs_async_alloc_handler(int min_id, int max_id, ucs_async_mode_t mode,
     return UCS_OK;
 
 err_free:
-    ucs_free(handler);
+    ucs_async_handler_put(handler);
 err_dec_num_handlers:
     if (async != NULL) {
         ucs_atomic_add32(&async->num_handlers, -1);
@@ -589,23 +730,33 @@ void __ucs_async_poll_missed(ucs_async_context_t *async)
 void ucs_async_poll(ucs_async_context_t *async)
 {
     ucs_async_handler_t **handlers, *handler;
-    size_t i, n;
+    ucs_async_handler_slot_t *slot;
+    size_t i, n, max_handlers;
 
     ucs_trace_poll("async=%p", async);
 
-    pthread_rwlock_rdlock(&ucs_async_global_context.handlers_lock);
-    handlers = ucs_alloca(kh_size(&ucs_async_global_context.handlers) * sizeof(*handlers));
-    n = 0;
-    kh_foreach_value(&ucs_async_global_context.handlers, handler, {
+    max_handlers = ucs_async_global_context.num_handlers;
+    handlers     = ucs_alloca(ucs_max(1, max_handlers) * sizeof(*handlers));
+    n            = 0;
+    ucs_async_handler_table_for_each(slot, {
+        if (n >= max_handlers) {
+            break;
+        }
+
+        handler = ucs_async_handler_slot_get(slot);
+        if (handler == NULL) {
+            continue;
+        }
+
         if (((async == NULL) || (async == handler->async)) &&  /* Async context match */
             ((handler->async == NULL) || (handler->async->poll_block == 0)) && /* Not blocked */
             handler->events) /* Non-empty event set */
         {
-            ucs_async_handler_hold(handler);
             handlers[n++] = handler;
+        } else {
+            ucs_async_handler_put(handler);
         }
     });
-    pthread_rwlock_unlock(&ucs_async_global_context.handlers_lock);
 
     for (i = 0; i < n; ++i) {
         ucs_async_handler_dispatch(handlers[i]);
@@ -617,23 +768,37 @@ void ucs_async_global_init()
 {
     int ret;
 
-    ret = pthread_rwlock_init(&ucs_async_global_context.handlers_lock, NULL);
+    ret = pthread_mutex_init(&ucs_async_global_context.handlers_lock, NULL);
     if (ret) {
-        ucs_fatal("pthread_rwlock_init() failed: %m");
+        ucs_fatal("pthread_mutex_init() failed: %m");
     }
 
-    kh_init_inplace(ucs_async_handler, &ucs_async_global_context.handlers);
+    ucs_list_head_init(&ucs_async_global_context.free_list);
     ucs_async_method_call_all(init);
 }
 
 void ucs_async_global_cleanup()
 {
-    int num_elems = kh_size(&ucs_async_global_context.handlers);
-    if (num_elems != 0) {
-        ucs_debug("async handler table is not empty during exit (contains %d elems)",
-                  num_elems);
+    ucs_async_handler_t *handler, *tmp;
+    unsigned i;
+
+    if (ucs_async_global_context.num_handlers != 0) {
+        ucs_debug("async handler table is not empty during exit (contains %u elems)",
+                  ucs_async_global_context.num_handlers);
     }
     ucs_async_method_call_all(cleanup);
-    kh_destroy_inplace(ucs_async_handler, &ucs_async_global_context.handlers);
-    pthread_rwlock_destroy(&ucs_async_global_context.handlers_lock);
+
+    ucs_list_for_each_safe(handler, tmp, &ucs_async_global_context.free_list,
+                           list) {
+        ucs_free(handler);
+    }
+    ucs_list_head_init(&ucs_async_global_context.free_list);
+
+    for (i = 0; i < UCS_ASYNC_HANDLER_NUM_PAGES; ++i) {
+        ucs_free((void*)ucs_async_global_context.pages[i]);
+        ucs_async_global_context.pages[i] = NULL;
+    }
+    ucs_async_global_context.max_fd        = 0;
+    ucs_async_global_context.num_timer_ids = 0;
+    pthread_mutex_destroy(&ucs_async_global_context.handlers_lock);
 }
@@ -9,6 +9,7 @@
 
 #include "async.h"
 
+#include <ucs/datastruct/list.h>
 #include <ucs/datastruct/queue.h>
 #include <ucs/time/timerq.h>
 
@@ -24,6 +25,7 @@ struct ucs_async_handler {
     ucs_async_context_t        *async;  /* Async context for the handler. Can be NULL */
     volatile uint32_t          missed;  /* Protect against adding to miss queue multiple times */
     volatile uint32_t          refcount;
+    ucs_list_link_t            list;    /* Entry in the free list once released */
 };
 
 
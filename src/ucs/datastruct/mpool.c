@@ -12,12 +12,34 @@
 #include "mpool.inl"
 #include "queue.h"
 
+#include <ucs/arch/atomic.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/debug/log.h>
 #include <ucs/sys/math.h>
 #include <ucs/sys/checker.h>
 #include <ucs/sys/sys.h>
 
 
+/* Number of per-thread magazines in a thread-safe pool; threads beyond that
+ * share magazines, and fall back to the remote-free list on contention */
+#define UCS_MPOOL_MT_NUM_MAGAZINES    16
+
+/* Number of elements a magazine holds before it's flushed */
+#define UCS_MPOOL_MT_MAGAZINE_SIZE    32
+
+
+struct ucs_mpool_magazine {
+    volatile uint32_t      busy;    /* Set while a thread is using the magazine */
+    unsigned               count;   /* Number of elements in the magazine */
+    ucs_mpool_elem_t       *head;   /* First element */
+    ucs_mpool_elem_t       *tail;   /* Last element */
+} UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE);
+
+
+static __thread unsigned ucs_mpool_thread_magazine = 0; /* index + 1 */
+static volatile uint32_t ucs_mpool_num_threads     = 0;
+
+
 static inline unsigned ucs_mpool_elem_total_size(ucs_mpool_data_t *data)
 {
     return ucs_align_up_pow2(data->elem_size, data->alignment);
@@ -66,6 +88,7 @@ ucs_status_t ucs_mpool_init(ucs_mpool_t *mp, size_t priv_size,
     }
 
     mp->freelist              = NULL;
+    mp->mt                    = 0;
     mp->data->elem_size       = sizeof(ucs_mpool_elem_t) + elem_size;
     mp->data->alignment       = alignment;
     mp->data->align_offset    = sizeof(ucs_mpool_elem_t) + align_offset;
@@ -74,6 +97,8 @@ ucs_status_t ucs_mpool_init(ucs_mpool_t *mp, size_t priv_size,
     mp->data->tail            = NULL;
     mp->data->chunks          = NULL;
     mp->data->ops             = ops;
+    mp->data->remote_free     = NULL;
+    mp->data->magazines       = NULL;
     mp->data->name            = ucs_strdup(name, "mpool_data_name");
 
     if (mp->data->name == NULL) {
@@ -93,6 +118,86 @@ err_strdup:
     return UCS_ERR_NO_MEMORY;
 }
 
+static void ucs_mpool_push_remote(ucs_mpool_data_t *data, ucs_mpool_elem_t *head,
+                                  ucs_mpool_elem_t *tail)
+{
+    ucs_mpool_elem_t *top;
+
+    VALGRIND_MAKE_MEM_DEFINED(tail, sizeof *tail);
+    do {
+        top        = data->remote_free;
+        tail->next = top;
+    } while (ucs_atomic_cswap64((volatile uint64_t*)&data->remote_free,
+                                (uintptr_t)top, (uintptr_t)head) !=
+             (uintptr_t)top);
+    VALGRIND_MAKE_MEM_NOACCESS(tail, sizeof *tail);
+}
+
+/* Prepend a list of elements to the freelist */
+static void ucs_mpool_freelist_prepend(ucs_mpool_t *mp, ucs_mpool_elem_t *head,
+                                       ucs_mpool_elem_t *tail)
+{
+    VALGRIND_MAKE_MEM_DEFINED(tail, sizeof *tail);
+    tail->next   = mp->freelist;
+    VALGRIND_MAKE_MEM_NOACCESS(tail, sizeof *tail);
+    mp->freelist = head;
+}
+
+/* Move the elements returned by other threads to the freelist. Must be called
+ * by the thread which gets objects from the pool.
+ *
+ * @param drain_magazines  Also take partially filled magazines which are not
+ *                         being used at the moment.
+ *
+ * @return Whether any element was moved.
+ */
+static int ucs_mpool_reclaim(ucs_mpool_t *mp, int drain_magazines)
+{
+    ucs_mpool_data_t *data = mp->data;
+    ucs_mpool_magazine_t *mag;
+    ucs_mpool_elem_t *head, *tail;
+    int reclaimed = 0;
+
+    /* Only this thread removes from the list, so taking it all at once is not
+     * subject to ABA */
+    head = (void*)ucs_atomic_swap64((volatile uint64_t*)&data->remote_free, 0);
+    if (head != NULL) {
+        for (tail = head; ; tail = tail->next) {
+            VALGRIND_MAKE_MEM_DEFINED(tail, sizeof *tail);
+            if (tail->next == NULL) {
+                break;
+            }
+            VALGRIND_MAKE_MEM_NOACCESS(tail, sizeof *tail);
+        }
+        VALGRIND_MAKE_MEM_NOACCESS(tail, sizeof *tail);
+        ucs_mpool_freelist_prepend(mp, head, tail);
+        reclaimed = 1;
+    }
+
+    if (!drain_magazines) {
+        return reclaimed;
+    }
+
+    for (mag = data->magazines;
+         mag < data->magazines + UCS_MPOOL_MT_NUM_MAGAZINES; ++mag) {
+        if ((mag->count == 0) || (ucs_atomic_cswap32(&mag->busy, 0, 1) != 0)) {
+            continue;
+        }
+
+        if (mag->count > 0) {
+            ucs_mpool_freelist_prepend(mp, mag->head, mag->tail);
+            mag->head  = NULL;
+            mag->count = 0;
+            reclaimed  = 1;
+        }
+
+        ucs_memory_cpu_store_fence();
+        mag->busy = 0;
+    }
+
+    return reclaimed;
+}
+
 void ucs_mpool_cleanup(ucs_mpool_t *mp, int leak_check)
 {
     ucs_mpool_chunk_t *chunk, *next_chunk;
@@ -100,6 +205,11 @@ void ucs_mpool_cleanup(ucs_mpool_t *mp, int leak_check)
     ucs_mpool_data_t *data = mp->data;
     void *obj;
 
+    if (data->magazines != NULL) {
+        ucs_mpool_reclaim(mp, 1);
+        ucs_free(data->magazines);
+    }
+
     /* Cleanup all elements in the freelist and set their header to NULL to mark
      * them as released for the leak check.
      */
@@ -156,7 +266,8 @@ const char *ucs_mpool_name(ucs_mpool_t *mp)
 
 int ucs_mpool_is_empty(ucs_mpool_t *mp)
 {
-    return (mp->freelist == NULL) && (mp->data->quota == 0);
+    return (mp->freelist == NULL) && (mp->data->quota == 0) &&
+           (mp->data->remote_free == NULL);
 }
 
 void *ucs_mpool_get(ucs_mpool_t *mp)
@@ -169,6 +280,72 @@ void ucs_mpool_put(void *obj)
     ucs_mpool_put_inline(obj);
 }
 
+ucs_status_t ucs_mpool_enable_mt(ucs_mpool_t *mp)
+{
+    ucs_mpool_data_t *data = mp->data;
+    int ret;
+
+    if (data->magazines != NULL) {
+        return UCS_OK;
+    }
+
+    if (data->chunks != NULL) {
+        ucs_error("mpool %s: cannot enable thread safety after allocation",
+                  ucs_mpool_name(mp));
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    ret = ucs_posix_memalign((void**)&data->magazines, UCS_SYS_CACHE_LINE_SIZE,
+                             sizeof(*data->magazines) *
+                             UCS_MPOOL_MT_NUM_MAGAZINES, "mpool_magazines");
+    if (ret != 0) {
+        ucs_error("mpool %s: failed to allocate magazines", ucs_mpool_name(mp));
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    memset(data->magazines, 0,
+           sizeof(*data->magazines) * UCS_MPOOL_MT_NUM_MAGAZINES);
+    mp->mt = 1;
+    ucs_debug("mpool %s: enabled thread-safe put", ucs_mpool_name(mp));
+    return UCS_OK;
+}
+
+void ucs_mpool_put_mt(ucs_mpool_t *mp, ucs_mpool_elem_t *elem)
+{
+    ucs_mpool_data_t *data = mp->data;
+    ucs_mpool_magazine_t *mag;
+
+    if (ucs_unlikely(ucs_mpool_thread_magazine == 0)) {
+        ucs_mpool_thread_magazine = (ucs_atomic_fadd32(&ucs_mpool_num_threads, 1) %
+                                     UCS_MPOOL_MT_NUM_MAGAZINES) + 1;
+    }
+
+    mag = &data->magazines[ucs_mpool_thread_magazine - 1];
+    if (ucs_unlikely(ucs_atomic_cswap32(&mag->busy, 0, 1) != 0)) {
+        /* Another thread shares this magazine and is using it now */
+        VALGRIND_MEMPOOL_FREE(mp, elem + 1);
+        ucs_mpool_push_remote(data, elem, elem);
+        return;
+    }
+
+    elem->next = mag->head;
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    VALGRIND_MEMPOOL_FREE(mp, elem + 1);
+    mag->head  = elem;
+    if (mag->count++ == 0) {
+        mag->tail = elem;
+    }
+
+    if (mag->count == UCS_MPOOL_MT_MAGAZINE_SIZE) {
+        ucs_mpool_push_remote(data, mag->head, mag->tail);
+        mag->head  = NULL;
+        mag->count = 0;
+    }
+
+    ucs_memory_cpu_store_fence();
+    mag->busy = 0;
+}
+
 void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
 {
     ucs_mpool_data_t *data = mp->data;
@@ -196,9 +373,11 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
     chunk            = ptr;
     chunk_padding    = ucs_padding((uintptr_t)(chunk + 1) + data->align_offset,
                                    data->alignment);
-    chunk->elems     = (void*)(chunk + 1) + chunk_padding;
-    chunk->num_elems = ucs_min(data->quota, (chunk_size - chunk_padding - sizeof(*chunk)) /
-                       ucs_mpool_elem_total_size(data));
+    chunk->elems      = (void*)(chunk + 1) + chunk_padding;
+    chunk->num_elems  = ucs_min(data->quota, (chunk_size - chunk_padding - sizeof(*chunk)) /
+                        ucs_mpool_elem_total_size(data));
+    chunk->num_free   = 0;
+    chunk->idle_count = 0;
 
     ucs_debug("mpool %s: allocated chunk %p of %lu bytes with %u elements",
               ucs_mpool_name(mp), chunk, chunk_size, chunk->num_elems);
@@ -229,10 +408,163 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
     VALGRIND_MAKE_MEM_NOACCESS(chunk + 1, chunk_size - sizeof(*chunk));
 }
 
+static int ucs_mpool_chunk_compare(const void *elem1, const void *elem2)
+{
+    const ucs_mpool_chunk_t *chunk1 = *(ucs_mpool_chunk_t* const*)elem1;
+    const ucs_mpool_chunk_t *chunk2 = *(ucs_mpool_chunk_t* const*)elem2;
+
+    return (chunk1->elems < chunk2->elems) ? -1 :
+           (chunk1->elems > chunk2->elems) ?  1 : 0;
+}
+
+/* Find the chunk of an element, in an array of chunks sorted by address */
+static ucs_mpool_chunk_t *ucs_mpool_elem_chunk(ucs_mpool_data_t *data,
+                                               ucs_mpool_chunk_t **chunks,
+                                               unsigned num_chunks,
+                                               ucs_mpool_elem_t *elem)
+{
+    unsigned low = 0, high = num_chunks, mid;
+
+    while (high - low > 1) {
+        mid = (low + high) / 2;
+        if ((void*)elem < chunks[mid]->elems) {
+            high = mid;
+        } else {
+            low  = mid;
+        }
+    }
+
+    ucs_assertv(((void*)elem >= chunks[low]->elems) &&
+                ((void*)elem < (void*)ucs_mpool_chunk_elem(data, chunks[low],
+                                                    chunks[low]->num_elems)),
+                "mpool %s: element %p does not belong to any chunk",
+                data->name, elem);
+    return chunks[low];
+}
+
+unsigned ucs_mpool_shrink(ucs_mpool_t *mp, unsigned min_free_elems)
+{
+    ucs_mpool_data_t *data = mp->data;
+    ucs_mpool_chunk_t **chunks, *chunk, **chunk_p;
+    ucs_mpool_elem_t *elem, **elem_p, *tail, *next;
+    unsigned num_chunks, num_released, total_free, i;
+    void *obj;
+
+    if (mp->mt) {
+        ucs_mpool_reclaim(mp, 1);
+    }
+
+    num_chunks = 0;
+    for (chunk = data->chunks; chunk != NULL; chunk = chunk->next) {
+        ++num_chunks;
+    }
+
+    if (num_chunks == 0) {
+        return 0;
+    }
+
+    chunks = ucs_malloc(sizeof(*chunks) * num_chunks, "mpool_shrink_chunks");
+    if (chunks == NULL) {
+        ucs_error("mpool %s: failed to allocate chunks array",
+                  ucs_mpool_name(mp));
+        return 0;
+    }
+
+    i = 0;
+    for (chunk = data->chunks; chunk != NULL; chunk = chunk->next) {
+        chunk->num_free = 0;
+        chunks[i++]     = chunk;
+    }
+    qsort(chunks, num_chunks, sizeof(*chunks), ucs_mpool_chunk_compare);
+
+    /* Count the available elements of every chunk */
+    total_free = 0;
+    for (elem = mp->freelist; elem != NULL; elem = elem->next) {
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        ++ucs_mpool_elem_chunk(data, chunks, num_chunks, elem)->num_free;
+        ++total_free;
+    }
+
+    /* A chunk is released only if it was found free twice in a row, so it has
+     * been idle for at least the period between the calls */
+    num_released = 0;
+    for (i = 0; i < num_chunks; ++i) {
+        chunk = chunks[i];
+        if (chunk->num_free < chunk->num_elems) {
+            chunk->idle_count = 0;
+        } else if ((++chunk->idle_count > 1) &&
+                   ((total_free - chunk->num_elems) >= min_free_elems)) {
+            total_free     -= chunk->num_elems;
+            chunk->num_free = UINT_MAX; /* Mark for release */
+            ++num_released;
+        }
+    }
+
+    if (num_released == 0) {
+        goto out;
+    }
+
+    /* Remove the elements of released chunks from the freelist */
+    tail   = NULL;
+    elem_p = &mp->freelist;
+    while (*elem_p != NULL) {
+        elem  = *elem_p;
+        chunk = ucs_mpool_elem_chunk(data, chunks, num_chunks, elem);
+        if (chunk->num_free != UINT_MAX) {
+            tail   = elem;
+            elem_p = &elem->next;
+            continue;
+        }
+
+        *elem_p = elem->next;
+        if (data->ops->obj_cleanup != NULL) {
+            obj = elem + 1;
+            VALGRIND_MEMPOOL_ALLOC(mp, obj, data->elem_size - sizeof(ucs_mpool_elem_t));
+            VALGRIND_MAKE_MEM_DEFINED(obj, data->elem_size - sizeof(ucs_mpool_elem_t));
+            data->ops->obj_cleanup(mp, obj);
+            VALGRIND_MEMPOOL_FREE(mp, obj);
+        }
+    }
+    data->tail = tail;
+
+    chunk_p = &data->chunks;
+    while (*chunk_p != NULL) {
+        chunk = *chunk_p;
+        if (chunk->num_free != UINT_MAX) {
+            chunk_p = &chunk->next;
+            continue;
+        }
+
+        *chunk_p = chunk->next;
+        if (data->quota != UINT_MAX) {
+            data->quota += chunk->num_elems;
+        }
+
+        ucs_debug("mpool %s: releasing idle chunk %p with %u elements",
+                  ucs_mpool_name(mp), chunk, chunk->num_elems);
+        data->ops->chunk_release(mp, chunk);
+    }
+
+out:
+    for (elem = mp->freelist; elem != NULL; elem = next) {
+        next = elem->next;
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    }
+    ucs_free(chunks);
+    return num_released;
+}
+
 void *ucs_mpool_get_grow(ucs_mpool_t *mp)
 {
     ucs_mpool_data_t *data = mp->data;
 
+    /* Prefer recycling objects returned by other threads over allocating new
+     * ones. Partially filled magazines are drained only if the pool cannot
+     * grow, since each one requires an atomic operation. */
+    if (mp->mt && ucs_mpool_reclaim(mp, data->quota == 0)) {
+        return ucs_mpool_get(mp);
+    }
+
     ucs_mpool_grow(mp, data->elems_per_chunk);
     if (mp->freelist == NULL) {
         return NULL;
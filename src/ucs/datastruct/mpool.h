@@ -20,6 +20,7 @@ typedef union  ucs_mpool_elem    ucs_mpool_elem_t;
 typedef struct ucs_mpool         ucs_mpool_t;
 typedef struct ucs_mpool_data    ucs_mpool_data_t;
 typedef struct ucs_mpool_ops     ucs_mpool_ops_t;
+typedef struct ucs_mpool_magazine ucs_mpool_magazine_t;
 
 
 /**
@@ -55,6 +56,10 @@ struct ucs_mpool_chunk {
     ucs_mpool_chunk_t      *next;      /* Next chunk */
     void                   *elems;     /* Array of elements */
     unsigned               num_elems;  /* How many elements */
+    unsigned               num_free;   /* How many elements were in the pool,
+                                          as counted by the last shrink */
+    unsigned               idle_count; /* Number of consecutive shrinks which
+                                          found all elements in the pool */
 };
 
 
@@ -64,6 +69,8 @@ struct ucs_mpool_chunk {
 struct ucs_mpool {
     ucs_mpool_elem_t       *freelist;  /* List of available elements */
     ucs_mpool_data_t       *data;      /* Slow-path data */
+    int                    mt;         /* Whether objects are returned through
+                                          the thread-safe path */
 };
 
 
@@ -80,6 +87,12 @@ struct ucs_mpool_data {
     ucs_mpool_chunk_t      *chunks;         /* List of allocated chunks */
     ucs_mpool_ops_t        *ops;            /* Memory pool operations */
     char                   *name;           /* Name - used for debugging */
+    ucs_mpool_elem_t * volatile remote_free; /* Elements returned by
+                                                 ucs_mpool_put_mt(), not yet
+                                                 moved to the freelist */
+    ucs_mpool_magazine_t   *magazines;      /* Per-thread caches of returned
+                                               elements, NULL if not
+                                               thread-safe */
 };
 
 
@@ -206,6 +219,30 @@ void *ucs_mpool_get(ucs_mpool_t *mp);
 void ucs_mpool_put(void *obj);
 
 
+/**
+ * Allow returning objects to the memory pool from any thread, without external
+ * locking. Returned objects are batched in per-thread magazines, and full
+ * magazines are pushed to a lock-free list, which is moved to the freelist
+ * when the freelist runs empty. Getting objects from the pool must still be
+ * serialized by the caller. Must be called before any object is allocated.
+ *
+ * @param mp               Memory pool structure.
+ *
+ * @return UCS status code.
+ */
+ucs_status_t ucs_mpool_enable_mt(ucs_mpool_t *mp);
+
+
+/**
+ * Return an object to a thread-safe memory pool.
+ * Used internally by ucs_mpool_put().
+ *
+ * @param mp               Memory pool which owns the object.
+ * @param elem             Element header of the object.
+ */
+void ucs_mpool_put_mt(ucs_mpool_t *mp, ucs_mpool_elem_t *elem);
+
+
 /**
  * Grow the memory pool by a specified amount of elements.
  *
@@ -215,6 +252,24 @@ void ucs_mpool_put(void *obj);
 void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems);
 
 
+/**
+ * Release chunks whose elements have all been in the pool since the previous
+ * call to this function, as long as at least @a min_free_elems elements remain
+ * available. Calling it periodically releases the memory left over by bursts
+ * of allocations, after it has been idle for a whole period. Chunks are
+ * released by the chunk_release operation, and their elements are cleaned up
+ * by obj_cleanup. Released elements are returned to the pool quota.
+ *
+ * Must be called by the thread which gets objects from the pool.
+ *
+ * @param mp               Memory pool structure.
+ * @param min_free_elems   How many available elements to keep.
+ *
+ * @return Number of released chunks.
+ */
+unsigned ucs_mpool_shrink(ucs_mpool_t *mp, unsigned min_free_elems);
+
+
 /**
  * Allocate and object and grow the memory pool if necessary.
  * Used internally by ucs_mpool_get().
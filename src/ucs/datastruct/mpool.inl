@@ -76,6 +76,11 @@ static inline void ucs_mpool_put_inline(void *obj)
 
     elem = ucs_mpool_obj_to_elem(obj);
     mp   = elem->mpool;
+    if (ucs_unlikely(mp->mt)) {
+        ucs_mpool_put_mt(mp, elem);
+        return;
+    }
+
     ucs_mpool_add_to_freelist(mp, elem,
                               ENABLE_DEBUG_DATA && ucs_global_opts.mpool_fifo);
     VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
@@ -6,6 +6,7 @@
 
 
 #include <ucs/arch/atomic.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/type/class.h>
 #include <ucs/datastruct/queue.h>
 #include <ucs/debug/log.h>
@@ -40,6 +41,8 @@
 #define ucs_rcache_region_pfn(_region) \
     ((_region)->priv)
 
+#define UCS_RCACHE_TLS_CACHE_SIZE    4
+
 
 typedef struct ucs_rcache_inv_entry {
     ucs_queue_elem_t         queue;
@@ -48,6 +51,24 @@ typedef struct ucs_rcache_inv_entry {
 } ucs_rcache_inv_entry_t;
 
 
+/* Per-thread cache entry of the last region returned by ucs_rcache_get(). The
+ * entry is valid only while the generation number of the rcache is unchanged,
+ * which means the region was not removed from the page table since. */
+typedef struct ucs_rcache_tls_entry {
+    ucs_rcache_t             *rcache;
+    uint64_t                 gen;
+    ucs_rcache_region_t      *region;
+    ucs_pgt_addr_t           start;
+    ucs_pgt_addr_t           end;
+    int                      prot;
+} ucs_rcache_tls_entry_t;
+
+
+static __thread ucs_rcache_tls_entry_t ucs_rcache_tls_cache[UCS_RCACHE_TLS_CACHE_SIZE];
+static volatile uint64_t ucs_rcache_global_gen = 0;
+static volatile uint32_t ucs_rcache_global_tls_index = 0;
+
+
 #if ENABLE_STATS
 static ucs_stats_class_t ucs_rcache_stats_class = {
     .name = "rcache",
@@ -63,6 +84,7 @@ static ucs_stats_class_t ucs_rcache_stats_class = {
         [UCS_RCACHE_PUTS]               = "puts",
         [UCS_RCACHE_REGS]               = "mem_regs",
         [UCS_RCACHE_DEREGS]             = "mem_deregs",
+        [UCS_RCACHE_EVICTS]             = "regions_evicted",
     }
 };
 #endif
@@ -158,6 +180,58 @@ static ucs_mpool_ops_t ucs_rcache_mp_ops = {
     .obj_cleanup   = NULL
 };
 
+static ucs_mpool_ops_t ucs_rcache_region_mp_ops = {
+    .chunk_alloc   = ucs_mpool_chunk_malloc,
+    .chunk_release = ucs_mpool_chunk_free,
+    .obj_init      = NULL,
+    .obj_cleanup   = NULL
+};
+
+static UCS_F_ALWAYS_INLINE uint64_t ucs_rcache_next_gen()
+{
+    return ucs_atomic_fadd64(&ucs_rcache_global_gen, 1) + 1;
+}
+
+/* Invalidate the per-thread cache entries of the rcache. The full fence orders
+ * the new generation before a following check of a region reference count,
+ * because a lock-free get holds the region before it checks the generation. */
+static UCS_F_ALWAYS_INLINE void ucs_rcache_tls_invalidate(ucs_rcache_t *rcache)
+{
+    rcache->gen = ucs_rcache_next_gen();
+    ucs_memory_bus_fence();
+}
+
+/* Lock must be held, so the generation number does not change */
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_tls_update(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
+{
+    ucs_rcache_tls_entry_t *entry = &ucs_rcache_tls_cache[rcache->tls_index];
+
+    entry->rcache = rcache;
+    entry->gen    = rcache->gen;
+    entry->region = region;
+    entry->start  = region->super.start;
+    entry->end    = region->super.end;
+    entry->prot   = region->prot;
+}
+
+/* Increment the reference count, unless the region is already released */
+static UCS_F_ALWAYS_INLINE int
+ucs_rcache_region_try_hold(ucs_rcache_region_t *region)
+{
+    uint32_t refcount;
+
+    do {
+        refcount = region->refcount;
+        if (refcount == 0) {
+            return 0;
+        }
+    } while (ucs_atomic_cswap32(&region->refcount, refcount,
+                                refcount + 1) != refcount);
+
+    return 1;
+}
+
 /* Lock must be held for read */
 static void ucs_rcache_region_validate_pfn(ucs_rcache_t *rcache,
                                            ucs_rcache_region_t *region)
@@ -179,6 +253,48 @@ static void ucs_rcache_region_validate_pfn(ucs_rcache_t *rcache,
     }
 }
 
+static UCS_F_ALWAYS_INLINE int ucs_rcache_lru_is_enabled(ucs_rcache_t *rcache)
+{
+    return (rcache->params.max_regions != SIZE_MAX) ||
+           (rcache->params.max_size    != SIZE_MAX);
+}
+
+/* LRU lock must be held */
+static void ucs_rcache_lru_add_locked(ucs_rcache_t *rcache,
+                                      ucs_rcache_region_t *region)
+{
+    if (region->lru_flags & UCS_RCACHE_LRU_FLAG_IN_LRU) {
+        ucs_list_del(&region->lru_list);
+    }
+
+    ucs_list_add_tail(&rcache->lru_list, &region->lru_list);
+    region->lru_flags |= UCS_RCACHE_LRU_FLAG_IN_LRU;
+}
+
+/* LRU lock must be held */
+static void ucs_rcache_lru_remove_locked(ucs_rcache_region_t *region)
+{
+    if (region->lru_flags & UCS_RCACHE_LRU_FLAG_IN_LRU) {
+        ucs_list_del(&region->lru_list);
+        region->lru_flags &= ~UCS_RCACHE_LRU_FLAG_IN_LRU;
+    }
+}
+
+static void ucs_rcache_lru_remove(ucs_rcache_t *rcache,
+                                  ucs_rcache_region_t *region)
+{
+    /* The unlocked check may miss a concurrent insertion, in which case the
+     * region is dropped from the LRU later, when eviction finds it in use */
+    if (!ucs_rcache_lru_is_enabled(rcache) ||
+        !(region->lru_flags & UCS_RCACHE_LRU_FLAG_IN_LRU)) {
+        return;
+    }
+
+    ucs_spin_lock(&rcache->lru_lock);
+    ucs_rcache_lru_remove_locked(region);
+    ucs_spin_unlock(&rcache->lru_lock);
+}
+
 /* Lock must be held */
 static void ucs_rcache_region_collect_callback(const ucs_pgtable_t *pgtable,
                                                ucs_pgt_region_t *pgt_region, void *arg)
@@ -213,18 +329,33 @@ static void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
         }
     }
 
-    ucs_free(region);
+    ucs_mpool_put(region);
 }
 
 static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
                                                   ucs_rcache_region_t *region,
-                                                  int lock,
-                                                  int must_be_destroyed)
+                                                  int lock)
 {
+    uint32_t refcount;
+
     ucs_rcache_region_trace(rcache, region, lock ? "put" : "put_nolock");
 
     ucs_assert(region->refcount > 0);
-    if (ucs_unlikely(ucs_atomic_fadd32(&region->refcount, -1) == 1)) {
+    if (ucs_rcache_lru_is_enabled(rcache)) {
+        /* Decrement under the LRU lock, so the region could not be invalidated
+         * and released between dropping the last user reference and adding it
+         * to the LRU list */
+        ucs_spin_lock(&rcache->lru_lock);
+        refcount = ucs_atomic_fadd32(&region->refcount, -1);
+        if ((refcount == 2) && (region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE)) {
+            ucs_rcache_lru_add_locked(rcache, region);
+        }
+        ucs_spin_unlock(&rcache->lru_lock);
+    } else {
+        refcount = ucs_atomic_fadd32(&region->refcount, -1);
+    }
+
+    if (ucs_unlikely(refcount == 1)) {
         if (lock) {
             pthread_rwlock_wrlock(&rcache->lock);
         }
@@ -232,16 +363,13 @@ static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
         if (lock) {
             pthread_rwlock_unlock(&rcache->lock);
         }
-    } else {
-        ucs_assert(!must_be_destroyed);
     }
 }
 
 /* Lock must be held in write mode */
 static void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
                                          ucs_rcache_region_t *region,
-                                         int must_be_in_pgt,
-                                         int must_be_destroyed)
+                                         int must_be_in_pgt)
 {
     ucs_status_t status;
 
@@ -249,17 +377,24 @@ static void ucs_rcache_region_invalidate(ucs_rcache_t *rcache,
 
     /* Remove the memory region from page table, if it's there */
     if (region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE) {
+        /* Invalidate per-thread cache entries before the region could be
+         * released */
+        ucs_rcache_tls_invalidate(rcache);
+
         status = ucs_pgtable_remove(&rcache->pgtable, &region->super);
         if (status != UCS_OK) {
             ucs_rcache_region_warn(rcache, region, "failed to remove (%s)",
                                    ucs_status_string(status));
         }
         region->flags &= ~UCS_RCACHE_REGION_FLAG_PGTABLE;
+        ucs_rcache_lru_remove(rcache, region);
+        --rcache->num_regions;
+        rcache->total_size -= region->super.end - region->super.start;
     } else {
         ucs_assert(!must_be_in_pgt);
     }
 
-     ucs_rcache_region_put_internal(rcache, region, 0, must_be_destroyed);
+     ucs_rcache_region_put_internal(rcache, region, 0);
 }
 
 /* Lock must be held in write mode */
@@ -274,7 +409,7 @@ static void ucs_rcache_invalidate_range(ucs_rcache_t *rcache, ucs_pgt_addr_t sta
     ucs_rcache_find_regions(rcache, start, end - 1, &region_list);
     ucs_list_for_each_safe(region, tmp, &region_list, list) {
         /* all regions on the list are in the page table */
-        ucs_rcache_region_invalidate(rcache, region, 1, 0);
+        ucs_rcache_region_invalidate(rcache, region, 1);
         UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_UNMAP_INVALIDATES, 1);
     }
 }
@@ -367,6 +502,55 @@ static void ucs_rcache_purge(ucs_rcache_t *rcache)
         }
         ucs_mem_region_destroy_internal(rcache, region);
     }
+
+    ucs_list_head_init(&rcache->lru_list);
+    rcache->num_regions = 0;
+    rcache->total_size  = 0;
+}
+
+static inline int ucs_rcache_is_over_limit(ucs_rcache_t *rcache, size_t length)
+{
+    return (rcache->num_regions >= rcache->params.max_regions) ||
+           (rcache->total_size + length > rcache->params.max_size);
+}
+
+/* Evict unused regions, least recently used first, until there is room for
+ * a new region of the given length, or all of them if 'force' is set.
+ * Regions which are in use are never evicted, so the limits are soft.
+ * Lock must be held in write mode.
+ */
+static void ucs_rcache_lru_evict(ucs_rcache_t *rcache, size_t length, int force)
+{
+    ucs_rcache_region_t *region;
+
+    ucs_trace_func("rcache=%s, length=%zu, force=%d", rcache->name, length,
+                   force);
+
+    ucs_spin_lock(&rcache->lru_lock);
+    while (!ucs_list_is_empty(&rcache->lru_list) &&
+           (force || ucs_rcache_is_over_limit(rcache, length))) {
+        region = ucs_list_head(&rcache->lru_list, ucs_rcache_region_t,
+                               lru_list);
+        ucs_rcache_lru_remove_locked(region);
+
+        /* Stop lock-free gets of the region before checking it's unused. The
+         * region was taken by a get if it's still in use, and will be returned
+         * to the LRU list when it's released. */
+        ucs_rcache_tls_invalidate(rcache);
+        if (region->refcount > 1) {
+            continue;
+        }
+
+        /* Invalidation takes the LRU lock and may trigger memory events. A
+         * lock-free get which has failed may still hold the region for a short
+         * time, and then it's destroyed when that get releases it. */
+        ucs_spin_unlock(&rcache->lru_lock);
+        ucs_rcache_region_trace(rcache, region, "evict");
+        ucs_rcache_region_invalidate(rcache, region, 1);
+        UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_EVICTS, 1);
+        ucs_spin_lock(&rcache->lru_lock);
+    }
+    ucs_spin_unlock(&rcache->lru_lock);
 }
 
 static inline int ucs_rcache_region_test(ucs_rcache_region_t *region, int prot)
@@ -401,6 +585,7 @@ ucs_rcache_check_overlap(ucs_rcache_t *rcache, ucs_pgt_addr_t *start,
         {
             /* Found a region which contains the given address range */
             ucs_rcache_region_hold(rcache, region);
+            ucs_rcache_lru_remove(rcache, region);
             *region_p = region;
             return UCS_ERR_ALREADY_EXISTS;
         }
@@ -431,7 +616,7 @@ ucs_rcache_check_overlap(ucs_rcache_t *rcache, ucs_pgt_addr_t *start,
                  * region. However mem_reg still may be able to deal with it.
                  * Do the safest thing: invalidate cached region
                  */
-                ucs_rcache_region_invalidate(rcache, region, 1, 0);
+                ucs_rcache_region_invalidate(rcache, region, 1);
                 continue;
             } else if (ucs_test_all_flags(mem_prot, region->prot)) {
                 *prot |= region->prot;
@@ -445,7 +630,7 @@ ucs_rcache_check_overlap(ucs_rcache_t *rcache, ucs_pgt_addr_t *start,
                 ucs_rcache_region_trace(rcache, region,
                                         "do not merge mem "UCS_RCACHE_PROT_FMT" with",
                                         UCS_RCACHE_PROT_ARG(mem_prot));
-                ucs_rcache_region_invalidate(rcache, region, 1, 0);
+                ucs_rcache_region_invalidate(rcache, region, 1);
                 continue;
             }
         }
@@ -456,7 +641,7 @@ ucs_rcache_check_overlap(ucs_rcache_t *rcache, ucs_pgt_addr_t *start,
         *start  = ucs_min(*start, region->super.start);
         *end    = ucs_max(*end,   region->super.end);
         *merged = 1;
-        ucs_rcache_region_invalidate(rcache, region, 1, 0);
+        ucs_rcache_region_invalidate(rcache, region, 1);
     }
     return UCS_OK;
 }
@@ -468,12 +653,13 @@ ucs_rcache_create_region(ucs_rcache_t *rcache, void *address, size_t length,
     ucs_rcache_region_t *region;
     ucs_pgt_addr_t start, end;
     ucs_status_t status;
-    int error, merged;
+    int merged, evicted;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
     pthread_rwlock_wrlock(&rcache->lock);
+    evicted = 0;
 
 retry:
     /* Align to page size */
@@ -502,12 +688,13 @@ retry:
         goto out_unlock;
     }
 
+    if (ucs_rcache_lru_is_enabled(rcache)) {
+        ucs_rcache_lru_evict(rcache, end - start, 0);
+    }
+
     /* Allocate structure for new region */
-    error = ucs_posix_memalign((void **)&region,
-                               ucs_max(sizeof(void *), UCS_PGT_ENTRY_MIN_ALIGN),
-                               rcache->params.region_struct_size,
-                               "rcache_region");
-    if (error != 0) {
+    region = ucs_mpool_get(&rcache->region_mp);
+    if (region == NULL) {
         status = UCS_ERR_NO_MEMORY;
         goto out_unlock;
     }
@@ -520,10 +707,13 @@ retry:
     if (status != UCS_OK) {
         ucs_error("failed to insert region " UCS_PGT_REGION_FMT ": %s",
                   UCS_PGT_REGION_ARG(&region->super), ucs_status_string(status));
-        ucs_free(region);
+        ucs_mpool_put(region);
         goto out_unlock;
     }
 
+    ++rcache->num_regions;
+    rcache->total_size += end - start;
+
     /* If memory registration failed, keep the region and mark it as invalid,
      * to avoid numerous retries of registering the region.
      */
@@ -546,11 +736,29 @@ retry:
              */
             ucs_debug("failed to register merged region " UCS_PGT_REGION_FMT ": %s, retrying",
                       UCS_PGT_REGION_ARG(&region->super), ucs_status_string(status));
-            ucs_rcache_region_invalidate(rcache, region, 1, 1);
+            ucs_rcache_region_invalidate(rcache, region, 1);
+            goto retry;
+        } else if (ucs_rcache_lru_is_enabled(rcache) && !evicted &&
+                   !ucs_list_is_empty(&rcache->lru_list)) {
+            /* Registration may have failed because of pinned memory limits.
+             * Release all unused regions and retry once.
+             */
+            ucs_debug("failed to register region " UCS_PGT_REGION_FMT ": %s, "
+                      "evicting unused regions and retrying",
+                      UCS_PGT_REGION_ARG(&region->super), ucs_status_string(status));
+            ucs_rcache_region_invalidate(rcache, region, 1);
+            ucs_rcache_lru_evict(rcache, 0, 1);
+            evicted = 1;
             goto retry;
         } else {
             ucs_debug("failed to register region " UCS_PGT_REGION_FMT ": %s",
                       UCS_PGT_REGION_ARG(&region->super), ucs_status_string(status));
+            if (ucs_rcache_lru_is_enabled(rcache)) {
+                /* Keep the invalid region evictable */
+                ucs_spin_lock(&rcache->lru_lock);
+                ucs_rcache_lru_add_locked(rcache, region);
+                ucs_spin_unlock(&rcache->lru_lock);
+            }
             goto out_unlock;
         }
     }
@@ -569,6 +777,9 @@ retry:
     ucs_rcache_region_trace(rcache, region, "created");
 
 out_set_region:
+    if (status == UCS_OK) {
+        ucs_rcache_tls_update(rcache, region);
+    }
     *region_p = region;
 out_unlock:
     pthread_rwlock_unlock(&rcache->lock);
@@ -585,14 +796,45 @@ ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
                             int prot, void *arg, ucs_rcache_region_t **region_p)
 {
     ucs_pgt_addr_t start = (uintptr_t)address;
+    ucs_rcache_tls_entry_t *entry;
     ucs_pgt_region_t *pgt_region;
     ucs_rcache_region_t *region;
+    uint64_t gen;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    pthread_rwlock_rdlock(&rcache->lock);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
+
+    /* Lock-free lookup of the last region used by this thread. The region
+     * structure may be released and recycled concurrently, so hold it only if
+     * it's still referenced, and make sure the generation did not change.
+     * The pfn check needs the lock, so it's done only by the locked lookup. */
+    entry = &ucs_rcache_tls_cache[rcache->tls_index];
+    gen   = rcache->gen;
+    ucs_memory_cpu_load_fence();
+    if (!ucs_global_opts.rcache_check_pfn &&
+        (entry->rcache == rcache) && (entry->gen == gen) &&
+        (start >= entry->start) && ((start + length) <= entry->end) &&
+        ucs_test_all_flags(entry->prot, prot) &&
+        ucs_queue_is_empty(&rcache->inv_q))
+    {
+        region = entry->region;
+        if (ucs_likely(ucs_rcache_region_try_hold(region))) {
+            ucs_memory_cpu_load_fence();
+            if (ucs_likely(rcache->gen == gen)) {
+                ucs_rcache_region_trace(rcache, region, "hold");
+                ucs_rcache_lru_remove(rcache, region);
+                *region_p = region;
+                UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
+                return UCS_OK;
+            }
+
+            ucs_rcache_region_put_internal(rcache, region, 1);
+        }
+    }
+
+    pthread_rwlock_rdlock(&rcache->lock);
     if (ucs_queue_is_empty(&rcache->inv_q)) {
         pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable,
                                       start);
@@ -602,7 +844,9 @@ ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
                 ucs_rcache_region_test(region, prot))
             {
                 ucs_rcache_region_hold(rcache, region);
+                ucs_rcache_lru_remove(rcache, region);
                 ucs_rcache_region_validate_pfn(rcache, region);
+                ucs_rcache_tls_update(rcache, region);
                 *region_p = region;
                 UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
                 pthread_rwlock_unlock(&rcache->lock);
@@ -623,7 +867,7 @@ ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
 
 void ucs_rcache_region_put(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
 {
-    ucs_rcache_region_put_internal(rcache, region, 1, 0);
+    ucs_rcache_region_put_internal(rcache, region, 1);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_PUTS, 1);
 }
 
@@ -638,6 +882,14 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err;
     }
 
+    if ((params->max_regions == 0) || (params->max_size == 0)) {
+        ucs_error("invalid regcache limits: max_regions (%zu) and max_size "
+                  "(%zu) must be nonzero", params->max_regions,
+                  params->max_size);
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     if (!ucs_is_pow2(params->alignment) ||
         (params->alignment < UCS_PGT_ADDR_ALIGN) ||
         (params->alignment > params->max_alignment))
@@ -675,10 +927,15 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err_destroy_rwlock;
     }
 
+    status = ucs_spinlock_init(&self->lru_lock);
+    if (status != UCS_OK) {
+        goto err_destroy_inv_q_lock;
+    }
+
     status = ucs_pgtable_init(&self->pgtable, ucs_rcache_pgt_dir_alloc,
                               ucs_rcache_pgt_dir_release);
     if (status != UCS_OK) {
-        goto err_destroy_inv_q_lock;
+        goto err_destroy_lru_lock;
     }
 
     status = ucs_mpool_init(&self->inv_mp, 0, sizeof(ucs_rcache_inv_entry_t), 0,
@@ -687,20 +944,41 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err_cleanup_pgtable;
     }
 
+    status = ucs_mpool_init(&self->region_mp, 0, params->region_struct_size,
+                            0, ucs_max(sizeof(void *), UCS_PGT_ENTRY_MIN_ALIGN),
+                            128, UINT_MAX, &ucs_rcache_region_mp_ops,
+                            "rcache_region_mp");
+    if (status != UCS_OK) {
+        goto err_destroy_mp;
+    }
+
     ucs_queue_head_init(&self->inv_q);
+    ucs_list_head_init(&self->lru_list);
+    self->gen         = ucs_rcache_next_gen();
+    self->tls_index   = ucs_atomic_fadd32(&ucs_rcache_global_tls_index, 1) %
+                        UCS_RCACHE_TLS_CACHE_SIZE;
+    self->num_regions = 0;
+    self->total_size  = 0;
 
     status = ucm_set_event_handler(params->ucm_events, params->ucm_event_priority,
                                    ucs_rcache_unmapped_callback, self);
     if (status != UCS_OK) {
-        goto err_destroy_mp;
+        goto err_destroy_region_mp;
     }
 
     return UCS_OK;
 
+err_destroy_region_mp:
+    ucs_mpool_cleanup(&self->region_mp, 1);
 err_destroy_mp:
     ucs_mpool_cleanup(&self->inv_mp, 1);
 err_cleanup_pgtable:
     ucs_pgtable_cleanup(&self->pgtable);
+err_destroy_lru_lock:
+    spinlock_status = ucs_spinlock_destroy(&self->lru_lock);
+    if (spinlock_status != UCS_OK) {
+        ucs_warn("ucs_spinlock_destroy() failed (%d)", spinlock_status);
+    }
 err_destroy_inv_q_lock:
     spinlock_status = ucs_spinlock_destroy(&self->inv_lock);
     if (spinlock_status != UCS_OK) {
@@ -725,8 +1003,13 @@ static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
     ucs_rcache_check_inv_queue(self);
     ucs_rcache_purge(self);
 
+    ucs_mpool_cleanup(&self->region_mp, 1);
     ucs_mpool_cleanup(&self->inv_mp, 1);
     ucs_pgtable_cleanup(&self->pgtable);
+    status = ucs_spinlock_destroy(&self->lru_lock);
+    if (status != UCS_OK) {
+        ucs_warn("ucs_spinlock_destroy() failed (%d)", status);
+    }
     status = ucs_spinlock_destroy(&self->inv_lock);
     if (status != UCS_OK) {
         ucs_warn("ucs_spinlock_destroy() failed (%d)", status);
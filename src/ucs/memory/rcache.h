@@ -39,6 +39,13 @@ enum {
     UCS_RCACHE_REGION_FLAG_PGTABLE    = UCS_BIT(1)  /**< In the page table */
 };
 
+/*
+ * Memory region LRU flags.
+ */
+enum {
+    UCS_RCACHE_LRU_FLAG_IN_LRU        = UCS_BIT(0)  /**< In the LRU list */
+};
+
 /*
  * Memory registration flags.
  */
@@ -113,16 +120,24 @@ struct ucs_rcache_params {
     const ucs_rcache_ops_t *ops;                /**< Memory operations functions */
     void                   *context;            /**< User-defined context that will
                                                      be passed to mem_reg/mem_dereg */
+    size_t                 max_regions;         /**< Maximal number of regions to keep
+                                                     in the cache, or SIZE_MAX for
+                                                     unlimited */
+    size_t                 max_size;            /**< Maximal total size of cached
+                                                     regions, or SIZE_MAX for
+                                                     unlimited */
 };
 
 
 struct ucs_rcache_region {
     ucs_pgt_region_t       super;    /**< Base class - page table region */
     ucs_list_link_t        list;     /**< List element */
+    ucs_list_link_t        lru_list; /**< LRU list element */
     volatile uint32_t      refcount; /**< Reference count, including +1 if it's
                                           in the page table */
     ucs_status_t           status;   /**< Current status code */
     uint8_t                prot;     /**< Protection bits */
+    uint8_t                lru_flags;/**< LRU flags. Protected by LRU lock. */
     uint16_t               flags;    /**< Status flags. Protected by page table lock. */
     uint64_t               priv;     /**< Used internally */
 };
@@ -150,6 +165,8 @@ void ucs_rcache_destroy(ucs_rcache_t *rcache);
 
 /**
  * Resolve buffer in the registration cache, or register it if not found.
+ * If the cache has capacity limits and registering a new region would exceed
+ * them, least recently used regions which are not in use are evicted first.
  * TODO register after N usages.
  *
  * @param [in]  rcache      Memory registration cache.
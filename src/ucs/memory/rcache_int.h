@@ -22,6 +22,8 @@ enum {
     UCS_RCACHE_PUTS,                /* number of put operations */
     UCS_RCACHE_REGS,                /* number of memory registrations */
     UCS_RCACHE_DEREGS,              /* number of memory deregistrations */
+    UCS_RCACHE_EVICTS,              /* number of unused regions evicted because
+                                       of capacity limits or memory pressure */
     UCS_RCACHE_STAT_LAST
 };
 
@@ -42,6 +44,23 @@ struct ucs_rcache {
                                           since we cannot use regulat malloc().
                                           The backing storage is original mmap()
                                           which does not generate memory events */
+    ucs_spinlock_t         lru_lock; /**< Lock for the LRU list. This is a
+                                          separate lock because regions are
+                                          released without taking the page table
+                                          lock */
+    ucs_list_link_t        lru_list; /**< Regions which are held only by the page
+                                          table, least recently used first */
+    ucs_mpool_t            region_mp; /**< Memory pool for region structures.
+                                           Released regions are recycled rather
+                                           than freed, so a lock-free lookup
+                                           may safely access a stale region */
+    volatile uint64_t      gen;      /**< Generation number, globally unique,
+                                          changed whenever a region is removed
+                                          from the page table */
+    unsigned               tls_index;/**< Index in the per-thread cache */
+    size_t                 num_regions; /**< Number of regions in the page table */
+    size_t                 total_size;  /**< Total size of regions in the page
+                                             table */
     char                   *name;
     UCS_STATS_NODE_DECLARE(stats);
 };
@@ -5,6 +5,10 @@
 * See file LICENSE for terms.
 */
 
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
 #include <ucs/debug/log.h>
 #include <ucs/debug/assert.h>
 #include <ucs/sys/string.h>
@@ -21,6 +25,9 @@
 #define __need_IOV_MAX
 #endif
 #include <limits.h>
+#if HAVE_DECL_MSG_ZEROCOPY
+#include <linux/errqueue.h>
+#endif
 
 
 #define UCS_SOCKET_MAX_CONN_PATH "/proc/sys/net/core/somaxconn"
@@ -273,7 +280,7 @@ ucs_socket_do_io_b(int fd, void *data, size_t length,
 
 static inline ucs_status_t
 ucs_socket_do_iov_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p,
-                     ucs_socket_iov_func_t iov_func, const char *name,
+                     int flags, ucs_socket_iov_func_t iov_func, const char *name,
                      ucs_socket_io_err_cb_t err_cb, void *err_cb_arg)
 {
     struct msghdr msg = {
@@ -284,7 +291,7 @@ ucs_socket_do_iov_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p
 
     ucs_assert(iov_cnt > 0);
 
-    ret = iov_func(fd, &msg, MSG_NOSIGNAL);
+    ret = iov_func(fd, &msg, MSG_NOSIGNAL | flags);
     if (ucs_likely(ret > 0)) {
         *length_p = ret;
         return UCS_OK;
@@ -333,10 +340,96 @@ ucs_status_t
 ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p,
                     ucs_socket_io_err_cb_t err_cb, void *err_cb_arg)
 {
-    return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, sendmsg,
+    return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, 0, sendmsg,
                                 "sendv", err_cb, err_cb_arg);
 }
 
+ucs_status_t
+ucs_socket_sendv_zcopy_nb(int fd, struct iovec *iov, size_t iov_cnt,
+                          size_t *length_p, ucs_socket_io_err_cb_t err_cb,
+                          void *err_cb_arg)
+{
+#if HAVE_DECL_MSG_ZEROCOPY
+    struct msghdr msg = {
+        .msg_iov    = iov,
+        .msg_iovlen = iov_cnt
+    };
+    ssize_t ret;
+
+    ucs_assert(iov_cnt > 0);
+
+    ret = sendmsg(fd, &msg, MSG_NOSIGNAL | MSG_ZEROCOPY);
+    if (ucs_likely(ret > 0)) {
+        *length_p = ret;
+        return UCS_OK;
+    }
+
+    *length_p = 0;
+    if ((ret < 0) && (errno == ENOBUFS)) {
+        /* The socket is out of option memory, which holds the completion
+         * notifications that were not read from the error queue yet */
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    return ucs_socket_handle_io_error(fd, "sendv_zcopy", ret, errno,
+                                      err_cb, err_cb_arg);
+#else
+    *length_p = 0;
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
+ucs_status_t ucs_socket_zcopy_completion(int fd, uint32_t *first_sn_p,
+                                         uint32_t *last_sn_p)
+{
+#if HAVE_DECL_MSG_ZEROCOPY
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err)) +
+                 CMSG_SPACE(sizeof(struct sockaddr_storage))];
+    struct msghdr msg = {
+        .msg_control    = control,
+        .msg_controllen = sizeof(control)
+    };
+    struct sock_extended_err *serr;
+    struct cmsghdr *cmsg;
+    ssize_t ret;
+
+    ret = recvmsg(fd, &msg, MSG_ERRQUEUE);
+    if (ret < 0) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return UCS_ERR_NO_PROGRESS;
+        }
+
+        ucs_error("recvmsg(fd=%d, MSG_ERRQUEUE) failed: %m", fd);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (!(((cmsg->cmsg_level == SOL_IP) &&
+               (cmsg->cmsg_type == IP_RECVERR)) ||
+              ((cmsg->cmsg_level == SOL_IPV6) &&
+               (cmsg->cmsg_type == IPV6_RECVERR)))) {
+            continue;
+        }
+
+        serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+        if ((serr->ee_errno != 0) ||
+            (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)) {
+            continue;
+        }
+
+        *first_sn_p = serr->ee_info;
+        *last_sn_p  = serr->ee_data;
+        return UCS_OK;
+    }
+
+    /* Not a zero-copy completion, e.g. ICMP error notification */
+    return UCS_ERR_NO_MESSAGE;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 ucs_status_t ucs_sockaddr_sizeof(const struct sockaddr *addr, size_t *size_p)
 {
     switch (addr->sa_family) {
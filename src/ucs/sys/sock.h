@@ -219,6 +219,53 @@ ucs_status_t ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt,
                                  void *err_cb_arg);
 
 
+/**
+ * Non-blocking zero-copy send operation sends I/O vector on the connected
+ * socket referred to by the file descriptor `fd` using MSG_ZEROCOPY flag.
+ * The socket must have SO_ZEROCOPY option enabled. Each successful call
+ * is assigned a sequence number (starting from 0), and the buffers must not
+ * be modified until the kernel reports completion of this sequence number
+ * (see @ref ucs_socket_zcopy_completion).
+ *
+ * @param [in]      fd              Socket fd.
+ * @param [in]      iov             A pointer to an array of iovec buffers.
+ * @param [in]      iov_cnt         The number of buffers pointed to by
+ *                                  the iov parameter.
+ * @param [out]     length_p        The amount of data transmitted is written to
+ *                                  this argument.
+ * @param [in]      err_cb          Error callback.
+ * @param [in]      err_cb_arg      User's argument for the error callback.
+ *
+ * @return UCS_OK on success, UCS_ERR_CANCELED if connection closed,
+ *         UCS_ERR_NO_PROGRESS if system call was interrupted or
+ *         would block, UCS_ERR_NO_RESOURCE if the kernel has no memory
+ *         for more completion notifications until the reported ones are
+ *         read (ENOBUFS), UCS_ERR_UNSUPPORTED if MSG_ZEROCOPY is not
+ *         supported, UCS_ERR_IO_ERROR on failure.
+ */
+ucs_status_t ucs_socket_sendv_zcopy_nb(int fd, struct iovec *iov,
+                                       size_t iov_cnt, size_t *length_p,
+                                       ucs_socket_io_err_cb_t err_cb,
+                                       void *err_cb_arg);
+
+
+/**
+ * Read a completion notification of zero-copy send operations from the error
+ * queue of the socket referred to by the file descriptor `fd`.
+ *
+ * @param [in]      fd              Socket fd.
+ * @param [out]     first_sn_p      Sequence number of the first completed send.
+ * @param [out]     last_sn_p       Sequence number of the last completed send.
+ *
+ * @return UCS_OK if a completion was read, UCS_ERR_NO_PROGRESS if the error
+ *         queue is empty, UCS_ERR_NO_MESSAGE if another notification was read
+ *         from the error queue, UCS_ERR_UNSUPPORTED if MSG_ZEROCOPY is not
+ *         supported, UCS_ERR_IO_ERROR on failure.
+ */
+ucs_status_t ucs_socket_zcopy_completion(int fd, uint32_t *first_sn_p,
+                                         uint32_t *last_sn_p);
+
+
 /**
  * Blocking receive operation receives data from the connected (or bound
  * connectionless) socket referred to by the file descriptor `fd`.
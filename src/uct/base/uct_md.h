@@ -18,6 +18,8 @@ typedef struct uct_md_rcache_config {
     size_t               alignment;    /**< Force address alignment */
     unsigned             event_prio;   /**< Memory events priority */
     double               overhead;     /**< Lookup overhead estimation */
+    size_t               max_regions;  /**< Maximal number of cached regions */
+    size_t               max_size;     /**< Maximal total size of cached regions */
 } uct_md_rcache_config_t;
 
 extern ucs_config_field_t uct_md_config_rcache_table[];
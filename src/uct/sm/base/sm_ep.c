@@ -8,6 +8,7 @@
 #endif
 
 #include "sm_ep.h"
+#include "sm_iface.h"
 
 #include <ucs/arch/atomic.h>
 
@@ -58,6 +59,56 @@ ucs_status_t uct_sm_ep_get_bcopy(uct_ep_h tl_ep, uct_unpack_callback_t unpack_cb
     return UCS_OK;
 }
 
+static UCS_F_ALWAYS_INLINE size_t
+uct_sm_ep_iov_copy(const uct_iov_t *iov, size_t iovcnt, void *remote_ptr,
+                   int is_put)
+{
+    size_t offset = 0;
+    size_t iov_it, iov_length;
+
+    for (iov_it = 0; iov_it < iovcnt; ++iov_it) {
+        iov_length = uct_iov_get_length(&iov[iov_it]);
+        if (is_put) {
+            memcpy(UCS_PTR_BYTE_OFFSET(remote_ptr, offset), iov[iov_it].buffer,
+                   iov_length);
+        } else {
+            memcpy(iov[iov_it].buffer, UCS_PTR_BYTE_OFFSET(remote_ptr, offset),
+                   iov_length);
+        }
+        offset += iov_length;
+    }
+
+    return offset;
+}
+
+ucs_status_t uct_sm_ep_put_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
+                                 size_t iovcnt, uint64_t remote_addr,
+                                 uct_rkey_t rkey, uct_completion_t *comp)
+{
+    size_t length;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, uct_sm_get_max_iov(), "uct_sm_ep_put_zcopy");
+
+    length = uct_sm_ep_iov_copy(iov, iovcnt, (void *)(rkey + remote_addr), 1);
+    uct_sm_ep_trace_data(remote_addr, rkey, "PUT_ZCOPY [length %zu]", length);
+    UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), PUT, ZCOPY, length);
+    return UCS_OK;
+}
+
+ucs_status_t uct_sm_ep_get_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
+                                 size_t iovcnt, uint64_t remote_addr,
+                                 uct_rkey_t rkey, uct_completion_t *comp)
+{
+    size_t length;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, uct_sm_get_max_iov(), "uct_sm_ep_get_zcopy");
+
+    length = uct_sm_ep_iov_copy(iov, iovcnt, (void *)(rkey + remote_addr), 0);
+    uct_sm_ep_trace_data(remote_addr, rkey, "GET_ZCOPY [length %zu]", length);
+    UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), GET, ZCOPY, length);
+    return UCS_OK;
+}
+
 ucs_status_t uct_sm_ep_atomic32_post(uct_ep_h ep, unsigned opcode, uint32_t value,
                                      uint64_t remote_addr, uct_rkey_t rkey)
 {
@@ -41,6 +41,68 @@ UCS_CLASS_DEFINE_DELETE_FUNC(uct_cma_ep_t, uct_ep_t);
      ucs_trace_data(_fmt " to %"PRIx64"(%+ld)", ## __VA_ARGS__, (_remote_addr), \
                     (_rkey))
 
+/* Split the operation to segments to be copied by the iface copy threads */
+static ucs_status_t uct_cma_ep_async_zcopy(uct_cma_ep_t *ep,
+                                           uct_cma_iface_t *iface,
+                                           const uct_iov_t *iov, size_t iovcnt,
+                                           uint64_t remote_addr, size_t length,
+                                           uct_completion_t *comp,
+                                           uct_cma_copy_func_t fn_p,
+                                           const char *fn_name)
+{
+    size_t seg_size = iface->async.seg_size;
+    unsigned num_segs, seg_idx;
+    uct_cma_copy_seg_t *segs, *seg;
+    uct_cma_copy_op_t *op;
+    size_t iov_it, iov_offset, offset, seg_left, elem_length;
+
+    num_segs = ucs_div_round_up(length, seg_size);
+    op       = ucs_malloc(sizeof(*op) + (sizeof(*segs) * num_segs),
+                          "cma_copy_op");
+    if (op == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    op->comp       = comp;
+    op->remote_pid = ep->remote_pid;
+    op->func       = fn_p;
+    op->func_name  = fn_name;
+    segs           = (uct_cma_copy_seg_t*)(op + 1);
+
+    iov_it     = 0;
+    iov_offset = 0;
+    offset     = 0;
+    for (seg_idx = 0; seg_idx < num_segs; ++seg_idx) {
+        seg                      = &segs[seg_idx];
+        seg_left                 = ucs_min(seg_size, length - offset);
+        seg->remote_iov.iov_base = (void*)(remote_addr + offset);
+        seg->remote_iov.iov_len  = seg_left;
+        seg->iovcnt              = 0;
+        offset                  += seg_left;
+
+        while (seg_left > 0) {
+            ucs_assert(iov_it < iovcnt);
+            elem_length = uct_iov_get_length(iov + iov_it);
+            if (iov_offset == elem_length) {
+                ++iov_it;
+                iov_offset = 0;
+                continue;
+            }
+
+            elem_length = ucs_min(elem_length - iov_offset, seg_left);
+            seg->local_iov[seg->iovcnt].iov_base =
+                    UCS_PTR_BYTE_OFFSET(iov[iov_it].buffer, iov_offset);
+            seg->local_iov[seg->iovcnt].iov_len  = elem_length;
+            ++seg->iovcnt;
+            iov_offset += elem_length;
+            seg_left   -= elem_length;
+        }
+    }
+
+    uct_cma_iface_post_op(iface, op, segs, num_segs);
+    return UCS_INPROGRESS;
+}
+
 static UCS_F_ALWAYS_INLINE
 ucs_status_t uct_cma_ep_common_zcopy(uct_ep_h tl_ep,
                                      const uct_iov_t *iov,
@@ -66,6 +128,22 @@ ucs_status_t uct_cma_ep_common_zcopy(uct_ep_h tl_ep,
     struct iovec local_iov[UCT_SM_MAX_IOV];
     struct iovec remote_iov;
     uct_cma_ep_t *ep = ucs_derived_of(tl_ep, uct_cma_ep_t);
+    uct_cma_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_cma_iface_t);
+    ucs_status_t status;
+
+    if ((iface->async.num_threads > 0) && (comp != NULL)) {
+        length = uct_iov_total_length(iov, iovcnt);
+        if ((length > 0) && (length >= iface->async.thresh)) {
+            status = uct_cma_ep_async_zcopy(ep, iface, iov, iovcnt,
+                                            remote_addr, length, comp, fn_p,
+                                            fn_name);
+            if (status != UCS_ERR_NO_MEMORY) {
+                return status;
+            }
+            /* Fall back to synchronous copy */
+        }
+        length = 0;
+    }
 
     do {
         iov_it_length = 0;
@@ -161,3 +239,25 @@ ucs_status_t uct_cma_ep_get_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov, size_t i
                        uct_iov_total_length(iov, iovcnt));
     return ret;
 }
+
+ucs_status_t uct_cma_ep_flush(uct_ep_h tl_ep, unsigned flags,
+                              uct_completion_t *comp)
+{
+    uct_cma_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_cma_iface_t);
+    ucs_status_t status;
+
+    /* Outstanding operations are tracked per iface */
+    status = uct_cma_iface_flush_async(iface, comp);
+    if (status == UCS_OK) {
+        UCT_TL_EP_STAT_FLUSH(ucs_derived_of(tl_ep, uct_base_ep_t));
+    } else if (status == UCS_INPROGRESS) {
+        UCT_TL_EP_STAT_FLUSH_WAIT(ucs_derived_of(tl_ep, uct_base_ep_t));
+    }
+    return status;
+}
+
+ucs_status_t uct_cma_ep_fence(uct_ep_h tl_ep, unsigned flags)
+{
+    uct_cma_iface_fence_async(ucs_derived_of(tl_ep->iface, uct_cma_iface_t));
+    return uct_sm_ep_fence(tl_ep, flags);
+}
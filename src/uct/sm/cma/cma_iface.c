@@ -9,7 +9,10 @@
 #include "cma_ep.h"
 
 #include <uct/base/uct_md.h>
+#include <ucs/arch/atomic.h>
+#include <ucs/sys/iovec.h>
 #include <ucs/sys/string.h>
+#include <sched.h>
 
 
 static ucs_config_field_t uct_cma_iface_config_table[] = {
@@ -17,6 +20,22 @@ static ucs_config_field_t uct_cma_iface_config_table[] = {
     ucs_offsetof(uct_cma_iface_config_t, super),
     UCS_CONFIG_TYPE_TABLE(uct_sm_iface_config_table)},
 
+    {"ASYNC_COPY_THREADS", "0",
+     "Number of threads which copy the data of large put/get zcopy operations in\n"
+     "the background. Such operations are split to segments which are copied in\n"
+     "parallel, and completed from progress. 0 performs all copies synchronously\n"
+     "by the calling thread.",
+     ucs_offsetof(uct_cma_iface_config_t, async.num_threads), UCS_CONFIG_TYPE_UINT},
+
+    {"ASYNC_COPY_THRESH", "1m",
+     "Minimal length of a put/get zcopy operation which is copied by the copy threads.",
+     ucs_offsetof(uct_cma_iface_config_t, async.thresh), UCS_CONFIG_TYPE_MEMUNITS},
+
+    {"ASYNC_COPY_SEG_SIZE", "256k",
+     "Size of the segments which an operation is split to, to be copied by the\n"
+     "copy threads.",
+     ucs_offsetof(uct_cma_iface_config_t, async.seg_size), UCS_CONFIG_TYPE_MEMUNITS},
+
     {NULL}
 };
 
@@ -68,22 +87,224 @@ static ucs_status_t uct_cma_iface_query(uct_iface_h tl_iface,
     return UCS_OK;
 }
 
+static void uct_cma_iface_copy_seg(uct_cma_copy_seg_t *seg)
+{
+    uct_cma_copy_op_t *op = seg->op;
+    uct_cma_iface_t *iface = op->iface;
+    size_t length          = seg->remote_iov.iov_len;
+    size_t iov_idx         = 0;
+    ssize_t ret;
+
+    while (length > 0) {
+        ret = op->func(op->remote_pid, seg->local_iov + iov_idx,
+                       seg->iovcnt - iov_idx, &seg->remote_iov, 1, 0);
+        if (ret < 0) {
+            ucs_error("%s failed to copy %zu bytes to %p: %m", op->func_name,
+                      length, seg->remote_iov.iov_base);
+            op->status = UCS_ERR_IO_ERROR;
+            break;
+        }
+
+        length                 -= ret;
+        seg->remote_iov.iov_len = length;
+        seg->remote_iov.iov_base = UCS_PTR_BYTE_OFFSET(seg->remote_iov.iov_base,
+                                                       ret);
+        if (length > 0) {
+            ucs_iov_advance(seg->local_iov, seg->iovcnt, &iov_idx, ret);
+        }
+    }
+
+    if (ucs_atomic_fadd32(&op->segs_left, -1) != 1) {
+        return;
+    }
+
+    /* Last segment of the operation */
+    ucs_spin_lock(&iface->async.done_lock);
+    ucs_queue_push(&iface->async.done, &op->queue);
+    ucs_spin_unlock(&iface->async.done_lock);
+    ucs_atomic_add32(&iface->async.num_copying, -1);
+}
+
+static void *uct_cma_iface_copy_thread(void *arg)
+{
+    uct_cma_iface_t *iface = arg;
+    uct_cma_copy_seg_t *seg;
+
+    pthread_mutex_lock(&iface->async.lock);
+    for (;;) {
+        while (ucs_queue_is_empty(&iface->async.segs) && !iface->async.stop) {
+            pthread_cond_wait(&iface->async.cond, &iface->async.lock);
+        }
+
+        /* Posted segments are copied before exiting */
+        if (ucs_queue_is_empty(&iface->async.segs)) {
+            break;
+        }
+
+        seg = ucs_queue_pull_elem_non_empty(&iface->async.segs,
+                                            uct_cma_copy_seg_t, queue);
+        pthread_mutex_unlock(&iface->async.lock);
+        uct_cma_iface_copy_seg(seg);
+        pthread_mutex_lock(&iface->async.lock);
+    }
+    pthread_mutex_unlock(&iface->async.lock);
+
+    return NULL;
+}
+
+void uct_cma_iface_post_op(uct_cma_iface_t *iface, uct_cma_copy_op_t *op,
+                           uct_cma_copy_seg_t *segs, unsigned num_segs)
+{
+    unsigned i;
+
+    ucs_assert(num_segs > 0);
+
+    op->iface     = iface;
+    op->segs_left = num_segs;
+    op->status    = UCS_OK;
+
+    ++iface->async.num_outstanding;
+    ucs_atomic_add32(&iface->async.num_copying, 1);
+
+    pthread_mutex_lock(&iface->async.lock);
+    for (i = 0; i < num_segs; ++i) {
+        segs[i].op = op;
+        ucs_queue_push(&iface->async.segs, &segs[i].queue);
+    }
+    pthread_cond_broadcast(&iface->async.cond);
+    pthread_mutex_unlock(&iface->async.lock);
+}
+
+ucs_status_t uct_cma_iface_flush_async(uct_cma_iface_t *iface,
+                                       uct_completion_t *comp)
+{
+    uct_cma_flush_comp_t *flush_comp;
+
+    if (iface->async.num_outstanding == 0) {
+        return UCS_OK;
+    }
+
+    if (comp != NULL) {
+        flush_comp = ucs_malloc(sizeof(*flush_comp), "cma_flush_comp");
+        if (flush_comp == NULL) {
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        flush_comp->comp = comp;
+        ucs_queue_push(&iface->async.flush_comps, &flush_comp->queue);
+    }
+
+    return UCS_INPROGRESS;
+}
+
+void uct_cma_iface_fence_async(uct_cma_iface_t *iface)
+{
+    /* Wait for the copy threads to finish operations posted before the fence,
+     * so following operations would not overtake them */
+    while (iface->async.num_copying > 0) {
+        sched_yield();
+    }
+}
+
+static ucs_status_t uct_cma_iface_flush(uct_iface_h tl_iface, unsigned flags,
+                                        uct_completion_t *comp)
+{
+    uct_cma_iface_t *iface = ucs_derived_of(tl_iface, uct_cma_iface_t);
+    ucs_status_t status;
+
+    status = uct_cma_iface_flush_async(iface, comp);
+    if (status == UCS_OK) {
+        UCT_TL_IFACE_STAT_FLUSH(&iface->super.super);
+    } else if (status == UCS_INPROGRESS) {
+        UCT_TL_IFACE_STAT_FLUSH_WAIT(&iface->super.super);
+    }
+    return status;
+}
+
+static ucs_status_t uct_cma_iface_fence(uct_iface_h tl_iface, unsigned flags)
+{
+    uct_cma_iface_fence_async(ucs_derived_of(tl_iface, uct_cma_iface_t));
+    return uct_sm_iface_fence(tl_iface, flags);
+}
+
+static unsigned uct_cma_iface_progress(uct_iface_h tl_iface)
+{
+    uct_cma_iface_t *iface = ucs_derived_of(tl_iface, uct_cma_iface_t);
+    uct_cma_flush_comp_t *flush_comp;
+    uct_cma_copy_op_t *op;
+    ucs_queue_head_t done;
+    unsigned count;
+
+    if (ucs_likely(iface->async.num_outstanding == 0)) {
+        return 0;
+    }
+
+    ucs_queue_head_init(&done);
+    ucs_spin_lock(&iface->async.done_lock);
+    ucs_queue_splice(&done, &iface->async.done);
+    ucs_spin_unlock(&iface->async.done_lock);
+
+    count = 0;
+    ucs_queue_for_each_extract(op, &done, queue, 1) {
+        uct_invoke_completion(op->comp, op->status);
+        ucs_free(op);
+        --iface->async.num_outstanding;
+        ++count;
+    }
+
+    if (iface->async.num_outstanding == 0) {
+        ucs_queue_for_each_extract(flush_comp, &iface->async.flush_comps,
+                                   queue, 1) {
+            uct_invoke_completion(flush_comp->comp, UCS_OK);
+            ucs_free(flush_comp);
+        }
+    }
+
+    return count;
+}
+
+static void uct_cma_iface_progress_enable(uct_iface_h tl_iface, unsigned flags)
+{
+    uct_cma_iface_t *iface = ucs_derived_of(tl_iface, uct_cma_iface_t);
+
+    /* Progress is needed only to complete asynchronous operations */
+    if (iface->async.num_threads > 0) {
+        uct_base_iface_progress_enable(tl_iface, flags);
+    }
+}
+
 static UCS_CLASS_DECLARE_DELETE_FUNC(uct_cma_iface_t, uct_iface_t);
 
+static void uct_cma_iface_stop_threads(uct_cma_iface_t *iface)
+{
+    unsigned i;
+
+    pthread_mutex_lock(&iface->async.lock);
+    iface->async.stop = 1;
+    pthread_cond_broadcast(&iface->async.cond);
+    pthread_mutex_unlock(&iface->async.lock);
+
+    for (i = 0; i < iface->async.num_threads; ++i) {
+        pthread_join(iface->async.threads[i], NULL);
+    }
+
+    ucs_free(iface->async.threads);
+}
+
 static uct_iface_ops_t uct_cma_iface_ops = {
     .ep_put_zcopy             = uct_cma_ep_put_zcopy,
     .ep_get_zcopy             = uct_cma_ep_get_zcopy,
     .ep_pending_add           = ucs_empty_function_return_busy,
     .ep_pending_purge         = ucs_empty_function,
-    .ep_flush                 = uct_base_ep_flush,
-    .ep_fence                 = uct_sm_ep_fence,
+    .ep_flush                 = uct_cma_ep_flush,
+    .ep_fence                 = uct_cma_ep_fence,
     .ep_create                = UCS_CLASS_NEW_FUNC_NAME(uct_cma_ep_t),
     .ep_destroy               = UCS_CLASS_DELETE_FUNC_NAME(uct_cma_ep_t),
-    .iface_flush              = uct_base_iface_flush,
-    .iface_fence              = uct_sm_iface_fence,
-    .iface_progress_enable    = ucs_empty_function,
-    .iface_progress_disable   = ucs_empty_function,
-    .iface_progress           = ucs_empty_function_return_zero,
+    .iface_flush              = uct_cma_iface_flush,
+    .iface_fence              = uct_cma_iface_fence,
+    .iface_progress_enable    = uct_cma_iface_progress_enable,
+    .iface_progress_disable   = uct_base_iface_progress_disable,
+    .iface_progress           = uct_cma_iface_progress,
     .iface_close              = UCS_CLASS_DELETE_FUNC_NAME(uct_cma_iface_t),
     .iface_query              = uct_cma_iface_query,
     .iface_get_address        = uct_cma_iface_get_address,
@@ -95,15 +316,102 @@ static UCS_CLASS_INIT_FUNC(uct_cma_iface_t, uct_md_h md, uct_worker_h worker,
                            const uct_iface_params_t *params,
                            const uct_iface_config_t *tl_config)
 {
+    uct_cma_iface_config_t *config = ucs_derived_of(tl_config,
+                                                    uct_cma_iface_config_t);
+    ucs_status_t status;
+    unsigned i;
+    int ret;
+
     UCS_CLASS_CALL_SUPER_INIT(uct_sm_iface_t, &uct_cma_iface_ops, md,
                               worker, params, tl_config);
     uct_sm_get_max_iov(); /* to initialize ucs_get_max_iov static variable */
 
+    if (config->async.seg_size == 0) {
+        ucs_error("CMA async copy segment size must be non-zero");
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    self->async.num_threads     = 0;
+    self->async.threads         = NULL;
+    self->async.thresh          = config->async.thresh;
+    self->async.seg_size        = config->async.seg_size;
+    self->async.stop            = 0;
+    self->async.num_copying     = 0;
+    self->async.num_outstanding = 0;
+    ucs_queue_head_init(&self->async.segs);
+    ucs_queue_head_init(&self->async.done);
+    ucs_queue_head_init(&self->async.flush_comps);
+    pthread_mutex_init(&self->async.lock, NULL);
+    pthread_cond_init(&self->async.cond, NULL);
+
+    status = ucs_spinlock_init(&self->async.done_lock);
+    if (status != UCS_OK) {
+        goto err_destroy_cond;
+    }
+
+    if (config->async.num_threads == 0) {
+        return UCS_OK;
+    }
+
+    self->async.threads = ucs_calloc(config->async.num_threads,
+                                     sizeof(*self->async.threads),
+                                     "cma_copy_threads");
+    if (self->async.threads == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err_destroy_spinlock;
+    }
+
+    for (i = 0; i < config->async.num_threads; ++i) {
+        ret = pthread_create(&self->async.threads[i], NULL,
+                             uct_cma_iface_copy_thread, self);
+        if (ret != 0) {
+            ucs_error("failed to create CMA copy thread: %s", strerror(ret));
+            status = UCS_ERR_IO_ERROR;
+            goto err_stop_threads;
+        }
+        ++self->async.num_threads;
+    }
+
     return UCS_OK;
+
+err_stop_threads:
+    uct_cma_iface_stop_threads(self);
+err_destroy_spinlock:
+    ucs_spinlock_destroy(&self->async.done_lock);
+err_destroy_cond:
+    pthread_cond_destroy(&self->async.cond);
+    pthread_mutex_destroy(&self->async.lock);
+    return status;
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_cma_iface_t)
 {
+    uct_cma_flush_comp_t *flush_comp;
+    uct_cma_copy_op_t *op;
+
+    uct_base_iface_progress_disable(&self->super.super.super,
+                                    UCT_PROGRESS_SEND | UCT_PROGRESS_RECV);
+
+    if (self->async.num_threads > 0) {
+        uct_cma_iface_stop_threads(self);
+    }
+
+    if (self->async.num_outstanding > 0) {
+        ucs_warn("cma iface %p: destroying with %u outstanding operations",
+                 self, self->async.num_outstanding);
+    }
+
+    ucs_queue_for_each_extract(op, &self->async.done, queue, 1) {
+        ucs_free(op);
+    }
+
+    ucs_queue_for_each_extract(flush_comp, &self->async.flush_comps, queue, 1) {
+        ucs_free(flush_comp);
+    }
+
+    ucs_spinlock_destroy(&self->async.done_lock);
+    pthread_cond_destroy(&self->async.cond);
+    pthread_mutex_destroy(&self->async.lock);
 }
 
 UCS_CLASS_DEFINE(uct_cma_iface_t, uct_base_iface_t);
@@ -9,16 +9,95 @@
 
 #include <uct/base/uct_iface.h>
 #include <uct/sm/base/sm_iface.h>
+#include <ucs/datastruct/queue.h>
+#include <ucs/type/spinlock.h>
+#include <sys/uio.h>
+#include <pthread.h>
+
+
+typedef struct uct_cma_iface uct_cma_iface_t;
+
+
+/* process_vm_readv/process_vm_writev */
+typedef ssize_t (*uct_cma_copy_func_t)(pid_t pid,
+                                       const struct iovec *local_iov,
+                                       unsigned long liovcnt,
+                                       const struct iovec *remote_iov,
+                                       unsigned long riovcnt,
+                                       unsigned long flags);
 
 
 typedef struct uct_cma_iface_config {
     uct_sm_iface_config_t         super;
+    struct {
+        unsigned                  num_threads;
+        size_t                    thresh;
+        size_t                    seg_size;
+    } async;
 } uct_cma_iface_config_t;
 
 
-typedef struct uct_cma_iface {
+/*
+ * Asynchronous zcopy operation, which is split to segments copied in parallel
+ * by the copy threads. Completed by iface progress after all its segments are
+ * copied.
+ */
+typedef struct uct_cma_copy_op {
+    ucs_queue_elem_t              queue;      /* Element in completed ops queue */
+    uct_cma_iface_t               *iface;     /* Interface which posted the op */
+    uct_completion_t              *comp;      /* User completion */
+    pid_t                         remote_pid; /* Remote process */
+    uct_cma_copy_func_t           func;       /* Function which copies the data */
+    const char                    *func_name; /* Copy function name, for errors */
+    volatile uint32_t             segs_left;  /* Segments which were not copied */
+    ucs_status_t                  status;     /* Operation status */
+} uct_cma_copy_op_t;
+
+
+/* Segment of an asynchronous operation */
+typedef struct uct_cma_copy_seg {
+    ucs_queue_elem_t              queue;      /* Element in segments queue */
+    uct_cma_copy_op_t             *op;        /* Operation of the segment */
+    struct iovec                  remote_iov; /* Remote memory range */
+    size_t                        iovcnt;     /* Number of local iov elements */
+    struct iovec                  local_iov[UCT_SM_MAX_IOV]; /* Local buffers */
+} uct_cma_copy_seg_t;
+
+
+/* Completion waiting for all outstanding operations on the iface */
+typedef struct uct_cma_flush_comp {
+    ucs_queue_elem_t              queue;
+    uct_completion_t              *comp;
+} uct_cma_flush_comp_t;
+
+
+struct uct_cma_iface {
     uct_sm_iface_t                super;
-} uct_cma_iface_t;
+    struct {
+        unsigned                  num_threads;     /* Number of copy threads */
+        size_t                    thresh;          /* Minimal async op length */
+        size_t                    seg_size;        /* Copied by a single thread */
+        pthread_t                 *threads;        /* Copy threads */
+        pthread_mutex_t           lock;            /* Protects segs and stop */
+        pthread_cond_t            cond;            /* Signals new segments */
+        ucs_queue_head_t          segs;            /* Segments to copy */
+        int                       stop;            /* Threads should exit */
+        ucs_spinlock_t            done_lock;       /* Protects done */
+        ucs_queue_head_t          done;            /* Copied operations */
+        volatile uint32_t         num_copying;     /* Ops which are still copied */
+        unsigned                  num_outstanding; /* Ops which were not completed */
+        ucs_queue_head_t          flush_comps;     /* Pending flush completions */
+    } async;
+};
+
+
+void uct_cma_iface_post_op(uct_cma_iface_t *iface, uct_cma_copy_op_t *op,
+                           uct_cma_copy_seg_t *segs, unsigned num_segs);
+
+ucs_status_t uct_cma_iface_flush_async(uct_cma_iface_t *iface,
+                                       uct_completion_t *comp);
+
+void uct_cma_iface_fence_async(uct_cma_iface_t *iface);
 
 
 #endif
@@ -15,20 +15,25 @@
 typedef struct uct_mm_ep                uct_mm_ep_t;
 typedef struct uct_mm_iface             uct_mm_iface_t;
 typedef struct uct_mm_fifo_ctl          uct_mm_fifo_ctl_t;
+typedef struct uct_mm_fifo_lane_ctl     uct_mm_fifo_lane_ctl_t;
 typedef struct uct_mm_fifo_element      uct_mm_fifo_element_t;
 typedef struct uct_mm_recv_desc         uct_mm_recv_desc_t;
 typedef struct uct_mm_remote_seg        uct_mm_remote_seg_t;
+typedef struct uct_mm_zcopy_desc        uct_mm_zcopy_desc_t;
 
 #define UCT_MM_BASE_ADDRESS_HASH_SIZE    64
 
 enum {
     UCT_MM_FIFO_ELEM_FLAG_OWNER  = UCS_BIT(0), /* new/old info */
     UCT_MM_FIFO_ELEM_FLAG_INLINE = UCS_BIT(1), /* if inline or not */
+    UCT_MM_FIFO_ELEM_FLAG_ZCOPY  = UCS_BIT(2), /* payload is in the sender's
+                                                  published segment */
 };
 
 enum {
     UCT_MM_AM_BCOPY,
     UCT_MM_AM_SHORT,
+    UCT_MM_AM_ZCOPY,
 };
 
 #define UCT_MM_IFACE_GET_FIFO_ELEM(_iface, _fifo , _index) \
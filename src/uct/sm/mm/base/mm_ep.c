@@ -55,6 +55,40 @@ static void uct_mm_ep_signal_remote(uct_mm_ep_t *ep)
     }
 }
 
+/* claim a free per-sender FIFO of the destination, if there is one */
+static void uct_mm_ep_claim_fifo_lane(uct_mm_ep_t *ep, uct_mm_iface_t *iface)
+{
+    uint64_t pid = getpid();
+    uct_mm_fifo_lane_ctl_t *lane_ctl;
+    unsigned i, lane;
+
+    ep->fifo_lane = NULL;
+
+    /* start from a different lane in every process to make collisions rare */
+    for (i = 0; i < iface->config.fifo_lanes; ++i) {
+        lane     = (pid + i) % iface->config.fifo_lanes;
+        lane_ctl = uct_mm_fifo_lane_ctl(iface, ep->fifo_ctl, lane);
+        if ((lane_ctl->owner != 0) ||
+            (ucs_atomic_cswap64(ucs_unaligned_ptr(&lane_ctl->owner), 0, pid) != 0)) {
+            continue;
+        }
+
+        ep->lane_ready.word = uct_mm_fifo_lanes_ready(iface, ep->fifo_ctl) +
+                              (lane / 64);
+        ep->lane_ready.bit  = UCS_BIT(lane % 64);
+        ep->fifo_lane       = lane_ctl;
+        ep->fifo_ctl        = &lane_ctl->fifo;
+        ep->fifo            = uct_mm_fifo_lane_elems(lane_ctl);
+        ep->cached_tail     = ep->fifo_ctl->tail;
+        ucs_debug("mm: ep %p claimed FIFO lane %u", ep, lane);
+        return;
+    }
+
+    if (iface->config.fifo_lanes > 0) {
+        ucs_debug("mm: ep %p found no free FIFO lane, using the shared FIFO", ep);
+    }
+}
+
 static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
 {
     uct_mm_iface_t *iface           = ucs_derived_of(params->iface, uct_mm_iface_t);
@@ -99,11 +133,15 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
      * the remote peer */
     uct_mm_set_fifo_elems_ptr(self->mapped_desc.address, &self->fifo);
 
+    /* send to a per-sender FIFO instead of the shared one, if possible */
+    uct_mm_ep_claim_fifo_lane(self, iface);
+
     /* Initiate the hash which will keep the base_adresses of remote memory
      * chunks that hold the descriptors for bcopy. */
     sglib_hashed_uct_mm_remote_seg_t_init(self->remote_segments_hash);
 
     ucs_arbiter_group_init(&self->arb_group);
+    ucs_queue_head_init(&self->zcopy_ops);
 
     ucs_debug("mm: ep connected: %p, to remote_shmid: %zu", self, addr->id);
 
@@ -116,6 +154,21 @@ static UCS_CLASS_CLEANUP_FUNC(uct_mm_ep_t)
     ucs_status_t status;
     uct_mm_remote_seg_t *remote_seg;
     struct sglib_hashed_uct_mm_remote_seg_t_iterator iter;
+    uct_mm_zcopy_op_t *op;
+
+    if (self->fifo_lane != NULL) {
+        /* the receiver keeps reading the elements which were already written,
+         * and the next owner continues from the lane's head */
+        ucs_memory_cpu_store_fence();
+        self->fifo_lane->owner = 0;
+    }
+
+    if (!ucs_queue_is_empty(&self->zcopy_ops)) {
+        ucs_list_del(&self->zcopy_list);
+        ucs_queue_for_each_extract(op, &self->zcopy_ops, queue, 1) {
+            ucs_mpool_put(op);
+        }
+    }
 
     for (remote_seg = sglib_hashed_uct_mm_remote_seg_t_it_init(&iter, self->remote_segments_hash);
          remote_seg != NULL; remote_seg = sglib_hashed_uct_mm_remote_seg_t_it_next(&iter)) {
@@ -195,6 +248,12 @@ static inline ucs_status_t uct_mm_ep_get_remote_elem(uct_mm_ep_t *ep, uint64_t h
     elem_index = ep->fifo_ctl->head & iface->fifo_mask;
     *elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo, elem_index);
 
+    if (ep->fifo_lane != NULL) {
+        /* no other sender writes to this FIFO */
+        ep->fifo_ctl->head = head + 1;
+        return UCS_OK;
+    }
+
     /* try to get ownership of the head element */
     returned_val = ucs_atomic_cswap64(ucs_unaligned_ptr(&ep->fifo_ctl->head), head, head+1);
     if (returned_val != head) {
@@ -204,6 +263,17 @@ static inline ucs_status_t uct_mm_ep_get_remote_elem(uct_mm_ep_t *ep, uint64_t h
     return UCS_OK;
 }
 
+/* let the receiver know that the lane has a new element */
+static UCS_F_ALWAYS_INLINE void uct_mm_ep_set_lane_ready(uct_mm_ep_t *ep)
+{
+    /* the receiver clears the bit before checking the lane for elements, so
+     * the element must be visible before the bit is checked */
+    ucs_memory_bus_fence();
+    if (!(*ep->lane_ready.word & ep->lane_ready.bit)) {
+        ucs_atomic_or64(ep->lane_ready.word, ep->lane_ready.bit);
+    }
+}
+
 static inline void uct_mm_ep_update_cached_tail(uct_mm_ep_t *ep)
 {
     ucs_memory_cpu_load_fence();
@@ -212,19 +282,28 @@ static inline void uct_mm_ep_update_cached_tail(uct_mm_ep_t *ep)
 
 /* A common mm active message sending function.
  * The first parameter indicates the origin of the call.
- * is_short = 1 - perform AM short sending
- * is_short = 0 - perform AM bcopy sending
+ * send_op = UCT_MM_AM_SHORT - perform AM short sending
+ * send_op = UCT_MM_AM_BCOPY - perform AM bcopy sending
+ * send_op = UCT_MM_AM_ZCOPY - perform AM zcopy sending; payload and length
+ *                             are the AM header. if zcopy_op is not NULL the
+ *                             iov is published in its memory segment, otherwise
+ *                             it is copied to the remote descriptor.
  */
 static UCS_F_ALWAYS_INLINE ssize_t
-uct_mm_ep_am_common_send(unsigned is_short, uct_mm_ep_t *ep, uct_mm_iface_t *iface,
+uct_mm_ep_am_common_send(unsigned send_op, uct_mm_ep_t *ep, uct_mm_iface_t *iface,
                          uint8_t am_id, size_t length, uint64_t header,
                          const void *payload, uct_pack_callback_t pack_cb, void *arg,
-                         unsigned flags)
+                         const uct_iov_t *iov, size_t iovcnt,
+                         uct_mm_zcopy_op_t *zcopy_op, unsigned flags)
 {
     uct_mm_fifo_element_t *elem;
+    uct_mm_zcopy_desc_t *zcopy_desc;
+    uct_mm_seg_t *seg;
     ucs_status_t status;
     void *base_address;
+    size_t iov_it;
     uint64_t head;
+    void *data;
 
     UCT_CHECK_AM_ID(am_id);
 
@@ -254,31 +333,76 @@ retry:
         goto retry;
     }
 
-    if (is_short) {
+    if (send_op == UCT_MM_AM_SHORT) {
         /* AM_SHORT */
         /* write to the remote FIFO */
         uct_am_short_fill_data(elem + 1, header, payload, length);
 
+        elem->flags &= ~UCT_MM_FIFO_ELEM_FLAG_ZCOPY;
         elem->flags |= UCT_MM_FIFO_ELEM_FLAG_INLINE;
         elem->length = length + sizeof(header);
 
         uct_iface_trace_am(&iface->super.super, UCT_AM_TRACE_TYPE_SEND, am_id,
                            elem + 1, length + sizeof(header), "TX: AM_SHORT");
         UCT_TL_EP_STAT_OP(&ep->super, AM, SHORT, sizeof(header) + length);
-    } else {
+    } else if (send_op == UCT_MM_AM_BCOPY) {
         /* AM_BCOPY */
         /* write to the remote descriptor */
         /* get the base_address: local ptr to remote memory chunk after attaching to it */
         base_address = uct_mm_ep_attach_remote_seg(ep, iface, elem);
         length       = pack_cb(base_address + elem->desc_offset, arg);
 
-        elem->flags &= ~UCT_MM_FIFO_ELEM_FLAG_INLINE;
+        elem->flags &= ~(UCT_MM_FIFO_ELEM_FLAG_INLINE |
+                         UCT_MM_FIFO_ELEM_FLAG_ZCOPY);
         elem->length = length;
 
         uct_iface_trace_am(&iface->super.super, UCT_AM_TRACE_TYPE_SEND, am_id,
                            base_address + elem->desc_offset, length, "TX: AM_BCOPY");
 
         UCT_TL_EP_STAT_OP(&ep->super, AM, BCOPY, length);
+    } else if (zcopy_op != NULL) {
+        /* AM_ZCOPY from the sender's segment */
+        /* write the segment to the remote FIFO, the receiver attaches to the
+         * segment and passes the payload to the AM handler from there */
+        seg                     = iov->memh;
+        zcopy_desc              = (uct_mm_zcopy_desc_t*)(elem + 1);
+        zcopy_desc->mmid        = seg->mmid;
+        zcopy_desc->serial      = seg->serial;
+        zcopy_desc->seg_address = seg->address;
+        zcopy_desc->seg_length  = seg->length;
+        zcopy_desc->offset      = (uintptr_t)iov->buffer - (uintptr_t)seg->address;
+        zcopy_desc->length      = uct_iov_get_length(iov);
+
+        elem->flags &= ~UCT_MM_FIFO_ELEM_FLAG_INLINE;
+        elem->flags |= UCT_MM_FIFO_ELEM_FLAG_ZCOPY;
+        elem->length = 0;
+
+        uct_iface_trace_am(&iface->super.super, UCT_AM_TRACE_TYPE_SEND, am_id,
+                           iov->buffer, zcopy_desc->length,
+                           "TX: AM_ZCOPY [mmid %"PRIu64" offset %zu]",
+                           zcopy_desc->mmid, zcopy_desc->offset);
+
+        UCT_TL_EP_STAT_OP(&ep->super, AM, ZCOPY, zcopy_desc->length);
+    } else {
+        /* AM_ZCOPY of a small or unregistered payload */
+        /* write the header and the iov to the remote descriptor */
+        base_address = uct_mm_ep_attach_remote_seg(ep, iface, elem);
+        data         = base_address + elem->desc_offset;
+        memcpy(data, payload, length);
+        for (iov_it = 0; iov_it < iovcnt; ++iov_it) {
+            memcpy(data + length, iov[iov_it].buffer,
+                   uct_iov_get_length(&iov[iov_it]));
+            length += uct_iov_get_length(&iov[iov_it]);
+        }
+
+        elem->flags &= ~(UCT_MM_FIFO_ELEM_FLAG_INLINE |
+                         UCT_MM_FIFO_ELEM_FLAG_ZCOPY);
+        elem->length = length;
+
+        uct_iface_trace_am(&iface->super.super, UCT_AM_TRACE_TYPE_SEND, am_id,
+                           data, length, "TX: AM_ZCOPY");
+
+        UCT_TL_EP_STAT_OP(&ep->super, AM, ZCOPY, length);
     }
 
     elem->am_id = am_id;
@@ -295,15 +419,29 @@ retry:
         elem->flags &= ~UCT_MM_FIFO_ELEM_FLAG_OWNER;
     }
 
+    if (ep->fifo_lane != NULL) {
+        uct_mm_ep_set_lane_ready(ep);
+    }
+
     if (ucs_unlikely(flags & UCT_SEND_FLAG_SIGNALED)) {
         uct_mm_ep_signal_remote(ep);
     }
 
-    if (is_short) {
+    if (send_op == UCT_MM_AM_SHORT) {
         return UCS_OK;
-    } else {
+    } else if (send_op == UCT_MM_AM_BCOPY) {
         return length;
+    } else if (zcopy_op == NULL) {
+        return UCS_OK;
     }
+
+    /* the segment is in use until the receiver releases the FIFO element */
+    zcopy_op->fifo_index = head;
+    if (ucs_queue_is_empty(&ep->zcopy_ops)) {
+        ucs_list_add_tail(&iface->zcopy_eps, &ep->zcopy_list);
+    }
+    ucs_queue_push(&ep->zcopy_ops, &zcopy_op->queue);
+    return UCS_INPROGRESS;
 }
 
 ucs_status_t uct_mm_ep_am_short(uct_ep_h tl_ep, uint8_t id, uint64_t header,
@@ -317,7 +455,8 @@ ucs_status_t uct_mm_ep_am_short(uct_ep_h tl_ep, uint8_t id, uint64_t header,
                      "am_short");
 
     return uct_mm_ep_am_common_send(UCT_MM_AM_SHORT, ep, iface, id, length,
-                                    header, payload, NULL, NULL, 0);
+                                    header, payload, NULL, NULL, NULL, 0, NULL,
+                                    0);
 }
 
 ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_cb,
@@ -327,7 +466,87 @@ ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_
     uct_mm_ep_t *ep = ucs_derived_of(tl_ep, uct_mm_ep_t);
 
     return uct_mm_ep_am_common_send(UCT_MM_AM_BCOPY, ep, iface, id, 0, 0, NULL,
-                                    pack_cb, arg, flags);
+                                    pack_cb, arg, NULL, 0, NULL, flags);
+}
+
+ucs_status_t uct_mm_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                unsigned header_length, const uct_iov_t *iov,
+                                size_t iovcnt, unsigned flags,
+                                uct_completion_t *comp)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
+    uct_mm_ep_t *ep = ucs_derived_of(tl_ep, uct_mm_ep_t);
+    uct_mm_zcopy_op_t *op;
+    size_t length;
+    ssize_t ret;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, 1ul, "uct_mm_ep_am_zcopy");
+    UCT_CHECK_LENGTH(header_length, 0, UCT_MM_IFACE_AM_MAX_HDR(iface),
+                     "am_zcopy header");
+
+    length = uct_iov_total_length(iov, iovcnt);
+
+    /* publish a large contiguous payload in its segment rather than copy it,
+     * the receiver passes it to the AM handler from there. the AM handler
+     * expects the header and the payload contiguously, so a message with a
+     * header is copied */
+    if ((header_length == 0) && (iovcnt == 1) &&
+        (iov->memh != UCT_MEM_HANDLE_NULL) && (iov->count == 1) &&
+        (length >= iface->config.zcopy_thresh)) {
+        op = ucs_mpool_get_inline(&iface->zcopy_op_mp);
+        if (ucs_unlikely(op == NULL)) {
+            ucs_error("failed to allocate mm zcopy operation");
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        op->comp = comp;
+        ret      = uct_mm_ep_am_common_send(UCT_MM_AM_ZCOPY, ep, iface, id,
+                                            header_length, 0, header, NULL,
+                                            NULL, iov, iovcnt, op, flags);
+        if (ret == UCS_ERR_NO_RESOURCE) {
+            ucs_mpool_put_inline(op);
+        }
+        return ret;
+    }
+
+    if (ucs_unlikely(header_length + length > iface->config.seg_size)) {
+        ucs_error("mm am_zcopy of %zu bytes does not fit a receive descriptor "
+                  "(%u bytes)", header_length + length,
+                  iface->config.seg_size);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    return uct_mm_ep_am_common_send(UCT_MM_AM_ZCOPY, ep, iface, id,
+                                    header_length, 0, header, NULL, NULL, iov,
+                                    iovcnt, NULL, flags);
+}
+
+unsigned uct_mm_ep_progress_zcopy(uct_mm_ep_t *ep)
+{
+    unsigned count = 0;
+    uct_mm_zcopy_op_t *op;
+    uint64_t tail, failed;
+
+    tail = ep->fifo_ctl->tail;
+    ucs_memory_cpu_load_fence();
+    failed = ep->fifo_ctl->zcopy_failed;
+
+    ucs_queue_for_each_extract(op, &ep->zcopy_ops, queue,
+                               (int64_t)(tail - op->fifo_index) > 0) {
+        if (op->comp != NULL) {
+            /* the receiver could not attach to the segment */
+            uct_invoke_completion(op->comp, (op->fifo_index == failed) ?
+                                            UCS_ERR_IO_ERROR : UCS_OK);
+        }
+        ucs_mpool_put_inline(op);
+        ++count;
+    }
+
+    if (ucs_queue_is_empty(&ep->zcopy_ops)) {
+        ucs_list_del(&ep->zcopy_list);
+    }
+
+    return count;
 }
 
 static inline int uct_mm_ep_has_tx_resources(uct_mm_ep_t *ep)
@@ -424,7 +643,9 @@ void uct_mm_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
 ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
                              uct_completion_t *comp)
 {
+    uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
     uct_mm_ep_t *ep = ucs_derived_of(tl_ep, uct_mm_ep_t);
+    uct_mm_zcopy_op_t *op;
 
     if (!uct_mm_ep_has_tx_resources(ep)) {
         if (!ucs_arbiter_group_is_empty(&ep->arb_group)) {
@@ -437,6 +658,24 @@ ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
         }
     }
 
+    if (!ucs_queue_is_empty(&ep->zcopy_ops)) {
+        /* the receiver still reads from published segments */
+        if (comp != NULL) {
+            op = ucs_mpool_get_inline(&iface->zcopy_op_mp);
+            if (op == NULL) {
+                return UCS_ERR_NO_MEMORY;
+            }
+
+            op->comp       = comp;
+            op->fifo_index = ucs_queue_tail_elem_non_empty(&ep->zcopy_ops,
+                                                           uct_mm_zcopy_op_t,
+                                                           queue)->fifo_index;
+            ucs_queue_push(&ep->zcopy_ops, &op->queue);
+        }
+        UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+        return UCS_INPROGRESS;
+    }
+
     ucs_memory_cpu_store_fence();
     UCT_TL_EP_STAT_FLUSH(&ep->super);
     return UCS_OK;
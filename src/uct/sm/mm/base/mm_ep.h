@@ -10,10 +10,22 @@
 
 #include "mm_iface.h"
 
+#include <ucs/datastruct/queue.h>
 #include <ucs/datastruct/sglib.h>
 #include <ucs/datastruct/sglib_wrapper.h>
 
 
+/*
+ * AM zcopy send (or flush) which completes when the receiver has released the
+ * FIFO element at fifo_index, and with it the sender's segment.
+ */
+typedef struct uct_mm_zcopy_op {
+    ucs_queue_elem_t     queue;       /* element in the ep's zcopy_ops queue */
+    uint64_t             fifo_index;  /* index of the FIFO element */
+    uct_completion_t     *comp;       /* user completion, may be NULL */
+} uct_mm_zcopy_op_t;
+
+
 struct uct_mm_ep {
     uct_base_ep_t       super;
 
@@ -30,6 +42,17 @@ struct uct_mm_ep {
 
     ucs_arbiter_group_t  arb_group;   /* the group that holds this ep's pending operations */
 
+    /* per-sender FIFO claimed in the destination's receive segment, or NULL if
+     * the shared FIFO is used. fifo_ctl and fifo point to it if claimed */
+    uct_mm_fifo_lane_ctl_t *fifo_lane;
+    struct {
+        volatile uint64_t   *word;     /* word of the destination's ready bitmap */
+        uint64_t            bit;       /* the lane's bit in the word */
+    } lane_ready;
+
+    ucs_queue_head_t     zcopy_ops;   /* outstanding AM zcopy sends, by FIFO index */
+    ucs_list_link_t      zcopy_list;  /* entry in iface->zcopy_eps */
+
     /* Used for signaling remote side wakeup */
     struct {
         struct sockaddr_un  sockaddr;  /* address of signaling socket */
@@ -47,6 +70,12 @@ ucs_status_t uct_mm_ep_am_short(uct_ep_h tl_ep, uint8_t id, uint64_t header,
                                 const void *payload, unsigned length);
 ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_cb,
                            void *arg, unsigned flags);
+ucs_status_t uct_mm_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                unsigned header_length, const uct_iov_t *iov,
+                                size_t iovcnt, unsigned flags,
+                                uct_completion_t *comp);
+
+unsigned uct_mm_ep_progress_zcopy(uct_mm_ep_t *ep);
 
 ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
                              uct_completion_t *comp);
@@ -23,6 +23,9 @@
 /* Maximal number of events to clear from the signaling pipe in single call */
 #define UCT_MM_IFACE_MAX_SIG_EVENTS  32
 
+/* Default number of FIFO elements to handle in single progress call */
+#define UCT_MM_IFACE_FIFO_MAX_POLL   16
+
 
 ucs_config_field_t uct_mm_iface_config_table[] = {
     {"", "ALLOC=md", NULL,
@@ -57,6 +60,27 @@ ucs_config_field_t uct_mm_iface_config_table[] = {
      "Size of the FIFO element size (data + header) in the MM UCTs.",
      ucs_offsetof(uct_mm_iface_config_t, fifo_elem_size), UCS_CONFIG_TYPE_UINT},
 
+    {"FIFO_MAX_POLL", UCS_PP_MAKE_STRING(UCT_MM_IFACE_FIFO_MAX_POLL),
+     "Maximal number of receive FIFO elements to handle in one progress call.\n"
+     "Larger values let a receiver with many local senders keep up with them.",
+     ucs_offsetof(uct_mm_iface_config_t, fifo_max_poll), UCS_CONFIG_TYPE_UINT},
+
+    {"ZCOPY_THRESH", "auto",
+     "Minimal payload size of a zero-copy active message which is read by the\n"
+     "receiver directly from the sender's registered memory segment. Smaller\n"
+     "payloads, and messages with a header, are copied to a receive descriptor.\n"
+     "\"auto\" means half of the segment size.",
+     ucs_offsetof(uct_mm_iface_config_t, zcopy_thresh), UCS_CONFIG_TYPE_MEMUNITS},
+
+    {"FIFO_LANES", "0",
+     "Number of single-producer receive FIFOs, in addition to the shared one.\n"
+     "An endpoint which claims such a FIFO sends to it without contending with\n"
+     "other senders on the FIFO head, and the receiver finds the FIFOs with new\n"
+     "elements in a bitmap. Endpoints fall back to the shared FIFO when all of\n"
+     "them are taken. Each one takes FIFO_SIZE elements and receive descriptors.\n"
+     "Must be the same on all processes.",
+     ucs_offsetof(uct_mm_iface_config_t, fifo_lanes), UCS_CONFIG_TYPE_UINT},
+
     {NULL}
 };
 
@@ -82,10 +106,17 @@ void uct_mm_iface_release_desc(uct_recv_desc_t *self, void *desc)
 ucs_status_t uct_mm_iface_flush(uct_iface_h tl_iface, unsigned flags,
                                 uct_completion_t *comp)
 {
+    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
+
     if (comp != NULL) {
         return UCS_ERR_UNSUPPORTED;
     }
 
+    if (!ucs_list_is_empty(&iface->zcopy_eps)) {
+        UCT_TL_IFACE_STAT_FLUSH_WAIT(ucs_derived_of(tl_iface, uct_base_iface_t));
+        return UCS_INPROGRESS;
+    }
+
     ucs_memory_cpu_store_fence();
     UCT_TL_IFACE_STAT_FLUSH(ucs_derived_of(tl_iface, uct_base_iface_t));
     return UCS_OK;
@@ -106,22 +137,25 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
     iface_attr->cap.put.max_zcopy       = SIZE_MAX;
     iface_attr->cap.put.opt_zcopy_align = UCS_SYS_CACHE_LINE_SIZE;
     iface_attr->cap.put.align_mtu       = iface_attr->cap.put.opt_zcopy_align;
-    iface_attr->cap.put.max_iov         = 1;
+    iface_attr->cap.put.max_iov         = uct_sm_get_max_iov();
 
     iface_attr->cap.get.max_bcopy       = SIZE_MAX;
     iface_attr->cap.get.min_zcopy       = 0;
     iface_attr->cap.get.max_zcopy       = SIZE_MAX;
     iface_attr->cap.get.opt_zcopy_align = UCS_SYS_CACHE_LINE_SIZE;
     iface_attr->cap.get.align_mtu       = iface_attr->cap.get.opt_zcopy_align;
-    iface_attr->cap.get.max_iov         = 1;
+    iface_attr->cap.get.max_iov         = uct_sm_get_max_iov();
 
     iface_attr->cap.am.max_short        = iface->config.fifo_elem_size -
                                           sizeof(uct_mm_fifo_element_t);
     iface_attr->cap.am.max_bcopy        = iface->config.seg_size;
     iface_attr->cap.am.min_zcopy        = 0;
-    iface_attr->cap.am.max_zcopy        = 0;
+    /* a message with a header is copied to a receive descriptor */
+    iface_attr->cap.am.max_zcopy        = iface->config.seg_size -
+                                          UCT_MM_IFACE_AM_MAX_HDR(iface);
     iface_attr->cap.am.opt_zcopy_align  = UCS_SYS_CACHE_LINE_SIZE;
     iface_attr->cap.am.align_mtu        = iface_attr->cap.am.opt_zcopy_align;
+    iface_attr->cap.am.max_hdr          = UCT_MM_IFACE_AM_MAX_HDR(iface);
     iface_attr->cap.am.max_iov          = 1;
 
     iface_attr->iface_addr_len          = sizeof(uct_mm_iface_addr_t);
@@ -130,10 +164,13 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
     iface_attr->max_conn_priv           = 0;
     iface_attr->cap.flags               = UCT_IFACE_FLAG_PUT_SHORT           |
                                           UCT_IFACE_FLAG_PUT_BCOPY           |
+                                          UCT_IFACE_FLAG_PUT_ZCOPY           |
                                           UCT_IFACE_FLAG_ATOMIC_CPU          |
                                           UCT_IFACE_FLAG_GET_BCOPY           |
+                                          UCT_IFACE_FLAG_GET_ZCOPY           |
                                           UCT_IFACE_FLAG_AM_SHORT            |
                                           UCT_IFACE_FLAG_AM_BCOPY            |
+                                          UCT_IFACE_FLAG_AM_ZCOPY            |
                                           UCT_IFACE_FLAG_PENDING             |
                                           UCT_IFACE_FLAG_CB_SYNC             |
                                           UCT_IFACE_FLAG_EVENT_SEND_COMP     |
@@ -163,14 +200,21 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
     return UCS_OK;
 }
 
-static inline void uct_mm_progress_fifo_tail(uct_mm_iface_t *iface)
+static inline void uct_mm_progress_fifo_tail(uct_mm_iface_t *iface,
+                                             uct_mm_fifo_ctl_t *fifo_ctl,
+                                             uint64_t read_index,
+                                             uint64_t prev_read_index,
+                                             int force)
 {
-    /* don't progress the tail every time - release in batches. improves performance */
-    if (iface->read_index & iface->fifo_release_factor_mask) {
+    /* don't progress the tail every time - release in batches. improves
+     * performance. the tail is released once if several batches were read.
+     * a zcopy sender waits for the tail to complete, so release it right away */
+    if (!force && !((prev_read_index ^ read_index) &
+                    ~iface->fifo_release_factor_mask)) {
         return;
     }
 
-    iface->recv_fifo_ctl->tail = iface->read_index;
+    fifo_ctl->tail = read_index;
 }
 
 ucs_status_t uct_mm_assign_desc_to_fifo_elem(uct_mm_iface_t *iface,
@@ -195,13 +239,111 @@ ucs_status_t uct_mm_assign_desc_to_fifo_elem(uct_mm_iface_t *iface,
     return UCS_OK;
 }
 
+static void uct_mm_iface_zcopy_seg_put(uct_mm_iface_t *iface,
+                                       uct_mm_remote_seg_t *remote_seg)
+{
+    ucs_status_t status;
+
+    status = uct_mm_md_mapper_ops(iface->super.super.md)->detach(remote_seg);
+    if (status != UCS_OK) {
+        ucs_warn("Unable to detach shared memory segment of mmid %zu: %s",
+                 remote_seg->mmid, ucs_status_string(status));
+    }
+
+    ucs_free(remote_seg);
+}
+
+/* get the sender's segment which the AM zcopy payload is in, attached once
+ * per segment */
+static uct_mm_remote_seg_t *
+uct_mm_iface_zcopy_seg_get(uct_mm_iface_t *iface,
+                           const uct_mm_zcopy_desc_t *zcopy_desc)
+{
+    uct_mm_mapper_ops_t *ops = uct_mm_md_mapper_ops(iface->super.super.md);
+    uct_mm_remote_seg_t *remote_seg, search;
+    ucs_status_t status;
+
+    search.mmid = zcopy_desc->mmid;
+    remote_seg  = sglib_hashed_uct_mm_remote_seg_t_find_member(
+                      iface->zcopy_segs_hash, &search);
+    if (remote_seg != NULL) {
+        if ((remote_seg->serial == zcopy_desc->serial) &&
+            (remote_seg->length == zcopy_desc->seg_length)) {
+            return remote_seg;
+        }
+
+        /* the mmid was reused by another segment of the sender */
+        sglib_hashed_uct_mm_remote_seg_t_delete(iface->zcopy_segs_hash,
+                                                remote_seg);
+        uct_mm_iface_zcopy_seg_put(iface, remote_seg);
+    }
+
+    remote_seg = ucs_malloc(sizeof(*remote_seg), "mm_zcopy_seg");
+    if (remote_seg == NULL) {
+        ucs_error("failed to allocate a remote segment of mmid %zu",
+                  zcopy_desc->mmid);
+        return NULL;
+    }
+
+    status = ops->attach(zcopy_desc->mmid, zcopy_desc->seg_length,
+                         zcopy_desc->seg_address, &remote_seg->address,
+                         &remote_seg->cookie, iface->path);
+    if (status != UCS_OK) {
+        ucs_error("failed to attach to remote mmid %zu: %s", zcopy_desc->mmid,
+                  ucs_status_string(status));
+        ucs_free(remote_seg);
+        return NULL;
+    }
+
+    remote_seg->mmid   = zcopy_desc->mmid;
+    remote_seg->length = zcopy_desc->seg_length;
+    remote_seg->serial = zcopy_desc->serial;
+    sglib_hashed_uct_mm_remote_seg_t_add(iface->zcopy_segs_hash, remote_seg);
+    return remote_seg;
+}
+
+static void uct_mm_iface_process_zcopy(uct_mm_iface_t *iface,
+                                       uct_mm_fifo_ctl_t *fifo_ctl,
+                                       uct_mm_fifo_element_t *elem,
+                                       uint64_t index)
+{
+    uct_mm_zcopy_desc_t *zcopy_desc = (uct_mm_zcopy_desc_t*)(elem + 1);
+    uct_mm_remote_seg_t *remote_seg;
+    void *payload;
+
+    remote_seg = uct_mm_iface_zcopy_seg_get(iface, zcopy_desc);
+    if (remote_seg == NULL) {
+        /* the message is dropped, and the sender completes it with an error
+         * when the tail is released */
+        fifo_ctl->zcopy_failed = index;
+        ucs_memory_cpu_store_fence();
+        return;
+    }
+
+    payload = UCS_PTR_BYTE_OFFSET(remote_seg->address, zcopy_desc->offset);
+
+    uct_iface_trace_am(&iface->super.super, UCT_AM_TRACE_TYPE_RECV,
+                       elem->am_id, payload, zcopy_desc->length,
+                       "RX: AM_ZCOPY");
+
+    /* the payload is passed from the sender's segment, which is released
+     * right after the callback */
+    uct_iface_invoke_am(&iface->super.super, elem->am_id, payload,
+                        zcopy_desc->length, 0);
+}
+
 static inline ucs_status_t uct_mm_iface_process_recv(uct_mm_iface_t *iface,
-                                                     uct_mm_fifo_element_t* elem)
+                                                     uct_mm_fifo_ctl_t *fifo_ctl,
+                                                     uct_mm_fifo_element_t* elem,
+                                                     uint64_t index)
 {
     ucs_status_t status;
     void         *data;
 
-    if (ucs_likely(elem->flags & UCT_MM_FIFO_ELEM_FLAG_INLINE)) {
+    if (ucs_unlikely(elem->flags & UCT_MM_FIFO_ELEM_FLAG_ZCOPY)) {
+        uct_mm_iface_process_zcopy(iface, fifo_ctl, elem, index);
+        return UCS_OK;
+    } else if (ucs_likely(elem->flags & UCT_MM_FIFO_ELEM_FLAG_INLINE)) {
         /* read short (inline) messages from the FIFO elements */
         uct_iface_trace_am(&iface->super.super, UCT_AM_TRACE_TYPE_RECV,
                            elem->am_id, elem + 1, elem->length, "RX: AM_SHORT");
@@ -227,31 +369,57 @@ static inline ucs_status_t uct_mm_iface_process_recv(uct_mm_iface_t *iface,
     return status;
 }
 
-static inline unsigned uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
+static UCS_F_ALWAYS_INLINE uct_mm_fifo_element_t*
+uct_mm_iface_fifo_elem(uct_mm_iface_t *iface, void *fifo_elements,
+                       uint64_t index)
 {
-    uint64_t read_index_loc, read_index;
-    uct_mm_fifo_element_t* read_index_elem;
-    ucs_status_t status;
+    return UCT_MM_IFACE_GET_FIFO_ELEM(iface, fifo_elements,
+                                      index & iface->fifo_mask);
+}
 
-    /* check the memory pool to make sure that there is a new descriptor available */
-    if (ucs_unlikely(iface->last_recv_desc == NULL)) {
-        UCT_TL_IFACE_GET_RX_DESC(&iface->super.super, &iface->recv_desc_mp,
-                                 iface->last_recv_desc, return 0);
-    }
+/* check the owner bit to see if there is a new element to read */
+static UCS_F_ALWAYS_INLINE int
+uct_mm_iface_fifo_elem_is_ready(uct_mm_iface_t *iface,
+                                uct_mm_fifo_element_t *elem, uint64_t index)
+{
+    return ((index >> iface->fifo_shift) & 1) == (elem->flags & 1);
+}
+
+static UCS_F_ALWAYS_INLINE unsigned
+uct_mm_iface_poll_fifo(uct_mm_iface_t *iface, uct_mm_fifo_ctl_t *fifo_ctl,
+                       void *fifo_elements, uint64_t *read_index_p,
+                       unsigned max_poll)
+{
+    uint64_t read_index      = *read_index_p;
+    uint64_t prev_read_index = read_index;
+    unsigned count           = 0;
+    int release_tail         = 0;
+    uct_mm_fifo_element_t *read_index_elem, *next_elem;
+    ucs_status_t status;
 
-    read_index = iface->read_index;
-    read_index_loc = (read_index & iface->fifo_mask);
     /* the fifo_element which the read_index points to */
-    read_index_elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elements ,read_index_loc);
+    read_index_elem = uct_mm_iface_fifo_elem(iface, fifo_elements, read_index);
 
-    /* check the read_index to see if there is a new item to read (checking the owner bit) */
-    if (((read_index >> iface->fifo_shift) & 1) == ((read_index_elem->flags) & 1)) {
+    while (uct_mm_iface_fifo_elem_is_ready(iface, read_index_elem, read_index) &&
+           (count < max_poll)) {
+
+        /* check the memory pool to make sure that there is a new descriptor available */
+        if (ucs_unlikely(iface->last_recv_desc == NULL)) {
+            UCT_TL_IFACE_GET_RX_DESC(&iface->super.super, &iface->recv_desc_mp,
+                                     iface->last_recv_desc, break);
+        }
 
         /* read from read_index_elem */
         ucs_memory_cpu_load_fence();
-        ucs_assert(iface->read_index <= iface->recv_fifo_ctl->head);
+        ucs_assert(read_index <= fifo_ctl->head);
 
-        status = uct_mm_iface_process_recv(iface, read_index_elem);
+        /* the next element is likely written by the senders already */
+        next_elem = uct_mm_iface_fifo_elem(iface, fifo_elements, read_index + 1);
+        ucs_prefetch(next_elem);
+
+        release_tail |= read_index_elem->flags & UCT_MM_FIFO_ELEM_FLAG_ZCOPY;
+        status        = uct_mm_iface_process_recv(iface, fifo_ctl,
+                                                  read_index_elem, read_index);
         if (status != UCS_OK) {
             /* the last_recv_desc is in use. get a new descriptor for it */
             UCT_TL_IFACE_GET_RX_DESC(&iface->super.super, &iface->recv_desc_mp,
@@ -259,14 +427,105 @@ static inline unsigned uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
         }
 
         /* raise the read_index. */
-        iface->read_index++;
+        read_index++;
+        read_index_elem = next_elem;
+        ++count;
+    }
 
-        uct_mm_progress_fifo_tail(iface);
+    *read_index_p = read_index;
+    uct_mm_progress_fifo_tail(iface, fifo_ctl, read_index, prev_read_index,
+                              release_tail);
 
-        return 1;
-    } else {
-        return 0;
+    return count;
+}
+
+static UCS_F_ALWAYS_INLINE int
+uct_mm_iface_lane_is_ready(uct_mm_iface_t *iface, uct_mm_iface_lane_t *lane)
+{
+    return uct_mm_iface_fifo_elem_is_ready(iface,
+                                           uct_mm_iface_fifo_elem(iface,
+                                                                  lane->fifo_elements,
+                                                                  lane->read_index),
+                                           lane->read_index);
+}
+
+/* poll the lanes whose bits are set in 'ready' and in 'mask', return the
+ * number of elements read, and the lane after the last polled one */
+static unsigned uct_mm_iface_poll_lanes_word(uct_mm_iface_t *iface,
+                                             unsigned word, uint64_t mask,
+                                             unsigned max_poll,
+                                             unsigned *next_lane_p)
+{
+    volatile uint64_t *ready = &iface->lanes_ready[word];
+    uint64_t lanes           = *ready & mask;
+    unsigned count           = 0;
+    uct_mm_iface_lane_t *lane;
+    unsigned bit;
+
+    ucs_for_each_bit(bit, lanes) {
+        if (count >= max_poll) {
+            break;
+        }
+
+        lane   = &iface->lanes[(word * 64) + bit];
+        count += uct_mm_iface_poll_fifo(iface, &lane->ctl->fifo,
+                                        lane->fifo_elements, &lane->read_index,
+                                        max_poll - count);
+        if (!uct_mm_iface_lane_is_ready(iface, lane)) {
+            /* the lane is drained. the sender sets the bit only if it finds it
+             * clear after writing an element, so check the lane again after
+             * clearing the bit */
+            ucs_atomic_and64(ready, ~UCS_BIT(bit));
+            if (uct_mm_iface_lane_is_ready(iface, lane)) {
+                ucs_atomic_or64(ready, UCS_BIT(bit));
+            }
+        }
+
+        *next_lane_p = (word * 64) + bit + 1;
+    }
+
+    return count;
+}
+
+static unsigned uct_mm_iface_poll_lanes(uct_mm_iface_t *iface,
+                                        unsigned max_poll)
+{
+    unsigned num_words  = ucs_div_round_up(iface->config.fifo_lanes, 64);
+    unsigned start_word = iface->lanes_poll_start / 64;
+    unsigned start_bit  = iface->lanes_poll_start % 64;
+    unsigned next_lane  = iface->lanes_poll_start;
+    unsigned count      = 0;
+    unsigned i, word;
+
+    /* round-robin over the lanes, starting after the last one polled in the
+     * previous call */
+    count += uct_mm_iface_poll_lanes_word(iface, start_word, ~UCS_MASK(start_bit),
+                                          max_poll, &next_lane);
+    for (i = 1; (i < num_words) && (count < max_poll); ++i) {
+        word   = (start_word + i) % num_words;
+        count += uct_mm_iface_poll_lanes_word(iface, word, UINT64_MAX,
+                                              max_poll - count, &next_lane);
+    }
+    if ((start_bit != 0) && (count < max_poll)) {
+        count += uct_mm_iface_poll_lanes_word(iface, start_word,
+                                              UCS_MASK(start_bit),
+                                              max_poll - count, &next_lane);
+    }
+
+    iface->lanes_poll_start = next_lane % iface->config.fifo_lanes;
+    return count;
+}
+
+static unsigned uct_mm_iface_progress_zcopy(uct_mm_iface_t *iface)
+{
+    unsigned count = 0;
+    uct_mm_ep_t *ep, *tmp;
+
+    ucs_list_for_each_safe(ep, tmp, &iface->zcopy_eps, zcopy_list) {
+        count += uct_mm_ep_progress_zcopy(ep);
     }
+
+    return count;
 }
 
 unsigned uct_mm_iface_progress(void *arg)
@@ -274,8 +533,21 @@ unsigned uct_mm_iface_progress(void *arg)
     uct_mm_iface_t *iface = arg;
     unsigned count;
 
-    /* progress receive */
-    count = uct_mm_iface_poll_fifo(iface);
+    /* progress receive, up to fifo_max_poll elements */
+    count = uct_mm_iface_poll_fifo(iface, iface->recv_fifo_ctl,
+                                   iface->recv_fifo_elements,
+                                   &iface->read_index,
+                                   iface->config.fifo_max_poll);
+
+    /* progress the per-sender FIFOs, up to fifo_max_poll elements as well */
+    if (iface->config.fifo_lanes > 0) {
+        count += uct_mm_iface_poll_lanes(iface, iface->config.fifo_max_poll);
+    }
+
+    /* complete the zcopy sends which the receivers are done with */
+    if (ucs_unlikely(!ucs_list_is_empty(&iface->zcopy_eps))) {
+        count += uct_mm_iface_progress_zcopy(iface);
+    }
 
     /* progress the pending sends (if there are any) */
     ucs_arbiter_dispatch(&iface->arbiter, 1, uct_mm_ep_process_pending, NULL);
@@ -316,12 +588,22 @@ static ucs_status_t uct_mm_iface_event_fd_arm(uct_iface_h tl_iface,
 
 static UCS_CLASS_DECLARE_DELETE_FUNC(uct_mm_iface_t, uct_iface_t);
 
+static ucs_mpool_ops_t uct_mm_zcopy_op_mpool_ops = {
+    ucs_mpool_chunk_malloc,
+    ucs_mpool_chunk_free,
+    NULL,
+    NULL
+};
+
 static uct_iface_ops_t uct_mm_iface_ops = {
     .ep_put_short             = uct_sm_ep_put_short,
     .ep_put_bcopy             = uct_sm_ep_put_bcopy,
+    .ep_put_zcopy             = uct_sm_ep_put_zcopy,
     .ep_get_bcopy             = uct_sm_ep_get_bcopy,
+    .ep_get_zcopy             = uct_sm_ep_get_zcopy,
     .ep_am_short              = uct_mm_ep_am_short,
     .ep_am_bcopy              = uct_mm_ep_am_bcopy,
+    .ep_am_zcopy              = uct_mm_ep_am_zcopy,
     .ep_atomic_cswap64        = uct_sm_ep_atomic_cswap64,
     .ep_atomic64_post         = uct_sm_ep_atomic64_post,
     .ep_atomic64_fetch        = uct_sm_ep_atomic64_fetch,
@@ -360,19 +642,104 @@ void uct_mm_iface_recv_desc_init(uct_iface_h tl_iface, void *obj, uct_mem_h memh
     desc->mpool_length = seg->length;
 }
 
-static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface, unsigned num_elems)
+static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface,
+                                       void *fifo_elements, unsigned num_elems)
 {
     uct_mm_fifo_element_t* fifo_elem_p;
     uct_mm_recv_desc_t *desc;
     unsigned i;
 
     for (i = 0; i < num_elems; i++) {
-        fifo_elem_p = UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elements, i);
+        fifo_elem_p = UCT_MM_IFACE_GET_FIFO_ELEM(iface, fifo_elements, i);
         desc = UCT_MM_IFACE_GET_DESC_START(iface, fifo_elem_p);
         ucs_mpool_put(desc);
     }
 }
 
+/* initiate the owner bit in all the FIFO elements and assign a receive
+ * descriptor per every FIFO element */
+static ucs_status_t uct_mm_iface_init_fifo_elems(uct_mm_iface_t *iface,
+                                                 void *fifo_elements)
+{
+    uct_mm_fifo_element_t* fifo_elem_p;
+    ucs_status_t status;
+    unsigned i;
+
+    for (i = 0; i < iface->config.fifo_size; i++) {
+        fifo_elem_p = UCT_MM_IFACE_GET_FIFO_ELEM(iface, fifo_elements, i);
+        fifo_elem_p->flags = UCT_MM_FIFO_ELEM_FLAG_OWNER;
+
+        status = uct_mm_assign_desc_to_fifo_elem(iface, fifo_elem_p, 1);
+        if (status != UCS_OK) {
+            ucs_error("Failed to allocate a descriptor for MM");
+            uct_mm_iface_free_rx_descs(iface, fifo_elements, i);
+            return status;
+        }
+    }
+
+    return UCS_OK;
+}
+
+static void uct_mm_iface_cleanup_lanes(uct_mm_iface_t *iface,
+                                       unsigned num_lanes)
+{
+    unsigned i;
+
+    for (i = 0; i < num_lanes; i++) {
+        uct_mm_iface_free_rx_descs(iface, iface->lanes[i].fifo_elements,
+                                   iface->config.fifo_size);
+    }
+
+    ucs_free(iface->lanes);
+}
+
+static ucs_status_t uct_mm_iface_init_lanes(uct_mm_iface_t *iface)
+{
+    uct_mm_iface_lane_t *lane;
+    ucs_status_t status;
+    unsigned i;
+
+    iface->lanes_poll_start = 0;
+
+    if (iface->config.fifo_lanes == 0) {
+        iface->lanes       = NULL;
+        iface->lanes_ready = NULL;
+        return UCS_OK;
+    }
+
+    iface->lanes = ucs_calloc(iface->config.fifo_lanes, sizeof(*iface->lanes),
+                              "mm_fifo_lanes");
+    if (iface->lanes == NULL) {
+        ucs_error("Failed to allocate %u MM FIFO lanes",
+                  iface->config.fifo_lanes);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    iface->lanes_ready = uct_mm_fifo_lanes_ready(iface, iface->recv_fifo_ctl);
+    memset((void*)iface->lanes_ready, 0, UCT_MM_FIFO_LANES_READY_SIZE(iface));
+
+    for (i = 0; i < iface->config.fifo_lanes; i++) {
+        lane                         = &iface->lanes[i];
+        lane->ctl                    = uct_mm_fifo_lane_ctl(iface,
+                                                            iface->recv_fifo_ctl,
+                                                            i);
+        lane->ctl->fifo.head         = 0;
+        lane->ctl->fifo.tail         = 0;
+        lane->ctl->fifo.zcopy_failed = UINT64_MAX;
+        lane->ctl->owner             = 0;
+        lane->fifo_elements          = uct_mm_fifo_lane_elems(lane->ctl);
+        lane->read_index             = 0;
+
+        status = uct_mm_iface_init_fifo_elems(iface, lane->fifo_elements);
+        if (status != UCS_OK) {
+            uct_mm_iface_cleanup_lanes(iface, i);
+            return status;
+        }
+    }
+
+    return UCS_OK;
+}
+
 ucs_status_t uct_mm_allocate_fifo_mem(uct_mm_iface_t *iface,
                                       uct_mm_iface_config_t *config, uct_md_h md)
 {
@@ -467,9 +834,7 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
                            const uct_iface_config_t *tl_config)
 {
     uct_mm_iface_config_t *mm_config = ucs_derived_of(tl_config, uct_mm_iface_config_t);
-    uct_mm_fifo_element_t* fifo_elem_p;
     ucs_status_t status;
-    unsigned i;
 
     UCS_CLASS_CALL_SUPER_INIT(uct_sm_iface_t, &uct_mm_iface_ops, md,
                               worker, params, tl_config);
@@ -495,11 +860,18 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto err;
     }
 
+    if (mm_config->fifo_max_poll == 0) {
+        ucs_error("The MM FIFO max poll must be greater than 0.");
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     /* check the value defining the size of the FIFO element */
-    if (mm_config->fifo_elem_size <= sizeof(uct_mm_fifo_element_t)) {
-        ucs_error("The UCT_MM_MAX_SHORT parameter must be larger than the FIFO "
-                  "element header size. ( > %ld bytes).",
-                  sizeof(uct_mm_fifo_element_t));
+    if (mm_config->fifo_elem_size <= (sizeof(uct_mm_fifo_element_t) +
+                                      sizeof(uct_mm_zcopy_desc_t))) {
+        ucs_error("The UCT_MM_FIFO_ELEM_SIZE parameter must be larger than the "
+                  "FIFO element and zcopy headers size. ( > %ld bytes).",
+                  sizeof(uct_mm_fifo_element_t) + sizeof(uct_mm_zcopy_desc_t));
         status = UCS_ERR_INVALID_PARAM;
         goto err;
     }
@@ -507,6 +879,11 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
     self->config.fifo_size         = mm_config->fifo_size;
     self->config.fifo_elem_size    = mm_config->fifo_elem_size;
     self->config.seg_size          = mm_config->seg_size;
+    self->config.fifo_max_poll     = mm_config->fifo_max_poll;
+    self->config.zcopy_thresh      = (mm_config->zcopy_thresh == UCS_MEMUNITS_AUTO) ?
+                                     (mm_config->seg_size / 2) :
+                                     mm_config->zcopy_thresh;
+    self->config.fifo_lanes        = mm_config->fifo_lanes;
     /* cppcheck-suppress internalAstError */
     self->fifo_release_factor_mask = UCS_MASK(ucs_ilog2(ucs_max((int)
                                      (mm_config->fifo_size * mm_config->release_fifo_factor),
@@ -526,9 +903,10 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto err;
     }
 
-    self->recv_fifo_ctl->head   = 0;
-    self->recv_fifo_ctl->tail   = 0;
-    self->read_index            = 0;
+    self->recv_fifo_ctl->head         = 0;
+    self->recv_fifo_ctl->tail         = 0;
+    self->recv_fifo_ctl->zcopy_failed = UINT64_MAX;
+    self->read_index                  = 0;
 
     status = uct_mm_iface_create_signal_fd(self);
     if (status != UCS_OK) {
@@ -562,26 +940,38 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto destroy_recv_mpool;
     }
 
-    /* initiate the owner bit in all the FIFO elements and assign a receive descriptor
-     * per every FIFO element */
-    for (i = 0; i < mm_config->fifo_size; i++) {
-        fifo_elem_p = UCT_MM_IFACE_GET_FIFO_ELEM(self, self->recv_fifo_elements, i);
-        fifo_elem_p->flags = UCT_MM_FIFO_ELEM_FLAG_OWNER;
+    status = uct_mm_iface_init_fifo_elems(self, self->recv_fifo_elements);
+    if (status != UCS_OK) {
+        goto destroy_last_desc;
+    }
 
-        status = uct_mm_assign_desc_to_fifo_elem(self, fifo_elem_p, 1);
-        if (status != UCS_OK) {
-            ucs_error("Failed to allocate a descriptor for MM");
-            goto destroy_descs;
-        }
+    /* the per-sender FIFOs follow the shared one */
+    status = uct_mm_iface_init_lanes(self);
+    if (status != UCS_OK) {
+        goto destroy_descs;
     }
 
+    status = ucs_mpool_init(&self->zcopy_op_mp, 0, sizeof(uct_mm_zcopy_op_t),
+                            0, UCS_SYS_CACHE_LINE_SIZE, 32, UINT_MAX,
+                            &uct_mm_zcopy_op_mpool_ops, "mm_zcopy_op");
+    if (status != UCS_OK) {
+        goto destroy_lanes;
+    }
+
+    ucs_list_head_init(&self->zcopy_eps);
+    sglib_hashed_uct_mm_remote_seg_t_init(self->zcopy_segs_hash);
+
     ucs_arbiter_init(&self->arbiter);
 
     ucs_debug("Created an MM iface. FIFO mm id: %zu", self->fifo_mm_id);
     return UCS_OK;
 
+destroy_lanes:
+    uct_mm_iface_cleanup_lanes(self, self->config.fifo_lanes);
 destroy_descs:
-    uct_mm_iface_free_rx_descs(self, i);
+    uct_mm_iface_free_rx_descs(self, self->recv_fifo_elements,
+                               self->config.fifo_size);
+destroy_last_desc:
     ucs_mpool_put(self->last_recv_desc);
 destroy_recv_mpool:
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
@@ -594,6 +984,21 @@ err:
     return status;
 }
 
+static void uct_mm_iface_zcopy_segs_cleanup(uct_mm_iface_t *iface)
+{
+    struct sglib_hashed_uct_mm_remote_seg_t_iterator iter;
+    uct_mm_remote_seg_t *remote_seg;
+
+    for (remote_seg = sglib_hashed_uct_mm_remote_seg_t_it_init(&iter,
+                                                                iface->zcopy_segs_hash);
+         remote_seg != NULL;
+         remote_seg = sglib_hashed_uct_mm_remote_seg_t_it_next(&iter)) {
+        sglib_hashed_uct_mm_remote_seg_t_delete(iface->zcopy_segs_hash,
+                                                remote_seg);
+        uct_mm_iface_zcopy_seg_put(iface, remote_seg);
+    }
+}
+
 static UCS_CLASS_CLEANUP_FUNC(uct_mm_iface_t)
 {
     ucs_status_t status;
@@ -604,10 +1009,14 @@ static UCS_CLASS_CLEANUP_FUNC(uct_mm_iface_t)
 
     /* return all the descriptors that are now 'assigned' to the FIFO,
      * to their mpool */
-    uct_mm_iface_free_rx_descs(self, self->config.fifo_size);
+    uct_mm_iface_free_rx_descs(self, self->recv_fifo_elements,
+                               self->config.fifo_size);
+    uct_mm_iface_cleanup_lanes(self, self->config.fifo_lanes);
 
     ucs_mpool_put(self->last_recv_desc);
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
+    ucs_mpool_cleanup(&self->zcopy_op_mp, 1);
+    uct_mm_iface_zcopy_segs_cleanup(self);
     close(self->signal_fd);
 
     size_to_free = UCT_MM_GET_FIFO_SIZE(self);
@@ -16,6 +16,8 @@
 #include <ucs/arch/cpu.h>
 #include <ucs/debug/memtrack.h>
 #include <ucs/datastruct/arbiter.h>
+#include <ucs/datastruct/list.h>
+#include <ucs/datastruct/mpool.h>
 #include <ucs/sys/compiler.h>
 #include <ucs/sys/sys.h>
 #include <sys/shm.h>
@@ -24,10 +26,31 @@
 
 #define UCT_MM_FIFO_CTL_SIZE_ALIGNED  ucs_align_up(sizeof(uct_mm_fifo_ctl_t),UCS_SYS_CACHE_LINE_SIZE)
 
+#define UCT_MM_FIFO_LANE_CTL_SIZE_ALIGNED  ucs_align_up(sizeof(uct_mm_fifo_lane_ctl_t),UCS_SYS_CACHE_LINE_SIZE)
+
+#define UCT_MM_FIFO_ELEMS_SIZE_ALIGNED(iface) \
+    ucs_align_up((iface)->config.fifo_size * (iface)->config.fifo_elem_size, \
+                 UCS_SYS_CACHE_LINE_SIZE)
+
+/* size of a per-sender FIFO: its control struct and its elements */
+#define UCT_MM_FIFO_LANE_SIZE(iface) \
+    (UCT_MM_FIFO_LANE_CTL_SIZE_ALIGNED + UCT_MM_FIFO_ELEMS_SIZE_ALIGNED(iface))
+
+/* size of the ready bitmap of the per-sender FIFOs */
+#define UCT_MM_FIFO_LANES_READY_SIZE(iface) \
+    ucs_align_up(ucs_div_round_up((iface)->config.fifo_lanes, 64) * \
+                 sizeof(uint64_t), UCS_SYS_CACHE_LINE_SIZE)
+
+/* maximal AM zcopy header, it is copied to a receive descriptor with the payload */
+#define UCT_MM_IFACE_AM_MAX_HDR(iface) \
+    ((iface)->config.fifo_elem_size - sizeof(uct_mm_fifo_element_t))
+
 #define UCT_MM_GET_FIFO_SIZE(iface)  (UCS_SYS_CACHE_LINE_SIZE - 1 +  \
                                       UCT_MM_FIFO_CTL_SIZE_ALIGNED + \
-                                     ((iface)->config.fifo_size *    \
-                                     (iface)->config.fifo_elem_size))
+                                      UCT_MM_FIFO_ELEMS_SIZE_ALIGNED(iface) + \
+                                      ((iface)->config.fifo_lanes *  \
+                                       UCT_MM_FIFO_LANE_SIZE(iface)) + \
+                                      UCT_MM_FIFO_LANES_READY_SIZE(iface))
 
 
 typedef struct uct_mm_iface_config {
@@ -39,6 +62,12 @@ typedef struct uct_mm_iface_config {
     ucs_ternary_value_t      hugetlb_mode;        /* Enable using huge pages for
                                                    * shared memory buffers */
     unsigned                 fifo_elem_size;      /* Size of the FIFO element size */
+    unsigned                 fifo_max_poll;       /* Maximal number of FIFO
+                                                   * elements to handle in one
+                                                   * progress call */
+    size_t                   zcopy_thresh;        /* Minimal AM zcopy payload to
+                                                   * pass in the sender's segment */
+    unsigned                 fifo_lanes;          /* Number of per-sender FIFOs */
     uct_iface_mpool_config_t mp;
 } uct_mm_iface_config_t;
 
@@ -52,9 +81,34 @@ struct uct_mm_fifo_ctl {
 
     /* 2nd cacheline */
     volatile uint64_t  tail;       /* how much was read */
+    volatile uint64_t  zcopy_failed; /* index of the last AM zcopy element
+                                        whose payload could not be read */
+} UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE);
+
+
+/*
+ * Control struct of a per-sender FIFO ("lane"). Only the sender which owns the
+ * lane writes its head, so it is advanced without an atomic operation.
+ */
+struct uct_mm_fifo_lane_ctl {
+    uct_mm_fifo_ctl_t  fifo;       /* head and tail of the lane */
+
+    /* next cacheline */
+    volatile uint64_t  owner;      /* pid of the sender which uses the lane,
+                                      or 0 if the lane is free */
 } UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE);
 
 
+/*
+ * Receive side of a per-sender FIFO
+ */
+typedef struct uct_mm_iface_lane {
+    uct_mm_fifo_lane_ctl_t  *ctl;
+    void                    *fifo_elements;
+    uint64_t                read_index;
+} uct_mm_iface_lane_t;
+
+
 struct uct_mm_iface {
     uct_sm_iface_t          super;
 
@@ -87,10 +141,24 @@ struct uct_mm_iface {
     const char              *path;            /* path to the backing file (for 'posix') */
     uct_recv_desc_t         release_desc;
 
+    ucs_mpool_t             zcopy_op_mp;      /* outstanding AM zcopy sends */
+    ucs_list_link_t         zcopy_eps;        /* eps with outstanding AM zcopy */
+    /* segments of AM zcopy senders, attached when their first message is
+     * received */
+    uct_mm_remote_seg_t     *zcopy_segs_hash[UCT_MM_BASE_ADDRESS_HASH_SIZE];
+
+    uct_mm_iface_lane_t     *lanes;           /* per-sender FIFOs */
+    volatile uint64_t       *lanes_ready;     /* bitmap of lanes which have
+                                                 elements to read */
+    unsigned                lanes_poll_start; /* lane to poll first */
+
     struct {
         unsigned fifo_size;
         unsigned fifo_elem_size;
         unsigned seg_size;                    /* size of the receive descriptor (for payload)*/
+        unsigned fifo_max_poll;               /* max. FIFO elements to handle per progress */
+        size_t   zcopy_thresh;                /* min. AM zcopy payload to publish */
+        unsigned fifo_lanes;                  /* number of per-sender FIFOs */
     } config;
 };
 
@@ -112,6 +180,20 @@ struct uct_mm_fifo_element {
 } UCS_S_PACKED;
 
 
+/*
+ * Placed in the FIFO element data of an AM zcopy message whose payload stays
+ * in the sender's memory segment. Such a message has no AM header.
+ */
+struct uct_mm_zcopy_desc {
+    uct_mm_id_t     mmid;           /* the mmid of the sender's segment */
+    uint64_t        serial;         /* serial of the segment in the sender */
+    void            *seg_address;   /* segment address in the sender */
+    size_t          seg_length;     /* segment length */
+    size_t          offset;         /* payload offset within the segment */
+    size_t          length;         /* payload length */
+} UCS_S_PACKED;
+
+
 struct uct_mm_recv_desc {
     uct_mm_id_t         key;
     void                *base_address;
@@ -185,6 +267,37 @@ static inline void uct_mm_set_fifo_elems_ptr(void *mem_region, void **fifo_elems
    *fifo_elems = (void*) fifo_ctl + UCT_MM_FIFO_CTL_SIZE_ALIGNED;
 }
 
+/**
+ * Get the control struct of a per-sender FIFO. Its elements follow it.
+ *
+ * @param [in] iface     interface which defines the FIFO layout.
+ * @param [in] fifo_ctl  control struct of the shared FIFO.
+ * @param [in] lane      index of the per-sender FIFO.
+ */
+static inline uct_mm_fifo_lane_ctl_t*
+uct_mm_fifo_lane_ctl(uct_mm_iface_t *iface, uct_mm_fifo_ctl_t *fifo_ctl,
+                     unsigned lane)
+{
+    return (void*)fifo_ctl + UCT_MM_FIFO_CTL_SIZE_ALIGNED +
+           UCT_MM_FIFO_ELEMS_SIZE_ALIGNED(iface) +
+           (lane * UCT_MM_FIFO_LANE_SIZE(iface));
+}
+
+static inline void* uct_mm_fifo_lane_elems(uct_mm_fifo_lane_ctl_t *lane_ctl)
+{
+    return (void*)lane_ctl + UCT_MM_FIFO_LANE_CTL_SIZE_ALIGNED;
+}
+
+/**
+ * Get the ready bitmap of the per-sender FIFOs, which follows the last one.
+ */
+static inline volatile uint64_t*
+uct_mm_fifo_lanes_ready(uct_mm_iface_t *iface, uct_mm_fifo_ctl_t *fifo_ctl)
+{
+    return (volatile uint64_t*)uct_mm_fifo_lane_ctl(iface, fifo_ctl,
+                                                    iface->config.fifo_lanes);
+}
+
 UCS_CLASS_DECLARE_NEW_FUNC(uct_mm_iface_t, uct_iface_t, uct_md_h, uct_worker_h,
                            const uct_iface_params_t*, const uct_iface_config_t*);
 
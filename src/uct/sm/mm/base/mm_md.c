@@ -12,6 +12,7 @@
 #include "mm_md.h"
 
 #include <ucs/debug/log.h>
+#include <ucs/arch/atomic.h>
 #include <inttypes.h>
 #include <limits.h>
 
@@ -45,6 +46,9 @@ ucs_status_t uct_mm_query_md_resources(uct_component_t *component,
     }
 }
 
+/* serial numbers of the local segments */
+static volatile uint64_t uct_mm_seg_serial = 0;
+
 ucs_status_t uct_mm_mem_alloc(uct_md_h md, size_t *length_p, void **address_p,
                               unsigned flags, const char *alloc_name,
                               uct_mem_h *memh_p)
@@ -69,6 +73,7 @@ ucs_status_t uct_mm_mem_alloc(uct_md_h md, size_t *length_p, void **address_p,
 
     seg->length  = *length_p;
     seg->address = *address_p;
+    seg->serial  = ucs_atomic_fadd64(&uct_mm_seg_serial, 1);
     *memh_p      = seg;
 
     ucs_debug("mm allocated address %p length %zu mmid %"PRIu64,
@@ -112,6 +117,7 @@ ucs_status_t uct_mm_mem_reg(uct_md_h md, void *address, size_t length,
 
     seg->length  = length;
     seg->address = address;
+    seg->serial  = ucs_atomic_fadd64(&uct_mm_seg_serial, 1);
     *memh_p      = seg;
 
     ucs_debug("mm registered address %p length %zu mmid %"PRIu64,
@@ -30,6 +30,7 @@ struct uct_mm_remote_seg {
     void        *address;    /**< local memory address */
     uint64_t    cookie;      /**< cookie for mmap, xpmem, etc. */
     size_t      length;      /**< size of the memory */
+    uint64_t    serial;      /**< serial of the remote segment, if known */
 };
 
 /*
@@ -125,6 +126,8 @@ typedef struct uct_mm_seg {
     void             *address;   /* Virtual address */
     size_t           length;     /* Size of the memory */
     const char       *path;      /* Path to the backing file when using posix */
+    uint64_t         serial;     /* Unique in the process, tells apart segments
+                                    whose mmid was reused */
 } uct_mm_seg_t;
 
 
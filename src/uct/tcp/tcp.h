@@ -13,6 +13,7 @@
 #include <ucs/datastruct/khash.h>
 #include <ucs/algorithm/crc.h>
 #include <ucs/sys/event_set.h>
+#include <ucs/type/spinlock.h>
 
 #include <net/if.h>
 
@@ -33,6 +34,26 @@
  * (TCP protocol and user's AM headers, payload) */
 #define UCT_TCP_EP_AM_SHORTV_IOV_COUNT        3
 
+/* How many IOVs are needed to keep PUT/GET Zcopy service data
+ * (TCP protocol and RMA headers) */
+#define UCT_TCP_EP_RMA_ZCOPY_SERVICE_IOV_COUNT 2
+
+/* Maximum number of sockets used by an endpoint to send active messages */
+#define UCT_TCP_EP_MAX_SOCKETS                16
+
+
+/**
+ * TCP progress engine, which detects socket events
+ */
+typedef enum uct_tcp_progress_engine {
+    UCT_TCP_PROGRESS_ENGINE_EPOLL,    /* Wait for readiness of the sockets and
+                                       * do I/O syscalls on each of them */
+    UCT_TCP_PROGRESS_ENGINE_IO_URING, /* Keep receive and poll operations posted
+                                       * to io_uring and reap their completions
+                                       * in batches */
+    UCT_TCP_PROGRESS_ENGINE_LAST
+} uct_tcp_progress_engine_t;
+
 
 /**
  * TCP context type
@@ -54,6 +75,31 @@ typedef enum uct_tcp_ep_ctx_type {
 } uct_tcp_ep_ctx_type_t;
 
 
+/**
+ * TCP packet IDs used by the transport itself. They follow user's AM IDs
+ * and share TCP active message header with them.
+ */
+enum {
+    /* Connection management packet */
+    UCT_TCP_EP_CM_AM_ID      = UCT_AM_ID_MAX,
+    /* PUT Zcopy request, followed by the data to write */
+    UCT_TCP_EP_PUT_REQ_AM_ID,
+    /* GET Zcopy request */
+    UCT_TCP_EP_GET_REQ_AM_ID,
+    /* Reply to PUT/GET Zcopy request: PUT acknowledgment, or GET reply
+     * followed by the requested data */
+    UCT_TCP_EP_RMA_REP_AM_ID,
+    /* Beginning of AM whose payload is split between the stripe sockets */
+    UCT_TCP_EP_STRIPE_AM_ID,
+    /* PUT Zcopy request followed by the first chunk of the data, the next
+     * chunks are sent on the stripe sockets */
+    UCT_TCP_EP_STRIPE_PUT_REQ_AM_ID,
+    /* GET Zcopy request, the first chunk of the data is replied on the EP
+     * socket and the next chunks - on the stripe sockets */
+    UCT_TCP_EP_STRIPE_GET_REQ_AM_ID
+};
+
+
 /**
  * TCP endpoint connection state
  */
@@ -87,6 +133,8 @@ typedef enum uct_tcp_ep_conn_state {
 
 /* Forward declaration */
 typedef struct uct_tcp_ep uct_tcp_ep_t;
+typedef struct uct_tcp_uring uct_tcp_uring_t;
+typedef struct uct_tcp_uring_op uct_tcp_uring_op_t;
 
 typedef unsigned (*uct_tcp_ep_progress_t)(uct_tcp_ep_t *ep);
 
@@ -118,6 +166,40 @@ KHASH_INIT(uct_tcp_cm_eps, struct sockaddr_in, ucs_list_link_t*,
            1, uct_tcp_khash_sockaddr_in_hash, uct_tcp_khash_sockaddr_in_equal);
 
 
+/**
+ * TCP memory region, registered for PUT/GET Zcopy access by the peers
+ */
+typedef struct uct_tcp_mem {
+    uint64_t              key;         /* Registration key, sent by the peers
+                                        * in RMA requests */
+    uintptr_t             address;     /* Start address of the region */
+    size_t                length;      /* Length of the region */
+} uct_tcp_mem_t;
+
+
+/**
+ * TCP remote key, as packed to the buffer and unpacked by the peer
+ */
+typedef struct uct_tcp_rkey {
+    uint64_t              key;         /* Registration key */
+    uint64_t              address;     /* Start address of the region */
+    uint64_t              length;      /* Length of the region */
+} UCS_S_PACKED uct_tcp_rkey_t;
+
+
+KHASH_MAP_INIT_INT64(uct_tcp_md_mems, uct_tcp_mem_t*);
+
+
+/**
+ * TCP memory domain
+ */
+typedef struct uct_tcp_md {
+    uct_md_t                 super;
+    ucs_spinlock_t           lock;     /* Protects the registrations hash */
+    khash_t(uct_tcp_md_mems) mems;     /* Registered regions by key */
+} uct_tcp_md_t;
+
+
 /**
  * TCP Connection Manager state
  */
@@ -154,7 +236,11 @@ typedef enum uct_tcp_cm_conn_event {
      * `UCT_TCP_CM_CONN_REQ` was sent) and want to have RX capability on a
      * peer's EP in order to send AM data. */
     UCT_TCP_CM_CONN_ACK_WITH_WAIT_REQ = (UCT_TCP_CM_CONN_WAIT_REQ |
-                                         UCT_TCP_CM_CONN_ACK)
+                                         UCT_TCP_CM_CONN_ACK),
+    /* Request to attach the connection as a stripe socket to the EP which
+     * owns the connection specified in the request. The peer replies with
+     * `UCT_TCP_CM_CONN_ACK`. */
+    UCT_TCP_CM_CONN_STRIPE_REQ        = UCS_BIT(3)
 } uct_tcp_cm_conn_event_t;
 
 
@@ -167,6 +253,20 @@ typedef struct uct_tcp_cm_conn_req_pkt {
 } UCS_S_PACKED uct_tcp_cm_conn_req_pkt_t;
 
 
+/**
+ * TCP stripe connection request packet
+ */
+typedef struct uct_tcp_cm_stripe_req_pkt {
+    uct_tcp_cm_conn_event_t       event;
+    struct sockaddr_in            iface_addr;  /* Iface address of the sender */
+    struct sockaddr_in            conn_addr;   /* Local address of the owner
+                                                * EP connection */
+    struct sockaddr_in            peer_addr;   /* Remote address of the owner
+                                                * EP connection */
+    uint8_t                       index;       /* Index of the stripe socket */
+} UCS_S_PACKED uct_tcp_cm_stripe_req_pkt_t;
+
+
 /**
  * TCP active message header
  */
@@ -176,6 +276,67 @@ typedef struct uct_tcp_am_hdr {
 } UCS_S_PACKED uct_tcp_am_hdr_t;
 
 
+/**
+ * TCP PUT/GET Zcopy header, the RMA payload (if any) follows it
+ * in the stream and is not accounted in uct_tcp_am_hdr_t::length
+ */
+typedef struct uct_tcp_ep_rma_hdr {
+    uint64_t                      key;       /* Registration key of the remote
+                                              * memory */
+    uint64_t                      address;   /* Remote address */
+    uint64_t                      length;    /* Length of the RMA payload */
+} UCS_S_PACKED uct_tcp_ep_rma_hdr_t;
+
+
+/**
+ * TCP striped AM header. It is followed by the user's header and the first
+ * chunk of the payload, each of the next chunks is sent without any header
+ * on the next stripe socket from the map
+ */
+typedef struct uct_tcp_ep_stripe_hdr {
+    uint8_t                       am_id;     /* User's AM ID */
+    uint16_t                      map;       /* Stripe sockets which carry
+                                              * the next chunks */
+    uint32_t                      length;    /* Total length of AM data */
+    uint32_t                      chunk;     /* Length of payload chunk on
+                                              * each socket */
+} UCS_S_PACKED uct_tcp_ep_stripe_hdr_t;
+
+
+/**
+ * TCP striped PUT/GET Zcopy header. The length of RMA header is the total
+ * length of the data, the first chunk of which is transferred on the EP
+ * socket and each of the next chunks - without any header on the next
+ * stripe socket from the map
+ */
+typedef struct uct_tcp_ep_stripe_rma_hdr {
+    uct_tcp_ep_rma_hdr_t          super;
+    uint16_t                      map;       /* Stripe sockets which carry
+                                              * the next chunks */
+    uint64_t                      chunk;     /* Length of data chunk on
+                                              * each socket */
+} UCS_S_PACKED uct_tcp_ep_stripe_rma_hdr_t;
+
+
+/**
+ * TCP RMA operation: PUT/GET Zcopy waiting for a reply or a flush waiting for
+ * preceding PUT/GET Zcopy operations on the initiator side, or a reply waiting
+ * for TX resources on the target side
+ */
+typedef struct uct_tcp_ep_rma_op {
+    ucs_queue_elem_t              queue;
+    void                          *buffer;   /* Local buffer to receive/send
+                                              * the data to/from */
+    size_t                        length;    /* Length of the data */
+    uct_completion_t              *comp;     /* User's completion */
+    int                           is_flush;  /* Whether this is flush request */
+    unsigned                      pending;   /* How many chunks of striped
+                                              * GET Zcopy reply are not
+                                              * received on the stripe
+                                              * sockets yet */
+} uct_tcp_ep_rma_op_t;
+
+
 /**
  * TCP endpoint communication context
  */
@@ -195,6 +356,13 @@ typedef struct uct_tcp_ep_zcopy_ctx {
     uct_completion_t              *comp;
     size_t                        iov_index;
     size_t                        iov_cnt;
+    int                           msg_zcopy;   /* Whether the data is sent with
+                                                * MSG_ZEROCOPY */
+    uint32_t                      sn;          /* Sequence number of the last
+                                                * MSG_ZEROCOPY send call */
+    ucs_queue_elem_t              queue;       /* Element in the queue of sends
+                                                * waiting for completion of
+                                                * MSG_ZEROCOPY */
     struct iovec                  iov[0];
 } uct_tcp_ep_zcopy_ctx_t;
 
@@ -210,8 +378,70 @@ struct uct_tcp_ep {
     int                           events;      /* Current notifications */
     uct_tcp_ep_ctx_t              tx;          /* TX resources */
     uct_tcp_ep_ctx_t              rx;          /* RX resources */
+    struct {
+        void                      *buf;        /* Where to receive RMA payload */
+        size_t                    length;      /* Remaining RMA payload length */
+        uct_tcp_ep_rma_op_t       *op;         /* GET Zcopy to complete, or NULL
+                                                * for PUT Zcopy */
+    } rma_rx;                                  /* RMA payload being received */
     struct sockaddr_in            peer_addr;   /* Remote iface addr */
     ucs_queue_head_t              pending_q;   /* Pending operations */
+    ucs_queue_head_t              rma_q;       /* PUT/GET Zcopy operations and
+                                                * flush requests waiting for
+                                                * replies */
+    ucs_queue_head_t              rma_rep_q;   /* PUT/GET replies waiting for
+                                                * TX resources */
+    struct {
+        ucs_queue_head_t          queue;       /* AM Zcopy operations and flush
+                                                * requests waiting for the
+                                                * kernel to release buffers */
+        uint32_t                  sn;          /* Sequence number of the next
+                                                * MSG_ZEROCOPY send call */
+        uint32_t                  done_sn;     /* Sequence number of the next
+                                                * send call to be completed */
+    } msg_zcopy;
+    struct {
+        uct_tcp_ep_t              *owner;      /* EP which uses this socket as
+                                                * a stripe, or NULL */
+        uct_tcp_ep_t              **tx_eps;    /* Stripe sockets to send AM
+                                                * payload chunks */
+        uct_tcp_ep_t              **rx_eps;    /* Stripe sockets to receive AM
+                                                * payload chunks */
+        uct_tcp_am_hdr_t          *rx_hdr;     /* Striped AM being assembled,
+                                                * or NULL for striped PUT */
+        unsigned                  rx_pending;  /* How many chunks of the AM
+                                                * or PUT are not received
+                                                * yet */
+        uct_tcp_ep_rma_op_t       *rx_op;      /* GET Zcopy waiting for the
+                                                * chunks from stripe sockets */
+        int                       tx_failed;   /* Whether sending a chunk
+                                                * failed and the connection
+                                                * was broken */
+        void                      *buf;        /* Where to receive a chunk */
+        size_t                    length;      /* Remaining chunk length */
+        uct_tcp_ep_rma_op_t       *op;         /* GET Zcopy which the chunk
+                                                * belongs to, or NULL */
+    } stripe;
+    struct {
+        uct_tcp_uring_op_t        *rx_op;      /* Posted receive operation */
+        uct_tcp_uring_op_t        *poll_op;    /* Posted poll operation */
+        void                      *rx_buf;     /* RX buffer with received data
+                                                * which isn't handled yet */
+        void                      *rx_dest;    /* Destination of the posted
+                                                * receive, or NULL if the data
+                                                * is received to a provided
+                                                * RX buffer */
+        size_t                    rx_offset;   /* Offset of the data which
+                                                * isn't handled yet */
+        size_t                    rx_length;   /* Length of the data which
+                                                * isn't handled yet */
+        ucs_status_t              rx_status;   /* Status of the last receive */
+        int                       rx_nobufs;   /* No provided buffer was
+                                                * available for the last
+                                                * receive */
+        ucs_list_link_t           list;        /* Element in the list of EPs
+                                                * to post the operations for */
+    } uring;                                   /* io_uring progress engine */
     ucs_list_link_t               list;
 };
 
@@ -227,14 +457,27 @@ typedef struct uct_tcp_iface {
     ucs_list_link_t               ep_list;           /* List of endpoints */
     char                          if_name[IFNAMSIZ]; /* Network interface name */
     ucs_sys_event_set_t           *event_set;        /* Event set identifier */
+    uct_tcp_uring_t               *uring;            /* io_uring progress engine,
+                                                      * or NULL if event set is used */
     ucs_mpool_t                   tx_mpool;          /* TX memory pool */
     ucs_mpool_t                   rx_mpool;          /* RX memory pool */
+    ucs_mpool_t                   rma_op_mpool;      /* RMA operations memory pool */
+    uct_recv_desc_t               release_desc;      /* Callback to release RX buffer
+                                                      * kept by the user */
+    size_t                        rx_headroom;       /* User's headroom in RX buffer */
     size_t                        outstanding;       /* How much data in the EP send buffers
                                                       * + how many non-blocking connections
                                                       * are in progress */
     struct {
         size_t                    tx_seg_size;       /* TX AM buffer size */
         size_t                    rx_seg_size;       /* RX AM buffer size */
+        size_t                    rx_buf_offset;     /* Offset of AM data in RX buffer,
+                                                      * the space before is reserved for
+                                                      * release descriptor and user's
+                                                      * headroom */
+        size_t                    rx_hdr_first_thresh; /* Minimum size of AM payload
+                                                        * that is received in
+                                                        * header-first mode */
         size_t                    sendv_thresh;      /* Minimum size of user's payload from which
                                                       * non-blocking vector send should be used */
         struct {
@@ -244,7 +487,16 @@ typedef struct uct_tcp_iface {
             size_t                max_hdr;           /* Maximum supported AM Zcopy header */
             size_t                hdr_offset;        /* Offset in TX buffer to empty space that
                                                       * can be used for AM Zcopy header */
+            size_t                msg_zcopy_thresh;  /* Minimum size of AM Zcopy payload
+                                                      * which is sent with MSG_ZEROCOPY */
         } zcopy;
+        struct {
+            unsigned              count;             /* Number of stripe sockets
+                                                      * per EP */
+            size_t                thresh;            /* Minimum size of AM Zcopy payload
+                                                      * or PUT/GET Zcopy data which is
+                                                      * split between them */
+        } stripe;
         struct sockaddr_in        ifaddr;            /* Network address */
         struct sockaddr_in        netmask;           /* Network address mask */
         int                       prefer_default;    /* Prefer default gateway */
@@ -266,10 +518,17 @@ typedef struct uct_tcp_iface_config {
     uct_iface_config_t            super;
     size_t                        tx_seg_size;
     size_t                        rx_seg_size;
+    size_t                        rx_hdr_first_thresh;
     size_t                        max_iov;
     size_t                        sendv_thresh;
+    size_t                        msg_zcopy_thresh;
+    unsigned                      sockets_per_ep;
+    size_t                        stripe_thresh;
     int                           prefer_default;
     unsigned                      max_poll;
+    uct_tcp_progress_engine_t     progress_engine;
+    unsigned                      io_uring_entries;
+    unsigned                      io_uring_rx_bufs;
     int                           sockopt_nodelay;
     size_t                        sockopt_sndbuf;
     size_t                        sockopt_rcvbuf;
@@ -282,6 +541,9 @@ extern uct_component_t uct_tcp_component;
 extern const char *uct_tcp_address_type_names[];
 extern const uct_tcp_cm_state_t uct_tcp_ep_cm_state[];
 
+ucs_status_t uct_tcp_md_check_access(uct_tcp_md_t *md, uint64_t key,
+                                     uint64_t address, uint64_t length);
+
 ucs_status_t uct_tcp_netif_caps(const char *if_name, double *latency_p,
                                 double *bandwidth_p, size_t *mtu_p);
 
@@ -307,6 +569,32 @@ void uct_tcp_iface_add_ep(uct_tcp_ep_t *ep);
 
 void uct_tcp_iface_remove_ep(uct_tcp_ep_t *ep);
 
+void uct_tcp_iface_handle_events(void *callback_data, int events, void *arg);
+
+ucs_status_t uct_tcp_uring_create(uct_tcp_iface_t *iface, unsigned entries,
+                                  unsigned rx_bufs, uct_tcp_uring_t **uring_p);
+
+void uct_tcp_uring_destroy(uct_tcp_uring_t *uring);
+
+int uct_tcp_uring_fd(uct_tcp_uring_t *uring);
+
+unsigned uct_tcp_uring_progress(uct_tcp_iface_t *iface);
+
+ucs_status_t uct_tcp_uring_arm(uct_tcp_iface_t *iface);
+
+void uct_tcp_uring_wakeup(uct_tcp_uring_t *uring);
+
+void uct_tcp_uring_ep_cleanup(uct_tcp_ep_t *ep);
+
+void uct_tcp_uring_ep_update(uct_tcp_ep_t *ep);
+
+void uct_tcp_uring_ep_move_rx(uct_tcp_ep_t *from_ep, uct_tcp_ep_t *to_ep);
+
+ucs_status_t uct_tcp_uring_ep_recv(uct_tcp_ep_t *ep, void *buf,
+                                   size_t *length_p);
+
+int uct_tcp_uring_ep_rx_adopt(uct_tcp_ep_t *ep);
+
 ucs_status_t uct_tcp_ep_init(uct_tcp_iface_t *iface, int fd,
                              const struct sockaddr_in *dest_addr,
                              uct_tcp_ep_t **ep_p);
@@ -341,6 +629,17 @@ void uct_tcp_ep_add(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep);
 
 unsigned uct_tcp_ep_progress_rx(uct_tcp_ep_t *ep);
 
+size_t uct_tcp_ep_rx_dest(uct_tcp_ep_t *ep, void **dest_p);
+
+ucs_status_t uct_tcp_ep_io_err_handler_cb(void *arg, int io_errno);
+
+unsigned uct_tcp_ep_progress_msg_zcopy(uct_tcp_ep_t *ep);
+
+void uct_tcp_ep_stripes_connect(uct_tcp_ep_t *ep);
+
+ucs_status_t uct_tcp_ep_stripe_attach(uct_tcp_ep_t *owner, uct_tcp_ep_t *ep,
+                                      unsigned index);
+
 void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, int add, int remove);
 
 void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep);
@@ -357,6 +656,14 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
                                  size_t iovcnt, unsigned flags,
                                  uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags);
 
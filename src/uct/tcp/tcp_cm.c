@@ -51,6 +51,10 @@ void uct_tcp_cm_change_conn_state(uct_tcp_ep_t *ep,
         if (ep->ctx_caps & UCS_BIT(UCT_TCP_EP_CTX_TYPE_TX)) {
             /* Progress possibly pending TX operations */
             uct_tcp_ep_pending_queue_dispatch(ep);
+            uct_tcp_ep_stripes_connect(ep);
+        } else if (ep->stripe.owner != NULL) {
+            /* Stripe socket is read only when AM payload chunk is expected */
+            uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVREAD);
         }
         break;
     case UCT_TCP_EP_CONN_STATE_CLOSED:
@@ -120,6 +124,13 @@ static void uct_tcp_cm_trace_conn_pkt(const uct_tcp_ep_t *ep,
         p += strlen(event_str);
     }
 
+    if (event & UCT_TCP_CM_CONN_STRIPE_REQ) {
+        ucs_assert(p == event_str);
+        ucs_snprintf_zero(event_str, sizeof(event_str), "%s",
+                          UCS_PP_MAKE_STRING(UCT_TCP_CM_CONN_STRIPE_REQ));
+        p += strlen(event_str);
+    }
+
     if (event & UCT_TCP_CM_CONN_WAIT_REQ) {
         ucs_assert(p == event_str);
         ucs_snprintf_zero(event_str, sizeof(event_str), "%s",
@@ -149,6 +160,57 @@ static void uct_tcp_cm_trace_conn_pkt(const uct_tcp_ep_t *ep,
                              str_addr, UCS_SOCKADDR_STRING_LEN));
 }
 
+static ucs_status_t uct_tcp_cm_get_conn_addrs(int fd,
+                                              struct sockaddr_in *local_addr,
+                                              struct sockaddr_in *remote_addr)
+{
+    socklen_t addr_len;
+
+    addr_len = sizeof(*local_addr);
+    if (getsockname(fd, (struct sockaddr*)local_addr, &addr_len) < 0) {
+        ucs_error("getsockname(fd=%d) failed: %m", fd);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    addr_len = sizeof(*remote_addr);
+    if (getpeername(fd, (struct sockaddr*)remote_addr, &addr_len) < 0) {
+        ucs_error("getpeername(fd=%d) failed: %m", fd);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_tcp_cm_stripe_req_pack(uct_tcp_ep_t *ep,
+                           uct_tcp_cm_stripe_req_pkt_t *stripe_pkt)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_t *owner    = ep->stripe.owner;
+    struct sockaddr_in conn_addr, peer_addr;
+    ucs_status_t status;
+    unsigned index;
+
+    for (index = 0; owner->stripe.tx_eps[index] != ep; ++index) {
+        ucs_assert(index < iface->config.stripe.count);
+    }
+
+    /* the packet isn't aligned in the TX buffer */
+    status = uct_tcp_cm_get_conn_addrs(owner->fd, &conn_addr, &peer_addr);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    stripe_pkt->event      = UCT_TCP_CM_CONN_STRIPE_REQ;
+    stripe_pkt->iface_addr = iface->config.ifaddr;
+    stripe_pkt->conn_addr  = conn_addr;
+    stripe_pkt->peer_addr  = peer_addr;
+    stripe_pkt->index      = index;
+
+    return UCS_OK;
+}
+
 ucs_status_t uct_tcp_cm_send_event(uct_tcp_ep_t *ep, uct_tcp_cm_conn_event_t event)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -162,12 +224,15 @@ ucs_status_t uct_tcp_cm_send_event(uct_tcp_ep_t *ep, uct_tcp_cm_conn_event_t eve
 
     ucs_assertv(!(event & ~(UCT_TCP_CM_CONN_REQ |
                             UCT_TCP_CM_CONN_ACK |
-                            UCT_TCP_CM_CONN_WAIT_REQ)),
+                            UCT_TCP_CM_CONN_WAIT_REQ |
+                            UCT_TCP_CM_CONN_STRIPE_REQ)),
                 "ep=%p", ep);
 
     pkt_length        = sizeof(*pkt_hdr);
     if (event == UCT_TCP_CM_CONN_REQ) {
         cm_pkt_length = sizeof(*conn_pkt);
+    } else if (event == UCT_TCP_CM_CONN_STRIPE_REQ) {
+        cm_pkt_length = sizeof(uct_tcp_cm_stripe_req_pkt_t);
     } else {
         cm_pkt_length = sizeof(event);
     }
@@ -175,13 +240,19 @@ ucs_status_t uct_tcp_cm_send_event(uct_tcp_ep_t *ep, uct_tcp_cm_conn_event_t eve
     pkt_buf           = ucs_alloca(pkt_length);
 
     pkt_hdr         = (uct_tcp_am_hdr_t*)pkt_buf;
-    pkt_hdr->am_id  = UCT_AM_ID_MAX;
+    pkt_hdr->am_id  = UCT_TCP_EP_CM_AM_ID;
     pkt_hdr->length = cm_pkt_length;
 
     if (event == UCT_TCP_CM_CONN_REQ) {
         conn_pkt             = (uct_tcp_cm_conn_req_pkt_t*)(pkt_hdr + 1);
         conn_pkt->event      = UCT_TCP_CM_CONN_REQ;
         conn_pkt->iface_addr = iface->config.ifaddr;
+    } else if (event == UCT_TCP_CM_CONN_STRIPE_REQ) {
+        status = uct_tcp_cm_stripe_req_pack(ep, (uct_tcp_cm_stripe_req_pkt_t*)
+                                                (pkt_hdr + 1));
+        if (status != UCS_OK) {
+            return status;
+        }
     } else {
         pkt_event            = (uct_tcp_cm_conn_event_t*)(pkt_hdr + 1);
         *pkt_event           = event;
@@ -292,6 +363,8 @@ uct_tcp_cm_simult_conn_accept_remote_conn(uct_tcp_ep_t *accept_ep,
                                           uct_tcp_ep_t *connect_ep,
                                           unsigned *progress_count)
 {
+    uct_tcp_iface_t *iface = ucs_derived_of(connect_ep->super.super.iface,
+                                            uct_tcp_iface_t);
     uct_tcp_cm_conn_event_t event;
     ucs_status_t status;
 
@@ -305,6 +378,12 @@ uct_tcp_cm_simult_conn_accept_remote_conn(uct_tcp_ep_t *accept_ep,
     close(connect_ep->fd);
     connect_ep->fd = accept_ep->fd;
 
+    if (iface->uring != NULL) {
+        /* the data could be already received by io_uring to the
+         * accepted EP */
+        uct_tcp_uring_ep_move_rx(accept_ep, connect_ep);
+    }
+
     /* 2. Migrate RX from the EP allocated during accepting connection to
      *    the found EP */
     status = uct_tcp_ep_move_ctx_cap(accept_ep, connect_ep,
@@ -464,6 +543,95 @@ err:
     return progress_count;
 }
 
+static int
+uct_tcp_cm_is_stripe_owner(uct_tcp_ep_t *ep,
+                           const uct_tcp_cm_stripe_req_pkt_t *stripe_pkt)
+{
+    struct sockaddr_in local_addr, remote_addr;
+
+    if ((ep->fd == -1) || (ep->stripe.owner != NULL) ||
+        (ep->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED)) {
+        return 0;
+    }
+
+    /* The owner's connection is seen from the peer side in reverse */
+    return (uct_tcp_cm_get_conn_addrs(ep->fd, &local_addr,
+                                      &remote_addr) == UCS_OK) &&
+           uct_tcp_khash_sockaddr_in_equal(local_addr,
+                                           stripe_pkt->peer_addr) &&
+           uct_tcp_khash_sockaddr_in_equal(remote_addr,
+                                           stripe_pkt->conn_addr);
+}
+
+static uct_tcp_ep_t *
+uct_tcp_cm_search_stripe_owner(uct_tcp_iface_t *iface,
+                               const uct_tcp_cm_stripe_req_pkt_t *stripe_pkt)
+{
+    ucs_list_link_t *ep_list;
+    uct_tcp_ep_t *ep;
+    khiter_t iter;
+
+    /* EPs which have only one of the context caps are kept in the map,
+     * others - in the iface list */
+    iter = kh_get(uct_tcp_cm_eps, &iface->ep_cm_map, stripe_pkt->iface_addr);
+    if (iter != kh_end(&iface->ep_cm_map)) {
+        ep_list = kh_value(&iface->ep_cm_map, iter);
+        ucs_list_for_each(ep, ep_list, list) {
+            if (uct_tcp_cm_is_stripe_owner(ep, stripe_pkt)) {
+                return ep;
+            }
+        }
+    }
+
+    ucs_list_for_each(ep, &iface->ep_list, list) {
+        if (uct_tcp_cm_is_stripe_owner(ep, stripe_pkt)) {
+            return ep;
+        }
+    }
+
+    return NULL;
+}
+
+static unsigned
+uct_tcp_cm_handle_stripe_req(uct_tcp_ep_t **ep_p,
+                             const uct_tcp_cm_stripe_req_pkt_t *stripe_pkt)
+{
+    uct_tcp_ep_t *ep       = *ep_p;
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    ucs_status_t status;
+    uct_tcp_ep_t *owner;
+
+    ep->peer_addr = stripe_pkt->iface_addr;
+    uct_tcp_cm_trace_conn_pkt(ep, UCS_LOG_LEVEL_TRACE,
+                              "%s received from", UCT_TCP_CM_CONN_STRIPE_REQ);
+
+    owner = uct_tcp_cm_search_stripe_owner(iface, stripe_pkt);
+    if (owner == NULL) {
+        ucs_error("tcp_ep %p: unable to find the owner of stripe socket %u",
+                  ep, stripe_pkt->index);
+        goto err;
+    }
+
+    status = uct_tcp_ep_stripe_attach(owner, ep, stripe_pkt->index);
+    if (status != UCS_OK) {
+        goto err;
+    }
+
+    status = uct_tcp_cm_send_event(ep, UCT_TCP_CM_CONN_ACK);
+    if (status != UCS_OK) {
+        goto err;
+    }
+
+    uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CONNECTED);
+    return 1;
+
+err:
+    uct_tcp_ep_destroy_internal(&ep->super.super);
+    *ep_p = NULL;
+    return 0;
+}
+
 void uct_tcp_cm_handle_conn_ack(uct_tcp_ep_t *ep, uct_tcp_cm_conn_event_t cm_event,
                                 uct_tcp_ep_conn_state_t new_conn_state)
 {
@@ -492,6 +660,9 @@ unsigned uct_tcp_cm_handle_conn_pkt(uct_tcp_ep_t **ep, void *pkt, uint32_t lengt
         ucs_assertv(length == sizeof(*cm_req_pkt), "ep=%p", *ep);
         cm_req_pkt = (uct_tcp_cm_conn_req_pkt_t*)pkt;
         return uct_tcp_cm_handle_conn_req(ep, cm_req_pkt);
+    case UCT_TCP_CM_CONN_STRIPE_REQ:
+        ucs_assertv(length == sizeof(uct_tcp_cm_stripe_req_pkt_t), "ep=%p", *ep);
+        return uct_tcp_cm_handle_stripe_req(ep, (uct_tcp_cm_stripe_req_pkt_t*)pkt);
     case UCT_TCP_CM_CONN_ACK_WITH_WAIT_REQ:
         if (!((*ep)->ctx_caps & UCS_BIT(UCT_TCP_EP_CTX_TYPE_RX))) {
             new_conn_state = UCT_TCP_EP_CONN_STATE_WAITING_REQ;
@@ -520,6 +691,13 @@ unsigned uct_tcp_cm_handle_conn_pkt(uct_tcp_ep_t **ep, void *pkt, uint32_t lengt
     return 0;
 }
 
+static inline uct_tcp_cm_conn_event_t
+uct_tcp_cm_conn_req_event(const uct_tcp_ep_t *ep)
+{
+    return (ep->stripe.owner != NULL) ? UCT_TCP_CM_CONN_STRIPE_REQ :
+                                        UCT_TCP_CM_CONN_REQ;
+}
+
 unsigned uct_tcp_cm_conn_progress(uct_tcp_ep_t *ep)
 {
     ucs_status_t status;
@@ -530,7 +708,7 @@ unsigned uct_tcp_cm_conn_progress(uct_tcp_ep_t *ep)
         goto err;
     }
 
-    status = uct_tcp_cm_send_event(ep, UCT_TCP_CM_CONN_REQ);
+    status = uct_tcp_cm_send_event(ep, uct_tcp_cm_conn_req_event(ep));
     if (status != UCS_OK) {
         return 0;
     }
@@ -543,6 +721,13 @@ unsigned uct_tcp_cm_conn_progress(uct_tcp_ep_t *ep)
     return 1;
 
 err:
+    if (ep->stripe.owner != NULL) {
+        /* The owner EP keeps working without striping */
+        uct_tcp_ep_mod_events(ep, 0, ep->events);
+        uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CLOSED);
+        return 0;
+    }
+
     uct_tcp_ep_set_failed(ep);
     return 0;
 }
@@ -559,7 +744,7 @@ ucs_status_t uct_tcp_cm_conn_start(uct_tcp_ep_t *ep)
         req_events      = UCS_EVENT_SET_EVWRITE;
         status          = UCS_OK;
     } else if (status == UCS_OK) {
-        status = uct_tcp_cm_send_event(ep, UCT_TCP_CM_CONN_REQ);
+        status = uct_tcp_cm_send_event(ep, uct_tcp_cm_conn_req_event(ep));
         if (status != UCS_OK) {
             return status;
         }
@@ -594,6 +779,12 @@ ucs_status_t uct_tcp_cm_handle_incoming_conn(uct_tcp_iface_t *iface,
     uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_ACCEPTING);
     uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVREAD, 0);
 
+    if (iface->uring != NULL) {
+        /* the receive operation of the EP is posted by the progress, which
+         * could wait for io_uring events */
+        uct_tcp_uring_wakeup(iface->uring);
+    }
+
     ucs_debug("tcp_iface %p: accepted connection from "
               "%s on %s to tcp_ep %p (fd %d)", iface,
               ucs_sockaddr_str((const struct sockaddr*)peer_addr,
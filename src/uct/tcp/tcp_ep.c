@@ -9,13 +9,16 @@
 
 #include "tcp.h"
 
+#include <ucs/arch/bitops.h>
 #include <ucs/async/async.h>
 #include <ucs/sys/iovec.h>
 
 
-/* Forward declaration */
+/* Forward declarations */
 static unsigned uct_tcp_ep_progress_data_tx(uct_tcp_ep_t *ep);
 
+static unsigned uct_tcp_ep_progress_rma_rep(uct_tcp_ep_t *ep);
+
 
 const uct_tcp_cm_state_t uct_tcp_ep_cm_state[] = {
     [UCT_TCP_EP_CONN_STATE_CLOSED]      = {
@@ -58,6 +61,24 @@ static inline int uct_tcp_ep_ctx_buf_need_progress(uct_tcp_ep_ctx_t *ctx)
     return ctx->offset < ctx->length;
 }
 
+static inline int uct_tcp_ep_stripes_tx_busy(uct_tcp_ep_t *ep)
+{
+    unsigned i;
+
+    if (ucs_likely(ep->stripe.tx_eps == NULL)) {
+        return 0;
+    }
+
+    for (i = 0; i < (UCT_TCP_EP_MAX_SOCKETS - 1); ++i) {
+        if ((ep->stripe.tx_eps[i] != NULL) &&
+            !uct_tcp_ep_ctx_buf_empty(&ep->stripe.tx_eps[i]->tx)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 static inline ucs_status_t uct_tcp_ep_check_tx_res(uct_tcp_ep_t *ep)
 {
     if (ucs_unlikely(ep->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED)) {
@@ -72,7 +93,12 @@ static inline ucs_status_t uct_tcp_ep_check_tx_res(uct_tcp_ep_t *ep)
         return UCS_ERR_NO_RESOURCE;
     }
 
-    return uct_tcp_ep_ctx_buf_empty(&ep->tx) ? UCS_OK : UCS_ERR_NO_RESOURCE;
+    /* PUT/GET replies have priority over user's operations, since a peer
+     * waits for them. Stripe sockets which are still sending don't block
+     * the EP, the next striped operations use only the idle ones */
+    return (uct_tcp_ep_ctx_buf_empty(&ep->tx) &&
+            ucs_queue_is_empty(&ep->rma_rep_q)) ?
+           UCS_OK : UCS_ERR_NO_RESOURCE;
 }
 
 static inline void uct_tcp_ep_ctx_rewind(uct_tcp_ep_ctx_t *ctx)
@@ -93,6 +119,17 @@ static inline void uct_tcp_ep_ctx_reset(uct_tcp_ep_ctx_t *ctx)
     uct_tcp_ep_ctx_init(ctx);
 }
 
+static inline void uct_tcp_ep_rx_reset(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    /* RX buffer starts after the space reserved for the user's headroom */
+    ucs_mpool_put_inline(UCS_PTR_BYTE_OFFSET(ep->rx.buf,
+                                             -iface->config.rx_buf_offset));
+    uct_tcp_ep_ctx_init(&ep->rx);
+}
+
 static void uct_tcp_ep_addr_cleanup(struct sockaddr_in *sock_addr)
 {
     memset(sock_addr, 0, sizeof(*sock_addr));
@@ -131,16 +168,119 @@ unsigned uct_tcp_ep_is_self(const uct_tcp_ep_t *ep)
     return !cmp;
 }
 
+static void uct_tcp_ep_rma_op_queue_purge(uct_tcp_iface_t *iface,
+                                          uct_tcp_ep_t *ep,
+                                          ucs_queue_head_t *queue,
+                                          ucs_status_t status)
+{
+    uct_tcp_ep_rma_op_t *op;
+
+    ucs_queue_for_each_extract(op, queue, queue, 1) {
+        if ((queue == &ep->rma_q) && !op->is_flush) {
+            /* outstanding PUT/GET Zcopy operation */
+            uct_tcp_iface_outstanding_dec(iface);
+        }
+        if (op->comp != NULL) {
+            uct_invoke_completion(op->comp, status);
+        }
+        ucs_mpool_put_inline(op);
+    }
+}
+
+static void uct_tcp_ep_msg_zcopy_queue_purge(uct_tcp_iface_t *iface,
+                                             uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+
+    ucs_queue_for_each_extract(ctx, &ep->msg_zcopy.queue, queue, 1) {
+        uct_tcp_iface_outstanding_dec(iface);
+        ucs_mpool_put_inline(ctx);
+    }
+}
+
+static void uct_tcp_ep_stripe_eps_destroy(uct_tcp_ep_t ***stripe_eps_p)
+{
+    uct_tcp_ep_t **stripe_eps = *stripe_eps_p;
+    unsigned i;
+
+    if (stripe_eps == NULL) {
+        return;
+    }
+
+    *stripe_eps_p = NULL;
+
+    for (i = 0; i < (UCT_TCP_EP_MAX_SOCKETS - 1); ++i) {
+        if (stripe_eps[i] != NULL) {
+            stripe_eps[i]->stripe.owner = NULL;
+            uct_tcp_ep_destroy_internal(&stripe_eps[i]->super.super);
+        }
+    }
+
+    ucs_free(stripe_eps);
+}
+
+static void uct_tcp_ep_stripe_detach(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_t *owner = ep->stripe.owner;
+    unsigned i;
+
+    for (i = 0; i < (UCT_TCP_EP_MAX_SOCKETS - 1); ++i) {
+        if ((owner->stripe.tx_eps != NULL) && (owner->stripe.tx_eps[i] == ep)) {
+            owner->stripe.tx_eps[i] = NULL;
+        }
+        if ((owner->stripe.rx_eps != NULL) && (owner->stripe.rx_eps[i] == ep)) {
+            owner->stripe.rx_eps[i] = NULL;
+        }
+    }
+
+    ep->stripe.owner = NULL;
+}
+
+static void uct_tcp_ep_stripes_cleanup(uct_tcp_iface_t *iface,
+                                       uct_tcp_ep_t *ep)
+{
+    if (ep->stripe.owner != NULL) {
+        uct_tcp_ep_stripe_detach(ep);
+    }
+
+    uct_tcp_ep_stripe_eps_destroy(&ep->stripe.tx_eps);
+    uct_tcp_ep_stripe_eps_destroy(&ep->stripe.rx_eps);
+
+    if (ep->stripe.rx_hdr != NULL) {
+        ucs_mpool_put_inline(UCS_PTR_BYTE_OFFSET(ep->stripe.rx_hdr,
+                                                 -iface->config.rx_buf_offset));
+        ep->stripe.rx_hdr = NULL;
+    }
+
+    ep->stripe.rx_pending = 0;
+    ep->stripe.rx_op      = NULL;
+    ep->stripe.length     = 0;
+    ep->stripe.op         = NULL;
+}
+
 static void uct_tcp_ep_cleanup(uct_tcp_ep_t *ep)
 {
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
     uct_tcp_ep_addr_cleanup(&ep->peer_addr);
 
+    uct_tcp_ep_rma_op_queue_purge(iface, ep, &ep->rma_q, UCS_ERR_CANCELED);
+    uct_tcp_ep_rma_op_queue_purge(iface, ep, &ep->rma_rep_q, UCS_ERR_CANCELED);
+    uct_tcp_ep_msg_zcopy_queue_purge(iface, ep);
+    uct_tcp_ep_stripes_cleanup(iface, ep);
+    ep->rma_rx.length = 0;
+
+    if (iface->uring != NULL) {
+        uct_tcp_uring_ep_cleanup(ep);
+    }
+
     if (ep->tx.buf) {
         uct_tcp_ep_ctx_reset(&ep->tx);
     }
 
     if (ep->rx.buf) {
-        uct_tcp_ep_ctx_reset(&ep->rx);
+        uct_tcp_ep_rx_reset(ep);
     }
 
     if (ep->events && (ep->fd != -1)) {
@@ -164,13 +304,44 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface,
     uct_tcp_ep_ctx_init(&self->tx);
     uct_tcp_ep_ctx_init(&self->rx);
 
+    self->rma_rx.buf    = NULL;
+    self->rma_rx.length = 0;
+    self->rma_rx.op     = NULL;
+
+    self->msg_zcopy.sn      = 0;
+    self->msg_zcopy.done_sn = 0;
+
+    self->stripe.owner      = NULL;
+    self->stripe.tx_eps     = NULL;
+    self->stripe.rx_eps     = NULL;
+    self->stripe.rx_hdr     = NULL;
+    self->stripe.rx_pending = 0;
+    self->stripe.rx_op      = NULL;
+    self->stripe.tx_failed  = 0;
+    self->stripe.buf        = NULL;
+    self->stripe.length     = 0;
+    self->stripe.op         = NULL;
+
+    self->uring.rx_op     = NULL;
+    self->uring.poll_op   = NULL;
+    self->uring.rx_buf    = NULL;
+    self->uring.rx_dest   = NULL;
+    self->uring.rx_offset = 0;
+    self->uring.rx_length = 0;
+    self->uring.rx_status = UCS_OK;
+    self->uring.rx_nobufs = 0;
+
     self->events     = 0;
     self->fd         = fd;
     self->ctx_caps   = 0;
     self->conn_state = UCT_TCP_EP_CONN_STATE_CLOSED;
 
     ucs_list_head_init(&self->list);
+    ucs_list_head_init(&self->uring.list);
     ucs_queue_head_init(&self->pending_q);
+    ucs_queue_head_init(&self->rma_q);
+    ucs_queue_head_init(&self->rma_rep_q);
+    ucs_queue_head_init(&self->msg_zcopy.queue);
 
     status = ucs_sys_fcntl_modfl(self->fd, O_NONBLOCK, 0);
     if (status != UCS_OK) {
@@ -376,6 +547,88 @@ err_close_fd:
     return status;
 }
 
+static ucs_status_t uct_tcp_ep_stripe_link(uct_tcp_ep_t *owner,
+                                           uct_tcp_ep_t ***stripe_eps_p,
+                                           unsigned index, uct_tcp_ep_t *ep)
+{
+    if (index >= (UCT_TCP_EP_MAX_SOCKETS - 1)) {
+        ucs_error("tcp_ep %p: invalid stripe socket index %u", owner, index);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (*stripe_eps_p == NULL) {
+        *stripe_eps_p = ucs_calloc(UCT_TCP_EP_MAX_SOCKETS - 1,
+                                   sizeof(**stripe_eps_p), "tcp_stripe_eps");
+        if (*stripe_eps_p == NULL) {
+            ucs_error("tcp_ep %p: failed to allocate stripe sockets", owner);
+            return UCS_ERR_NO_MEMORY;
+        }
+    }
+
+    if ((*stripe_eps_p)[index] != NULL) {
+        ucs_error("tcp_ep %p: stripe socket %u already exists", owner, index);
+        return UCS_ERR_ALREADY_EXISTS;
+    }
+
+    (*stripe_eps_p)[index] = ep;
+    ep->stripe.owner       = owner;
+
+    /* Stripe sockets are owned by the EP, don't keep them in the iface list */
+    uct_tcp_iface_remove_ep(ep);
+    ucs_list_head_init(&ep->list);
+
+    ucs_debug("tcp_ep %p: stripe socket %u fd %d is tcp_ep %p", owner, index,
+              ep->fd, ep);
+    return UCS_OK;
+}
+
+ucs_status_t uct_tcp_ep_stripe_attach(uct_tcp_ep_t *owner, uct_tcp_ep_t *ep,
+                                      unsigned index)
+{
+    return uct_tcp_ep_stripe_link(owner, &owner->stripe.rx_eps, index, ep);
+}
+
+void uct_tcp_ep_stripes_connect(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_t *stripe_ep;
+    ucs_status_t status;
+    unsigned i;
+    int fd;
+
+    if ((iface->config.stripe.count == 0) || (ep->stripe.owner != NULL) ||
+        (ep->stripe.tx_eps != NULL)) {
+        return;
+    }
+
+    /* If some of the sockets can't be connected, the EP doesn't split
+     * AM payload and keeps using its own socket only */
+    for (i = 0; i < iface->config.stripe.count; ++i) {
+        status = ucs_socket_create(AF_INET, SOCK_STREAM, &fd);
+        if (status != UCS_OK) {
+            return;
+        }
+
+        status = uct_tcp_ep_init(iface, fd, &ep->peer_addr, &stripe_ep);
+        if (status != UCS_OK) {
+            close(fd);
+            return;
+        }
+
+        status = uct_tcp_ep_stripe_link(ep, &ep->stripe.tx_eps, i, stripe_ep);
+        if (status != UCS_OK) {
+            uct_tcp_ep_destroy_internal(&stripe_ep->super.super);
+            return;
+        }
+
+        status = uct_tcp_cm_conn_start(stripe_ep);
+        if (status != UCS_OK) {
+            return;
+        }
+    }
+}
+
 ucs_status_t uct_tcp_ep_create(const uct_ep_params_t *params,
                                uct_ep_h *ep_p)
 {
@@ -417,6 +670,11 @@ ucs_status_t uct_tcp_ep_create(const uct_ep_params_t *params,
     } while (ep == NULL);
 
     if (status == UCS_OK) {
+        if (ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) {
+            /* TX capability was added to the connected EP */
+            uct_tcp_ep_stripes_connect(ep);
+        }
+
         /* cppcheck-suppress autoVariables */
         *ep_p = &ep->super.super;
     }
@@ -436,6 +694,12 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, int add, int remove)
         ucs_trace("tcp_ep %p: set events to %c%c", ep,
                   (new_events & UCS_EVENT_SET_EVREAD)  ? 'r' : '-',
                   (new_events & UCS_EVENT_SET_EVWRITE) ? 'w' : '-');
+        if (iface->uring != NULL) {
+            /* the operations are posted to io_uring on the next progress */
+            uct_tcp_uring_ep_update(ep);
+            return;
+        }
+
         if (new_events == 0) {
             status = ucs_event_set_del(iface->event_set, ep->fd);
         } else if (old_events != 0) {
@@ -459,7 +723,8 @@ void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep)
     uct_pending_queue_dispatch(priv, &ep->pending_q,
                                uct_tcp_ep_ctx_buf_empty(&ep->tx));
     if (uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
-        ucs_assert(ucs_queue_is_empty(&ep->pending_q));
+        /* a flush request, which waits for the stripe sockets, is
+         * dispatched again by the stripe socket which completes sending */
         uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVWRITE);
     }
 }
@@ -490,13 +755,67 @@ uct_tcp_ep_iovec_fill_iov(struct iovec *io_vec, const uct_iov_t *iov,
     return io_vec_it;
 }
 
-static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep,
-                                           uct_tcp_ep_ctx_t *ctx)
+/* Fill iovec data structure by the part of data described by another
+ * iovec data structure, which starts from the given offset.
+ * @return Number of elements in io_vec[].
+ */
+static size_t
+uct_tcp_ep_iovec_slice(struct iovec *io_vec, const struct iovec *src_iov,
+                       size_t src_iov_cnt, size_t offset, size_t length)
+{
+    size_t iov_it, io_vec_it = 0;
+
+    for (iov_it = 0; (iov_it < src_iov_cnt) && (length > 0); ++iov_it) {
+        if (offset >= src_iov[iov_it].iov_len) {
+            offset -= src_iov[iov_it].iov_len;
+            continue;
+        }
+
+        io_vec[io_vec_it].iov_base = UCS_PTR_BYTE_OFFSET(src_iov[iov_it].iov_base,
+                                                         offset);
+        io_vec[io_vec_it].iov_len  = ucs_min(src_iov[iov_it].iov_len - offset,
+                                             length);
+        length                    -= io_vec[io_vec_it].iov_len;
+        offset                     = 0;
+        ++io_vec_it;
+    }
+
+    return io_vec_it;
+}
+
+static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep)
 {
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
     ucs_debug("tcp_ep %p: remote disconnected", ep);
 
+    if (ep->stripe.owner != NULL) {
+        /* The owner EP keeps working without this stripe socket. If a chunk
+         * was being received on it, the owner EP is disconnected too */
+        uct_tcp_ep_mod_events(ep, 0, ep->events);
+        if (ep->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED) {
+            uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CLOSED);
+        }
+        return;
+    }
+
+    if ((!ucs_queue_is_empty(&ep->rma_q) || ep->stripe.tx_failed) &&
+        (ep->ctx_caps & UCS_BIT(UCT_TCP_EP_CTX_TYPE_TX))) {
+        /* Replies to the outstanding PUT/GET Zcopy operations will never
+         * arrive, or a striped operation was lost: complete them with an
+         * error and report the failure */
+        uct_tcp_ep_rma_op_queue_purge(iface, ep, &ep->rma_q,
+                                      UCS_ERR_UNREACHABLE);
+        uct_tcp_ep_set_failed(ep);
+        return;
+    }
+
     uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVREAD);
-    uct_tcp_ep_ctx_reset(ctx);
+    if (ep->rx.buf != NULL) {
+        /* RX buffer is released when RMA payload is being received */
+        uct_tcp_ep_rx_reset(ep);
+    }
 
     if (ep->ctx_caps & UCS_BIT(UCT_TCP_EP_CTX_TYPE_RX)) {
         if (ep->ctx_caps & UCS_BIT(UCT_TCP_EP_CTX_TYPE_TX)) {
@@ -509,6 +828,37 @@ static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep,
     }
 }
 
+/* Break the connection after an unrecoverable PUT/GET Zcopy or striping
+ * error, so that the peer detects the disconnection and fails its outstanding
+ * operations */
+static void uct_tcp_ep_shutdown(uct_tcp_ep_t *ep)
+{
+    if (shutdown(ep->fd, SHUT_RDWR) < 0) {
+        ucs_debug("tcp_ep %p: shutdown(fd=%d) failed: %m", ep, ep->fd);
+    }
+}
+
+/* A chunk of striped operation was not sent, so the peer is unable to
+ * complete it: break the connection of the EP and its stripe sockets. The
+ * EP is failed when the disconnection is detected */
+static void uct_tcp_ep_stripes_tx_fail(uct_tcp_ep_t *ep)
+{
+    unsigned i;
+
+    ep->stripe.tx_failed = 1;
+    uct_tcp_ep_shutdown(ep);
+
+    if (ep->stripe.tx_eps == NULL) {
+        return;
+    }
+
+    for (i = 0; i < (UCT_TCP_EP_MAX_SOCKETS - 1); ++i) {
+        if (ep->stripe.tx_eps[i] != NULL) {
+            uct_tcp_ep_shutdown(ep->stripe.tx_eps[i]);
+        }
+    }
+}
+
 static inline unsigned uct_tcp_ep_send(uct_tcp_ep_t *ep, size_t *sent_length)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -530,6 +880,109 @@ static inline unsigned uct_tcp_ep_send(uct_tcp_ep_t *ep, size_t *sent_length)
     return (*sent_length > 0);
 }
 
+static inline ucs_status_t
+uct_tcp_ep_zcopy_sendv(uct_tcp_ep_t *ep, uct_tcp_ep_zcopy_ctx_t *ctx,
+                       struct iovec *iov, size_t iov_cnt, size_t *length_p)
+{
+    ucs_status_t status;
+
+    if (!ctx->msg_zcopy) {
+        return ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, length_p, NULL, NULL);
+    }
+
+    status = ucs_socket_sendv_zcopy_nb(ep->fd, iov, iov_cnt, length_p,
+                                       NULL, NULL);
+    if (status == UCS_OK) {
+        /* the kernel numbers each successful MSG_ZEROCOPY send call, the
+         * user's buffers may be reused after the last call is reported */
+        ctx->sn = ep->msg_zcopy.sn++;
+    } else if (status == UCS_ERR_NO_RESOURCE) {
+        if (ep->msg_zcopy.done_sn != ep->msg_zcopy.sn) {
+            /* the kernel memory is held by the notifications of our sends,
+             * back off until they are read from the error queue */
+            ucs_trace_data("tcp_ep %p: MSG_ZEROCOPY send got ENOBUFS, %u "
+                           "sends are not completed", ep,
+                           ep->msg_zcopy.sn - ep->msg_zcopy.done_sn);
+            return UCS_ERR_NO_PROGRESS;
+        }
+
+        /* all sends are completed, so nothing to wait for: copy the data.
+         * The operation is completed in order after the last send */
+        ctx->sn = ep->msg_zcopy.sn - 1;
+        status  = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, length_p, NULL,
+                                      NULL);
+    }
+
+    return status;
+}
+
+static inline int uct_tcp_ep_msg_zcopy_need_wait(uct_tcp_ep_t *ep,
+                                                 uct_tcp_ep_zcopy_ctx_t *ctx)
+{
+    return ctx->msg_zcopy || !ucs_queue_is_empty(&ep->msg_zcopy.queue);
+}
+
+static inline void
+uct_tcp_ep_msg_zcopy_push(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                          uct_tcp_ep_zcopy_ctx_t *ctx)
+{
+    if (!ctx->msg_zcopy) {
+        /* keep the completion order with MSG_ZEROCOPY sends posted before */
+        ctx->sn = ep->msg_zcopy.sn - 1;
+    }
+
+    /* the TX buffer is owned by the operation until the kernel releases
+     * the user's pages, so detach it from the EP */
+    ucs_queue_push(&ep->msg_zcopy.queue, &ctx->queue);
+    uct_tcp_iface_outstanding_inc(iface);
+    uct_tcp_ep_ctx_init(&ep->tx);
+
+    if (iface->uring != NULL) {
+        /* poll the socket to get the completion from the error queue */
+        uct_tcp_uring_ep_update(ep);
+    }
+}
+
+unsigned uct_tcp_ep_progress_msg_zcopy(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    unsigned count         = 0;
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    uint32_t first_sn, last_sn;
+    ucs_status_t status;
+
+    if (ep->msg_zcopy.done_sn == ep->msg_zcopy.sn) {
+        return 0;
+    }
+
+    do {
+        status = ucs_socket_zcopy_completion(ep->fd, &first_sn, &last_sn);
+        if (status == UCS_OK) {
+            ucs_trace_data("tcp_ep %p: MSG_ZEROCOPY sends %u..%u completed",
+                           ep, first_sn, last_sn);
+            /* TCP reports the completions in order */
+            if (UCS_CIRCULAR_COMPARE32(last_sn, >=, ep->msg_zcopy.done_sn)) {
+                ep->msg_zcopy.done_sn = last_sn + 1;
+            }
+        }
+    } while ((status == UCS_OK) || (status == UCS_ERR_NO_MESSAGE));
+
+    ucs_queue_for_each_extract(ctx, &ep->msg_zcopy.queue, queue,
+                               UCS_CIRCULAR_COMPARE32(ctx->sn, <,
+                                                      ep->msg_zcopy.done_sn)) {
+        if (ctx->comp != NULL) {
+            uct_invoke_completion(ctx->comp, UCS_OK);
+        }
+
+        uct_tcp_iface_outstanding_dec(iface);
+        ucs_mpool_put_inline(ctx);
+        count++;
+    }
+
+    return count;
+}
+
 static inline unsigned uct_tcp_ep_sendv(uct_tcp_ep_t *ep, size_t *sent_length)
 {
     uct_tcp_iface_t *iface      = ucs_derived_of(ep->super.super.iface,
@@ -539,9 +992,9 @@ static inline unsigned uct_tcp_ep_sendv(uct_tcp_ep_t *ep, size_t *sent_length)
 
     ucs_assertv(ep->tx.offset < ep->tx.length, "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, &ctx->iov[ctx->iov_index],
-                                 ctx->iov_cnt - ctx->iov_index,
-                                 sent_length, NULL, NULL);
+    status = uct_tcp_ep_zcopy_sendv(ep, ctx, &ctx->iov[ctx->iov_index],
+                                    ctx->iov_cnt - ctx->iov_index,
+                                    sent_length);
 
     ep->tx.offset      += *sent_length;
     iface->outstanding -= *sent_length;
@@ -552,7 +1005,18 @@ static inline unsigned uct_tcp_ep_sendv(uct_tcp_ep_t *ep, size_t *sent_length)
                         &ctx->iov_index, *sent_length);
     } else {
         ep->ctx_caps  &= ~UCS_BIT(UCT_TCP_EP_CTX_TYPE_ZCOPY_TX);
-        if (ctx->comp != NULL) {
+        if (UCS_STATUS_IS_ERR(status) && (ep->stripe.owner != NULL) &&
+            !ep->stripe.owner->stripe.tx_failed) {
+            /* the peer is unable to complete the striped operation */
+            ucs_error("tcp_ep %p: failed to send a chunk of striped "
+                      "operation: %s", ep, ucs_status_string(status));
+            uct_tcp_ep_stripes_tx_fail(ep->stripe.owner);
+        }
+
+        if ((status == UCS_OK) && uct_tcp_ep_msg_zcopy_need_wait(ep, ctx)) {
+            /* completed when the kernel releases the user's buffers */
+            uct_tcp_ep_msg_zcopy_push(iface, ep, ctx);
+        } else if (ctx->comp != NULL) {
             uct_invoke_completion(ctx->comp, status);
         }
     }
@@ -560,7 +1024,7 @@ static inline unsigned uct_tcp_ep_sendv(uct_tcp_ep_t *ep, size_t *sent_length)
     return (*sent_length > 0);
 }
 
-static ucs_status_t uct_tcp_ep_io_err_handler_cb(void *arg, int io_errno)
+ucs_status_t uct_tcp_ep_io_err_handler_cb(void *arg, int io_errno)
 {
     uct_tcp_ep_t *ep                    = (uct_tcp_ep_t*)arg;
     uct_tcp_iface_t UCS_V_UNUSED *iface = ucs_derived_of(ep->super.super.iface,
@@ -584,24 +1048,38 @@ static ucs_status_t uct_tcp_ep_io_err_handler_cb(void *arg, int io_errno)
     return UCS_ERR_NO_PROGRESS;
 }
 
+static inline ucs_status_t uct_tcp_ep_recv_nb(uct_tcp_ep_t *ep, void *buf,
+                                              size_t *length_p)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    if (iface->uring != NULL) {
+        /* take the data received by io_uring */
+        return uct_tcp_uring_ep_recv(ep, buf, length_p);
+    }
+
+    return ucs_socket_recv_nb(ep->fd, buf, length_p,
+                              uct_tcp_ep_io_err_handler_cb, ep);
+}
+
 static inline unsigned uct_tcp_ep_recv(uct_tcp_ep_t *ep, size_t recv_length)
 {
     ucs_status_t status;
 
     ucs_assertv(recv_length, "ep=%p", ep);
 
-    status = ucs_socket_recv_nb(ep->fd, ep->rx.buf + ep->rx.length, &recv_length,
-                                uct_tcp_ep_io_err_handler_cb, ep);
+    status = uct_tcp_ep_recv_nb(ep, ep->rx.buf + ep->rx.length, &recv_length);
     if (status != UCS_OK) {
         if (status == UCS_ERR_NO_PROGRESS) {
             /* If no data were read to the allocated buffer,
              * we can safely reset it for futher re-use and to
              * avoid overwriting this buffer, because `rx::length == 0` */
             if (!ep->rx.length) {
-                uct_tcp_ep_ctx_reset(&ep->rx);
+                uct_tcp_ep_rx_reset(ep);
             }
         } else {
-            uct_tcp_ep_handle_disconnected(ep, &ep->rx);
+            uct_tcp_ep_handle_disconnected(ep);
         }
         return 0;
     }
@@ -631,11 +1109,23 @@ static unsigned uct_tcp_ep_progress_data_tx(uct_tcp_ep_t *ep)
         ucs_trace_data("ep %p fd %d sent %zu/%zu bytes, moved to offest %zu",
                        ep, ep->fd, ep->tx.offset, ep->tx.length, sent_length);
 
-        if (!uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+        /* TX buffer could be detached by MSG_ZEROCOPY operation */
+        if ((ep->tx.buf != NULL) &&
+            !uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
             uct_tcp_ep_ctx_reset(&ep->tx);
         }
     }
 
+    if (!ucs_queue_is_empty(&ep->rma_rep_q)) {
+        count += uct_tcp_ep_progress_rma_rep(ep);
+    }
+
+    if ((ep->stripe.owner != NULL) && uct_tcp_ep_ctx_buf_empty(&ep->tx) &&
+        !ucs_queue_is_empty(&ep->stripe.owner->pending_q)) {
+        /* operations of the owner EP could wait for this stripe socket */
+        uct_tcp_ep_pending_queue_dispatch(ep->stripe.owner);
+    }
+
     if (!ucs_queue_is_empty(&ep->pending_q)) {
         uct_tcp_ep_pending_queue_dispatch(ep);
         return count;
@@ -649,105 +1139,745 @@ static unsigned uct_tcp_ep_progress_data_tx(uct_tcp_ep_t *ep)
     return count;
 }
 
-static inline void
+static inline ucs_status_t
 uct_tcp_ep_comp_recv_am(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
                         uct_tcp_am_hdr_t *hdr)
 {
+    unsigned flags = 0;
+
     uct_iface_trace_am(&iface->super, UCT_AM_TRACE_TYPE_RECV, hdr->am_id,
                        hdr + 1, hdr->length,
                        "RECV: ep %p fd %d received %zu/%zu bytes",
                        ep, ep->fd, ep->rx.offset, ep->rx.length);
-    uct_iface_invoke_am(&iface->super, hdr->am_id, hdr + 1, hdr->length, 0);
+
+    if (((void*)hdr == ep->rx.buf) && (ep->rx.offset == ep->rx.length) &&
+        (hdr->length >= iface->config.rx_hdr_first_thresh)) {
+        /* The AM is the only data in RX buffer, so the buffer can be kept
+         * by the user instead of copying the payload */
+        uct_recv_desc(UCS_PTR_BYTE_OFFSET(hdr + 1, -iface->rx_headroom)) =
+            &iface->release_desc;
+        flags = UCT_CB_PARAM_FLAG_DESC;
+    }
+
+    return uct_iface_invoke_am(&iface->super, hdr->am_id, hdr + 1,
+                               hdr->length, flags);
 }
 
-unsigned uct_tcp_ep_progress_rx(uct_tcp_ep_t *ep)
+static ucs_status_t uct_tcp_ep_rma_rep_add(uct_tcp_ep_t *ep, void *buffer,
+                                           size_t length)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
-    unsigned handled       = 0;
-    uct_tcp_am_hdr_t *hdr;
-    size_t recv_length;
-    size_t remainder;
-
-    ucs_trace_func("ep=%p", ep);
-
-    if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
-        ucs_assert(ep->rx.buf == NULL);
+    uct_tcp_ep_rma_op_t *op;
 
-        ep->rx.buf = ucs_mpool_get_inline(&iface->rx_mpool);
-        if (ucs_unlikely(ep->rx.buf == NULL)) {
-            ucs_warn("tcp_ep %p: unable to get a buffer from RX memory pool", ep);
-            return 0;
-        }
+    op = ucs_mpool_get_inline(&iface->rma_op_mpool);
+    if (ucs_unlikely(op == NULL)) {
+        ucs_error("tcp_ep %p: unable to get a buffer from RMA operations "
+                  "memory pool", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
 
-        /* post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size;
-    } else if (ep->rx.length - ep->rx.offset < sizeof(*hdr)) {
-        ucs_assert(ep->rx.buf != NULL);
+    op->buffer   = buffer;
+    op->length   = length;
+    op->comp     = NULL;
+    op->is_flush = 0;
+    ucs_queue_push(&ep->rma_rep_q, &op->queue);
 
-        /* do partial receive of the remaining part of the hdr
-         * and post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size - ep->rx.length;
-    } else {
-        ucs_assert(ep->rx.buf != NULL);
+    uct_tcp_ep_progress_rma_rep(ep);
+    return UCS_OK;
+}
 
-        /* do partial receive of the remaining user data */
-        hdr         = ep->rx.buf + ep->rx.offset;
-        recv_length = hdr->length - (ep->rx.length - ep->rx.offset - sizeof(*hdr));
+/* PUT Zcopy acknowledgment or GET Zcopy reply was received, complete the
+ * operation and all flush requests that were waiting for it */
+static void uct_tcp_ep_rma_op_complete(uct_tcp_iface_t *iface,
+                                       uct_tcp_ep_t *ep,
+                                       uct_tcp_ep_rma_op_t *op)
+{
+    ucs_assert(op == ucs_queue_head_elem_non_empty(&ep->rma_q,
+                                                   uct_tcp_ep_rma_op_t,
+                                                   queue));
+    ucs_queue_pull_non_empty(&ep->rma_q);
+    uct_tcp_iface_outstanding_dec(iface);
+    if (op->comp != NULL) {
+        uct_invoke_completion(op->comp, UCS_OK);
     }
+    ucs_mpool_put_inline(op);
 
-    if (!uct_tcp_ep_recv(ep, recv_length)) {
-        goto out;
+    ucs_queue_for_each_extract(op, &ep->rma_q, queue, op->is_flush) {
+        uct_invoke_completion(op->comp, UCS_OK);
+        ucs_mpool_put_inline(op);
     }
+}
 
-    /* Parse received active messages */
-    while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
-        remainder = ep->rx.length - ep->rx.offset;
-        if (remainder < sizeof(*hdr)) {
-            /* Move the partially received hdr to the beginning of the buffer */
-            memmove(ep->rx.buf, ep->rx.buf + ep->rx.offset, remainder);
-            ep->rx.offset = 0;
-            ep->rx.length = remainder;
-            handled++;
-            goto out;
-        }
+/* Whether the EP waits for the chunks of striped AM, PUT or GET reply, which
+ * are received on the stripe sockets, to handle the next packets */
+static UCS_F_ALWAYS_INLINE int uct_tcp_ep_stripe_rx_paused(uct_tcp_ep_t *ep)
+{
+    return (ep->stripe.rx_pending != 0) || (ep->stripe.rx_op != NULL);
+}
 
-        hdr = ep->rx.buf + ep->rx.offset;
-        ucs_assert(hdr->length <= (iface->config.rx_seg_size -
-                                   sizeof(uct_tcp_am_hdr_t)));
+static ucs_status_t uct_tcp_ep_rma_rx_complete(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface  = ucs_derived_of(ep->super.super.iface,
+                                             uct_tcp_iface_t);
+    uct_tcp_ep_rma_op_t *op = ep->rma_rx.op;
 
-        if (remainder < sizeof(*hdr) + hdr->length) {
-            handled++;
-            goto out;
+    ep->rma_rx.buf = NULL;
+    ep->rma_rx.op  = NULL;
+
+    if (op == NULL) {
+        if ((ep->stripe.rx_pending != 0) && (--ep->stripe.rx_pending != 0)) {
+            /* The rest of striped PUT Zcopy data is still being received on
+             * the stripe sockets, the last of them acknowledges it */
+            uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVREAD);
+            return UCS_OK;
+        }
+
+        /* PUT Zcopy data was written, acknowledge it */
+        return uct_tcp_ep_rma_rep_add(ep, NULL, 0);
+    }
+
+    if (op->pending != 0) {
+        /* The rest of GET Zcopy reply is still being received on the stripe
+         * sockets, the last of them completes the operation */
+        ep->stripe.rx_op = op;
+        uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVREAD);
+        return UCS_OK;
+    }
+
+    uct_tcp_ep_rma_op_complete(iface, ep, op);
+    return UCS_OK;
+}
+
+static ucs_status_t uct_tcp_ep_rma_rx_start(uct_tcp_ep_t *ep, void *buffer,
+                                            size_t length,
+                                            uct_tcp_ep_rma_op_t *op)
+{
+    size_t copy_length;
+
+    /* Copy a part of the payload that was already received to RX buffer */
+    copy_length = ucs_min(length, ep->rx.length - ep->rx.offset);
+    memcpy(buffer, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
+           copy_length);
+    ep->rx.offset += copy_length;
+
+    /* The rest of the payload is received directly to the user's buffer */
+    ep->rma_rx.buf    = UCS_PTR_BYTE_OFFSET(buffer, copy_length);
+    ep->rma_rx.length = length - copy_length;
+    ep->rma_rx.op     = op;
+
+    if (ep->rma_rx.length == 0) {
+        return uct_tcp_ep_rma_rx_complete(ep);
+    }
+
+    return UCS_OK;
+}
+
+static unsigned uct_tcp_ep_progress_rma_rx(uct_tcp_ep_t *ep)
+{
+    size_t recv_length = ep->rma_rx.length;
+    ucs_status_t status;
+
+    ucs_assertv(ep->rx.buf == NULL, "ep=%p", ep);
+
+    status = uct_tcp_ep_recv_nb(ep, ep->rma_rx.buf, &recv_length);
+    if (status != UCS_OK) {
+        if (status != UCS_ERR_NO_PROGRESS) {
+            uct_tcp_ep_handle_disconnected(ep);
+        }
+        return 0;
+    }
+
+    ucs_trace_data("tcp_ep %p: recvd %zu bytes of RMA payload to %p, "
+                   "%zu bytes remaining", ep, recv_length, ep->rma_rx.buf,
+                   ep->rma_rx.length - recv_length);
+
+    ep->rma_rx.buf     = UCS_PTR_BYTE_OFFSET(ep->rma_rx.buf, recv_length);
+    ep->rma_rx.length -= recv_length;
+    if ((ep->rma_rx.length == 0) &&
+        (uct_tcp_ep_rma_rx_complete(ep) != UCS_OK)) {
+        uct_tcp_ep_shutdown(ep);
+        uct_tcp_ep_handle_disconnected(ep);
+    }
+
+    return 1;
+}
+
+static UCS_F_ALWAYS_INLINE int uct_tcp_ep_rma_is_put(uint8_t am_id)
+{
+    return (am_id == UCT_TCP_EP_PUT_REQ_AM_ID) ||
+           (am_id == UCT_TCP_EP_STRIPE_PUT_REQ_AM_ID);
+}
+
+/* Check that each stripe socket from the map carries a chunk of the data,
+ * which is not carried by the EP socket. The last chunk may be shorter */
+static int uct_tcp_ep_stripe_map_check(unsigned map, size_t length,
+                                       size_t chunk)
+{
+    return (map != 0) && !(map & ~UCS_MASK(UCT_TCP_EP_MAX_SOCKETS - 1)) &&
+           (chunk != 0) &&
+           (ucs_div_round_up(length, chunk) == ucs_popcount(map));
+}
+
+/* Check that the peer's stripe sockets from the map are able to carry the
+ * chunks of a striped operation */
+static ucs_status_t uct_tcp_ep_stripe_rx_check(uct_tcp_ep_t *ep,
+                                               unsigned map)
+{
+    uct_tcp_ep_t *stripe_ep;
+    unsigned i;
+
+    ucs_for_each_bit(i, map) {
+        stripe_ep = (ep->stripe.rx_eps != NULL) ? ep->stripe.rx_eps[i] : NULL;
+        if ((stripe_ep == NULL) ||
+            (stripe_ep->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED) ||
+            (stripe_ep->stripe.length != 0)) {
+            ucs_error("tcp_ep %p: stripe socket %u isn't ready for striped "
+                      "operation", ep, i);
+            return UCS_ERR_UNREACHABLE;
+        }
+    }
+
+    return UCS_OK;
+}
+
+/* Receive the data to the buffer in chunks, each of them - on the next stripe
+ * socket from the map */
+static void uct_tcp_ep_stripe_rx_arm(uct_tcp_ep_t **stripe_eps, unsigned map,
+                                     void *buffer, size_t length, size_t chunk,
+                                     uct_tcp_ep_rma_op_t *op)
+{
+    size_t offset = 0;
+    uct_tcp_ep_t *stripe_ep;
+    unsigned i;
+
+    ucs_for_each_bit(i, map) {
+        stripe_ep                = stripe_eps[i];
+        stripe_ep->stripe.buf    = UCS_PTR_BYTE_OFFSET(buffer, offset);
+        stripe_ep->stripe.length = ucs_min(chunk, length - offset);
+        stripe_ep->stripe.op     = op;
+        offset                  += stripe_ep->stripe.length;
+        uct_tcp_ep_mod_events(stripe_ep, UCS_EVENT_SET_EVREAD, 0);
+    }
+
+    ucs_assert(offset == length);
+}
+
+static ucs_status_t
+uct_tcp_ep_stripe_rma_start(uct_tcp_ep_t *ep, uint8_t am_id,
+                            const uct_tcp_ep_stripe_rma_hdr_t *stripe_hdr)
+{
+    void *address = (void*)stripe_hdr->super.address;
+    size_t length = stripe_hdr->super.length;
+    size_t chunk  = stripe_hdr->chunk;
+    unsigned map  = stripe_hdr->map;
+    size_t offset;
+    ucs_status_t status;
+    unsigned i;
+
+    if ((length <= chunk) ||
+        !uct_tcp_ep_stripe_map_check(map, length - chunk, chunk)) {
+        ucs_error("tcp_ep %p: invalid striped %s (length %zu map 0x%x chunk "
+                  "%zu)", ep, uct_tcp_ep_rma_is_put(am_id) ? "PUT" : "GET",
+                  length, map, chunk);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    status = uct_tcp_ep_stripe_rx_check(ep, map);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if (am_id == UCT_TCP_EP_STRIPE_PUT_REQ_AM_ID) {
+        /* The first chunk follows the request on the EP socket, the next
+         * packets are handled when all chunks are written */
+        uct_tcp_ep_stripe_rx_arm(ep->stripe.rx_eps, map,
+                                 UCS_PTR_BYTE_OFFSET(address, chunk),
+                                 length - chunk, chunk, NULL);
+        ep->stripe.rx_pending = ucs_popcount(map) + 1;
+        return uct_tcp_ep_rma_rx_start(ep, address, chunk, NULL);
+    }
+
+    /* The first chunk is replied on the EP socket, the next chunks - on the
+     * stripe sockets without any header */
+    status = uct_tcp_ep_rma_rep_add(ep, address, chunk);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    offset = chunk;
+    ucs_for_each_bit(i, map) {
+        status = uct_tcp_ep_rma_rep_add(ep->stripe.rx_eps[i],
+                                        UCS_PTR_BYTE_OFFSET(address, offset),
+                                        ucs_min(chunk, length - offset));
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        offset += chunk;
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t uct_tcp_ep_handle_rma_pkt(uct_tcp_iface_t *iface,
+                                              uct_tcp_ep_t *ep,
+                                              const uct_tcp_am_hdr_t *hdr)
+{
+    uct_tcp_md_t *md = ucs_derived_of(iface->super.md, uct_tcp_md_t);
+    const uct_tcp_ep_rma_hdr_t *rma_hdr;
+    uct_tcp_ep_rma_op_t *op;
+    ucs_status_t status;
+    size_t hdr_length;
+
+    hdr_length = ((hdr->am_id == UCT_TCP_EP_STRIPE_PUT_REQ_AM_ID) ||
+                  (hdr->am_id == UCT_TCP_EP_STRIPE_GET_REQ_AM_ID)) ?
+                 sizeof(uct_tcp_ep_stripe_rma_hdr_t) : sizeof(*rma_hdr);
+    if (hdr->length != hdr_length) {
+        ucs_error("tcp_ep %p: received RMA packet (id %d) with invalid "
+                  "length %u", ep, hdr->am_id, hdr->length);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    rma_hdr = (const uct_tcp_ep_rma_hdr_t*)(hdr + 1);
+
+    switch (hdr->am_id) {
+    case UCT_TCP_EP_PUT_REQ_AM_ID:
+    case UCT_TCP_EP_GET_REQ_AM_ID:
+    case UCT_TCP_EP_STRIPE_PUT_REQ_AM_ID:
+    case UCT_TCP_EP_STRIPE_GET_REQ_AM_ID:
+        ucs_trace_data("tcp_ep %p: %s request key 0x%"PRIx64" address "
+                       "0x%"PRIx64" length %"PRIu64, ep,
+                       uct_tcp_ep_rma_is_put(hdr->am_id) ? "PUT" : "GET",
+                       rma_hdr->key, rma_hdr->address, rma_hdr->length);
+
+        /* The peer may access only the memory it got a remote key for */
+        status = uct_tcp_md_check_access(md, rma_hdr->key, rma_hdr->address,
+                                         rma_hdr->length);
+        if (status != UCS_OK) {
+            ucs_error("tcp_ep %p: peer %s is not allowed to access "
+                      "0x%"PRIx64"..0x%"PRIx64" with key 0x%"PRIx64, ep,
+                      uct_tcp_ep_rma_is_put(hdr->am_id) ? "PUT" : "GET",
+                      rma_hdr->address, rma_hdr->address + rma_hdr->length,
+                      rma_hdr->key);
+            return status;
+        }
+
+        if (hdr->am_id == UCT_TCP_EP_PUT_REQ_AM_ID) {
+            return uct_tcp_ep_rma_rx_start(ep, (void*)rma_hdr->address,
+                                           rma_hdr->length, NULL);
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REQ_AM_ID) {
+            return uct_tcp_ep_rma_rep_add(ep, (void*)rma_hdr->address,
+                                          rma_hdr->length);
+        }
+
+        return uct_tcp_ep_stripe_rma_start(
+                ep, hdr->am_id, (const uct_tcp_ep_stripe_rma_hdr_t*)rma_hdr);
+    case UCT_TCP_EP_RMA_REP_AM_ID:
+        if (ucs_queue_is_empty(&ep->rma_q)) {
+            ucs_error("tcp_ep %p: received unexpected RMA reply", ep);
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        op = ucs_queue_head_elem_non_empty(&ep->rma_q, uct_tcp_ep_rma_op_t,
+                                           queue);
+        if (op->is_flush || (op->length != rma_hdr->length)) {
+            ucs_error("tcp_ep %p: RMA reply length %"PRIu64" does not match "
+                      "operation %p length %zu", ep, rma_hdr->length, op,
+                      op->length);
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        return uct_tcp_ep_rma_rx_start(ep, op->buffer, op->length, op);
+    default:
+        ucs_error("tcp_ep %p: received unknown packet (id %d)", ep,
+                  hdr->am_id);
+        return UCS_ERR_INVALID_PARAM;
+    }
+}
+
+static ucs_status_t uct_tcp_ep_stripe_rx_start(uct_tcp_iface_t *iface,
+                                               uct_tcp_ep_t *ep,
+                                               uct_tcp_am_hdr_t *hdr)
+{
+    uct_tcp_ep_stripe_hdr_t *stripe_hdr = (uct_tcp_ep_stripe_hdr_t*)(hdr + 1);
+    uct_tcp_am_hdr_t *am_hdr;
+    ucs_status_t status;
+    size_t offset;
+    void *buf;
+
+    /* the AM header, the user's header and the first part of the payload
+     * are received on the EP socket, the rest of the payload - on the
+     * stripe sockets */
+    if ((hdr->length < sizeof(*stripe_hdr)) ||
+        (stripe_hdr->am_id >= UCT_AM_ID_MAX) ||
+        (stripe_hdr->length > (iface->config.rx_seg_size -
+                               sizeof(uct_tcp_am_hdr_t)))) {
+        goto err_invalid;
+    }
+
+    offset = hdr->length - sizeof(*stripe_hdr);
+    if ((stripe_hdr->length <= offset) ||
+        !uct_tcp_ep_stripe_map_check(stripe_hdr->map,
+                                     stripe_hdr->length - offset,
+                                     stripe_hdr->chunk)) {
+        goto err_invalid;
+    }
+
+    status = uct_tcp_ep_stripe_rx_check(ep, stripe_hdr->map);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    buf = ucs_mpool_get_inline(&iface->rx_mpool);
+    if (ucs_unlikely(buf == NULL)) {
+        ucs_error("tcp_ep %p: unable to get a buffer from RX memory pool "
+                  "for striped AM", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    am_hdr         = UCS_PTR_BYTE_OFFSET(buf, iface->config.rx_buf_offset);
+    am_hdr->am_id  = stripe_hdr->am_id;
+    am_hdr->length = stripe_hdr->length;
+    memcpy(am_hdr + 1, stripe_hdr + 1, offset);
+
+    uct_tcp_ep_stripe_rx_arm(ep->stripe.rx_eps, stripe_hdr->map,
+                             UCS_PTR_BYTE_OFFSET(am_hdr + 1, offset),
+                             am_hdr->length - offset, stripe_hdr->chunk, NULL);
+
+    ucs_trace_data("tcp_ep %p: receiving striped AM %u length %u over stripe "
+                   "sockets 0x%x", ep, am_hdr->am_id, am_hdr->length,
+                   stripe_hdr->map);
+
+    /* AMs after the striped one are handled when it is completed */
+    ep->stripe.rx_hdr     = am_hdr;
+    ep->stripe.rx_pending = ucs_popcount(stripe_hdr->map);
+    uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVREAD);
+    return UCS_OK;
+
+err_invalid:
+    ucs_error("tcp_ep %p: invalid striped AM (length %u map 0x%x chunk %u)",
+              ep, stripe_hdr->length, stripe_hdr->map, stripe_hdr->chunk);
+    return UCS_ERR_INVALID_PARAM;
+}
+
+static unsigned uct_tcp_ep_rx_parse(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep);
+
+/* Resume handling of the packets received after the striped operation */
+static unsigned uct_tcp_ep_stripe_rx_resume(uct_tcp_iface_t *iface,
+                                            uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVREAD, 0);
+    if (ep->rx.buf != NULL) {
+        return uct_tcp_ep_rx_parse(iface, ep);
+    }
+
+    return 0;
+}
+
+static unsigned uct_tcp_ep_stripe_rx_complete(uct_tcp_iface_t *iface,
+                                              uct_tcp_ep_t *ep)
+{
+    uct_tcp_am_hdr_t *hdr = ep->stripe.rx_hdr;
+    ucs_status_t status;
+
+    if (hdr == NULL) {
+        /* all chunks of striped PUT Zcopy data were written */
+        status = uct_tcp_ep_rma_rep_add(ep, NULL, 0);
+        if (status != UCS_OK) {
+            uct_tcp_ep_shutdown(ep);
+            uct_tcp_ep_handle_disconnected(ep);
+            return 0;
+        }
+
+        return 1 + uct_tcp_ep_stripe_rx_resume(iface, ep);
+    }
+
+    ep->stripe.rx_hdr = NULL;
+
+    uct_iface_trace_am(&iface->super, UCT_AM_TRACE_TYPE_RECV, hdr->am_id,
+                       hdr + 1, hdr->length, "RECV: ep %p fd %d received "
+                       "striped AM", ep, ep->fd);
+
+    /* the buffer contains only this AM, so it can be kept by the user */
+    uct_recv_desc(UCS_PTR_BYTE_OFFSET(hdr + 1, -iface->rx_headroom)) =
+            &iface->release_desc;
+    status = uct_iface_invoke_am(&iface->super, hdr->am_id, hdr + 1,
+                                 hdr->length, UCT_CB_PARAM_FLAG_DESC);
+    if (status != UCS_INPROGRESS) {
+        ucs_mpool_put_inline(UCS_PTR_BYTE_OFFSET(hdr,
+                                                 -iface->config.rx_buf_offset));
+    }
+
+    return 1 + uct_tcp_ep_stripe_rx_resume(iface, ep);
+}
+
+static unsigned uct_tcp_ep_progress_stripe_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_t *owner    = ep->stripe.owner;
+    size_t recv_length     = ep->stripe.length;
+    uct_tcp_ep_rma_op_t *op;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_recv_nb(ep, ep->stripe.buf, &recv_length);
+    if (status != UCS_OK) {
+        if (status != UCS_ERR_NO_PROGRESS) {
+            /* the striped operation can't be completed without this part */
+            uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVREAD);
+            uct_tcp_ep_handle_disconnected(owner);
+        }
+        return 0;
+    }
+
+    ucs_trace_data("tcp_ep %p: recvd %zu bytes of striped %s", ep,
+                   recv_length, (ep->stripe.op != NULL) ? "GET reply" :
+                   (owner->stripe.rx_hdr != NULL) ? "AM" : "PUT");
+
+    ep->stripe.buf     = UCS_PTR_BYTE_OFFSET(ep->stripe.buf, recv_length);
+    ep->stripe.length -= recv_length;
+    if (ep->stripe.length != 0) {
+        return 1;
+    }
+
+    uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVREAD);
+
+    op = ep->stripe.op;
+    if (op != NULL) {
+        /* a chunk of GET Zcopy reply, the operation is completed after its
+         * first chunk is received on the owner EP socket too */
+        ep->stripe.op = NULL;
+        ucs_assert(op->pending > 0);
+        if ((--op->pending != 0) || (owner->stripe.rx_op != op)) {
+            return 1;
+        }
+
+        owner->stripe.rx_op = NULL;
+        uct_tcp_ep_rma_op_complete(iface, owner, op);
+        return 2 + uct_tcp_ep_stripe_rx_resume(iface, owner);
+    }
+
+    ucs_assert(owner->stripe.rx_pending > 0);
+    if (--owner->stripe.rx_pending != 0) {
+        return 1;
+    }
+
+    return 1 + uct_tcp_ep_stripe_rx_complete(iface, owner);
+}
+
+/* Length of the rest of the AM which is partially received to RX buffer */
+static size_t uct_tcp_ep_rx_remainder(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
+{
+    uct_tcp_am_hdr_t *hdr;
+
+    if (ep->rx.length - ep->rx.offset < sizeof(*hdr)) {
+        /* do partial receive of the remaining part of the hdr
+         * and post the entire AM buffer */
+        return iface->config.rx_seg_size - ep->rx.length;
+    }
+
+    /* do partial receive of the remaining user data */
+    hdr = ep->rx.buf + ep->rx.offset;
+    return hdr->length - (ep->rx.length - ep->rx.offset - sizeof(*hdr));
+}
+
+/* Get the place where the next data of the EP has to be received, so io_uring
+ * could receive it there without copying. Returns 0 if the data has to be
+ * received to a new RX buffer */
+size_t uct_tcp_ep_rx_dest(uct_tcp_ep_t *ep, void **dest_p)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    if (ep->stripe.length != 0) {
+        *dest_p = ep->stripe.buf;
+        return ep->stripe.length;
+    }
+
+    if (ep->rma_rx.length != 0) {
+        *dest_p = ep->rma_rx.buf;
+        return ep->rma_rx.length;
+    }
+
+    if (uct_tcp_ep_stripe_rx_paused(ep) ||
+        !uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
+        return 0;
+    }
+
+    *dest_p = ep->rx.buf + ep->rx.length;
+    return uct_tcp_ep_rx_remainder(iface, ep);
+}
+
+unsigned uct_tcp_ep_progress_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    size_t recv_length;
+
+    ucs_trace_func("ep=%p", ep);
+
+    if (ep->stripe.length != 0) {
+        return uct_tcp_ep_progress_stripe_rx(ep);
+    }
+
+    if (ep->rma_rx.length != 0) {
+        return uct_tcp_ep_progress_rma_rx(ep);
+    }
+
+    if (ucs_unlikely(uct_tcp_ep_stripe_rx_paused(ep))) {
+        /* waiting for the rest of the striped operation */
+        return 0;
+    }
+
+    if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
+        ucs_assert(ep->rx.buf == NULL);
+
+        if ((iface->uring != NULL) && uct_tcp_uring_ep_rx_adopt(ep)) {
+            /* io_uring received the data to RX buffer */
+            return uct_tcp_ep_rx_parse(iface, ep);
+        }
+
+        ep->rx.buf = ucs_mpool_get_inline(&iface->rx_mpool);
+        if (ucs_unlikely(ep->rx.buf == NULL)) {
+            ucs_warn("tcp_ep %p: unable to get a buffer from RX memory pool", ep);
+            return 0;
+        }
+
+        ep->rx.buf = UCS_PTR_BYTE_OFFSET(ep->rx.buf,
+                                         iface->config.rx_buf_offset);
+
+        /* post the entire AM buffer */
+        recv_length = iface->config.rx_seg_size;
+    } else {
+        ucs_assert(ep->rx.buf != NULL);
+        recv_length = uct_tcp_ep_rx_remainder(iface, ep);
+    }
+
+    if (!uct_tcp_ep_recv(ep, recv_length)) {
+        return 0;
+    }
+
+    return uct_tcp_ep_rx_parse(iface, ep);
+}
+
+/* Parse received active messages */
+static unsigned uct_tcp_ep_rx_parse(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
+{
+    unsigned handled = 0;
+    uct_tcp_am_hdr_t *hdr;
+    size_t remainder;
+    ucs_status_t status;
+
+    while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
+        remainder = ep->rx.length - ep->rx.offset;
+        if (remainder < sizeof(*hdr)) {
+            /* Move the partially received hdr to the beginning of the buffer */
+            memmove(ep->rx.buf, ep->rx.buf + ep->rx.offset, remainder);
+            ep->rx.offset = 0;
+            ep->rx.length = remainder;
+            handled++;
+            goto out;
+        }
+
+        hdr = ep->rx.buf + ep->rx.offset;
+        ucs_assert(hdr->length <= (iface->config.rx_seg_size -
+                                   sizeof(uct_tcp_am_hdr_t)));
+
+        if (remainder < sizeof(*hdr) + hdr->length) {
+            if ((ep->rx.offset != 0) &&
+                (hdr->length >= iface->config.rx_hdr_first_thresh)) {
+                /* Header-first mode: move the beginning of the large AM to
+                 * the beginning of the buffer and receive only the rest of
+                 * its payload, so the whole buffer can be passed to the user */
+                memmove(ep->rx.buf, hdr, remainder);
+                ep->rx.offset = 0;
+                ep->rx.length = remainder;
+            }
+            handled++;
+            goto out;
         }
 
         /* Full message was received */
         ep->rx.offset += sizeof(*hdr) + hdr->length;
 
         if (ucs_likely(hdr->am_id < UCT_AM_ID_MAX)) {
-            uct_tcp_ep_comp_recv_am(iface, ep, hdr);
             handled++;
-        } else {
+            if (uct_tcp_ep_comp_recv_am(iface, ep, hdr) == UCS_INPROGRESS) {
+                /* RX buffer is owned by the user, it will be released by
+                 * uct_iface_release_desc() */
+                uct_tcp_ep_ctx_init(&ep->rx);
+                goto out;
+            }
+        } else if (hdr->am_id == UCT_TCP_EP_CM_AM_ID) {
             handled += 1 + uct_tcp_cm_handle_conn_pkt(&ep, hdr + 1, hdr->length);
             if (ep == NULL) {
                 goto out;
             }
+        } else if (hdr->am_id == UCT_TCP_EP_STRIPE_AM_ID) {
+            handled++;
+            status = uct_tcp_ep_stripe_rx_start(iface, ep, hdr);
+            if (status != UCS_OK) {
+                uct_tcp_ep_handle_disconnected(ep);
+                goto out;
+            }
+
+            /* RX buffer is kept until the striped AM is completed */
+            goto out;
+        } else {
+            handled++;
+            status = uct_tcp_ep_handle_rma_pkt(iface, ep, hdr);
+            if (status != UCS_OK) {
+                /* The rest of the stream can't be parsed anymore */
+                uct_tcp_ep_shutdown(ep);
+                uct_tcp_ep_handle_disconnected(ep);
+                goto out;
+            }
+
+            if (ep->rma_rx.length != 0) {
+                /* RX buffer was entirely consumed by RMA payload, the rest
+                 * of the payload will be received to the user's buffer */
+                ucs_assertv(!uct_tcp_ep_ctx_buf_need_progress(&ep->rx),
+                            "ep=%p", ep);
+                break;
+            }
+
+            if (uct_tcp_ep_stripe_rx_paused(ep)) {
+                /* RX buffer is kept until the striped operation is
+                 * completed */
+                goto out;
+            }
         }
     }
 
-    uct_tcp_ep_ctx_reset(&ep->rx);
+    uct_tcp_ep_rx_reset(ep);
 
 out:
     return handled;
 }
 
 static inline ucs_status_t
-uct_tcp_ep_am_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+uct_tcp_ep_tx_buf_get(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
                       uint8_t am_id, uct_tcp_am_hdr_t **hdr)
 {
-    ucs_status_t status;
+    ucs_assertv(ep->tx.buf == NULL, "ep=%p", ep);
 
-    UCT_CHECK_AM_ID(am_id);
+    ep->tx.buf = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(ep->tx.buf == NULL)) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    *hdr          = ep->tx.buf;
+    (*hdr)->am_id = am_id;
+
+    return UCS_OK;
+}
+
+static inline ucs_status_t
+uct_tcp_ep_tx_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                      uint8_t am_id, uct_tcp_am_hdr_t **hdr)
+{
+    ucs_status_t status;
 
     status = uct_tcp_ep_check_tx_res(ep);
     if (ucs_unlikely(status != UCS_OK)) {
@@ -757,16 +1887,11 @@ uct_tcp_ep_am_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
         return status;
     }
 
-    ucs_assertv(ep->tx.buf == NULL, "ep=%p", ep);
-
-    ep->tx.buf = ucs_mpool_get_inline(&iface->tx_mpool);
-    if (ucs_unlikely(ep->tx.buf == NULL)) {
+    status = uct_tcp_ep_tx_buf_get(iface, ep, am_id, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
         goto err_no_res;
     }
 
-    *hdr          = ep->tx.buf;
-    (*hdr)->am_id = am_id;
-
     return UCS_OK;
 
 err_no_res:
@@ -775,6 +1900,15 @@ err_no_res:
     return UCS_ERR_NO_RESOURCE;
 }
 
+static inline ucs_status_t
+uct_tcp_ep_am_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                      uint8_t am_id, uct_tcp_am_hdr_t **hdr)
+{
+    UCT_CHECK_AM_ID(am_id);
+
+    return uct_tcp_ep_tx_prepare(iface, ep, am_id, hdr);
+}
+
 static inline void
 uct_tcp_ep_set_outstanding_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
                                  uct_tcp_ep_zcopy_ctx_t *ctx, const void *header,
@@ -851,8 +1985,14 @@ uct_tcp_ep_am_sendv(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
 
     ucs_assertv(ep->tx.length <= send_limit, "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt,
-                                 &ep->tx.offset, NULL, NULL);
+    if (short_sendv) {
+        status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt,
+                                     &ep->tx.offset, NULL, NULL);
+    } else {
+        status = uct_tcp_ep_zcopy_sendv(ep, ucs_derived_of(hdr,
+                                                           uct_tcp_ep_zcopy_ctx_t),
+                                        iov, iov_cnt, &ep->tx.offset);
+    }
 
     uct_iface_trace_am(&iface->super, UCT_AM_TRACE_TYPE_SEND, hdr->am_id,
                        /* the function will be invoked only in case of
@@ -937,41 +2077,303 @@ ucs_status_t uct_tcp_ep_am_short(uct_ep_h uct_ep, uint8_t am_id, uint64_t header
                 return UCS_OK;
             }
 
-            status = UCS_OK;
+            status = UCS_OK;
+        }
+
+        uct_tcp_ep_ctx_reset(&ep->tx);
+    }
+
+    return status;
+}
+
+ssize_t uct_tcp_ep_am_bcopy(uct_ep_h uct_ep, uint8_t am_id,
+                            uct_pack_callback_t pack_cb, void *arg,
+                            unsigned flags)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uint32_t payload_length;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+
+    /* Save the length of the payload, because hdr (ep::buf)
+     * can be released inside `uct_tcp_ep_am_send` call */
+    hdr->length = payload_length = pack_cb(hdr + 1, arg);
+
+    uct_tcp_ep_am_send(iface, ep, hdr);
+
+    UCT_TL_EP_STAT_OP(&ep->super, AM, BCOPY, payload_length);
+
+    return payload_length;
+}
+
+/* Select the stripe sockets to carry the chunks of a striped operation: the
+ * connected ones which don't send (or receive a GET Zcopy reply chunk) now.
+ * @return Map of the stripe sockets, or 0 if the operation is not striped */
+static unsigned
+uct_tcp_ep_stripe_map(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, size_t length,
+                      int is_get, size_t *chunk_p)
+{
+    unsigned map   = 0;
+    unsigned count = 0;
+    uct_tcp_ep_t *stripe_ep;
+    unsigned i;
+
+    if (ucs_likely(ep->stripe.tx_eps == NULL) ||
+        (length < iface->config.stripe.thresh)) {
+        return 0;
+    }
+
+    for (i = 0; i < iface->config.stripe.count; ++i) {
+        stripe_ep = ep->stripe.tx_eps[i];
+        if ((stripe_ep != NULL) &&
+            (stripe_ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
+            (is_get ? (stripe_ep->stripe.length == 0) :
+                      uct_tcp_ep_ctx_buf_empty(&stripe_ep->tx))) {
+            map |= UCS_BIT(i);
+            ++count;
+        }
+    }
+
+    if ((count == 0) || (length <= count)) {
+        return 0;
+    }
+
+    /* the EP socket carries the first chunk, skip the stripe sockets which
+     * would get no data */
+    *chunk_p = ucs_div_round_up(length, count + 1);
+    count    = ucs_div_round_up(length, *chunk_p) - 1;
+    ucs_for_each_bit(i, map) {
+        if (count == 0) {
+            map &= ~UCS_BIT(i);
+        } else {
+            --count;
+        }
+    }
+
+    return map;
+}
+
+static ucs_status_t
+uct_tcp_ep_stripe_send(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                       uct_tcp_ep_zcopy_ctx_t *ctx, size_t length,
+                       uct_completion_t *comp)
+{
+    ucs_status_t status;
+
+    ep->tx.length = length;
+
+    status = uct_tcp_ep_zcopy_sendv(ep, ctx, ctx->iov, ctx->iov_cnt,
+                                    &ep->tx.offset);
+
+    ucs_trace_data("tcp_ep %p: sent %zu/%zu bytes of striped operation", ep,
+                   ep->tx.offset, ep->tx.length);
+
+    if ((status == UCS_OK) || (status == UCS_ERR_NO_PROGRESS)) {
+        if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+            iface->outstanding += ep->tx.length - ep->tx.offset;
+
+            /* headers are already placed in the TX buffer */
+            uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, NULL, 0, comp);
+            return UCS_INPROGRESS;
+        }
+
+        if (uct_tcp_ep_msg_zcopy_need_wait(ep, ctx)) {
+            ctx->comp = comp;
+            uct_tcp_ep_msg_zcopy_push(iface, ep, ctx);
+            return UCS_INPROGRESS;
+        }
+
+        status = UCS_OK;
+    }
+
+    uct_tcp_ep_ctx_reset(&ep->tx);
+    return status;
+}
+
+/* Get TX buffers of the stripe sockets from the map before sending anything */
+static ucs_status_t
+uct_tcp_ep_stripes_tx_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                              unsigned map)
+{
+    uct_tcp_am_hdr_t *hdr;
+    ucs_status_t status;
+    unsigned i;
+
+    ucs_for_each_bit(i, map) {
+        status = uct_tcp_ep_tx_prepare(iface, ep->stripe.tx_eps[i],
+                                       UCT_TCP_EP_STRIPE_AM_ID, &hdr);
+        if (status != UCS_OK) {
+            map &= UCS_MASK(i);
+            ucs_for_each_bit(i, map) {
+                uct_tcp_ep_ctx_reset(&ep->stripe.tx_eps[i]->tx);
+            }
+            return status;
+        }
+    }
+
+    return UCS_OK;
+}
+
+/* Send the chunks of the payload, which follow the first chunk, on the stripe
+ * sockets from the map without any header. The number of the chunks which are
+ * still in progress is returned in pending_p. If a chunk is not sent, the
+ * connection is broken and the chunks in progress complete with an error */
+static ucs_status_t
+uct_tcp_ep_stripes_send(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, unsigned map,
+                        const struct iovec *payload_iov, size_t payload_iov_cnt,
+                        size_t length, size_t chunk, uct_completion_t *comp,
+                        unsigned *pending_p)
+{
+    size_t offset       = chunk;
+    ucs_status_t ret    = UCS_OK;
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    uct_tcp_ep_t *stripe_ep;
+    ucs_status_t status;
+    unsigned i;
+
+    *pending_p = 0;
+
+    ucs_for_each_bit(i, map) {
+        stripe_ep = ep->stripe.tx_eps[i];
+        if (ret != UCS_OK) {
+            /* a previous chunk failed, release the rest of TX buffers */
+            uct_tcp_ep_ctx_reset(&stripe_ep->tx);
+            continue;
         }
 
-        uct_tcp_ep_ctx_reset(&ep->tx);
+        ctx            = (uct_tcp_ep_zcopy_ctx_t*)stripe_ep->tx.buf;
+        ctx->msg_zcopy = 0;
+        ctx->iov_cnt   = uct_tcp_ep_iovec_slice(ctx->iov, payload_iov,
+                                                payload_iov_cnt, offset, chunk);
+
+        status = uct_tcp_ep_stripe_send(iface, stripe_ep, ctx,
+                                        ucs_min(chunk, length - offset), comp);
+        if (UCS_STATUS_IS_ERR(status)) {
+            ucs_error("tcp_ep %p: failed to send a chunk of striped operation "
+                      "on stripe socket %u: %s", ep, i,
+                      ucs_status_string(status));
+            uct_tcp_ep_stripes_tx_fail(ep);
+            ret = status;
+            continue;
+        }
+
+        *pending_p += (status == UCS_INPROGRESS);
+        offset     += chunk;
     }
 
-    return status;
+    return ret;
 }
 
-ssize_t uct_tcp_ep_am_bcopy(uct_ep_h uct_ep, uint8_t am_id,
-                            uct_pack_callback_t pack_cb, void *arg,
-                            unsigned flags)
+/* Return the status of a striped operation whose parts are in progress */
+static ucs_status_t
+uct_tcp_ep_stripes_op_status(uct_completion_t *comp, unsigned pending,
+                             ucs_status_t status)
 {
-    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
-    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
-    uct_tcp_am_hdr_t *hdr  = NULL;
-    uint32_t payload_length;
+    if (pending == 0) {
+        return status;
+    }
+
+    if (comp != NULL) {
+        /* the completion is invoked by every part, which is in progress */
+        comp->count += pending - 1;
+    }
+
+    return UCS_INPROGRESS;
+}
+
+/* Send the AM header, the user's header and the first part of the payload
+ * on the EP socket and the rest of the payload - on the idle stripe sockets.
+ * The peer delivers the AM after all parts are received, so AMs are still
+ * ordered by the EP socket */
+static ucs_status_t
+uct_tcp_ep_am_zcopy_striped(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                            uint8_t am_id, const void *header,
+                            unsigned header_length, const uct_iov_t *iov,
+                            size_t iovcnt, size_t payload_length,
+                            unsigned map, size_t chunk,
+                            uct_completion_t *comp)
+{
+    uct_tcp_am_hdr_t *hdr;
+    uct_tcp_ep_stripe_hdr_t *stripe_hdr;
+    struct iovec *payload_iov;
+    size_t payload_iov_cnt, length;
+    uct_tcp_ep_zcopy_ctx_t *ctx;
     ucs_status_t status;
+    unsigned pending;
 
-    status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
+    status = uct_tcp_ep_tx_prepare(iface, ep, UCT_TCP_EP_STRIPE_AM_ID, &hdr);
     if (status != UCS_OK) {
         return status;
     }
 
-    ucs_assertv(hdr != NULL, "ep=%p", ep);
+    status = uct_tcp_ep_stripes_tx_prepare(iface, ep, map);
+    if (status != UCS_OK) {
+        goto err_reset;
+    }
 
-    /* Save the length of the payload, because hdr (ep::buf)
-     * can be released inside `uct_tcp_ep_am_send` call */
-    hdr->length = payload_length = pack_cb(hdr + 1, arg);
+    payload_iov     = ucs_alloca(iovcnt * sizeof(*payload_iov));
+    payload_iov_cnt = uct_tcp_ep_iovec_fill_iov(payload_iov, iov, iovcnt,
+                                                &length);
+    ucs_assert(length == payload_length);
 
-    uct_tcp_ep_am_send(iface, ep, hdr);
+    status = uct_tcp_ep_stripes_send(iface, ep, map, payload_iov,
+                                     payload_iov_cnt, payload_length, chunk,
+                                     comp, &pending);
+    if (status != UCS_OK) {
+        uct_tcp_ep_ctx_reset(&ep->tx);
+        return uct_tcp_ep_stripes_op_status(comp, pending, status);
+    }
 
-    UCT_TL_EP_STAT_OP(&ep->super, AM, BCOPY, payload_length);
+    stripe_hdr         = UCS_PTR_BYTE_OFFSET(ep->tx.buf,
+                                             iface->config.zcopy.hdr_offset);
+    stripe_hdr->am_id  = am_id;
+    stripe_hdr->map    = map;
+    stripe_hdr->length = header_length + payload_length;
+    stripe_hdr->chunk  = chunk;
+    if (header_length != 0) {
+        ucs_assert(header != NULL);
+        memcpy(stripe_hdr + 1, header, header_length);
+    }
 
-    return payload_length;
+    ctx                  = ucs_derived_of(hdr, uct_tcp_ep_zcopy_ctx_t);
+    ctx->msg_zcopy       = (chunk >= iface->config.zcopy.msg_zcopy_thresh);
+    ctx->iov[0].iov_base = hdr;
+    ctx->iov[0].iov_len  = sizeof(*hdr);
+    ctx->iov[1].iov_base = stripe_hdr;
+    ctx->iov[1].iov_len  = sizeof(*stripe_hdr) + header_length;
+    ctx->iov_cnt         = 2 + uct_tcp_ep_iovec_slice(&ctx->iov[2], payload_iov,
+                                                      payload_iov_cnt, 0, chunk);
+    hdr->length          = sizeof(*stripe_hdr) + header_length + chunk;
+
+    status = uct_tcp_ep_stripe_send(iface, ep, ctx,
+                                    sizeof(*hdr) + hdr->length, comp);
+    if (UCS_STATUS_IS_ERR(status)) {
+        /* the chunks sent on the stripe sockets can't be taken back */
+        uct_tcp_ep_stripes_tx_fail(ep);
+        return uct_tcp_ep_stripes_op_status(comp, pending, status);
+    }
+
+    UCT_TL_EP_STAT_OP(&ep->super, AM, ZCOPY, stripe_hdr->length);
+    uct_iface_trace_am(&iface->super, UCT_AM_TRACE_TYPE_SEND, am_id, header,
+                       stripe_hdr->length, "SEND: ep %p fd %d striped AM "
+                       "over stripe sockets 0x%x, chunk %zu", ep, ep->fd, map,
+                       chunk);
+
+    return uct_tcp_ep_stripes_op_status(comp,
+                                        pending + (status == UCS_INPROGRESS),
+                                        UCS_OK);
+
+err_reset:
+    uct_tcp_ep_ctx_reset(&ep->tx);
+    return status;
 }
 
 ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *header,
@@ -983,7 +2385,9 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
     uct_tcp_am_hdr_t *hdr  = NULL;
     uct_tcp_ep_zcopy_ctx_t *ctx;
+    size_t payload_length, chunk;
     ucs_status_t status;
+    unsigned map;
 
     UCT_CHECK_IOV_SIZE(iovcnt, iface->config.zcopy.max_iov,
                        "uct_tcp_ep_am_zcopy");
@@ -992,6 +2396,17 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     UCT_CHECK_LENGTH(header_length + uct_iov_total_length(iov, iovcnt), 0,
                      iface->config.rx_seg_size - sizeof(uct_tcp_am_hdr_t),
                      "am_zcopy");
+    UCT_CHECK_AM_ID(am_id);
+
+    payload_length = uct_iov_total_length(iov, iovcnt);
+    if ((header_length + sizeof(uct_tcp_ep_stripe_hdr_t) <=
+         iface->config.zcopy.max_hdr) &&
+        ((map = uct_tcp_ep_stripe_map(iface, ep, payload_length, 0,
+                                      &chunk)) != 0)) {
+        return uct_tcp_ep_am_zcopy_striped(iface, ep, am_id, header,
+                                           header_length, iov, iovcnt,
+                                           payload_length, map, chunk, comp);
+    }
 
     status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
     if (status != UCS_OK) {
@@ -1000,8 +2415,9 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
 
     ucs_assertv(hdr != NULL, "ep=%p", ep);
 
-    ctx          = ucs_derived_of(hdr, uct_tcp_ep_zcopy_ctx_t);
-    ctx->iov_cnt = 0;
+    ctx            = ucs_derived_of(hdr, uct_tcp_ep_zcopy_ctx_t);
+    ctx->iov_cnt   = 0;
+    ctx->msg_zcopy = (payload_length >= iface->config.zcopy.msg_zcopy_thresh);
 
     /* TCP transport header */
     ctx->iov[ctx->iov_cnt].iov_base = hdr;
@@ -1011,7 +2427,15 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     if (header_length != 0) {
         /* User-defined header */
         ucs_assert(header != NULL);
-        ctx->iov[ctx->iov_cnt].iov_base = (void*)header;
+        if (ctx->msg_zcopy) {
+            /* the header must stay valid until the kernel completes
+             * the send, keep it in the TX buffer */
+            ctx->iov[ctx->iov_cnt].iov_base = ep->tx.buf +
+                                              iface->config.zcopy.hdr_offset;
+            memcpy(ctx->iov[ctx->iov_cnt].iov_base, header, header_length);
+        } else {
+            ctx->iov[ctx->iov_cnt].iov_base = (void*)header;
+        }
         ctx->iov[ctx->iov_cnt].iov_len  = header_length;
         ctx->iov_cnt++;
     }
@@ -1032,18 +2456,455 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
                                              header_length, comp);
             return UCS_INPROGRESS;
         }
+
+        if (uct_tcp_ep_msg_zcopy_need_wait(ep, ctx)) {
+            ctx->comp = comp;
+            uct_tcp_ep_msg_zcopy_push(iface, ep, ctx);
+            return UCS_INPROGRESS;
+        }
+    }
+
+    uct_tcp_ep_ctx_reset(&ep->tx);
+    return status;
+}
+
+static inline uct_tcp_ep_zcopy_ctx_t*
+uct_tcp_ep_rma_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                       uct_tcp_am_hdr_t *hdr, uint64_t key, uint64_t address,
+                       size_t length)
+{
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    uct_tcp_ep_rma_hdr_t *rma_hdr;
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+
+    ctx            = ucs_derived_of(hdr, uct_tcp_ep_zcopy_ctx_t);
+    ctx->iov_cnt   = 0;
+    ctx->msg_zcopy = 0;
+    hdr->length    = sizeof(uct_tcp_ep_rma_hdr_t);
+
+    /* TCP transport header */
+    ctx->iov[ctx->iov_cnt].iov_base = hdr;
+    ctx->iov[ctx->iov_cnt].iov_len  = sizeof(*hdr);
+    ctx->iov_cnt++;
+
+    /* RMA header is kept in the space reserved for AM Zcopy header */
+    rma_hdr          = UCS_PTR_BYTE_OFFSET(ep->tx.buf,
+                                           iface->config.zcopy.hdr_offset);
+    rma_hdr->key     = key;
+    rma_hdr->address = address;
+    rma_hdr->length  = length;
+
+    ctx->iov[ctx->iov_cnt].iov_base = rma_hdr;
+    ctx->iov[ctx->iov_cnt].iov_len  = sizeof(*rma_hdr);
+    ctx->iov_cnt++;
+
+    return ctx;
+}
+
+static inline uct_tcp_ep_zcopy_ctx_t*
+uct_tcp_ep_stripe_rma_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                              uct_tcp_am_hdr_t *hdr, uint64_t key,
+                              uint64_t address, size_t length, unsigned map,
+                              size_t chunk)
+{
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    uct_tcp_ep_stripe_rma_hdr_t *stripe_hdr;
+
+    ctx               = uct_tcp_ep_rma_prepare(iface, ep, hdr, key, address,
+                                               length);
+    stripe_hdr        = ctx->iov[1].iov_base;
+    stripe_hdr->map   = map;
+    stripe_hdr->chunk = chunk;
+    hdr->length       = sizeof(*stripe_hdr);
+    ctx->iov[1].iov_len = sizeof(*stripe_hdr);
+
+    return ctx;
+}
+
+static UCS_F_ALWAYS_INLINE uint64_t uct_tcp_ep_rma_key(uct_rkey_t rkey)
+{
+    /* Zero-length operations may be posted without a remote key */
+    return (rkey == UCT_INVALID_RKEY) ? 0 : ((uct_tcp_rkey_t*)rkey)->key;
+}
+
+static inline ucs_status_t
+uct_tcp_ep_rma_send(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                    uct_tcp_ep_zcopy_ctx_t *ctx, size_t payload_length,
+                    uct_completion_t *comp)
+{
+    const uct_tcp_ep_rma_hdr_t *rma_hdr = ctx->iov[1].iov_base;
+    ucs_status_t status;
+
+    ep->tx.length = sizeof(uct_tcp_am_hdr_t) + ctx->super.length +
+                    payload_length;
+
+    status = ucs_socket_sendv_nb(ep->fd, ctx->iov, ctx->iov_cnt,
+                                 &ep->tx.offset, NULL, NULL);
+
+    ucs_trace_data("tcp_ep %p: %s address 0x%"PRIx64" length %"PRIu64", "
+                   "sent %zu/%zu bytes", ep,
+                   (ctx->super.am_id == UCT_TCP_EP_RMA_REP_AM_ID) ?
+                   "GET reply" : uct_tcp_ep_rma_is_put(ctx->super.am_id) ?
+                   "PUT" : "GET request", rma_hdr->address,
+                   rma_hdr->length, ep->tx.offset, ep->tx.length);
+
+    if ((status == UCS_OK) || (status == UCS_ERR_NO_PROGRESS)) {
+        if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+            iface->outstanding += ep->tx.length - ep->tx.offset;
+
+            /* RMA header is already placed in the TX buffer */
+            uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, NULL, 0, comp);
+            return UCS_INPROGRESS;
+        }
+
+        status = UCS_OK;
+    }
+
+    uct_tcp_ep_ctx_reset(&ep->tx);
+    return status;
+}
+
+static inline void
+uct_tcp_ep_rma_op_push(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                       uct_tcp_ep_rma_op_t *op, void *buffer, size_t length,
+                       uct_completion_t *comp)
+{
+    op->buffer   = buffer;
+    op->length   = length;
+    op->comp     = comp;
+    op->is_flush = 0;
+    op->pending  = 0;
+    ucs_queue_push(&ep->rma_q, &op->queue);
+    uct_tcp_iface_outstanding_inc(iface);
+}
+
+static UCS_F_ALWAYS_INLINE unsigned
+uct_tcp_ep_rma_stripe_map(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                          size_t length, int is_get, size_t *chunk_p)
+{
+    if (iface->config.zcopy.max_hdr < sizeof(uct_tcp_ep_stripe_rma_hdr_t)) {
+        return 0;
+    }
+
+    return uct_tcp_ep_stripe_map(iface, ep, length, is_get, chunk_p);
+}
+
+/* Send PUT Zcopy request with the first chunk of the data on the EP socket
+ * and the next chunks - on the idle stripe sockets. The peer acknowledges it
+ * on the EP socket after all chunks are written */
+static ucs_status_t
+uct_tcp_ep_put_zcopy_striped(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                             const uct_iov_t *iov, size_t iovcnt,
+                             size_t length, uint64_t remote_addr,
+                             uct_rkey_t rkey, unsigned map, size_t chunk,
+                             uct_completion_t *comp)
+{
+    uct_tcp_am_hdr_t *hdr = NULL;
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    struct iovec *payload_iov;
+    size_t payload_iov_cnt, payload_length;
+    uct_tcp_ep_rma_op_t *op;
+    ucs_status_t status;
+    unsigned pending;
+
+    op = ucs_mpool_get_inline(&iface->rma_op_mpool);
+    if (ucs_unlikely(op == NULL)) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    status = uct_tcp_ep_tx_prepare(iface, ep, UCT_TCP_EP_STRIPE_PUT_REQ_AM_ID,
+                                   &hdr);
+    if (status != UCS_OK) {
+        goto err_put_op;
+    }
+
+    status = uct_tcp_ep_stripes_tx_prepare(iface, ep, map);
+    if (status != UCS_OK) {
+        goto err_reset;
+    }
+
+    payload_iov     = ucs_alloca(iovcnt * sizeof(*payload_iov));
+    payload_iov_cnt = uct_tcp_ep_iovec_fill_iov(payload_iov, iov, iovcnt,
+                                                &payload_length);
+    ucs_assert(payload_length == length);
+
+    status = uct_tcp_ep_stripes_send(iface, ep, map, payload_iov,
+                                     payload_iov_cnt, length, chunk, comp,
+                                     &pending);
+    if (status != UCS_OK) {
+        uct_tcp_ep_ctx_reset(&ep->tx);
+        ucs_mpool_put_inline(op);
+        return uct_tcp_ep_stripes_op_status(comp, pending, status);
     }
 
+    ctx           = uct_tcp_ep_stripe_rma_prepare(iface, ep, hdr,
+                                                  uct_tcp_ep_rma_key(rkey),
+                                                  remote_addr, length, map,
+                                                  chunk);
+    ctx->iov_cnt += uct_tcp_ep_iovec_slice(&ctx->iov[ctx->iov_cnt],
+                                           payload_iov, payload_iov_cnt, 0,
+                                           chunk);
+
+    status = uct_tcp_ep_rma_send(iface, ep, ctx, chunk, comp);
+    if (UCS_STATUS_IS_ERR(status)) {
+        /* the chunks sent on the stripe sockets can't be taken back */
+        uct_tcp_ep_stripes_tx_fail(ep);
+        ucs_mpool_put_inline(op);
+        return uct_tcp_ep_stripes_op_status(comp, pending, status);
+    }
+
+    uct_tcp_ep_rma_op_push(iface, ep, op, NULL, 0, NULL);
+    UCT_TL_EP_STAT_OP(&ep->super, PUT, ZCOPY, length);
+    return uct_tcp_ep_stripes_op_status(comp,
+                                        pending + (status == UCS_INPROGRESS),
+                                        UCS_OK);
+
+err_reset:
     uct_tcp_ep_ctx_reset(&ep->tx);
+err_put_op:
+    ucs_mpool_put_inline(op);
+    return status;
+}
+
+/* Send GET Zcopy request on the EP socket and receive the first chunk of the
+ * reply on it and the next chunks - on the idle stripe sockets */
+static ucs_status_t
+uct_tcp_ep_get_zcopy_striped(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                             void *buffer, size_t length, uint64_t remote_addr,
+                             uct_rkey_t rkey, unsigned map, size_t chunk,
+                             uct_completion_t *comp)
+{
+    uct_tcp_am_hdr_t *hdr = NULL;
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    uct_tcp_ep_rma_op_t *op;
+    ucs_status_t status;
+
+    op = ucs_mpool_get_inline(&iface->rma_op_mpool);
+    if (ucs_unlikely(op == NULL)) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    status = uct_tcp_ep_tx_prepare(iface, ep, UCT_TCP_EP_STRIPE_GET_REQ_AM_ID,
+                                   &hdr);
+    if (status != UCS_OK) {
+        goto err_put_op;
+    }
+
+    ctx    = uct_tcp_ep_stripe_rma_prepare(iface, ep, hdr,
+                                           uct_tcp_ep_rma_key(rkey),
+                                           remote_addr, length, map, chunk);
+    status = uct_tcp_ep_rma_send(iface, ep, ctx, 0, NULL);
+    if (UCS_STATUS_IS_ERR(status)) {
+        goto err_put_op;
+    }
+
+    /* the reply to the request on the EP socket brings the first chunk */
+    uct_tcp_ep_rma_op_push(iface, ep, op, buffer, chunk, comp);
+    op->pending = ucs_popcount(map);
+    uct_tcp_ep_stripe_rx_arm(ep->stripe.tx_eps, map,
+                             UCS_PTR_BYTE_OFFSET(buffer, chunk),
+                             length - chunk, chunk, op);
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, length);
+    return UCS_INPROGRESS;
+
+err_put_op:
+    ucs_mpool_put_inline(op);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    uct_tcp_ep_rma_op_t *op;
+    ucs_status_t status;
+    size_t length, chunk;
+    unsigned map;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, iface->config.zcopy.max_iov -
+                       UCT_TCP_EP_RMA_ZCOPY_SERVICE_IOV_COUNT,
+                       "uct_tcp_ep_put_zcopy");
+
+    length = uct_iov_total_length(iov, iovcnt);
+    map    = uct_tcp_ep_rma_stripe_map(iface, ep, length, 0, &chunk);
+    if (map != 0) {
+        return uct_tcp_ep_put_zcopy_striped(iface, ep, iov, iovcnt, length,
+                                            remote_addr, rkey, map, chunk,
+                                            comp);
+    }
+
+    op = ucs_mpool_get_inline(&iface->rma_op_mpool);
+    if (ucs_unlikely(op == NULL)) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    status = uct_tcp_ep_tx_prepare(iface, ep, UCT_TCP_EP_PUT_REQ_AM_ID, &hdr);
+    if (status != UCS_OK) {
+        goto err_put_op;
+    }
+
+    ctx           = uct_tcp_ep_rma_prepare(iface, ep, hdr,
+                                           uct_tcp_ep_rma_key(rkey),
+                                           remote_addr, length);
+    ctx->iov_cnt += uct_tcp_ep_iovec_fill_iov(&ctx->iov[ctx->iov_cnt], iov,
+                                              iovcnt, &length);
+
+    status = uct_tcp_ep_rma_send(iface, ep, ctx, length, comp);
+    if (UCS_STATUS_IS_ERR(status)) {
+        goto err_put_op;
+    }
+
+    /* The data is written remotely when the acknowledgment is received,
+     * wait for it to be able to complete flush requests */
+    uct_tcp_ep_rma_op_push(iface, ep, op, NULL, 0, NULL);
+    UCT_TL_EP_STAT_OP(&ep->super, PUT, ZCOPY, length);
+    return status;
+
+err_put_op:
+    ucs_mpool_put_inline(op);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    size_t length          = uct_iov_get_length(&iov[0]);
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    uct_tcp_ep_rma_op_t *op;
+    ucs_status_t status;
+    unsigned map;
+    size_t chunk;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, 1ul, "uct_tcp_ep_get_zcopy");
+
+    map = uct_tcp_ep_rma_stripe_map(iface, ep, length, 1, &chunk);
+    if (map != 0) {
+        return uct_tcp_ep_get_zcopy_striped(iface, ep, iov[0].buffer, length,
+                                            remote_addr, rkey, map, chunk,
+                                            comp);
+    }
+
+    op = ucs_mpool_get_inline(&iface->rma_op_mpool);
+    if (ucs_unlikely(op == NULL)) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    status = uct_tcp_ep_tx_prepare(iface, ep, UCT_TCP_EP_GET_REQ_AM_ID, &hdr);
+    if (status != UCS_OK) {
+        goto err_put_op;
+    }
+
+    /* GET request has no payload, the reply brings the requested data */
+    ctx    = uct_tcp_ep_rma_prepare(iface, ep, hdr, uct_tcp_ep_rma_key(rkey),
+                                    remote_addr, length);
+    status = uct_tcp_ep_rma_send(iface, ep, ctx, 0, NULL);
+    if (UCS_STATUS_IS_ERR(status)) {
+        goto err_put_op;
+    }
+
+    uct_tcp_ep_rma_op_push(iface, ep, op, iov[0].buffer, length, comp);
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, length);
+    return UCS_INPROGRESS;
+
+err_put_op:
+    ucs_mpool_put_inline(op);
     return status;
 }
 
+static ucs_status_t uct_tcp_ep_send_rma_rep(uct_tcp_iface_t *iface,
+                                            uct_tcp_ep_t *ep,
+                                            const uct_tcp_ep_rma_op_t *op)
+{
+    uct_tcp_am_hdr_t *hdr = NULL;
+    uct_tcp_ep_zcopy_ctx_t *ctx;
+    ucs_status_t status;
+
+    /* Don't check TX resources, since GET replies have priority over
+     * the pending user's operations */
+    status = uct_tcp_ep_tx_buf_get(iface, ep, UCT_TCP_EP_RMA_REP_AM_ID, &hdr);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if (ep->stripe.owner != NULL) {
+        /* stripe socket carries only the chunks of GET replies, which are
+         * received by the peer without any header */
+        ctx                  = ucs_derived_of(hdr, uct_tcp_ep_zcopy_ctx_t);
+        ctx->msg_zcopy       = 0;
+        ctx->iov[0].iov_base = op->buffer;
+        ctx->iov[0].iov_len  = op->length;
+        ctx->iov_cnt         = 1;
+        return uct_tcp_ep_stripe_send(iface, ep, ctx, op->length, NULL);
+    }
+
+    /* The initiator matches replies to its operations by order, so the
+     * reply doesn't need a key */
+    ctx = uct_tcp_ep_rma_prepare(iface, ep, hdr, 0, (uintptr_t)op->buffer,
+                                 op->length);
+
+    if (op->length != 0) {
+        ctx->iov[ctx->iov_cnt].iov_base = op->buffer;
+        ctx->iov[ctx->iov_cnt].iov_len  = op->length;
+        ctx->iov_cnt++;
+    }
+
+    return uct_tcp_ep_rma_send(iface, ep, ctx, op->length, NULL);
+}
+
+static unsigned uct_tcp_ep_progress_rma_rep(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    unsigned count         = 0;
+    uct_tcp_ep_rma_op_t *op;
+    ucs_status_t status;
+
+    while (!ucs_queue_is_empty(&ep->rma_rep_q) &&
+           uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
+        op     = ucs_queue_head_elem_non_empty(&ep->rma_rep_q,
+                                               uct_tcp_ep_rma_op_t, queue);
+        status = uct_tcp_ep_send_rma_rep(iface, ep, op);
+        if (status == UCS_ERR_NO_RESOURCE) {
+            break;
+        } else if (UCS_STATUS_IS_ERR(status)) {
+            /* The initiator waits for the replies in order, so the lost
+             * reply can't be skipped: drop the rest of the replies and
+             * break the connection to fail the initiator's operations */
+            ucs_error("tcp_ep %p: failed to send RMA reply: %s", ep,
+                      ucs_status_string(status));
+            uct_tcp_ep_rma_op_queue_purge(iface, ep, &ep->rma_rep_q, status);
+            uct_tcp_ep_shutdown(ep);
+            return count;
+        }
+
+        ucs_queue_pull_non_empty(&ep->rma_rep_q);
+        ucs_mpool_put_inline(op);
+        count++;
+    }
+
+    if (!ucs_queue_is_empty(&ep->rma_rep_q)) {
+        uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
+    }
+
+    return count;
+}
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags)
 {
     uct_tcp_ep_t *ep = ucs_derived_of(tl_ep, uct_tcp_ep_t);
 
-    if (uct_tcp_ep_check_tx_res(ep) == UCS_OK) {
+    if ((uct_tcp_ep_check_tx_res(ep) == UCS_OK) &&
+        !uct_tcp_ep_stripes_tx_busy(ep)) {
         return UCS_ERR_BUSY;
     }
 
@@ -1064,14 +2925,72 @@ void uct_tcp_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
 ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
                               uct_completion_t *comp)
 {
-    uct_tcp_ep_t *ep = ucs_derived_of(tl_ep, uct_tcp_ep_t);
-
-    if (uct_tcp_ep_check_tx_res(ep) == UCS_ERR_NO_RESOURCE) {
+    uct_tcp_ep_t *ep                 = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface           = ucs_derived_of(tl_ep->iface,
+                                                      uct_tcp_iface_t);
+    uct_tcp_ep_rma_op_t *op          = NULL;
+    uct_tcp_ep_zcopy_ctx_t *zcopy_op = NULL;
+    int rma_pending, msg_zcopy_pending;
+
+    if ((uct_tcp_ep_check_tx_res(ep) == UCS_ERR_NO_RESOURCE) ||
+        /* wait for the chunks of striped operations */
+        uct_tcp_ep_stripes_tx_busy(ep)) {
         UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
         return UCS_ERR_NO_RESOURCE;
     }
 
-    UCT_TL_EP_STAT_FLUSH(&ep->super);
-    return UCS_OK;
+    rma_pending       = !ucs_queue_is_empty(&ep->rma_q);
+    msg_zcopy_pending = !ucs_queue_is_empty(&ep->msg_zcopy.queue);
+
+    if (!rma_pending && !msg_zcopy_pending) {
+        UCT_TL_EP_STAT_FLUSH(&ep->super);
+        return UCS_OK;
+    }
+
+    if (comp != NULL) {
+        if (rma_pending) {
+            op = ucs_mpool_get_inline(&iface->rma_op_mpool);
+            if (ucs_unlikely(op == NULL)) {
+                return UCS_ERR_NO_RESOURCE;
+            }
+        }
+
+        if (msg_zcopy_pending) {
+            zcopy_op = ucs_mpool_get_inline(&iface->tx_mpool);
+            if (ucs_unlikely(zcopy_op == NULL)) {
+                if (op != NULL) {
+                    ucs_mpool_put_inline(op);
+                }
+                return UCS_ERR_NO_RESOURCE;
+            }
+        }
+
+        if (rma_pending && msg_zcopy_pending) {
+            /* completed by both queues */
+            ++comp->count;
+        }
+
+        if (op != NULL) {
+            /* Complete the flush after replies to all GET Zcopy operations
+             * posted before it are received */
+            op->buffer   = NULL;
+            op->length   = 0;
+            op->comp     = comp;
+            op->is_flush = 1;
+            ucs_queue_push(&ep->rma_q, &op->queue);
+        }
+
+        if (zcopy_op != NULL) {
+            /* Complete the flush after the kernel reports the last
+             * MSG_ZEROCOPY send posted before it */
+            zcopy_op->comp = comp;
+            zcopy_op->sn   = ep->msg_zcopy.sn - 1;
+            ucs_queue_push(&ep->msg_zcopy.queue, &zcopy_op->queue);
+            uct_tcp_iface_outstanding_inc(iface);
+        }
+    }
+
+    UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+    return UCS_INPROGRESS;
 }
 
@@ -19,6 +19,12 @@
 #include <dirent.h>
 
 
+static const char *uct_tcp_progress_engine_names[] = {
+    [UCT_TCP_PROGRESS_ENGINE_EPOLL]    = "epoll",
+    [UCT_TCP_PROGRESS_ENGINE_IO_URING] = "io_uring",
+    [UCT_TCP_PROGRESS_ENGINE_LAST]     = NULL
+};
+
 static ucs_config_field_t uct_tcp_iface_config_table[] = {
   {"", "", NULL,
    ucs_offsetof(uct_tcp_iface_config_t, super),
@@ -32,6 +38,16 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Size of receive copy-out buffer",
    ucs_offsetof(uct_tcp_iface_config_t, rx_seg_size), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"RX_HDR_FIRST_THRESH", "16kb",
+   "Minimum size of active message payload which is received in header-first\n"
+   "mode: when such a message is received partially, its beginning is moved to\n"
+   "the start of the receive buffer and only the rest of its payload is received\n"
+   "after it. The buffer then holds just this message, and it is passed to the\n"
+   "active message handler as a descriptor which the user may keep instead of\n"
+   "copying the payload. The payload is not received to the user's buffer.",
+   ucs_offsetof(uct_tcp_iface_config_t, rx_hdr_first_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
   {"MAX_IOV", "6",
    "Maximum IOV count that can contain user-defined payload in a single\n"
    "call to non-blocking vector socket send",
@@ -41,6 +57,26 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Threshold for switching from send() to sendmsg() for short active messages",
    ucs_offsetof(uct_tcp_iface_config_t, sendv_thresh), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"MSG_ZEROCOPY_THRESH", "inf",
+   "Minimum size of AM Zcopy payload which is sent with MSG_ZEROCOPY flag to\n"
+   "avoid copying the data to the socket buffer. The operation is completed\n"
+   "when the kernel releases the user's buffer. \"inf\" - disable MSG_ZEROCOPY",
+   ucs_offsetof(uct_tcp_iface_config_t, msg_zcopy_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"SOCKETS_PER_EP", "1",
+   "Number of TCP sockets used by an endpoint. The payload of large AM Zcopy\n"
+   "messages and the data of large PUT/GET Zcopy operations are split between\n"
+   "the idle sockets to spread the traffic over several TCP flows. Maximal\n"
+   "value is "
+   UCS_PP_MAKE_STRING(UCT_TCP_EP_MAX_SOCKETS) ".",
+   ucs_offsetof(uct_tcp_iface_config_t, sockets_per_ep), UCS_CONFIG_TYPE_UINT},
+
+  {"STRIPE_THRESH", "16kb",
+   "Minimum size of AM Zcopy payload or PUT/GET Zcopy data which is split\n"
+   "between the endpoint sockets, if SOCKETS_PER_EP is greater than 1",
+   ucs_offsetof(uct_tcp_iface_config_t, stripe_thresh), UCS_CONFIG_TYPE_MEMUNITS},
+
   {"PREFER_DEFAULT", "y",
    "Give higher priority to the default network interface on the host",
    ucs_offsetof(uct_tcp_iface_config_t, prefer_default), UCS_CONFIG_TYPE_BOOL},
@@ -49,6 +85,24 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Number of times to poll on a ready socket. 0 - no polling, -1 - until drained",
    ucs_offsetof(uct_tcp_iface_config_t, max_poll), UCS_CONFIG_TYPE_UINT},
 
+  {"PROGRESS_ENGINE", "epoll",
+   "Mechanism used to progress the sockets:\n"
+   " epoll    - wait for socket events and receive the data by system calls.\n"
+   " io_uring - post receive and poll operations to io_uring and reap their\n"
+   "            completions in batches. Falls back to epoll if io_uring or\n"
+   "            its provided buffer rings are not supported.",
+   ucs_offsetof(uct_tcp_iface_config_t, progress_engine),
+   UCS_CONFIG_TYPE_ENUM(uct_tcp_progress_engine_names)},
+
+  {"IO_URING_ENTRIES", "1024",
+   "Number of submission queue entries of io_uring progress engine",
+   ucs_offsetof(uct_tcp_iface_config_t, io_uring_entries), UCS_CONFIG_TYPE_UINT},
+
+  {"IO_URING_RX_BUFS", "64",
+   "Number of RX buffers provided to io_uring, which are shared by all\n"
+   "endpoints waiting for new data. Rounded up to a power of 2.",
+   ucs_offsetof(uct_tcp_iface_config_t, io_uring_rx_bufs), UCS_CONFIG_TYPE_UINT},
+
   {"NODELAY", "y",
    "Set TCP_NODELAY socket option to disable Nagle algorithm. Setting this\n"
    "option usually provides better performance",
@@ -74,6 +128,20 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
 
 static UCS_CLASS_DEFINE_DELETE_FUNC(uct_tcp_iface_t, uct_iface_t);
 
+static void uct_tcp_iface_release_desc(uct_recv_desc_t *self, void *desc)
+{
+    uct_tcp_iface_t *iface = ucs_container_of(self, uct_tcp_iface_t,
+                                              release_desc);
+    void *rx_buf;
+
+    /* The descriptor is the user's headroom which precedes the payload of
+     * the only AM in RX buffer */
+    rx_buf = UCS_PTR_BYTE_OFFSET(desc, iface->rx_headroom -
+                                       sizeof(uct_tcp_am_hdr_t));
+    ucs_mpool_put_inline(UCS_PTR_BYTE_OFFSET(rx_buf,
+                                             -iface->config.rx_buf_offset));
+}
+
 static ucs_status_t uct_tcp_iface_get_device_address(uct_iface_h tl_iface,
                                                      uct_device_addr_t *addr)
 {
@@ -132,6 +200,21 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface, uct_iface_attr_t *
         attr->cap.flags              |= UCT_IFACE_FLAG_AM_ZCOPY;
     }
 
+    if ((iface->config.zcopy.max_iov > UCT_TCP_EP_RMA_ZCOPY_SERVICE_IOV_COUNT) &&
+        (iface->config.zcopy.max_hdr >= sizeof(uct_tcp_ep_rma_hdr_t))) {
+        attr->cap.put.max_iov         = iface->config.zcopy.max_iov -
+                                        UCT_TCP_EP_RMA_ZCOPY_SERVICE_IOV_COUNT;
+        attr->cap.put.max_zcopy       = SIZE_MAX;
+        attr->cap.put.opt_zcopy_align = 1;
+        attr->cap.put.align_mtu       = 1;
+        attr->cap.get.max_iov         = 1;
+        attr->cap.get.max_zcopy       = SIZE_MAX;
+        attr->cap.get.opt_zcopy_align = 1;
+        attr->cap.get.align_mtu       = 1;
+        attr->cap.flags              |= UCT_IFACE_FLAG_PUT_ZCOPY |
+                                        UCT_IFACE_FLAG_GET_ZCOPY;
+    }
+
     status = uct_tcp_netif_caps(iface->if_name, &attr->latency.overhead,
                                 &attr->bandwidth.shared, &attr->cap.am.align_mtu);
     attr->bandwidth.dedicated = 0;
@@ -160,17 +243,38 @@ static ucs_status_t uct_tcp_iface_event_fd_get(uct_iface_h tl_iface, int *fd_p)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
 
+    if (iface->uring != NULL) {
+        *fd_p = uct_tcp_uring_fd(iface->uring);
+        return UCS_OK;
+    }
+
     return ucs_event_set_fd_get(iface->event_set, fd_p);
 }
 
-static void uct_tcp_iface_handle_events(void *callback_data,
-                                        int events, void *arg)
+static ucs_status_t uct_tcp_iface_event_arm(uct_iface_h tl_iface,
+                                            unsigned events)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
+
+    if (iface->uring != NULL) {
+        return uct_tcp_uring_arm(iface);
+    }
+
+    return UCS_OK;
+}
+
+void uct_tcp_iface_handle_events(void *callback_data, int events, void *arg)
 {
     unsigned *count  = (unsigned*)arg;
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)callback_data;
 
     ucs_assertv(ep->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED, "ep=%p", ep);
 
+    if (events & UCS_EVENT_SET_EVERR) {
+        /* Completions of MSG_ZEROCOPY sends are reported via error queue.
+         * Handle them first, since RX progress may destroy the EP */
+        *count += uct_tcp_ep_progress_msg_zcopy(ep);
+    }
     if (events & UCS_EVENT_SET_EVREAD) {
         *count += uct_tcp_ep_progress_rx(ep);
     }
@@ -187,6 +291,10 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
     unsigned read_events;
     ucs_status_t status;
 
+    if (iface->uring != NULL) {
+        return uct_tcp_uring_progress(iface);
+    }
+
     do {
         read_events = ucs_min(ucs_sys_event_set_max_wait_events, max_events);
         status = ucs_event_set_wait(iface->event_set, &read_events,
@@ -272,6 +380,9 @@ static void uct_tcp_iface_connect_handler(int listen_fd, void *arg)
 
 ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd)
 {
+#if HAVE_DECL_SO_ZEROCOPY
+    const int zerocopy = 1;
+#endif
     ucs_status_t status;
 
     status = ucs_socket_setopt(fd, IPPROTO_TCP, TCP_NODELAY,
@@ -299,6 +410,16 @@ ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd)
         }
     }
 
+#if HAVE_DECL_SO_ZEROCOPY
+    if (iface->config.zcopy.msg_zcopy_thresh != UCS_MEMUNITS_INF) {
+        status = ucs_socket_setopt(fd, SOL_SOCKET, SO_ZEROCOPY,
+                                   (const void*)&zerocopy, sizeof(int));
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+#endif
+
     return UCS_OK;
 }
 
@@ -306,6 +427,8 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .ep_am_short              = uct_tcp_ep_am_short,
     .ep_am_bcopy              = uct_tcp_ep_am_bcopy,
     .ep_am_zcopy              = uct_tcp_ep_am_zcopy,
+    .ep_put_zcopy             = uct_tcp_ep_put_zcopy,
+    .ep_get_zcopy             = uct_tcp_ep_get_zcopy,
     .ep_pending_add           = uct_tcp_ep_pending_add,
     .ep_pending_purge         = uct_tcp_ep_pending_purge,
     .ep_flush                 = uct_tcp_ep_flush,
@@ -318,7 +441,7 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .iface_progress_disable   = uct_base_iface_progress_disable,
     .iface_progress           = uct_tcp_iface_progress,
     .iface_event_fd_get       = uct_tcp_iface_event_fd_get,
-    .iface_event_arm          = ucs_empty_function_return_success,
+    .iface_event_arm          = uct_tcp_iface_event_arm,
     .iface_close              = UCS_CLASS_DELETE_FUNC_NAME(uct_tcp_iface_t),
     .iface_query              = uct_tcp_iface_query,
     .iface_get_address        = uct_tcp_iface_get_address,
@@ -439,6 +562,15 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                                sizeof(uct_tcp_am_hdr_t);
     self->config.rx_seg_size = config->rx_seg_size +
                                sizeof(uct_tcp_am_hdr_t);
+    self->rx_headroom        = (params->field_mask &
+                                UCT_IFACE_PARAM_FIELD_RX_HEADROOM) ?
+                               params->rx_headroom : 0;
+    self->release_desc.cb    = uct_tcp_iface_release_desc;
+    /* Reserve the space for the release descriptor and user's headroom
+     * before AM data of the 1st message in RX buffer */
+    self->config.rx_buf_offset       = sizeof(uct_recv_desc_t*) +
+                                       self->rx_headroom;
+    self->config.rx_hdr_first_thresh = config->rx_hdr_first_thresh;
 
     if (ucs_socket_max_iov() >= UCT_TCP_EP_AM_SHORTV_IOV_COUNT) {
         self->config.sendv_thresh = config->sendv_thresh;
@@ -468,6 +600,25 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
 
     self->config.zcopy.max_hdr  = self->config.tx_seg_size -
                                   self->config.zcopy.hdr_offset;
+#if HAVE_DECL_SO_ZEROCOPY
+    self->config.zcopy.msg_zcopy_thresh = config->msg_zcopy_thresh;
+#else
+    if (config->msg_zcopy_thresh != UCS_MEMUNITS_INF) {
+        ucs_warn("MSG_ZEROCOPY is not supported, ignoring "
+                 "UCX_TCP_MSG_ZEROCOPY_THRESH");
+    }
+    self->config.zcopy.msg_zcopy_thresh = UCS_MEMUNITS_INF;
+#endif
+
+    if ((config->sockets_per_ep == 0) ||
+        (config->sockets_per_ep > UCT_TCP_EP_MAX_SOCKETS)) {
+        ucs_error("number of sockets per EP (%u) must be in range [1..%d]",
+                  config->sockets_per_ep, UCT_TCP_EP_MAX_SOCKETS);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    self->config.stripe.count   = config->sockets_per_ep - 1;
+    self->config.stripe.thresh  = config->stripe_thresh;
     self->config.prefer_default = config->prefer_default;
     self->config.max_poll       = config->max_poll;
     self->sockopt.nodelay       = config->sockopt_nodelay;
@@ -492,7 +643,8 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         goto err;
     }
 
-    status = ucs_mpool_init(&self->rx_mpool, 0, self->config.rx_seg_size * 2,
+    status = ucs_mpool_init(&self->rx_mpool, 0, self->config.rx_buf_offset +
+                            self->config.rx_seg_size * 2,
                             0, UCS_SYS_CACHE_LINE_SIZE,
                             (config->rx_mpool.bufs_grow == 0) ?
                             32 : config->rx_mpool.bufs_grow,
@@ -502,27 +654,53 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         goto err_cleanup_tx_mpool;
     }
 
+    status = ucs_mpool_init(&self->rma_op_mpool, 0,
+                            sizeof(uct_tcp_ep_rma_op_t), 0,
+                            UCS_SYS_CACHE_LINE_SIZE, 32, UINT_MAX,
+                            &uct_tcp_mpool_ops, "uct_tcp_iface_rma_op_mp");
+    if (status != UCS_OK) {
+        goto err_cleanup_rx_mpool;
+    }
+
     status = uct_tcp_netif_inaddr(self->if_name, &self->config.ifaddr,
                                   &self->config.netmask);
     if (status != UCS_OK) {
-        goto err_cleanup_rx_mpool;
+        goto err_cleanup_rma_op_mpool;
     }
 
     status = ucs_event_set_create(&self->event_set);
     if (status != UCS_OK) {
         status = UCS_ERR_IO_ERROR;
-        goto err_cleanup_rx_mpool;
+        goto err_cleanup_rma_op_mpool;
+    }
+
+    self->uring = NULL;
+    if (config->progress_engine == UCT_TCP_PROGRESS_ENGINE_IO_URING) {
+        status = uct_tcp_uring_create(self, config->io_uring_entries,
+                                      config->io_uring_rx_bufs, &self->uring);
+        if (status == UCS_ERR_UNSUPPORTED) {
+            ucs_warn("tcp_iface %p: io_uring is not supported, using epoll",
+                     self);
+        } else if (status != UCS_OK) {
+            goto err_cleanup_event_set;
+        }
     }
 
     status = uct_tcp_iface_listener_init(self);
     if (status != UCS_OK) {
-        goto err_cleanup_event_set;
+        goto err_destroy_uring;
     }
 
     return UCS_OK;
 
+err_destroy_uring:
+    if (self->uring != NULL) {
+        uct_tcp_uring_destroy(self->uring);
+    }
 err_cleanup_event_set:
     ucs_event_set_cleanup(self->event_set);
+err_cleanup_rma_op_mpool:
+    ucs_mpool_cleanup(&self->rma_op_mpool, 1);
 err_cleanup_rx_mpool:
     ucs_mpool_cleanup(&self->rx_mpool, 1);
 err_cleanup_tx_mpool:
@@ -591,6 +769,12 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_iface_t)
 
     uct_tcp_iface_eps_cleanup(self);
 
+    if (self->uring != NULL) {
+        /* RX buffers are released when posted operations are completed */
+        uct_tcp_uring_destroy(self->uring);
+    }
+
+    ucs_mpool_cleanup(&self->rma_op_mpool, 1);
     ucs_mpool_cleanup(&self->rx_mpool, 1);
     ucs_mpool_cleanup(&self->tx_mpool, 1);
 
@@ -10,52 +10,176 @@
 #include "tcp.h"
 
 #include <uct/base/uct_md.h>
+#include <ucs/sys/sys.h>
 
 
 static ucs_status_t uct_tcp_md_query(uct_md_h md, uct_md_attr_t *attr)
 {
-    /* Dummy memory registration provided. No real memory handling exists */
+    /* PUT/GET Zcopy data is sent from/received to the user's buffer by the
+     * socket calls. Memory registration only allows the peers to access the
+     * region, and the remote key identifies it */
     attr->cap.flags               = UCT_MD_FLAG_REG |
-                                    UCT_MD_FLAG_NEED_RKEY; /* TODO ignore rkey in rma/amo ops */
-    attr->cap.flags               = 0;
+                                    UCT_MD_FLAG_NEED_RKEY;
     attr->cap.max_alloc           = 0;
-    attr->cap.reg_mem_types       = 0;
+    attr->cap.reg_mem_types       = UCS_BIT(UCS_MEMORY_TYPE_HOST);
     attr->cap.access_mem_type     = UCS_MEMORY_TYPE_HOST;
     attr->cap.detect_mem_types    = 0;
-    attr->cap.max_reg             = 0;
-    attr->rkey_packed_size        = 0;
-    attr->reg_cost.overhead       = 0;
+    attr->cap.max_reg             = ULONG_MAX;
+    attr->rkey_packed_size        = sizeof(uct_tcp_rkey_t);
+    /* Registration allocates a region and inserts it to the hash. It also
+     * makes UCP prefer copying for short messages, in particular for
+     * zero-length ones, which can't be registered */
+    attr->reg_cost.overhead       = 50.0e-9;
     attr->reg_cost.growth         = 0;
     memset(&attr->local_cpus, 0xff, sizeof(attr->local_cpus));
     return UCS_OK;
 }
 
-static ucs_status_t uct_tcp_md_mem_reg(uct_md_h md, void *address, size_t length,
-                                       unsigned flags, uct_mem_h *memh_p)
+static ucs_status_t uct_tcp_md_mem_reg(uct_md_h uct_md, void *address,
+                                       size_t length, unsigned flags,
+                                       uct_mem_h *memh_p)
 {
-    /* We have to emulate memory registration. Return dummy pointer */
-    *memh_p = (void*)0xdeadbeef;
+    uct_tcp_md_t *md = ucs_derived_of(uct_md, uct_tcp_md_t);
+    uct_tcp_mem_t *mem;
+    khiter_t iter;
+    int ret;
+
+    mem = ucs_malloc(sizeof(*mem), "uct_tcp_mem_t");
+    if (mem == NULL) {
+        ucs_error("failed to allocate tcp memory registration");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    mem->address = (uintptr_t)address;
+    mem->length  = length;
+
+    /* The key is random, so the peers can't access a region which was not
+     * exposed to them by sending its remote key */
+    ucs_spin_lock(&md->lock);
+    do {
+        mem->key = ucs_generate_uuid((uintptr_t)mem);
+        iter     = kh_put(uct_tcp_md_mems, &md->mems, mem->key, &ret);
+    } while (ret == 0);
+
+    if (ret < 0) {
+        ucs_spin_unlock(&md->lock);
+        ucs_error("failed to add tcp memory registration to hash");
+        ucs_free(mem);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    kh_val(&md->mems, iter) = mem;
+    ucs_spin_unlock(&md->lock);
+
+    ucs_trace("tcp md %p: registered %p..%p key 0x%"PRIx64, md, address,
+              UCS_PTR_BYTE_OFFSET(address, length), mem->key);
+    *memh_p = mem;
     return UCS_OK;
 }
 
+static ucs_status_t uct_tcp_md_mem_dereg(uct_md_h uct_md, uct_mem_h memh)
+{
+    uct_tcp_md_t *md   = ucs_derived_of(uct_md, uct_tcp_md_t);
+    uct_tcp_mem_t *mem = memh;
+    khiter_t iter;
+
+    ucs_spin_lock(&md->lock);
+    iter = kh_get(uct_tcp_md_mems, &md->mems, mem->key);
+    ucs_assert(iter != kh_end(&md->mems));
+    kh_del(uct_tcp_md_mems, &md->mems, iter);
+    ucs_spin_unlock(&md->lock);
+
+    ucs_free(mem);
+    return UCS_OK;
+}
+
+static ucs_status_t uct_tcp_md_mkey_pack(uct_md_h md, uct_mem_h memh,
+                                         void *rkey_buffer)
+{
+    const uct_tcp_mem_t *mem    = memh;
+    uct_tcp_rkey_t *packed_rkey = rkey_buffer;
+
+    packed_rkey->key     = mem->key;
+    packed_rkey->address = mem->address;
+    packed_rkey->length  = mem->length;
+    return UCS_OK;
+}
+
+ucs_status_t uct_tcp_md_check_access(uct_tcp_md_t *md, uint64_t key,
+                                     uint64_t address, uint64_t length)
+{
+    ucs_status_t status = UCS_ERR_INVALID_ADDR;
+    const uct_tcp_mem_t *mem;
+    khiter_t iter;
+
+    if (length == 0) {
+        /* Zero-length operations don't touch the memory, and may be posted
+         * without a remote key */
+        return UCS_OK;
+    }
+
+    ucs_spin_lock(&md->lock);
+    iter = kh_get(uct_tcp_md_mems, &md->mems, key);
+    if (iter != kh_end(&md->mems)) {
+        mem = kh_val(&md->mems, iter);
+        /* [address, address + length) must be inside the region, written
+         * so that it can't overflow */
+        if ((address >= mem->address) && (length <= mem->length) &&
+            ((address - mem->address) <= (mem->length - length))) {
+            status = UCS_OK;
+        }
+    }
+    ucs_spin_unlock(&md->lock);
+
+    return status;
+}
+
+static void uct_tcp_md_close(uct_md_h uct_md)
+{
+    uct_tcp_md_t *md = ucs_derived_of(uct_md, uct_tcp_md_t);
+
+    if (kh_size(&md->mems) != 0) {
+        ucs_warn("tcp md %p: %u memory regions were not deregistered", md,
+                 kh_size(&md->mems));
+    }
+
+    kh_destroy_inplace(uct_tcp_md_mems, &md->mems);
+    ucs_spinlock_destroy(&md->lock);
+    ucs_free(md);
+}
+
 static ucs_status_t
 uct_tcp_md_open(uct_component_t *component, const char *md_name,
                 const uct_md_config_t *md_config, uct_md_h *md_p)
 {
     static uct_md_ops_t md_ops = {
-        .close              = ucs_empty_function,
+        .close              = uct_tcp_md_close,
         .query              = uct_tcp_md_query,
-        .mkey_pack          = ucs_empty_function_return_success,
+        .mkey_pack          = uct_tcp_md_mkey_pack,
         .mem_reg            = uct_tcp_md_mem_reg,
-        .mem_dereg          = ucs_empty_function_return_success,
+        .mem_dereg          = uct_tcp_md_mem_dereg,
         .detect_memory_type = ucs_empty_function_return_unsupported
     };
-    static uct_md_t md = {
-        .ops          = &md_ops,
-        .component    = &uct_tcp_component
-    };
+    uct_tcp_md_t *md;
+    ucs_status_t status;
 
-    *md_p = &md;
+    md = ucs_malloc(sizeof(*md), "uct_tcp_md_t");
+    if (md == NULL) {
+        ucs_error("failed to allocate tcp md");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = ucs_spinlock_init(&md->lock);
+    if (status != UCS_OK) {
+        ucs_free(md);
+        return status;
+    }
+
+    md->super.ops       = &md_ops;
+    md->super.component = &uct_tcp_component;
+    kh_init_inplace(uct_tcp_md_mems, &md->mems);
+
+    *md_p = &md->super;
     return UCS_OK;
 }
 
@@ -63,22 +187,34 @@ static ucs_status_t uct_tcp_md_rkey_unpack(uct_component_t *component,
                                            const void *rkey_buffer,
                                            uct_rkey_t *rkey_p, void **handle_p)
 {
-    /**
-     * Pseudo stub function for the key unpacking
-     * Need rkey == 0 due to work with same process to reuse uct_base_[put|get|atomic]*
-     */
-    *rkey_p   = 0;
+    uct_tcp_rkey_t *rkey;
+
+    rkey = ucs_malloc(sizeof(*rkey), "uct_tcp_rkey_t");
+    if (rkey == NULL) {
+        ucs_error("failed to allocate tcp remote key");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    memcpy(rkey, rkey_buffer, sizeof(*rkey));
+    *rkey_p   = (uintptr_t)rkey;
     *handle_p = NULL;
     return UCS_OK;
 }
 
+static ucs_status_t uct_tcp_md_rkey_release(uct_component_t *component,
+                                            uct_rkey_t rkey, void *handle)
+{
+    ucs_free((void*)rkey);
+    return UCS_OK;
+}
+
 uct_component_t uct_tcp_component = {
     .query_md_resources = uct_md_query_single_md_resource,
     .md_open            = uct_tcp_md_open,
     .cm_open            = ucs_empty_function_return_unsupported,
     .rkey_unpack        = uct_tcp_md_rkey_unpack,
     .rkey_ptr           = ucs_empty_function_return_unsupported,
-    .rkey_release       = ucs_empty_function_return_success,
+    .rkey_release       = uct_tcp_md_rkey_release,
     .name               = UCT_TCP_NAME,
     .md_config          = UCT_MD_DEFAULT_CONFIG_INITIALIZER,
     .tl_list            = UCT_COMPONENT_TL_LIST_INITIALIZER(&uct_tcp_component),
@@ -0,0 +1,1200 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2020.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "tcp.h"
+
+#include <ucs/arch/cpu.h>
+#include <ucs/async/async.h>
+
+#if HAVE_LINUX_IO_URING_H && HAVE_DECL_IORING_OP_RECV && \
+    HAVE_DECL_IORING_OP_POLL_ADD && HAVE_DECL_IORING_OP_ASYNC_CANCEL && \
+    HAVE_DECL_IOSQE_BUFFER_SELECT && HAVE_DECL_IORING_REGISTER_PBUF_RING && \
+    HAVE_DECL_IORING_REGISTER_SYNC_CANCEL && \
+    HAVE_DECL___NR_IO_URING_SETUP && HAVE_DECL___NR_IO_URING_ENTER && \
+    HAVE_DECL___NR_IO_URING_REGISTER
+#  define UCT_TCP_HAVE_IO_URING 1
+#else
+#  define UCT_TCP_HAVE_IO_URING 0
+#endif
+
+#if UCT_TCP_HAVE_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/poll.h>
+#include <sys/eventfd.h>
+
+
+/* User data of the operation which polls the wakeup file descriptor */
+#define UCT_TCP_URING_WAKEUP_DATA ((uintptr_t)1)
+
+/* Group of the RX buffers provided to the ring */
+#define UCT_TCP_URING_RX_BGID     0
+
+/* Maximal number of entries in a provided buffers ring */
+#define UCT_TCP_URING_RX_MAX_BUFS 32768
+
+
+/**
+ * io_uring operation type
+ */
+typedef enum uct_tcp_uring_op_type {
+    UCT_TCP_URING_OP_RECV,                    /* Receive to RX buffer */
+    UCT_TCP_URING_OP_POLL                     /* Wait until the socket is
+                                               * writable or has an error */
+} uct_tcp_uring_op_type_t;
+
+
+/**
+ * io_uring operation posted by an endpoint
+ */
+struct uct_tcp_uring_op {
+    uct_tcp_ep_t                  *ep;        /* EP which posted the operation,
+                                               * or NULL if it was destroyed */
+    uct_tcp_uring_op_type_t       type;       /* Operation type */
+    void                          *dest;      /* Destination of receive
+                                               * operation, or NULL if it
+                                               * receives to an RX buffer */
+    void                          *buf;       /* RX buffer of receive
+                                               * operation, or NULL if it
+                                               * selects a provided buffer */
+    short                         events;     /* Events of poll operation */
+    ucs_list_link_t               list;       /* Element in the list of posted
+                                               * operations */
+};
+
+
+/**
+ * io_uring instance of TCP interface
+ */
+struct uct_tcp_uring {
+    uct_tcp_iface_t               *iface;     /* Interface which owns the ring */
+    int                           fd;         /* io_uring file descriptor */
+    int                           wakeup_fd;  /* Signaled when EPs are added
+                                               * by the async thread */
+    int                           wakeup_armed; /* Whether wakeup_fd is
+                                                 * polled by the ring */
+    struct {
+        void                      *ring;      /* Mapped submission ring */
+        size_t                    ring_size;  /* Size of the mapped ring */
+        unsigned                  *head;      /* Consumed by the kernel */
+        unsigned                  *tail;      /* Published to the kernel */
+        unsigned                  *flags;     /* Ring flags */
+        unsigned                  *array;     /* Indexes of the entries */
+        unsigned                  mask;       /* Ring index mask */
+        unsigned                  entries;    /* Number of ring entries */
+        struct io_uring_sqe       *sqes;      /* Mapped submission entries */
+        size_t                    sqes_size;  /* Size of the mapped entries */
+        unsigned                  local_tail; /* Next entry to fill */
+    } sq;
+    struct {
+        void                      *ring;      /* Mapped completion ring */
+        size_t                    ring_size;  /* Size of the mapped ring */
+        unsigned                  *head;      /* Consumed by the user */
+        unsigned                  *tail;      /* Produced by the kernel */
+        unsigned                  mask;       /* Ring index mask */
+        struct io_uring_cqe       *cqes;      /* Completion entries */
+    } cq;
+    struct {
+        struct io_uring_buf_ring  *ring;      /* Ring of provided buffers */
+        size_t                    ring_size;  /* Size of the mapped ring */
+        unsigned                  mask;       /* Ring index mask */
+        uint16_t                  tail;       /* Next entry to fill */
+        void                      **bufs;     /* RX buffers by buffer ID, NULL
+                                               * if not provided */
+        uint16_t                  *free_ids;  /* IDs of buffers to provide */
+        unsigned                  num_free;   /* Number of IDs to provide */
+    } rx;
+    ucs_mpool_t                   op_mp;      /* Operations memory pool */
+    ucs_list_link_t               op_list;    /* Posted operations */
+    ucs_list_link_t               ep_list;    /* EPs which need to post
+                                               * operations */
+};
+
+
+static ucs_mpool_ops_t uct_tcp_uring_mpool_ops = {
+    ucs_mpool_chunk_malloc,
+    ucs_mpool_chunk_free,
+    NULL,
+    NULL
+};
+
+static inline int uct_tcp_uring_enter(uct_tcp_uring_t *uring,
+                                      unsigned to_submit,
+                                      unsigned min_complete, unsigned flags)
+{
+    return syscall(__NR_io_uring_enter, uring->fd, to_submit, min_complete,
+                   flags, NULL, 0);
+}
+
+static inline int uct_tcp_uring_register(uct_tcp_uring_t *uring,
+                                         unsigned opcode, void *arg,
+                                         unsigned nr_args)
+{
+    return syscall(__NR_io_uring_register, uring->fd, opcode, arg, nr_args);
+}
+
+static void uct_tcp_uring_submit(uct_tcp_uring_t *uring)
+{
+    unsigned to_submit;
+    int ret;
+
+    /* entries which weren't consumed by the previous call are submitted
+     * again */
+    to_submit = uring->sq.local_tail - *(volatile unsigned*)uring->sq.head;
+    if (to_submit == 0) {
+        return;
+    }
+
+    ucs_memory_cpu_store_fence();
+    *(volatile unsigned*)uring->sq.tail = uring->sq.local_tail;
+
+    ret = uct_tcp_uring_enter(uring, to_submit, 0, 0);
+    if ((ret < 0) && (errno != EAGAIN) && (errno != EBUSY) &&
+        (errno != EINTR)) {
+        ucs_error("io_uring_enter(fd=%d, to_submit=%u) failed: %m",
+                  uring->fd, to_submit);
+    }
+}
+
+static struct io_uring_sqe *uct_tcp_uring_get_sqe(uct_tcp_uring_t *uring)
+{
+    struct io_uring_sqe *sqe;
+    unsigned index;
+
+    if ((uring->sq.local_tail - *(volatile unsigned*)uring->sq.head) ==
+        uring->sq.entries) {
+        uct_tcp_uring_submit(uring);
+        if ((uring->sq.local_tail - *(volatile unsigned*)uring->sq.head) ==
+            uring->sq.entries) {
+            return NULL;
+        }
+    }
+
+    ucs_memory_cpu_load_fence();
+
+    index                  = uring->sq.local_tail & uring->sq.mask;
+    sqe                    = &uring->sq.sqes[index];
+    uring->sq.array[index] = index;
+    uring->sq.local_tail++;
+
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+static void uct_tcp_uring_wakeup_post(uct_tcp_uring_t *uring)
+{
+    struct io_uring_sqe *sqe;
+    uint64_t dummy;
+
+    /* consume the signals before polling again */
+    while (read(uring->wakeup_fd, &dummy, sizeof(dummy)) > 0) {
+    }
+
+    sqe = uct_tcp_uring_get_sqe(uring);
+    if (sqe == NULL) {
+        return;
+    }
+
+    sqe->opcode         = IORING_OP_POLL_ADD;
+    sqe->fd             = uring->wakeup_fd;
+    sqe->poll_events    = POLLIN;
+    sqe->user_data      = UCT_TCP_URING_WAKEUP_DATA;
+    uring->wakeup_armed = 1;
+}
+
+/* Return the RX buffers taken by the received data to the ring, so the kernel
+ * could select them for the next receive operations */
+static void uct_tcp_uring_rx_provide(uct_tcp_uring_t *uring)
+{
+    uct_tcp_iface_t *iface = uring->iface;
+    uint16_t tail          = uring->rx.tail;
+    struct io_uring_buf *entry;
+    uint16_t id;
+    void *buf;
+
+    while (uring->rx.num_free > 0) {
+        buf = ucs_mpool_get_inline(&iface->rx_mpool);
+        if (ucs_unlikely(buf == NULL)) {
+            break;
+        }
+
+        id                 = uring->rx.free_ids[--uring->rx.num_free];
+        uring->rx.bufs[id] = buf;
+
+        /* the tail of the ring overlays the reserved field of the first
+         * entry, so the fields are set one by one */
+        entry       = &uring->rx.ring->bufs[tail & uring->rx.mask];
+        entry->addr = (uintptr_t)UCS_PTR_BYTE_OFFSET(buf,
+                                                     iface->config.rx_buf_offset);
+        entry->len  = iface->config.rx_seg_size;
+        entry->bid  = id;
+        ++tail;
+    }
+
+    if (tail != uring->rx.tail) {
+        ucs_memory_cpu_store_fence();
+        *(volatile uint16_t*)&uring->rx.ring->tail = tail;
+        uring->rx.tail                              = tail;
+    }
+}
+
+static void *uct_tcp_uring_rx_take(uct_tcp_uring_t *uring, unsigned cqe_flags)
+{
+    uint16_t id = cqe_flags >> IORING_CQE_BUFFER_SHIFT;
+    void *buf   = uring->rx.bufs[id];
+
+    ucs_assertv(buf != NULL, "tcp_uring %p: buffer %u is not provided", uring,
+                id);
+
+    uring->rx.bufs[id]                       = NULL;
+    uring->rx.free_ids[uring->rx.num_free++] = id;
+    return buf;
+}
+
+static uct_tcp_uring_op_t *
+uct_tcp_uring_op_post(uct_tcp_uring_t *uring, uct_tcp_ep_t *ep,
+                      uct_tcp_uring_op_type_t type,
+                      struct io_uring_sqe **sqe_p)
+{
+    struct io_uring_sqe *sqe;
+    uct_tcp_uring_op_t *op;
+
+    op = ucs_mpool_get_inline(&uring->op_mp);
+    if (ucs_unlikely(op == NULL)) {
+        return NULL;
+    }
+
+    sqe = uct_tcp_uring_get_sqe(uring);
+    if (ucs_unlikely(sqe == NULL)) {
+        ucs_mpool_put_inline(op);
+        return NULL;
+    }
+
+    op->ep         = ep;
+    op->type       = type;
+    op->dest       = NULL;
+    op->buf        = NULL;
+    op->events     = 0;
+    sqe->fd        = ep->fd;
+    sqe->user_data = (uintptr_t)op;
+
+    ucs_list_add_tail(&uring->op_list, &op->list);
+    *sqe_p = sqe;
+    return op;
+}
+
+static uct_tcp_uring_op_t *uct_tcp_uring_recv_post(uct_tcp_uring_t *uring,
+                                                   uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = uring->iface;
+    void *buf              = NULL;
+    struct io_uring_sqe *sqe;
+    uct_tcp_uring_op_t *op;
+    size_t length;
+    void *dest;
+
+    length = uct_tcp_ep_rx_dest(ep, &dest);
+    if ((length == 0) && ep->uring.rx_nobufs) {
+        /* pending receives of other EPs could keep all provided buffers,
+         * so receive to a buffer of this operation */
+        buf = ucs_mpool_get_inline(&iface->rx_mpool);
+        if (ucs_unlikely(buf == NULL)) {
+            return NULL;
+        }
+    }
+
+    op = uct_tcp_uring_op_post(uring, ep, UCT_TCP_URING_OP_RECV, &sqe);
+    if (ucs_unlikely(op == NULL)) {
+        if (buf != NULL) {
+            ucs_mpool_put_inline(buf);
+        }
+        return NULL;
+    }
+
+    sqe->opcode = IORING_OP_RECV;
+    if (length != 0) {
+        /* the EP waits for the rest of the data, receive it to its place */
+        op->dest  = dest;
+        sqe->addr = (uintptr_t)dest;
+        sqe->len  = ucs_min(length, INT_MAX);
+    } else if (buf != NULL) {
+        op->buf   = buf;
+        sqe->addr = (uintptr_t)UCS_PTR_BYTE_OFFSET(buf,
+                                                   iface->config.rx_buf_offset);
+        sqe->len  = iface->config.rx_seg_size;
+    } else {
+        /* the kernel selects an RX buffer for the received data, the data is
+         * received to the place of AM data in the buffer, so the buffer can
+         * be used by the EP without copying */
+        sqe->flags     = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = UCT_TCP_URING_RX_BGID;
+        sqe->len       = iface->config.rx_seg_size;
+    }
+
+    return op;
+}
+
+static uct_tcp_uring_op_t *uct_tcp_uring_poll_post(uct_tcp_uring_t *uring,
+                                                   uct_tcp_ep_t *ep,
+                                                   short poll_events)
+{
+    struct io_uring_sqe *sqe;
+    uct_tcp_uring_op_t *op;
+
+    op = uct_tcp_uring_op_post(uring, ep, UCT_TCP_URING_OP_POLL, &sqe);
+    if (ucs_unlikely(op == NULL)) {
+        return NULL;
+    }
+
+    op->events       = poll_events;
+    sqe->opcode      = IORING_OP_POLL_ADD;
+    sqe->poll_events = poll_events;
+    return op;
+}
+
+/* Replace the entry of the operation by NOP, if it is not submitted yet */
+static int uct_tcp_uring_op_unpost(uct_tcp_uring_t *uring,
+                                   uct_tcp_uring_op_t *op)
+{
+    unsigned head = *(volatile unsigned*)uring->sq.head;
+    struct io_uring_sqe *sqe;
+
+    for (; head != uring->sq.local_tail; ++head) {
+        sqe = &uring->sq.sqes[uring->sq.array[head & uring->sq.mask]];
+        if (sqe->user_data == (uintptr_t)op) {
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode    = IORING_OP_NOP;
+            sqe->user_data = (uintptr_t)op;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void uct_tcp_uring_op_cancel_sync(uct_tcp_uring_t *uring,
+                                         uct_tcp_uring_op_t *op)
+{
+    struct io_uring_sync_cancel_reg reg;
+    int ret;
+
+    memset(&reg, 0, sizeof(reg));
+    reg.addr            = (uintptr_t)op;
+    reg.timeout.tv_sec  = -1;
+    reg.timeout.tv_nsec = -1;
+
+    do {
+        ret = uct_tcp_uring_register(uring, IORING_REGISTER_SYNC_CANCEL,
+                                     &reg, 1);
+    } while ((ret < 0) && (errno == EINTR));
+
+    /* ENOENT means that the operation is already completed */
+    if ((ret < 0) && (errno != ENOENT)) {
+        ucs_error("tcp_uring %p: failed to cancel operation %p: %m", uring,
+                  op);
+    }
+}
+
+static void uct_tcp_uring_op_cancel(uct_tcp_uring_t *uring,
+                                    uct_tcp_uring_op_t *op)
+{
+    struct io_uring_sqe *sqe;
+
+    /* the operation is released when its completion is reaped */
+    op->ep = NULL;
+
+    if (uct_tcp_uring_op_unpost(uring, op)) {
+        return;
+    }
+
+    if (op->dest == NULL) {
+        sqe = uct_tcp_uring_get_sqe(uring);
+        if (sqe != NULL) {
+            sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+            sqe->fd        = -1;
+            sqe->addr      = (uintptr_t)op;
+            sqe->user_data = 0;
+            return;
+        }
+    }
+
+    /* the kernel could write to the destination of the receive after its
+     * owner is destroyed, or no entry is free even after submitting the
+     * pending ones, so wait until the operation is canceled */
+    uct_tcp_uring_op_cancel_sync(uring, op);
+}
+
+static void uct_tcp_uring_op_release(uct_tcp_uring_op_t *op)
+{
+    if (op->buf != NULL) {
+        ucs_mpool_put_inline(op->buf);
+    }
+
+    ucs_list_del(&op->list);
+    ucs_mpool_put_inline(op);
+}
+
+static ucs_status_t uct_tcp_uring_rx_status(uct_tcp_ep_t *ep, int res)
+{
+    if (res == 0) {
+        ucs_trace("tcp_ep %p: fd %d is closed", ep, ep->fd);
+        return UCS_ERR_CANCELED; /* Connection closed */
+    }
+
+    if (uct_tcp_ep_io_err_handler_cb(ep, -res) != UCS_OK) {
+        ucs_error("recv(fd=%d) failed: %d", ep->fd, -res);
+    }
+
+    return UCS_ERR_IO_ERROR;
+}
+
+static unsigned uct_tcp_uring_handle_cqe(uct_tcp_uring_t *uring,
+                                         uct_tcp_uring_op_t *op, int res,
+                                         unsigned cqe_flags)
+{
+    uct_tcp_ep_t *ep = op->ep;
+    unsigned count   = 0;
+    void *buf        = NULL;
+    int events;
+
+    if (cqe_flags & IORING_CQE_F_BUFFER) {
+        buf = uct_tcp_uring_rx_take(uring, cqe_flags);
+    } else if ((op->buf != NULL) && (res > 0)) {
+        buf     = op->buf;
+        op->buf = NULL;
+    }
+
+    if (ep == NULL) {
+        /* the EP was destroyed */
+        if (buf != NULL) {
+            ucs_mpool_put_inline(buf);
+        }
+        uct_tcp_uring_op_release(op);
+        return 0;
+    }
+
+    if (op->type == UCT_TCP_URING_OP_RECV) {
+        ucs_assert(ep->uring.rx_op == op);
+        ucs_assert(ep->uring.rx_length == 0);
+        ep->uring.rx_op = NULL;
+
+        if (res > 0) {
+            ucs_trace_data("tcp_ep %p: io_uring recvd %d bytes to %s", ep,
+                           res, (op->dest != NULL) ? "destination" :
+                           "RX buffer");
+            /* the data is kept until the EP handles it */
+            ucs_assert((op->dest != NULL) || (buf != NULL));
+            ep->uring.rx_dest   = op->dest;
+            ep->uring.rx_buf    = buf;
+            ep->uring.rx_offset = 0;
+            ep->uring.rx_length = res;
+            ep->uring.rx_nobufs = 0;
+            buf                 = NULL;
+        } else if (res == -ENOBUFS) {
+            /* all provided buffers are taken, the next receive is posted with
+             * its own buffer */
+            ucs_trace_data("tcp_ep %p: no io_uring RX buffers", ep);
+            ep->uring.rx_nobufs = 1;
+        } else if ((res != -EAGAIN) && (res != -EINTR)) {
+            ep->uring.rx_status = uct_tcp_uring_rx_status(ep, res);
+        }
+
+        events = UCS_EVENT_SET_EVREAD;
+    } else {
+        ucs_assert(ep->uring.poll_op == op);
+        ep->uring.poll_op = NULL;
+
+        if (res < 0) {
+            events = 0;
+        } else {
+            events = ((res & POLLOUT) ? UCS_EVENT_SET_EVWRITE : 0) |
+                     ((res & POLLERR) ? UCS_EVENT_SET_EVERR   : 0) |
+                     /* let the EP detect the error by sending */
+                     ((res & POLLHUP) ? UCS_EVENT_SET_EVWRITE : 0);
+        }
+    }
+
+    if (buf != NULL) {
+        ucs_mpool_put_inline(buf);
+    }
+
+    uct_tcp_uring_op_release(op);
+
+    /* post the next operations, if the EP needs them after handling */
+    uct_tcp_uring_ep_update(ep);
+
+    events &= ep->events | UCS_EVENT_SET_EVERR;
+    if ((events != 0) && (ep->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED)) {
+        uct_tcp_iface_handle_events(ep, events, &count);
+    }
+
+    return count;
+}
+
+static unsigned uct_tcp_uring_reap(uct_tcp_uring_t *uring, unsigned max_cqes)
+{
+    unsigned head  = *uring->cq.head;
+    unsigned count = 0;
+    unsigned num_cqes;
+    struct io_uring_cqe *cqe;
+    uct_tcp_uring_op_t *op;
+    unsigned flags;
+    int res;
+
+#ifdef IORING_SQ_CQ_OVERFLOW
+    if (ucs_unlikely(*(volatile unsigned*)uring->sq.flags &
+                     IORING_SQ_CQ_OVERFLOW)) {
+        /* move the completions kept by the kernel to the ring */
+        uct_tcp_uring_enter(uring, 0, 0, IORING_ENTER_GETEVENTS);
+    }
+#endif
+
+    for (num_cqes = 0; num_cqes < max_cqes; ++num_cqes) {
+        if (head == *(volatile unsigned*)uring->cq.tail) {
+            break;
+        }
+
+        ucs_memory_cpu_load_fence();
+
+        cqe = &uring->cq.cqes[head & uring->cq.mask];
+        op    = (uct_tcp_uring_op_t*)(uintptr_t)cqe->user_data;
+        res   = cqe->res;
+        flags = cqe->flags;
+
+        /* release the entry before handling, since the handler may submit
+         * new operations */
+        ucs_memory_cpu_store_fence();
+        *(volatile unsigned*)uring->cq.head = ++head;
+
+        if ((uintptr_t)op == UCT_TCP_URING_WAKEUP_DATA) {
+            /* EPs to handle were added to the list */
+            uring->wakeup_armed = 0;
+        } else if (op != NULL) {
+            count += uct_tcp_uring_handle_cqe(uring, op, res, flags);
+        }
+    }
+
+    return count;
+}
+
+static unsigned uct_tcp_uring_ep_progress(uct_tcp_uring_t *uring,
+                                          uct_tcp_ep_t *ep)
+{
+    unsigned count = 0;
+    short poll_events;
+
+    if (ep->events & UCS_EVENT_SET_EVREAD) {
+        if ((ep->uring.rx_length != 0) || (ep->uring.rx_status != UCS_OK)) {
+            /* handle the data received before, the next receive is posted
+             * after that */
+            uct_tcp_uring_ep_update(ep);
+            uct_tcp_iface_handle_events(ep, UCS_EVENT_SET_EVREAD, &count);
+            return count;
+        }
+
+        if (ep->uring.rx_op == NULL) {
+            ep->uring.rx_op = uct_tcp_uring_recv_post(uring, ep);
+            if (ucs_unlikely(ep->uring.rx_op == NULL)) {
+                uct_tcp_uring_ep_update(ep);
+                return 0;
+            }
+        }
+    }
+
+    /* POLLERR and POLLHUP are always reported, completions of MSG_ZEROCOPY
+     * sends are reported as socket errors */
+    poll_events = (ep->events & UCS_EVENT_SET_EVWRITE) ? POLLOUT : 0;
+    if ((poll_events == 0) && ucs_queue_is_empty(&ep->msg_zcopy.queue)) {
+        return count;
+    }
+
+    if ((ep->uring.poll_op != NULL) &&
+        (poll_events & ~ep->uring.poll_op->events)) {
+        /* the EP started waiting for more events */
+        uct_tcp_uring_op_cancel(uring, ep->uring.poll_op);
+        ep->uring.poll_op = NULL;
+    }
+
+    if (ep->uring.poll_op == NULL) {
+        ep->uring.poll_op = uct_tcp_uring_poll_post(uring, ep, poll_events);
+        if (ucs_unlikely(ep->uring.poll_op == NULL)) {
+            uct_tcp_uring_ep_update(ep);
+        }
+    }
+
+    return count;
+}
+
+static void uct_tcp_uring_unmap(uct_tcp_uring_t *uring)
+{
+    if (uring->sq.sqes != NULL) {
+        munmap(uring->sq.sqes, uring->sq.sqes_size);
+    }
+
+    if ((uring->cq.ring != NULL) && (uring->cq.ring != uring->sq.ring)) {
+        munmap(uring->cq.ring, uring->cq.ring_size);
+    }
+
+    if (uring->sq.ring != NULL) {
+        munmap(uring->sq.ring, uring->sq.ring_size);
+    }
+}
+
+static void *uct_tcp_uring_mmap(uct_tcp_uring_t *uring, size_t size,
+                                off_t offset, const char *name)
+{
+    void *ptr;
+
+    ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+               uring->fd, offset);
+    if (ptr == MAP_FAILED) {
+        ucs_error("failed to map io_uring %s (fd=%d, size=%zu): %m", name,
+                  uring->fd, size);
+        return NULL;
+    }
+
+    return ptr;
+}
+
+static ucs_status_t uct_tcp_uring_rx_init(uct_tcp_uring_t *uring,
+                                          unsigned rx_bufs)
+{
+    unsigned num_bufs = ucs_roundup_pow2(ucs_min(ucs_max(rx_bufs, 1),
+                                                 UCT_TCP_URING_RX_MAX_BUFS));
+    struct io_uring_buf_reg reg;
+    ucs_status_t status;
+    unsigned i;
+
+    uring->rx.ring_size = num_bufs * sizeof(struct io_uring_buf);
+    uring->rx.ring      = mmap(NULL, uring->rx.ring_size,
+                               PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (uring->rx.ring == MAP_FAILED) {
+        ucs_error("failed to allocate io_uring buffers ring (size=%zu): %m",
+                  uring->rx.ring_size);
+        uring->rx.ring = NULL;
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    uring->rx.bufs     = ucs_calloc(num_bufs, sizeof(*uring->rx.bufs),
+                                    "tcp_uring_rx_bufs");
+    uring->rx.free_ids = ucs_malloc(num_bufs * sizeof(*uring->rx.free_ids),
+                                    "tcp_uring_rx_free_ids");
+    if ((uring->rx.bufs == NULL) || (uring->rx.free_ids == NULL)) {
+        ucs_error("failed to allocate io_uring RX buffers table");
+        status = UCS_ERR_NO_MEMORY;
+        goto err_free;
+    }
+
+    for (i = 0; i < num_bufs; ++i) {
+        uring->rx.free_ids[i] = num_bufs - 1 - i;
+    }
+
+    uring->rx.mask     = num_bufs - 1;
+    uring->rx.tail     = 0;
+    uring->rx.num_free = num_bufs;
+
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr    = (uintptr_t)uring->rx.ring;
+    reg.ring_entries = num_bufs;
+    reg.bgid         = UCT_TCP_URING_RX_BGID;
+    if (uct_tcp_uring_register(uring, IORING_REGISTER_PBUF_RING, &reg,
+                               1) < 0) {
+        ucs_debug("io_uring_register(fd=%d, PBUF_RING) failed: %m",
+                  uring->fd);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_free;
+    }
+
+    return UCS_OK;
+
+err_free:
+    ucs_free(uring->rx.free_ids);
+    ucs_free(uring->rx.bufs);
+    munmap(uring->rx.ring, uring->rx.ring_size);
+    uring->rx.ring = NULL;
+    return status;
+}
+
+static void uct_tcp_uring_rx_cleanup(uct_tcp_uring_t *uring)
+{
+    struct io_uring_buf_reg reg;
+    unsigned id;
+
+    memset(&reg, 0, sizeof(reg));
+    reg.bgid = UCT_TCP_URING_RX_BGID;
+    if (uct_tcp_uring_register(uring, IORING_UNREGISTER_PBUF_RING, &reg,
+                               1) < 0) {
+        ucs_warn("io_uring_register(fd=%d, UNREGISTER_PBUF_RING) failed: %m",
+                 uring->fd);
+    }
+
+    for (id = 0; id <= uring->rx.mask; ++id) {
+        if (uring->rx.bufs[id] != NULL) {
+            ucs_mpool_put_inline(uring->rx.bufs[id]);
+        }
+    }
+
+    ucs_free(uring->rx.free_ids);
+    ucs_free(uring->rx.bufs);
+    munmap(uring->rx.ring, uring->rx.ring_size);
+}
+
+ucs_status_t uct_tcp_uring_create(uct_tcp_iface_t *iface, unsigned entries,
+                                  unsigned rx_bufs, uct_tcp_uring_t **uring_p)
+{
+    struct io_uring_sync_cancel_reg cancel_reg;
+    struct io_uring_params params;
+    uct_tcp_uring_t *uring;
+    ucs_status_t status;
+
+    uring = ucs_calloc(1, sizeof(*uring), "tcp_uring");
+    if (uring == NULL) {
+        ucs_error("failed to allocate io_uring context");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    memset(&params, 0, sizeof(params));
+    uring->fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (uring->fd < 0) {
+        ucs_debug("io_uring_setup(entries=%u) failed: %m", entries);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_free;
+    }
+
+#ifdef IORING_FEAT_NODROP
+    if (!(params.features & IORING_FEAT_NODROP))
+#endif
+    {
+        /* completions must not be lost when many EPs post operations */
+        ucs_debug("io_uring doesn't keep overflowed completions");
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_close;
+    }
+
+    uring->sq.ring_size = params.sq_off.array +
+                          (params.sq_entries * sizeof(unsigned));
+    uring->cq.ring_size = params.cq_off.cqes +
+                          (params.cq_entries * sizeof(struct io_uring_cqe));
+    uring->sq.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        uring->sq.ring_size = ucs_max(uring->sq.ring_size,
+                                      uring->cq.ring_size);
+    }
+
+    uring->sq.ring = uct_tcp_uring_mmap(uring, uring->sq.ring_size,
+                                        IORING_OFF_SQ_RING, "SQ ring");
+    if (uring->sq.ring == NULL) {
+        status = UCS_ERR_IO_ERROR;
+        goto err_close;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        uring->cq.ring = uring->sq.ring;
+    } else {
+        uring->cq.ring = uct_tcp_uring_mmap(uring, uring->cq.ring_size,
+                                            IORING_OFF_CQ_RING, "CQ ring");
+        if (uring->cq.ring == NULL) {
+            status = UCS_ERR_IO_ERROR;
+            goto err_unmap;
+        }
+    }
+
+    uring->sq.sqes = uct_tcp_uring_mmap(uring, uring->sq.sqes_size,
+                                        IORING_OFF_SQES, "SQEs");
+    if (uring->sq.sqes == NULL) {
+        status = UCS_ERR_IO_ERROR;
+        goto err_unmap;
+    }
+
+    uring->sq.head       = UCS_PTR_BYTE_OFFSET(uring->sq.ring,
+                                               params.sq_off.head);
+    uring->sq.tail       = UCS_PTR_BYTE_OFFSET(uring->sq.ring,
+                                               params.sq_off.tail);
+    uring->sq.flags      = UCS_PTR_BYTE_OFFSET(uring->sq.ring,
+                                               params.sq_off.flags);
+    uring->sq.array      = UCS_PTR_BYTE_OFFSET(uring->sq.ring,
+                                               params.sq_off.array);
+    uring->sq.mask       = *(unsigned*)UCS_PTR_BYTE_OFFSET(uring->sq.ring,
+                                                           params.sq_off.ring_mask);
+    uring->sq.entries    = *(unsigned*)UCS_PTR_BYTE_OFFSET(uring->sq.ring,
+                                                           params.sq_off.ring_entries);
+    uring->sq.local_tail = *uring->sq.tail;
+    uring->cq.head       = UCS_PTR_BYTE_OFFSET(uring->cq.ring,
+                                               params.cq_off.head);
+    uring->cq.tail       = UCS_PTR_BYTE_OFFSET(uring->cq.ring,
+                                               params.cq_off.tail);
+    uring->cq.mask       = *(unsigned*)UCS_PTR_BYTE_OFFSET(uring->cq.ring,
+                                                           params.cq_off.ring_mask);
+    uring->cq.cqes       = UCS_PTR_BYTE_OFFSET(uring->cq.ring,
+                                               params.cq_off.cqes);
+    uring->iface         = iface;
+
+    /* a destroyed EP cancels its receive synchronously, since the kernel
+     * could still write to its destination; no operation is posted yet, so
+     * the supported request fails with ENOENT */
+    memset(&cancel_reg, 0, sizeof(cancel_reg));
+    cancel_reg.addr = UCT_TCP_URING_WAKEUP_DATA;
+    if ((uct_tcp_uring_register(uring, IORING_REGISTER_SYNC_CANCEL,
+                                &cancel_reg, 1) < 0) && (errno != ENOENT)) {
+        ucs_debug("io_uring_register(fd=%d, SYNC_CANCEL) failed: %m",
+                  uring->fd);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_unmap;
+    }
+
+    status = uct_tcp_uring_rx_init(uring, rx_bufs);
+    if (status != UCS_OK) {
+        goto err_unmap;
+    }
+
+    status = ucs_mpool_init(&uring->op_mp, 0, sizeof(uct_tcp_uring_op_t), 0,
+                            UCS_SYS_CACHE_LINE_SIZE, 32, UINT_MAX,
+                            &uct_tcp_uring_mpool_ops, "uct_tcp_uring_op_mp");
+    if (status != UCS_OK) {
+        goto err_rx_cleanup;
+    }
+
+    uring->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (uring->wakeup_fd < 0) {
+        ucs_error("eventfd() failed: %m");
+        status = UCS_ERR_IO_ERROR;
+        goto err_cleanup_mpool;
+    }
+
+    uring->wakeup_armed = 0;
+    ucs_list_head_init(&uring->op_list);
+    ucs_list_head_init(&uring->ep_list);
+
+    uct_tcp_uring_rx_provide(uring);
+
+    ucs_debug("tcp_iface %p: created io_uring fd %d with %u entries and %u "
+              "RX buffers", iface, uring->fd, uring->sq.entries,
+              uring->rx.mask + 1);
+
+    *uring_p = uring;
+    return UCS_OK;
+
+err_cleanup_mpool:
+    ucs_mpool_cleanup(&uring->op_mp, 1);
+err_rx_cleanup:
+    uct_tcp_uring_rx_cleanup(uring);
+err_unmap:
+    uct_tcp_uring_unmap(uring);
+err_close:
+    close(uring->fd);
+err_free:
+    ucs_free(uring);
+    return status;
+}
+
+void uct_tcp_uring_destroy(uct_tcp_uring_t *uring)
+{
+    uct_tcp_uring_op_t *op;
+    int ret;
+
+    /* all EPs are destroyed, wait for completion of their operations to
+     * release RX buffers which could be used by the kernel */
+    ucs_assert(ucs_list_is_empty(&uring->ep_list));
+
+    ucs_list_for_each(op, &uring->op_list, list) {
+        uct_tcp_uring_op_cancel(uring, op);
+    }
+
+    while (!ucs_list_is_empty(&uring->op_list)) {
+        uct_tcp_uring_submit(uring);
+        uct_tcp_uring_reap(uring, UINT_MAX);
+        if (ucs_list_is_empty(&uring->op_list)) {
+            break;
+        }
+
+        ret = uct_tcp_uring_enter(uring, 0, 1, IORING_ENTER_GETEVENTS);
+        if ((ret < 0) && (errno != EINTR)) {
+            ucs_warn("io_uring_enter(fd=%d) failed: %m, %lu operations are "
+                     "not completed", uring->fd,
+                     ucs_list_length(&uring->op_list));
+            break;
+        }
+    }
+
+    ucs_mpool_cleanup(&uring->op_mp, 1);
+    uct_tcp_uring_rx_cleanup(uring);
+    uct_tcp_uring_unmap(uring);
+    /* the poll of wakeup file descriptor is removed with the ring */
+    close(uring->fd);
+    close(uring->wakeup_fd);
+    ucs_free(uring);
+}
+
+int uct_tcp_uring_fd(uct_tcp_uring_t *uring)
+{
+    return uring->fd;
+}
+
+unsigned uct_tcp_uring_progress(uct_tcp_iface_t *iface)
+{
+    uct_tcp_uring_t *uring = iface->uring;
+    unsigned count;
+    uct_tcp_ep_t *ep;
+    UCS_LIST_HEAD(ep_list);
+
+    /* the list of EPs is shared with the async thread, which accepts
+     * connections; take the lock once for the whole batch, so updating the
+     * EPs while handling the completions only increments its counter */
+    UCS_ASYNC_BLOCK(iface->super.worker->async);
+
+    count = uct_tcp_uring_reap(uring, iface->config.max_poll);
+    uct_tcp_uring_rx_provide(uring);
+
+    /* EPs which are added to the list during handling will post their
+     * operations on the next progress */
+    ucs_list_splice_tail(&ep_list, &uring->ep_list);
+    ucs_list_head_init(&uring->ep_list);
+
+    while (!ucs_list_is_empty(&ep_list)) {
+        ep = ucs_list_extract_head(&ep_list, uct_tcp_ep_t, uring.list);
+        ucs_list_head_init(&ep->uring.list);
+        count += uct_tcp_uring_ep_progress(uring, ep);
+    }
+
+    UCS_ASYNC_UNBLOCK(iface->super.worker->async);
+
+    if (!uring->wakeup_armed) {
+        uct_tcp_uring_wakeup_post(uring);
+    }
+
+    /* submit all new operations by a single system call */
+    uct_tcp_uring_submit(uring);
+
+    return count;
+}
+
+ucs_status_t uct_tcp_uring_arm(uct_tcp_iface_t *iface)
+{
+    uct_tcp_uring_t *uring = iface->uring;
+
+    if (!ucs_list_is_empty(&uring->ep_list) || !uring->wakeup_armed) {
+        return UCS_ERR_BUSY;
+    }
+
+    uct_tcp_uring_submit(uring);
+
+    return (*uring->cq.head != *(volatile unsigned*)uring->cq.tail) ?
+           UCS_ERR_BUSY : UCS_OK;
+}
+
+void uct_tcp_uring_wakeup(uct_tcp_uring_t *uring)
+{
+    uint64_t dummy = 1;
+    int ret;
+
+    ret = write(uring->wakeup_fd, &dummy, sizeof(dummy));
+    if ((ret < 0) && (errno != EAGAIN)) {
+        ucs_error("write(wakeup_fd=%d) failed: %m", uring->wakeup_fd);
+    }
+}
+
+void uct_tcp_uring_ep_update(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    /* EPs could be created by the async thread, which accepts connections */
+    UCS_ASYNC_BLOCK(iface->super.worker->async);
+    if (ucs_list_is_empty(&ep->uring.list)) {
+        ucs_list_add_tail(&iface->uring->ep_list, &ep->uring.list);
+    }
+    UCS_ASYNC_UNBLOCK(iface->super.worker->async);
+}
+
+void uct_tcp_uring_ep_cleanup(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    UCS_ASYNC_BLOCK(iface->super.worker->async);
+    ucs_list_del(&ep->uring.list);
+    ucs_list_head_init(&ep->uring.list);
+    UCS_ASYNC_UNBLOCK(iface->super.worker->async);
+
+    if (ep->uring.rx_op != NULL) {
+        uct_tcp_uring_op_cancel(iface->uring, ep->uring.rx_op);
+        ep->uring.rx_op = NULL;
+    }
+
+    if (ep->uring.poll_op != NULL) {
+        uct_tcp_uring_op_cancel(iface->uring, ep->uring.poll_op);
+        ep->uring.poll_op = NULL;
+    }
+
+    if (ep->uring.rx_buf != NULL) {
+        ucs_mpool_put_inline(ep->uring.rx_buf);
+        ep->uring.rx_buf = NULL;
+    }
+
+    ep->uring.rx_dest   = NULL;
+    ep->uring.rx_length = 0;
+}
+
+void uct_tcp_uring_ep_move_rx(uct_tcp_ep_t *from_ep, uct_tcp_ep_t *to_ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(to_ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    /* the operations of the destination EP were posted to its old socket */
+    uct_tcp_uring_ep_cleanup(to_ep);
+
+    to_ep->uring.rx_op     = from_ep->uring.rx_op;
+    to_ep->uring.rx_buf    = from_ep->uring.rx_buf;
+    to_ep->uring.rx_dest   = from_ep->uring.rx_dest;
+    to_ep->uring.rx_offset = from_ep->uring.rx_offset;
+    to_ep->uring.rx_length = from_ep->uring.rx_length;
+    to_ep->uring.rx_status = from_ep->uring.rx_status;
+    to_ep->uring.rx_nobufs = from_ep->uring.rx_nobufs;
+    if (to_ep->uring.rx_op != NULL) {
+        to_ep->uring.rx_op->ep = to_ep;
+    }
+
+    from_ep->uring.rx_op     = NULL;
+    from_ep->uring.rx_buf    = NULL;
+    from_ep->uring.rx_dest   = NULL;
+    from_ep->uring.rx_length = 0;
+    from_ep->uring.rx_status = UCS_OK;
+
+    if (from_ep->uring.poll_op != NULL) {
+        uct_tcp_uring_op_cancel(iface->uring, from_ep->uring.poll_op);
+        from_ep->uring.poll_op = NULL;
+    }
+
+    uct_tcp_uring_ep_update(to_ep);
+}
+
+ucs_status_t uct_tcp_uring_ep_recv(uct_tcp_ep_t *ep, void *buf,
+                                   size_t *length_p)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    ucs_status_t status;
+
+    if (ep->uring.rx_dest != NULL) {
+        /* the data was received to its place */
+        ucs_assertv(buf == ep->uring.rx_dest, "ep=%p buf=%p rx_dest=%p", ep,
+                    buf, ep->uring.rx_dest);
+        ucs_assertv(ep->uring.rx_length <= *length_p, "ep=%p", ep);
+        *length_p           = ep->uring.rx_length;
+        ep->uring.rx_dest   = NULL;
+        ep->uring.rx_length = 0;
+        return UCS_OK;
+    }
+
+    if (ep->uring.rx_buf == NULL) {
+        *length_p = 0;
+        if (ep->uring.rx_status == UCS_OK) {
+            return UCS_ERR_NO_PROGRESS;
+        }
+
+        /* report the error of the last receive once */
+        status              = ep->uring.rx_status;
+        ep->uring.rx_status = UCS_OK;
+        return status;
+    }
+
+    *length_p = ucs_min(*length_p, ep->uring.rx_length);
+    memcpy(buf, UCS_PTR_BYTE_OFFSET(ep->uring.rx_buf,
+                                    iface->config.rx_buf_offset +
+                                    ep->uring.rx_offset), *length_p);
+
+    ep->uring.rx_offset += *length_p;
+    ep->uring.rx_length -= *length_p;
+    if (ep->uring.rx_length == 0) {
+        ucs_mpool_put_inline(ep->uring.rx_buf);
+        ep->uring.rx_buf = NULL;
+    }
+
+    return UCS_OK;
+}
+
+int uct_tcp_uring_ep_rx_adopt(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    if ((ep->uring.rx_buf == NULL) || (ep->uring.rx_offset != 0)) {
+        return 0;
+    }
+
+    ucs_assert(ep->rx.buf == NULL);
+
+    ep->rx.buf          = UCS_PTR_BYTE_OFFSET(ep->uring.rx_buf,
+                                              iface->config.rx_buf_offset);
+    ep->rx.offset       = 0;
+    ep->rx.length       = ep->uring.rx_length;
+    ep->uring.rx_buf    = NULL;
+    ep->uring.rx_length = 0;
+    return 1;
+}
+
+#else
+
+ucs_status_t uct_tcp_uring_create(uct_tcp_iface_t *iface, unsigned entries,
+                                  unsigned rx_bufs, uct_tcp_uring_t **uring_p)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+void uct_tcp_uring_destroy(uct_tcp_uring_t *uring)
+{
+}
+
+int uct_tcp_uring_fd(uct_tcp_uring_t *uring)
+{
+    return -1;
+}
+
+unsigned uct_tcp_uring_progress(uct_tcp_iface_t *iface)
+{
+    return 0;
+}
+
+ucs_status_t uct_tcp_uring_arm(uct_tcp_iface_t *iface)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+void uct_tcp_uring_wakeup(uct_tcp_uring_t *uring)
+{
+}
+
+void uct_tcp_uring_ep_update(uct_tcp_ep_t *ep)
+{
+}
+
+void uct_tcp_uring_ep_cleanup(uct_tcp_ep_t *ep)
+{
+}
+
+void uct_tcp_uring_ep_move_rx(uct_tcp_ep_t *from_ep, uct_tcp_ep_t *to_ep)
+{
+}
+
+ucs_status_t uct_tcp_uring_ep_recv(uct_tcp_ep_t *ep, void *buf,
+                                   size_t *length_p)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+int uct_tcp_uring_ep_rx_adopt(uct_tcp_ep_t *ep)
+{
+    return 0;
+}
+
+#endif
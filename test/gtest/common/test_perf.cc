@@ -276,6 +276,11 @@ void test_perf::run_test(const test_spec& test, unsigned flags, bool check_perf,
 
         ASSERT_UCS_OK(result.status);
 
+        EXPECT_LE(result.result.latency_tail.p50,  result.result.latency_tail.p90);
+        EXPECT_LE(result.result.latency_tail.p90,  result.result.latency_tail.p99);
+        EXPECT_LE(result.result.latency_tail.p99,  result.result.latency_tail.p999);
+        EXPECT_LE(result.result.latency_tail.p999, result.result.latency_tail.max);
+
         double value = *(double*)( ((char*)&result.result) + test.field_offset) *
                         test.norm;
         char result_str[200] = {0};
@@ -1288,3 +1288,91 @@ UCS_MT_TEST_F(malloc_hook_dlopen, dlopen_mt_with_memtype, 2) {
 
     event.unset();
 }
+
+class malloc_hook_mt : public ucs::test {
+protected:
+    virtual void init() {
+        ucs::test::init();
+        m_total_ops = 0;
+    }
+
+    static void count_event_callback(ucm_event_type_t event_type,
+                                     ucm_event_t *event, void *arg)
+    {
+        ucs_atomic_add32(reinterpret_cast<volatile uint32_t*>(arg), 1);
+    }
+
+    static void empty_event_callback(ucm_event_type_t event_type,
+                                     ucm_event_t *event, void *arg)
+    {
+    }
+
+    void mmap_munmap() {
+        size_t size = ucs_get_page_size();
+        void *ptr   = mmap(NULL, size, PROT_READ|PROT_WRITE,
+                           MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        ASSERT_NE(MAP_FAILED, ptr) << strerror(errno);
+        munmap(ptr, size);
+    }
+
+    volatile uint64_t m_total_ops;
+};
+
+UCS_MT_TEST_F(malloc_hook_mt, mmap_munmap_perf, 4) {
+    ucs_status_t status;
+
+    if (barrier()) {
+        status = ucm_set_event_handler(UCM_EVENT_VM_MAPPED |
+                                       UCM_EVENT_VM_UNMAPPED, 0,
+                                       empty_event_callback, NULL);
+        ASSERT_UCS_OK(status);
+    }
+    barrier();
+
+    ucs_time_t end_time = ucs_get_time() + ucs_time_from_sec(0.5);
+    uint64_t count      = 0;
+    do {
+        for (int i = 0; i < 100; ++i) {
+            mmap_munmap();
+        }
+        count += 100;
+    } while (ucs_get_time() < end_time);
+
+    ucs_atomic_add64(&m_total_ops, count);
+    if (barrier()) {
+        UCS_TEST_MESSAGE << num_threads() << " threads: "
+                         << (m_total_ops * 2.0) / 0.5 / 1e6
+                         << " million mmap/munmap per second";
+        ucm_unset_event_handler(UCM_EVENT_VM_MAPPED | UCM_EVENT_VM_UNMAPPED,
+                                empty_event_callback, NULL);
+    }
+    barrier();
+}
+
+UCS_MT_TEST_F(malloc_hook_mt, set_unset_handler, 4) {
+    /* Handler is not called after it was removed, even if other threads
+     * dispatch events concurrently */
+    for (int i = 0; i < 100 / ucs::test_time_multiplier(); ++i) {
+        volatile uint32_t count = 0;
+        ucs_status_t status;
+
+        status = ucm_set_event_handler(UCM_EVENT_VM_MAPPED |
+                                       UCM_EVENT_VM_UNMAPPED, 0,
+                                       count_event_callback, (void*)&count);
+        ASSERT_UCS_OK(status);
+
+        for (int j = 0; j < 10; ++j) {
+            mmap_munmap();
+        }
+
+        ucm_unset_event_handler(UCM_EVENT_VM_MAPPED | UCM_EVENT_VM_UNMAPPED,
+                                count_event_callback, (void*)&count);
+
+        uint32_t prev_count = count;
+        EXPECT_GE(prev_count, 20u);
+        for (int j = 0; j < 10; ++j) {
+            mmap_munmap();
+        }
+        EXPECT_EQ(prev_count, count);
+    }
+}
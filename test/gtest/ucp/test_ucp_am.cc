@@ -125,6 +125,7 @@ protected:
     void do_send_process_data_test(int test_release, uint16_t am_id,
                                    int send_reply);
     void do_send_process_data_iov_test();
+    void do_send_process_data_outstanding_test();
     void set_handlers(uint16_t am_id);
     void set_reply_handlers();
 };
@@ -249,6 +250,48 @@ void test_ucp_am::do_send_process_data_iov_test()
     }
 }
 
+void test_ucp_am::do_send_process_data_outstanding_test()
+{
+    /* Sizes span the pooled reassembly size classes and the malloc fallback */
+    const size_t sizes[] = { 5000, 65536, 100000, UCS_MBYTE, UCS_MBYTE + 1,
+                             3 * UCS_MBYTE };
+    const size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    std::vector<std::vector<char> > bufs(num_sizes);
+    std::vector<void*> reqs;
+    ucs_status_ptr_t sstatus;
+
+    recv_ams = 0;
+    sent_ams = 0;
+    release  = 0;
+
+    set_handlers(UCP_SEND_ID);
+
+    /* Post all messages before progressing, so that fragments of different
+     * messages are being reassembled at the same time */
+    for (int iter = 0; iter < 2; ++iter) {
+        for (size_t i = 0; i < num_sizes; ++i) {
+            bufs[i].assign(sizes[i], (char)sizes[i]);
+            sstatus = ucp_am_send_nb(receiver().ep(), UCP_SEND_ID,
+                                     bufs[i].data(), bufs[i].size(),
+                                     ucp_dt_make_contig(1),
+                                     (ucp_send_callback_t)ucs_empty_function,
+                                     0);
+            ASSERT_FALSE(UCS_PTR_IS_ERR(sstatus));
+            reqs.push_back(sstatus);
+            sent_ams++;
+        }
+
+        while (!reqs.empty()) {
+            wait(reqs.back());
+            reqs.pop_back();
+        }
+    }
+
+    while (sent_ams != recv_ams) {
+        progress();
+    }
+}
+
 void test_ucp_am::do_set_am_handler_realloc_test()
 {
     set_handlers(UCP_SEND_ID);
@@ -281,6 +324,11 @@ UCS_TEST_P(test_ucp_am, send_process_iov_am)
     do_send_process_data_iov_test();
 }
 
+UCS_TEST_P(test_ucp_am, send_process_outstanding_am)
+{
+    do_send_process_data_outstanding_test();
+}
+
 UCS_TEST_P(test_ucp_am, set_am_handler_realloc)
 {
     do_set_am_handler_realloc_test();
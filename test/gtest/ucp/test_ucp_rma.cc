@@ -7,6 +7,10 @@
 
 #include "test_ucp_memheap.h"
 #include <ucs/sys/sys.h>
+extern "C" {
+#include <ucp/core/ucp_ep.inl>
+#include <ucp/core/ucp_worker.h>
+}
 
 
 class test_ucp_rma : public test_ucp_memheap {
@@ -99,8 +103,148 @@ public:
     }
 
     void test_message_sizes(blocking_send_func_t func, size_t *msizes, int iters, int is_nbi);
+
+    void test_strided(bool is_put, size_t length, size_t count,
+                      size_t local_stride, size_t remote_stride);
+
+    void test_iov(bool is_put, size_t iovcnt, size_t max_length);
+
+protected:
+    void map_remote(size_t size, ucp_mem_h *memh_p, void **address_p,
+                    ucp_rkey_h *rkey_p);
+
+    void unmap_remote(ucp_mem_h memh, ucp_rkey_h rkey);
+
+    void wait_vec(void *status);
 };
 
+void test_ucp_rma::map_remote(size_t size, ucp_mem_h *memh_p, void **address_p,
+                              ucp_rkey_h *rkey_p)
+{
+    ucp_mem_map_params_t params;
+    ucp_mem_attr_t mem_attr;
+    ucs_status_t status;
+    void *rkey_buffer;
+    size_t rkey_buffer_size;
+
+    params.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                        UCP_MEM_MAP_PARAM_FIELD_LENGTH |
+                        UCP_MEM_MAP_PARAM_FIELD_FLAGS;
+    params.address    = NULL;
+    params.length     = size;
+    params.flags      = GetParam().variant | UCP_MEM_MAP_ALLOCATE;
+
+    status = ucp_mem_map(receiver().ucph(), &params, memh_p);
+    ASSERT_UCS_OK(status);
+
+    mem_attr.field_mask = UCP_MEM_ATTR_FIELD_ADDRESS;
+    status = ucp_mem_query(*memh_p, &mem_attr);
+    ASSERT_UCS_OK(status);
+    *address_p = mem_attr.address;
+
+    status = ucp_rkey_pack(receiver().ucph(), *memh_p, &rkey_buffer,
+                           &rkey_buffer_size);
+    ASSERT_UCS_OK(status);
+
+    status = ucp_ep_rkey_unpack(sender().ep(), rkey_buffer, rkey_p);
+    ASSERT_UCS_OK(status);
+
+    ucp_rkey_buffer_release(rkey_buffer);
+}
+
+void test_ucp_rma::unmap_remote(ucp_mem_h memh, ucp_rkey_h rkey)
+{
+    ucp_rkey_destroy(rkey);
+    ucs_status_t status = ucp_mem_unmap(receiver().ucph(), memh);
+    ASSERT_UCS_OK(status);
+}
+
+void test_ucp_rma::wait_vec(void *status)
+{
+    ASSERT_UCS_PTR_OK(status);
+    if (UCS_PTR_IS_PTR(status)) {
+        wait(status);
+    }
+    flush_worker(sender());
+}
+
+void test_ucp_rma::test_strided(bool is_put, size_t length, size_t count,
+                                size_t local_stride, size_t remote_stride)
+{
+    std::vector<char> local(local_stride * (count - 1) + length);
+    size_t remote_size = remote_stride * (count - 1) + length;
+    ucp_mem_h memh;
+    ucp_rkey_h rkey;
+    void *remote;
+
+    sender().connect(&receiver(), get_ep_params());
+    map_remote(remote_size, &memh, &remote, &rkey);
+
+    ucs::fill_random(local);
+    ucs::fill_random(remote, remote_size);
+
+    void *status;
+    if (is_put) {
+        status = ucp_put_strided_nb(sender().ep(), &local[0], length, count,
+                                    local_stride, (uintptr_t)remote,
+                                    remote_stride, rkey, send_completion);
+    } else {
+        status = ucp_get_strided_nb(sender().ep(), &local[0], length, count,
+                                    local_stride, (uintptr_t)remote,
+                                    remote_stride, rkey, send_completion);
+    }
+    wait_vec(status);
+
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(0, memcmp(&local[i * local_stride],
+                            (char*)remote + (i * remote_stride), length))
+            << "block " << i;
+    }
+
+    unmap_remote(memh, rkey);
+}
+
+void test_ucp_rma::test_iov(bool is_put, size_t iovcnt, size_t max_length)
+{
+    std::vector<std::vector<char> > buffers(iovcnt);
+    std::vector<ucp_dt_iov_t> iov(iovcnt);
+    size_t total_length = 0;
+    ucp_mem_h memh;
+    ucp_rkey_h rkey;
+    void *remote;
+
+    for (size_t i = 0; i < iovcnt; ++i) {
+        buffers[i].resize(1 + (ucs::rand() % max_length));
+        ucs::fill_random(buffers[i]);
+        iov[i].buffer = &buffers[i][0];
+        iov[i].length = buffers[i].size();
+        total_length += iov[i].length;
+    }
+
+    sender().connect(&receiver(), get_ep_params());
+    map_remote(total_length, &memh, &remote, &rkey);
+    ucs::fill_random(remote, total_length);
+
+    void *status;
+    if (is_put) {
+        status = ucp_put_iov_nb(sender().ep(), &iov[0], iovcnt,
+                                (uintptr_t)remote, rkey, send_completion);
+    } else {
+        status = ucp_get_iov_nb(sender().ep(), &iov[0], iovcnt,
+                                (uintptr_t)remote, rkey, send_completion);
+    }
+    wait_vec(status);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < iovcnt; ++i) {
+        EXPECT_EQ(0, memcmp(iov[i].buffer, (char*)remote + offset,
+                            iov[i].length)) << "iov " << i;
+        offset += iov[i].length;
+    }
+
+    unmap_remote(memh, rkey);
+}
+
 void test_ucp_rma::test_message_sizes(blocking_send_func_t func, size_t *msizes, int iters, int is_nbi)
 {
    int i;
@@ -315,4 +459,133 @@ UCS_TEST_P(test_ucp_rma, nonblocking_stream_get_nb_flush_ep) {
                        1, true, true);
 }
 
+UCS_TEST_P(test_ucp_rma, put_strided) {
+    /* remote contiguous, gathered */
+    test_strided(true, 8, 100, 64, 8);
+    test_strided(true, 4096, 16, 8192, 4096);
+    /* more blocks than a single UCT iov operation takes */
+    test_strided(true, 3000, 100, 5000, 3000);
+    /* same local block written repeatedly */
+    test_strided(true, 1000, 20, 0, 1000);
+    /* both sides strided */
+    test_strided(true, 24, 50, 40, 100);
+    test_strided(true, 20000, 4, 30000, 25000);
+    /* both sides contiguous */
+    test_strided(true, 100, 10, 100, 100);
+}
+
+UCS_TEST_P(test_ucp_rma, get_strided) {
+    test_strided(false, 8, 100, 64, 8);
+    test_strided(false, 4096, 16, 8192, 4096);
+    test_strided(false, 3000, 100, 5000, 3000);
+    test_strided(false, 24, 50, 40, 100);
+    test_strided(false, 20000, 4, 30000, 25000);
+    test_strided(false, 100, 10, 100, 100);
+}
+
+UCS_TEST_P(test_ucp_rma, put_iov) {
+    test_iov(true, 1, 1000);
+    test_iov(true, 10, 100);
+    test_iov(true, 64, 8192);
+}
+
+UCS_TEST_P(test_ucp_rma, get_iov) {
+    test_iov(false, 1, 1000);
+    test_iov(false, 10, 100);
+    test_iov(false, 64, 8192);
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_rma)
+
+
+class test_ucp_rma_sw : public test_ucp_rma {
+public:
+    void init() {
+        /* PUT data and GET replies are sent with AM zcopy */
+        modify_config("ZCOPY_THRESH", "1");
+        test_ucp_rma::init();
+    }
+
+    void connect() {
+        sender().connect(&receiver(), get_ep_params());
+        if (ucp_ep_config(sender().ep())->key.rma_lanes[0] != UCP_NULL_LANE) {
+            UCS_TEST_SKIP_R("RMA is not done in software");
+        }
+    }
+
+    void test_xfer(bool is_put, size_t length) {
+        std::vector<char> local(length);
+        ucp_mem_h memh;
+        ucp_rkey_h rkey;
+        void *remote;
+        void *status;
+
+        map_remote(length, &memh, &remote, &rkey);
+        ucs::fill_random(local);
+        ucs::fill_random(remote, length);
+
+        if (is_put) {
+            status = ucp_put_nb(sender().ep(), &local[0], length,
+                                (uintptr_t)remote, rkey, send_completion);
+        } else {
+            status = ucp_get_nb(sender().ep(), &local[0], length,
+                                (uintptr_t)remote, rkey, send_completion);
+        }
+        wait_vec(status);
+
+        EXPECT_EQ(0, memcmp(&local[0], remote, length)) << "length " << length;
+        unmap_remote(memh, rkey);
+    }
+
+private:
+    static void send_completion(void *request, ucs_status_t status) {}
+};
+
+UCS_TEST_P(test_ucp_rma_sw, put_zcopy) {
+    static const size_t sizes[] = { 1, 1000, 9000, 65536, 300000 };
+
+    connect();
+    for (size_t i = 0; i < ucs_static_array_size(sizes); ++i) {
+        test_xfer(true, sizes[i]);
+    }
+}
+
+UCS_TEST_P(test_ucp_rma_sw, get_reply_zcopy) {
+    static const size_t sizes[] = { 1, 1000, 9000, 65536, 300000 };
+
+    connect();
+    for (size_t i = 0; i < ucs_static_array_size(sizes); ++i) {
+        test_xfer(false, sizes[i]);
+    }
+}
+
+UCS_TEST_P(test_ucp_rma_sw, coalesced_acks) {
+    static const size_t num_puts = 1000;
+    std::vector<uint64_t> local(num_puts);
+    ucp_mem_h memh;
+    ucp_rkey_h rkey;
+    void *remote;
+
+    connect();
+    map_remote(num_puts * sizeof(uint64_t), &memh, &remote, &rkey);
+
+    /* the acks of puts done in the same progress round are sent together,
+     * and the flush completes only when all puts are acknowledged */
+    for (size_t i = 0; i < num_puts; ++i) {
+        local[i] = i;
+        ASSERT_UCS_OK_OR_INPROGRESS(
+                ucp_put_nbi(sender().ep(), &local[i], sizeof(local[i]),
+                            (uintptr_t)remote + (i * sizeof(uint64_t)), rkey));
+    }
+    flush_worker(sender());
+
+    EXPECT_EQ(0, memcmp(&local[0], remote, num_puts * sizeof(uint64_t)));
+    EXPECT_EQ(0u, sender().worker()->flush_ops_count);
+    EXPECT_EQ(ucp_ep_flush_state(sender().ep())->send_sn,
+              ucp_ep_flush_state(sender().ep())->cmpl_sn);
+    EXPECT_EQ(0u, kh_size(&receiver().worker()->rma_cmpl_hash));
+
+    unmap_remote(memh, rkey);
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_rma_sw)
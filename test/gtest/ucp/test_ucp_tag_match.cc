@@ -8,6 +8,7 @@
 #include "test_ucp_tag.h"
 
 #include <common/test_helpers.h>
+#include <ucp/core/ucp_worker.h> /* for checking the mask hash tables */
 
 using namespace ucs; /* For vector<char> serialization */
 
@@ -374,6 +375,68 @@ UCS_TEST_P(test_ucp_tag_match, send_recv_nb_exp) {
     request_release(my_recv_req);
 }
 
+UCS_TEST_P(test_ucp_tag_match, send_recv_exp_masks_order) {
+    /* more distinct masks than have a hash table of expected requests */
+    static const ucp_tag_t tag_masks[] = { 0xffffffffffffffff, 0xffff, 0xff, 0,
+                                           0xfff, 0xf0, 0xffffff, 0xf,
+                                           0xffffffffffffffff, 0xffff, 0xf0 };
+    static const size_t num_requests   = ucs_static_array_size(tag_masks);
+    static const ucp_tag_t send_tag    = 0x111337;
+
+    std::vector<uint64_t> recv_data(num_requests, 0);
+    std::vector<request*> recv_reqs;
+
+    for (size_t i = 0; i < num_requests; ++i) {
+        request *my_recv_req = recv_nb(&recv_data[i], sizeof(recv_data[i]),
+                                       DATATYPE, send_tag & tag_masks[i],
+                                       tag_masks[i]);
+        ASSERT_TRUE(!UCS_PTR_IS_ERR(my_recv_req));
+        ASSERT_TRUE(my_recv_req != NULL);
+        recv_reqs.push_back(my_recv_req);
+    }
+
+    /* every message matches all requests, so they complete in posting order */
+    for (uint64_t i = 0; i < num_requests; ++i) {
+        send_b(&i, sizeof(i), DATATYPE, send_tag);
+    }
+
+    for (size_t i = 0; i < num_requests; ++i) {
+        wait(recv_reqs[i]);
+        EXPECT_TRUE(recv_reqs[i]->completed);
+        EXPECT_EQ(UCS_OK, recv_reqs[i]->status);
+        EXPECT_EQ(send_tag, recv_reqs[i]->info.sender_tag);
+        EXPECT_EQ(i, recv_data[i]) << "mask " << std::hex << tag_masks[i];
+        request_release(recv_reqs[i]);
+    }
+
+    EXPECT_EQ(0u, receiver().worker()->tm.expected.num_masks);
+}
+
+UCS_TEST_P(test_ucp_tag_match, send_recv_exp_masks_reuse) {
+    static const ucp_tag_t send_tag = 0x111337;
+    static const unsigned num_masks = 2 * UCP_TAG_MATCH_MAX_MASKS;
+
+    /* the hash table of a mask is released when its last request completes,
+     * so every new mask gets one */
+    for (unsigned i = 0; i < num_masks; ++i) {
+        ucp_tag_t tag_mask = UCS_MASK(4 * (i + 1));
+        uint64_t send_data = i, recv_data = 0;
+
+        request *my_recv_req = recv_nb(&recv_data, sizeof(recv_data), DATATYPE,
+                                       send_tag & tag_mask, tag_mask);
+        ASSERT_TRUE(!UCS_PTR_IS_ERR(my_recv_req));
+        ASSERT_TRUE(my_recv_req != NULL);
+        EXPECT_EQ(1u, receiver().worker()->tm.expected.num_masks);
+
+        send_b(&send_data, sizeof(send_data), DATATYPE, send_tag);
+        wait(my_recv_req);
+        EXPECT_EQ(UCS_OK, my_recv_req->status);
+        EXPECT_EQ(send_data, recv_data);
+        request_release(my_recv_req);
+        EXPECT_EQ(0u, receiver().worker()->tm.expected.num_masks);
+    }
+}
+
 UCS_TEST_P(test_ucp_tag_match, send_nb_multiple_recv_unexp) {
     const unsigned      num_requests = 1000;
     ucp_tag_recv_info_t info;
@@ -639,4 +702,201 @@ UCS_TEST_P(test_ucp_tag_match, rndv_exp_huge_mix) {
     }
 }
 
+UCS_TEST_P(test_ucp_tag_match, nbr_batch) {
+    const unsigned count      = 16;
+    const unsigned num_unexp  = 2;
+    std::vector<uint64_t> sendbuf(count), recvbuf(count, 0);
+    std::vector<ucp_tag_recv_op_t> recv_ops(count);
+    std::vector<ucp_tag_send_op_t> send_ops(count - num_unexp);
+    std::vector<ucs_status_t> statuses(send_ops.size());
+    std::vector<request*> reqs;
+    ucs_status_t status;
+
+    for (unsigned i = 0; i < count; ++i) {
+        sendbuf[i] = i * 13;
+    }
+
+    /* first messages arrive before the receives are posted */
+    for (unsigned i = 0; i < num_unexp; ++i) {
+        send_b(&sendbuf[i], sizeof(sendbuf[i]), DATATYPE, i);
+    }
+    short_progress_loop();
+
+    for (unsigned i = 0; i < count; ++i) {
+        reqs.push_back(request_alloc());
+        recv_ops[i].buffer   = &recvbuf[i];
+        recv_ops[i].count    = sizeof(recvbuf[i]);
+        recv_ops[i].datatype = DATATYPE;
+        recv_ops[i].tag      = i;
+        recv_ops[i].tag_mask = (i % 2) ? (ucp_tag_t)-1 : 0xffff;
+        recv_ops[i].request  = reqs.back();
+    }
+
+    status = ucp_tag_recv_nbr_batch(receiver().worker(), &recv_ops[0], count);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < send_ops.size(); ++i) {
+        reqs.push_back(request_alloc());
+        send_ops[i].ep       = sender().ep();
+        send_ops[i].buffer   = &sendbuf[num_unexp + i];
+        send_ops[i].count    = sizeof(sendbuf[num_unexp + i]);
+        send_ops[i].datatype = DATATYPE;
+        send_ops[i].tag      = num_unexp + i;
+        send_ops[i].request  = reqs.back();
+    }
+
+    status = ucp_tag_send_nbr_batch(sender().worker(), &send_ops[0],
+                                    send_ops.size(), &statuses[0]);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < statuses.size(); ++i) {
+        ASSERT_UCS_OK_OR_INPROGRESS(statuses[i]);
+        if (statuses[i] == UCS_OK) {
+            /* completed in place, nothing to wait for */
+            request_free(reqs[count + i]);
+            reqs[count + i] = NULL;
+        }
+    }
+
+    for (unsigned i = 0; i < reqs.size(); ++i) {
+        if (reqs[i] == NULL) {
+            continue;
+        }
+
+        while (ucp_request_check_status(reqs[i]) == UCS_INPROGRESS) {
+            progress();
+        }
+        EXPECT_UCS_OK(ucp_request_check_status(reqs[i]));
+        request_free(reqs[i]);
+    }
+
+    EXPECT_EQ(sendbuf, recvbuf);
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_tag_match)
+
+class test_ucp_tag_cq : public test_ucp_tag {
+public:
+    virtual ucp_worker_params_t get_worker_params() {
+        ucp_worker_params_t params = test_ucp_tag::get_worker_params();
+        params.field_mask |= UCP_WORKER_PARAM_FIELD_CQ_SIZE;
+        params.cq_size     = 4;
+        return params;
+    }
+
+protected:
+    /* poll the completion queue of the receiver until all requests in
+     * 'outstanding' are reported, and release them */
+    void wait_cq(std::set<void*>& outstanding) {
+        ucs_time_t deadline = ucs::get_deadline();
+        ucp_cq_entry_t entries[8];
+        unsigned i, count;
+
+        while (!outstanding.empty() && (ucs_get_time() < deadline)) {
+            progress();
+            count = ucp_worker_poll_cq(receiver().worker(), entries,
+                                       ucs_static_array_size(entries));
+            EXPECT_LE(count, ucs_static_array_size(entries));
+            for (i = 0; i < count; ++i) {
+                EXPECT_UCS_OK(entries[i].status);
+                EXPECT_EQ(1ul, outstanding.erase(entries[i].request));
+                ucp_request_free(entries[i].request);
+            }
+        }
+
+        EXPECT_TRUE(outstanding.empty());
+    }
+};
+
+UCS_TEST_P(test_ucp_tag_cq, send_recv) {
+    const unsigned count = 64;
+    std::vector<uint64_t> sendbuf(count), recvbuf(count, 0);
+    std::set<void*> outstanding;
+    ucp_cq_entry_t entry;
+    void *req;
+
+    for (unsigned i = 0; i < count; ++i) {
+        req = ucp_tag_recv_nb(receiver().worker(), &recvbuf[i],
+                              sizeof(recvbuf[i]), DATATYPE, i, (ucp_tag_t)-1,
+                              NULL);
+        ASSERT_UCS_PTR_OK(req);
+        ASSERT_TRUE(req != NULL);
+        outstanding.insert(req);
+    }
+
+    /* nothing was completed yet */
+    EXPECT_EQ(0u, ucp_worker_poll_cq(receiver().worker(), &entry, 1));
+
+    for (unsigned i = 0; i < count; ++i) {
+        sendbuf[i] = i * 7;
+        send_b(&sendbuf[i], sizeof(sendbuf[i]), DATATYPE, i);
+    }
+
+    /* more completions than the initial queue size */
+    wait_cq(outstanding);
+    EXPECT_EQ(sendbuf, recvbuf);
+    EXPECT_EQ(0u, ucp_worker_poll_cq(receiver().worker(), &entry, 1));
+}
+
+UCS_TEST_P(test_ucp_tag_cq, unexp_recv) {
+    uint64_t send_data = 0xdeadbeefdeadbeef;
+    uint64_t recv_data = 0;
+    std::set<void*> outstanding;
+    void *req;
+
+    send_b(&send_data, sizeof(send_data), DATATYPE, 0x111337);
+    short_progress_loop();
+
+    req = ucp_tag_recv_nb(receiver().worker(), &recv_data, sizeof(recv_data),
+                          DATATYPE, 0x111337, (ucp_tag_t)-1, NULL);
+    ASSERT_UCS_PTR_OK(req);
+    ASSERT_TRUE(req != NULL);
+    outstanding.insert(req);
+
+    wait_cq(outstanding);
+    EXPECT_EQ(send_data, recv_data);
+}
+
+UCS_TEST_P(test_ucp_tag_cq, free_before_poll) {
+    const unsigned count = 16;
+    std::vector<uint64_t> sendbuf(count, 0), recvbuf(count, 0);
+    std::vector<void*> reqs;
+    std::set<void*> outstanding;
+    void *req;
+
+    for (unsigned i = 0; i < count; ++i) {
+        req = ucp_tag_recv_nb(receiver().worker(), &recvbuf[i],
+                              sizeof(recvbuf[i]), DATATYPE, i, (ucp_tag_t)-1,
+                              NULL);
+        ASSERT_UCS_PTR_OK(req);
+        ASSERT_TRUE(req != NULL);
+        reqs.push_back(req);
+    }
+
+    for (unsigned i = 0; i < count; ++i) {
+        send_b(&sendbuf[i], sizeof(sendbuf[i]), DATATYPE, i);
+    }
+
+    for (unsigned i = 0; i < count; ++i) {
+        while (ucp_request_check_status(reqs[i]) == UCS_INPROGRESS) {
+            progress();
+        }
+    }
+
+    /* completed requests which are released before they are polled are
+     * dropped from the queue */
+    for (unsigned i = 0; i < count; ++i) {
+        if (i % 2) {
+            ucp_request_free(reqs[i]);
+        } else {
+            outstanding.insert(reqs[i]);
+        }
+    }
+
+    wait_cq(outstanding);
+
+    ucp_cq_entry_t entry;
+    EXPECT_EQ(0u, ucp_worker_poll_cq(receiver().worker(), &entry, 1));
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_tag_cq)
@@ -446,6 +446,37 @@ UCS_TEST_P(test_async, many_timers) {
     }
 }
 
+class test_async_readd : public test_async {
+protected:
+    static const unsigned NUM_THREADS = 4;
+
+    static void *thread_func(void *arg) {
+        test_async_readd *self = reinterpret_cast<test_async_readd*>(arg);
+        int max_iters          = 200 / ucs::test_time_multiplier();
+
+        for (int i = 0; i < max_iters; ++i) {
+            local_timer lt(self->GetParam());
+            self->suspend_and_poll(&lt, 0.1);
+        }
+        return NULL;
+    }
+};
+
+/*
+ * Add and remove timers from several threads while they are being dispatched,
+ * so handler table slots and handler objects are reused concurrently.
+ */
+UCS_TEST_P(test_async_readd, timers_mt) {
+    pthread_t threads[NUM_THREADS];
+
+    for (unsigned i = 0; i < NUM_THREADS; ++i) {
+        pthread_create(&threads[i], NULL, thread_func, (void*)this);
+    }
+    for (unsigned i = 0; i < NUM_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
 UCS_TEST_P(test_async, ctx_event) {
     local_event le(GetParam());
     for (int retry = 0; retry < EVENT_RETRIES; ++retry) {
@@ -768,3 +799,7 @@ INSTANTIATE_TEST_CASE_P(signal,          test_async_timer_mt, ::testing::Values(
 INSTANTIATE_TEST_CASE_P(thread_spinlock, test_async_timer_mt, ::testing::Values(UCS_ASYNC_MODE_THREAD_SPINLOCK));
 INSTANTIATE_TEST_CASE_P(thread_mutex,    test_async_timer_mt, ::testing::Values(UCS_ASYNC_MODE_THREAD_MUTEX));
 INSTANTIATE_TEST_CASE_P(poll,            test_async_timer_mt, ::testing::Values(UCS_ASYNC_MODE_POLL));
+INSTANTIATE_TEST_CASE_P(signal,          test_async_readd, ::testing::Values(UCS_ASYNC_MODE_SIGNAL));
+INSTANTIATE_TEST_CASE_P(thread_spinlock, test_async_readd, ::testing::Values(UCS_ASYNC_MODE_THREAD_SPINLOCK));
+INSTANTIATE_TEST_CASE_P(thread_mutex,    test_async_readd, ::testing::Values(UCS_ASYNC_MODE_THREAD_MUTEX));
+INSTANTIATE_TEST_CASE_P(poll,            test_async_readd, ::testing::Values(UCS_ASYNC_MODE_POLL));
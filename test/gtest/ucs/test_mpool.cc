@@ -7,6 +7,7 @@
 #include <common/test.h>
 extern "C" {
 #include <ucs/datastruct/mpool.h>
+#include <ucs/datastruct/mpool.inl>
 }
 
 #include <limits.h>
@@ -201,3 +202,307 @@ UCS_TEST_F(test_mpool, infinite) {
 
     ucs_mpool_cleanup(&mp, 1);
 }
+
+class test_mpool_shrink : public test_mpool {
+protected:
+    static const unsigned ELEMS_PER_CHUNK = 6;
+    static const unsigned NUM_CHUNKS      = 3;
+    static const unsigned NUM_ELEMS       = ELEMS_PER_CHUNK * NUM_CHUNKS;
+
+    static int num_chunks;
+    static unsigned num_cleanups;
+
+    static ucs_status_t chunk_alloc(ucs_mpool_t *mp, size_t *size_p,
+                                    void **chunk_p) {
+        ucs_status_t status = test_alloc(mp, size_p, chunk_p);
+        if (status == UCS_OK) {
+            ++num_chunks;
+        }
+        return status;
+    }
+
+    static void chunk_release(ucs_mpool_t *mp, void *chunk) {
+        --num_chunks;
+        test_free(mp, chunk);
+    }
+
+    static void obj_cleanup(ucs_mpool_t *mp, void *obj) {
+        ++num_cleanups;
+    }
+
+    virtual void init() {
+        test_mpool::init();
+        num_chunks   = 0;
+        num_cleanups = 0;
+    }
+
+    void init_mpool(ucs_mpool_t *mp, unsigned max_elems) {
+        static ucs_mpool_ops_t ops = {
+           chunk_alloc,
+           chunk_release,
+           NULL,
+           obj_cleanup
+        };
+
+        ucs_status_t status = ucs_mpool_init(mp, 0, header_size + data_size,
+                                             header_size, align,
+                                             ELEMS_PER_CHUNK, max_elems, &ops,
+                                             "test");
+        ASSERT_UCS_OK(status);
+    }
+
+    void get_objs(ucs_mpool_t *mp, unsigned count, std::vector<void*>& objs) {
+        for (unsigned i = 0; i < count; ++i) {
+            void *ptr = ucs_mpool_get(mp);
+            ASSERT_TRUE(ptr != NULL) << "i=" << i;
+            objs.push_back(ptr);
+        }
+    }
+
+    void put_objs(std::vector<void*>& objs) {
+        for (unsigned i = 0; i < objs.size(); ++i) {
+            ucs_mpool_put(objs[i]);
+        }
+        objs.clear();
+    }
+};
+
+const unsigned test_mpool_shrink::NUM_CHUNKS;
+const unsigned test_mpool_shrink::NUM_ELEMS;
+int test_mpool_shrink::num_chunks        = 0;
+unsigned test_mpool_shrink::num_cleanups = 0;
+
+UCS_TEST_F(test_mpool_shrink, release_idle) {
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    init_mpool(&mp, UINT_MAX);
+
+    get_objs(&mp, NUM_ELEMS, objs);
+    EXPECT_EQ(int(NUM_CHUNKS), num_chunks);
+
+    /* chunks in use are never released */
+    EXPECT_EQ(0u, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(0u, ucs_mpool_shrink(&mp, 0));
+
+    put_objs(objs);
+
+    /* chunks must be found idle twice in a row */
+    EXPECT_EQ(0u, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(NUM_CHUNKS, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(0, num_chunks);
+    EXPECT_EQ(NUM_ELEMS, num_cleanups);
+
+    /* the pool grows again on demand */
+    get_objs(&mp, NUM_ELEMS, objs);
+    EXPECT_EQ(int(NUM_CHUNKS), num_chunks);
+    put_objs(objs);
+
+    ucs_mpool_cleanup(&mp, 1);
+    EXPECT_EQ(0, num_chunks);
+}
+
+UCS_TEST_F(test_mpool_shrink, min_free) {
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    init_mpool(&mp, UINT_MAX);
+
+    get_objs(&mp, NUM_ELEMS, objs);
+    put_objs(objs);
+
+    EXPECT_EQ(0u, ucs_mpool_shrink(&mp, ELEMS_PER_CHUNK));
+    EXPECT_EQ(NUM_CHUNKS - 1, ucs_mpool_shrink(&mp, ELEMS_PER_CHUNK));
+    EXPECT_EQ(1, num_chunks);
+
+    /* the last chunk is kept while it is needed to satisfy min_free_elems */
+    EXPECT_EQ(0u, ucs_mpool_shrink(&mp, 1));
+    EXPECT_EQ(1u, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(0, num_chunks);
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_shrink, partially_used) {
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    init_mpool(&mp, UINT_MAX);
+
+    get_objs(&mp, NUM_ELEMS, objs);
+    void *last = objs.back();
+    objs.pop_back();
+    put_objs(objs);
+
+    /* the chunk of the object which is still in use remains */
+    EXPECT_EQ(0u, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(NUM_CHUNKS - 1, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(1, num_chunks);
+
+    /* the remaining chunk has not been idle for a whole period yet */
+    ucs_mpool_put(last);
+    EXPECT_EQ(0u, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(1u, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(0, num_chunks);
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_shrink, quota) {
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    init_mpool(&mp, NUM_ELEMS);
+
+    for (unsigned loop = 0; loop < 3; ++loop) {
+        get_objs(&mp, NUM_ELEMS, objs);
+        EXPECT_TRUE(NULL == ucs_mpool_get(&mp));
+        put_objs(objs);
+
+        /* released elements are returned to the quota */
+        ucs_mpool_shrink(&mp, 0);
+        EXPECT_EQ(NUM_CHUNKS, ucs_mpool_shrink(&mp, 0));
+        EXPECT_EQ(0, num_chunks);
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_shrink, mt) {
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    init_mpool(&mp, UINT_MAX);
+    ASSERT_UCS_OK(ucs_mpool_enable_mt(&mp));
+
+    get_objs(&mp, NUM_ELEMS, objs);
+    put_objs(objs);
+
+    /* objects parked in the thread magazine are reclaimed before shrinking */
+    EXPECT_EQ(0u, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(NUM_CHUNKS, ucs_mpool_shrink(&mp, 0));
+    EXPECT_EQ(0, num_chunks);
+
+    get_objs(&mp, NUM_ELEMS, objs);
+    put_objs(objs);
+
+    ucs_mpool_cleanup(&mp, 1);
+    EXPECT_EQ(0, num_chunks);
+}
+
+class test_mpool_mt : public test_mpool {
+protected:
+    static const unsigned NUM_ELEMS   = 1024;
+    static const unsigned NUM_THREADS = 4;
+
+    struct put_args {
+        std::vector<void*> objs;
+    };
+
+    static void *put_thread(void *arg) {
+        put_args *args = (put_args*)arg;
+
+        for (std::vector<void*>::iterator iter = args->objs.begin();
+             iter != args->objs.end(); ++iter) {
+            ucs_mpool_put(*iter);
+        }
+        return NULL;
+    }
+
+    void init_mpool(ucs_mpool_t *mp) {
+        static ucs_mpool_ops_t ops = {
+           ucs_mpool_chunk_malloc,
+           ucs_mpool_chunk_free,
+           NULL,
+           NULL
+        };
+
+        /* all elements are allocated in a single chunk */
+        ucs_status_t status = ucs_mpool_init(mp, 0, header_size + data_size,
+                                             header_size, align, NUM_ELEMS,
+                                             NUM_ELEMS, &ops, "test");
+        ASSERT_UCS_OK(status);
+        ASSERT_UCS_OK(ucs_mpool_enable_mt(mp));
+    }
+
+    void get_all(ucs_mpool_t *mp, std::vector<void*>& objs) {
+        for (unsigned i = 0; i < NUM_ELEMS; ++i) {
+            void *ptr = ucs_mpool_get(mp);
+            ASSERT_TRUE(ptr != NULL) << "i=" << i;
+            ASSERT_EQ(mp, ucs_mpool_obj_owner(ptr));
+            objs.push_back(ptr);
+        }
+        EXPECT_TRUE(NULL == ucs_mpool_get(mp));
+        EXPECT_TRUE(ucs_mpool_is_empty(mp));
+    }
+};
+
+UCS_TEST_F(test_mpool_mt, local_put) {
+    ucs_mpool_t mp;
+
+    init_mpool(&mp);
+
+    for (unsigned loop = 0; loop < 10; ++loop) {
+        std::vector<void*> objs;
+        get_all(&mp, objs);
+
+        /* objects are parked in the magazine of this thread, and must be
+         * recycled once the pool cannot grow anymore */
+        for (unsigned i = 0; i < objs.size(); ++i) {
+            ucs_mpool_put(objs[i]);
+        }
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_mt, remote_put) {
+    put_args args[NUM_THREADS];
+    pthread_t threads[NUM_THREADS];
+    ucs_mpool_t mp;
+
+    init_mpool(&mp);
+
+    for (unsigned loop = 0; loop < 10; ++loop) {
+        std::vector<void*> objs;
+        get_all(&mp, objs);
+
+        for (unsigned i = 0; i < objs.size(); ++i) {
+            args[i % NUM_THREADS].objs.push_back(objs[i]);
+        }
+
+        for (unsigned i = 0; i < NUM_THREADS; ++i) {
+            pthread_create(&threads[i], NULL, put_thread, &args[i]);
+        }
+
+        for (unsigned i = 0; i < NUM_THREADS; ++i) {
+            pthread_join(threads[i], NULL);
+            args[i].objs.clear();
+        }
+    }
+
+    /* objects left in magazines are not reported as leaks */
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_mt, enable_after_alloc) {
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    ucs_mpool_t mp;
+
+    ucs_mpool_ops_t ops = {
+       ucs_mpool_chunk_malloc,
+       ucs_mpool_chunk_free,
+       NULL,
+       NULL
+    };
+
+    ASSERT_UCS_OK(ucs_mpool_init(&mp, 0, header_size + data_size, header_size,
+                                 align, 6, 18, &ops, "test"));
+
+    void *obj = ucs_mpool_get(&mp);
+    ASSERT_TRUE(obj != NULL);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, ucs_mpool_enable_mt(&mp));
+
+    ucs_mpool_put(obj);
+    ucs_mpool_cleanup(&mp, 1);
+}
@@ -30,7 +30,9 @@ UCS_TEST_F(test_rcache_basic, create_fail) {
         UCS_BIT(30), /* non-existing event */
         1000,
         &ops,
-        NULL
+        NULL,
+        SIZE_MAX,
+        SIZE_MAX
     };
 
     ucs_rcache_t *rcache;
@@ -52,7 +54,8 @@ protected:
         uint32_t            id;
     };
 
-    test_rcache() : m_reg_count(0), m_ptr(NULL) {
+    test_rcache() : m_reg_count(0), m_ptr(NULL), m_max_regions(SIZE_MAX),
+                    m_max_size(SIZE_MAX) {
     }
 
     virtual void init() {
@@ -69,7 +72,9 @@ protected:
             UCM_EVENT_VM_UNMAPPED,
             1000,
             &ops,
-            reinterpret_cast<void*>(this)
+            reinterpret_cast<void*>(this),
+            m_max_regions,
+            m_max_size
         };
         UCS_TEST_CREATE_HANDLE(ucs_rcache_t*, m_rcache, ucs_rcache_destroy,
                                ucs_rcache_create, &params, "test", ucs_stats_get_root());
@@ -160,6 +165,8 @@ protected:
     volatile uint32_t m_reg_count;
     ucs::handle<ucs_rcache_t*> m_rcache;
     void * volatile m_ptr;
+    size_t m_max_regions;
+    size_t m_max_size;
 
 private:
 
@@ -280,6 +287,37 @@ UCS_MT_TEST_F(test_rcache, get_unmapped, 6) {
     free(ptr);
 }
 
+UCS_MT_TEST_F(test_rcache, get_remapped, 6) {
+    /*
+     *  - get, put, get again -> should be same id
+     *  - unmap and map the same address, get again -> should be different id
+     */
+    static const size_t size = 64 * 1024;
+    region *region;
+    uint32_t id;
+    void *ptr, *new_ptr;
+
+    ptr    = alloc_pages(size, PROT_READ|PROT_WRITE);
+    region = get(ptr, size);
+    id     = region->id;
+    put(region);
+
+    region = get(ptr, size);
+    EXPECT_EQ(id, region->id);
+    put(region);
+
+    munmap(ptr, size);
+    new_ptr = mmap(ptr, size, PROT_READ|PROT_WRITE,
+                   MAP_PRIVATE|MAP_ANONYMOUS|MAP_FIXED, -1, 0);
+    ASSERT_EQ(ptr, new_ptr) << strerror(errno);
+
+    region = get(ptr, size);
+    EXPECT_NE(id, region->id);
+    put(region);
+
+    munmap(ptr, size);
+}
+
 UCS_MT_TEST_F(test_rcache, merge, 6) {
     /*
      * +---------+-----+---------+
@@ -539,6 +577,134 @@ UCS_MT_TEST_F(test_rcache, shared_region, 6) {
     shared_free(mem);
 }
 
+class test_rcache_lru : public test_rcache {
+protected:
+    test_rcache_lru() {
+        m_max_regions = 2;
+    }
+
+    virtual void init() {
+        test_rcache::init();
+        m_page_size = ucs_get_page_size();
+        m_mem       = alloc_pages(m_page_size * 4, PROT_READ|PROT_WRITE);
+    }
+
+    virtual void cleanup() {
+        m_rcache.reset();
+        munmap(m_mem, m_page_size * 4);
+        test_rcache::cleanup();
+    }
+
+    void *page(unsigned index) {
+        return (char*)m_mem + (index * m_page_size);
+    }
+
+    uint32_t get_put(unsigned index) {
+        region *r   = get(page(index), m_page_size);
+        uint32_t id = r->id;
+        put(r);
+        return id;
+    }
+
+    size_t m_page_size;
+    void   *m_mem;
+};
+
+UCS_TEST_F(test_rcache_lru, evict_lru) {
+    uint32_t id0 = get_put(0);
+    uint32_t id1 = get_put(1);
+    EXPECT_EQ(2u, m_reg_count);
+
+    /* touch region 0, so region 1 becomes the least recently used */
+    EXPECT_EQ(id0, get_put(0));
+
+    get_put(2);
+    EXPECT_EQ(2u, m_reg_count);
+    EXPECT_EQ(id0, get_put(0));
+    EXPECT_NE(id1, get_put(1));
+    EXPECT_EQ(2u, m_reg_count);
+}
+
+UCS_TEST_F(test_rcache_lru, inuse_not_evicted) {
+    region *r0 = get(page(0), m_page_size);
+    region *r1 = get(page(1), m_page_size);
+    region *r2 = get(page(2), m_page_size);
+
+    /* the limit is exceeded, since all regions are in use */
+    EXPECT_EQ(3u, m_reg_count);
+
+    uint32_t id2 = r2->id;
+    put(r1);
+    put(r0);
+    put(r2);
+
+    /* evict least recently released regions until there is room for one */
+    get_put(3);
+    EXPECT_EQ(2u, m_reg_count);
+    EXPECT_EQ(id2, get_put(2));
+}
+
+UCS_MT_TEST_F(test_rcache_lru, evict_mt, 6) {
+    for (int i = 0; i < 1000 / ucs::test_time_multiplier(); ++i) {
+        region *r = get(page(ucs::rand() % 4), m_page_size);
+        put(r);
+    }
+}
+
+class test_rcache_lru_size : public test_rcache_lru {
+protected:
+    test_rcache_lru_size() {
+        m_max_regions = SIZE_MAX;
+        m_max_size    = 2 * ucs_get_page_size();
+    }
+};
+
+UCS_TEST_F(test_rcache_lru_size, evict_lru) {
+    uint32_t id0 = get_put(0);
+    get_put(1);
+    get_put(2);
+    EXPECT_EQ(2u, m_reg_count);
+
+    /* region 0 was evicted */
+    EXPECT_NE(id0, get_put(0));
+    EXPECT_EQ(2u, m_reg_count);
+}
+
+class test_rcache_lru_pressure : public test_rcache_lru {
+protected:
+    test_rcache_lru_pressure() {
+        m_max_regions = 100;
+    }
+
+    /* Emulate a locked memory limit of 2 regions */
+    virtual ucs_status_t mem_reg(region *region) {
+        if (m_reg_count >= 2) {
+            return UCS_ERR_IO_ERROR;
+        }
+        return test_rcache::mem_reg(region);
+    }
+};
+
+UCS_TEST_F(test_rcache_lru_pressure, evict_on_failure) {
+    get_put(0);
+    get_put(1);
+    EXPECT_EQ(2u, m_reg_count);
+
+    /* registration fails, unused regions are released and it's retried */
+    region *r2 = get(page(2), m_page_size);
+    region *r3 = get(page(3), m_page_size);
+    EXPECT_EQ(2u, m_reg_count);
+
+    /* no unused regions to release */
+    ucs_rcache_region_t *r;
+    ucs_status_t status = ucs_rcache_get(m_rcache, page(0), m_page_size,
+                                         PROT_READ|PROT_WRITE, NULL, &r);
+    EXPECT_EQ(UCS_ERR_IO_ERROR, status);
+
+    put(r2);
+    put(r3);
+}
+
 class test_rcache_no_register : public test_rcache {
 protected:
     bool m_fail_reg;
@@ -663,7 +829,7 @@ protected:
     /* a helper function for stats tests debugging */
     void dump_stats() {
         printf("gets %d hf %d hs %d misses %d merges %d unmaps %d"
-               " unmaps_inv %d puts %d regs %d deregs %d\n",
+               " unmaps_inv %d puts %d regs %d deregs %d evicts %d\n",
                get_counter(UCS_RCACHE_GETS),
                get_counter(UCS_RCACHE_HITS_FAST),
                get_counter(UCS_RCACHE_HITS_SLOW),
@@ -673,7 +839,8 @@ protected:
                get_counter(UCS_RCACHE_UNMAP_INVALIDATES),
                get_counter(UCS_RCACHE_PUTS),
                get_counter(UCS_RCACHE_REGS),
-               get_counter(UCS_RCACHE_DEREGS));
+               get_counter(UCS_RCACHE_DEREGS),
+               get_counter(UCS_RCACHE_EVICTS));
     }
 };
 
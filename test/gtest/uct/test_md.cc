@@ -484,6 +484,7 @@ UCS_TEST_SKIP_COND_P(test_md, sockaddr_accessibility,
                    cma, \
                    posix, \
                    sysv, \
+                   tcp, \
                    xpmem, \
                    cuda_cpy, \
                    cuda_ipc, \
@@ -54,6 +54,12 @@ public:
         return UCS_OK;
     }
 
+    static ucs_status_t count_am_handler(void *arg, void *data, size_t length,
+                                         unsigned flags) {
+        ++(*(unsigned*)arg);
+        return UCS_OK;
+    }
+
     void cleanup() {
         uct_test::cleanup();
     }
@@ -102,4 +108,69 @@ UCS_TEST_P(test_uct_mm, open_for_posix) {
     }
 }
 
+UCS_TEST_P(test_uct_mm, fifo_max_poll) {
+    static const unsigned max_poll = 8;
+    uint64_t send_data             = 0xdeadbeef;
+    unsigned recv_count            = 0;
+    ucs_status_t status;
+
+    set_config("FIFO_MAX_POLL=" + ucs::to_string(max_poll));
+    initialize();
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, count_am_handler, &recv_count,
+                             0);
+
+    for (unsigned i = 0; i < (max_poll * 2) + 1; ++i) {
+        status = uct_ep_am_short(m_e1->ep(0), 0, 0, &send_data,
+                                 sizeof(send_data));
+        ASSERT_UCS_OK(status);
+    }
+
+    /* every progress call handles up to max_poll ready elements */
+    EXPECT_EQ(max_poll, uct_iface_progress(m_e2->iface()));
+    EXPECT_EQ(max_poll, recv_count);
+    EXPECT_EQ(max_poll, uct_iface_progress(m_e2->iface()));
+    EXPECT_EQ(max_poll * 2, recv_count);
+    EXPECT_EQ(1u, uct_iface_progress(m_e2->iface()));
+    EXPECT_EQ(0u, uct_iface_progress(m_e2->iface()));
+    EXPECT_EQ((max_poll * 2) + 1, recv_count);
+}
+
+UCS_TEST_P(test_uct_mm, fifo_lanes) {
+    static const unsigned num_sends = 1000;
+    uint64_t send_data              = 0xdeadbeef;
+    unsigned recv_count             = 0;
+    ucs_status_t status;
+
+    /* m_e1 claims the only lane, m_e3 falls back to the shared FIFO */
+    set_config("FIFO_LANES=1");
+    initialize();
+
+    entity *m_e3 = uct_test::create_entity(0);
+    m_entities.push_back(m_e3);
+    m_e3->connect(0, *m_e2, 0);
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, count_am_handler, &recv_count,
+                             0);
+
+    for (unsigned i = 0; i < num_sends; ++i) {
+        entity *sender = (i % 2) ? m_e3 : m_e1;
+        do {
+            status = uct_ep_am_short(sender->ep(0), 0, 0, &send_data,
+                                     sizeof(send_data));
+            progress();
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_UCS_OK(status);
+    }
+
+    ucs_time_t deadline = ucs_get_time() +
+                          ucs_time_from_sec(DEFAULT_TIMEOUT_SEC);
+    while ((recv_count < num_sends) && (ucs_get_time() < deadline)) {
+        progress();
+    }
+    EXPECT_EQ(num_sends, recv_count);
+}
+
 _UCT_INSTANTIATE_TEST_CASE(test_uct_mm, mm)
+_UCT_INSTANTIATE_TEST_CASE(test_uct_mm, posix)
+_UCT_INSTANTIATE_TEST_CASE(test_uct_mm, sysv)
@@ -6,6 +6,11 @@
 
 #include "uct_p2p_test.h"
 
+extern "C" {
+#include <uct/tcp/tcp.h>
+}
+
+#include <sys/socket.h>
 #include <string>
 #include <vector>
 
@@ -31,7 +36,7 @@ public:
 
     uct_p2p_am_test() :
         uct_p2p_test(sizeof(receive_desc_t)), m_am_count(0), m_am_posted(0),
-        m_keep_data(false)
+        m_am_desc_count(0), m_keep_data(false)
     {
         m_pending_req.sendbuf = NULL;
         m_pending_req.test = NULL;
@@ -140,6 +145,9 @@ public:
             if (flags & UCT_CB_PARAM_FLAG_DESC) {
                 my_desc = (receive_desc_t *)data - 1;
                 my_desc->magic  = MAGIC_DESC;
+                pthread_mutex_lock(&m_lock);
+                ++m_am_desc_count;
+                pthread_mutex_unlock(&m_lock);
             } else {
                 my_desc = (receive_desc_t *)ucs_malloc(sizeof(*my_desc) + length,
                                                        "TODO: remove allocation");
@@ -223,6 +231,7 @@ public:
         ucs_status_t status;
 
         m_am_count = 0;
+        m_am_desc_count = 0;
         m_send_tracer.count = 0;
         m_recv_tracer.count = 0;
 
@@ -301,6 +310,7 @@ protected:
 protected:
     unsigned                     m_am_count;
     unsigned                     m_am_posted;
+    unsigned                     m_am_desc_count;
 
     struct test_req_t {
         uct_pending_req_t  uct;
@@ -550,6 +560,16 @@ UCS_TEST_SKIP_COND_P(uct_p2p_am_test, am_zcopy,
                     TEST_UCT_FLAG_DIR_SEND_TO_RECV);
 }
 
+UCS_TEST_SKIP_COND_P(uct_p2p_am_test, am_zcopy_keep_data,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP)) {
+    set_keep_data(true);
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_am_test::am_zcopy),
+                    sizeof(uint64_t),
+                    sender().iface_attr().cap.am.max_zcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+}
+
 UCT_INSTANTIATE_TEST_CASE(uct_p2p_am_test)
 
 const unsigned uct_p2p_am_misc::RX_MAX_BUFS  = 1024; /* due to hard coded 'grow'
@@ -704,3 +724,373 @@ UCS_TEST_P(uct_p2p_am_tx_bufs, am_tx_max_bufs) {
 }
 
 UCT_INSTANTIATE_TEST_CASE(uct_p2p_am_tx_bufs)
+
+/**
+ * TCP transport features which are enabled by configuration. Every test runs
+ * with each of the configurations from the variants table.
+ */
+class uct_p2p_am_tcp : public uct_p2p_am_test
+{
+public:
+    enum {
+        HDR_FIRST,
+        MSG_ZCOPY,
+        STRIPES,
+        IO_URING,
+        VARIANT_LAST
+    };
+
+    struct variant_t {
+        const char *name;
+        const char *config[5]; /* name/value pairs, NULL-terminated */
+    };
+
+    struct tcp_resource : public p2p_resource {
+        virtual std::string name() const {
+            return p2p_resource::name() + "/" + variants[variant].name;
+        }
+
+        int variant;
+
+        tcp_resource(const p2p_resource& res, int variant) :
+                     p2p_resource(res), variant(variant) { }
+    };
+
+    static const variant_t variants[VARIANT_LAST];
+
+    static std::vector<const resource*> enum_resources(const std::string& tl_name)
+    {
+        static std::vector<tcp_resource> all_resources;
+
+        if (all_resources.empty()) {
+            std::vector<const resource*> r = uct_p2p_test::enum_resources("tcp");
+            for (std::vector<const resource*>::iterator iter = r.begin();
+                 iter != r.end(); ++iter) {
+                for (int variant = 0; variant < VARIANT_LAST; ++variant) {
+                    all_resources.push_back(tcp_resource(
+                        *static_cast<const p2p_resource*>(*iter), variant));
+                }
+            }
+        }
+
+        return filter_resources(all_resources, tl_name);
+    }
+
+    uct_p2p_am_tcp() : uct_p2p_am_test(), m_check_desc(false) {
+        for (const char * const *config = variants[variant()].config;
+             *config != NULL;
+             config += 2) {
+            modify_config(config[0], config[1]);
+        }
+    }
+
+    int variant() const {
+        return static_cast<const tcp_resource*>(GetParam())->variant;
+    }
+
+    virtual void test_xfer(send_func_t send, size_t length, unsigned flags,
+                           ucs_memory_type_t mem_type) {
+        if (receiver().iface_attr().cap.flags & UCT_IFACE_FLAG_CB_SYNC) {
+            test_xfer_check(send, length, flags, 0, mem_type);
+        }
+        if (receiver().iface_attr().cap.flags & UCT_IFACE_FLAG_CB_ASYNC) {
+            test_xfer_check(send, length, flags, UCT_CB_FLAG_ASYNC, mem_type);
+        }
+    }
+
+protected:
+    static bool stripes_connected(const uct_tcp_ep_t *ep) {
+        if (ep->stripe.tx_eps == NULL) {
+            return false;
+        }
+
+        uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                                uct_tcp_iface_t);
+        for (unsigned i = 0; i < iface->config.stripe.count; ++i) {
+            if ((ep->stripe.tx_eps[i] == NULL) ||
+                (ep->stripe.tx_eps[i]->conn_state !=
+                 UCT_TCP_EP_CONN_STATE_CONNECTED)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void check_uring() {
+        uct_tcp_iface_t *iface = ucs_derived_of(sender().iface(),
+                                                uct_tcp_iface_t);
+        if (iface->uring == NULL) {
+            UCS_TEST_SKIP_R("io_uring is not supported");
+        }
+    }
+
+    void reconnect() {
+        sender().destroy_ep(0);
+        sender().connect(0, receiver(), 0);
+    }
+
+    void am_short_wait(const mapped_buffer& sendbuf) {
+        unsigned prev_am_count = m_am_count;
+        ucs_status_t status;
+
+        do {
+            status = am_short(sender_ep(), sendbuf, sendbuf);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_UCS_OK(status);
+
+        wait_for_value(&m_am_count, prev_am_count + 1, true);
+        EXPECT_EQ(prev_am_count + 1, m_am_count);
+    }
+
+    void test_xfer_check(send_func_t send, size_t length, unsigned flags,
+                         uint32_t am_mode, ucs_memory_type_t mem_type) {
+        test_xfer_do(send, length, flags, am_mode, mem_type);
+        if (m_check_desc) {
+            /* every message is received alone to an RX buffer, so it has to
+             * be passed to the user as a descriptor */
+            EXPECT_EQ(m_am_count, m_am_desc_count) << "length " << length;
+        }
+    }
+
+    bool m_check_desc;
+};
+
+const uct_p2p_am_tcp::variant_t
+uct_p2p_am_tcp::variants[uct_p2p_am_tcp::VARIANT_LAST] = {
+    {"hdr_first", {"RX_HDR_FIRST_THRESH", "1", NULL}},
+    {"msg_zcopy", {"MSG_ZEROCOPY_THRESH", "0", NULL}},
+    {"stripes",   {"SOCKETS_PER_EP", "4", "STRIPE_THRESH", "1k", NULL}},
+    {"io_uring",  {"PROGRESS_ENGINE", "io_uring", NULL}}
+};
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_tcp, am_bcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_BCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_am_test::am_bcopy),
+                    0ul,
+                    sender().iface_attr().cap.am.max_bcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_tcp, am_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_am_test::am_zcopy),
+                    0ul,
+                    sender().iface_attr().cap.am.max_zcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_tcp, am_zcopy_keep_data,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP)) {
+    set_keep_data(true);
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_am_test::am_zcopy),
+                    sizeof(uint64_t),
+                    sender().iface_attr().cap.am.max_zcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_tcp, hdr_first_desc,
+                     (variant() != HDR_FIRST) ||
+                     !check_caps(UCT_IFACE_FLAG_AM_BCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP)) {
+    set_keep_data(true);
+    m_check_desc = true;
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_am_test::am_bcopy),
+                    sizeof(uint64_t),
+                    sender().iface_attr().cap.am.max_bcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_tcp, msg_zcopy_outstanding,
+                     (variant() != MSG_ZCOPY) ||
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY)) {
+    /* Keep many MSG_ZEROCOPY sends in flight: their completions are read
+     * from the error queue, and the socket may run out of memory for the
+     * notifications (ENOBUFS), which has to delay the sends */
+    const unsigned num_sends = 1000;
+    const unsigned comp_count = num_sends + 1;
+    size_t length = ucs_min(sender().iface_attr().cap.am.max_zcopy, 4096ul);
+    mapped_buffer sendbuf(length, SEED1, sender());
+    unsigned num_inprogress = 0;
+    uct_completion_t comp;
+    ucs_status_t status;
+
+    comp.func  = (uct_completion_callback_t)ucs_empty_function;
+    comp.count = comp_count;
+
+    status = uct_iface_set_am_handler(receiver().iface(), AM_ID, am_handler,
+                                      this, 0);
+    ASSERT_UCS_OK(status);
+
+    UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, sendbuf.ptr(), length, sendbuf.memh(),
+                            1);
+
+    for (unsigned i = 0; i < num_sends; ++i) {
+        do {
+            status = uct_ep_am_zcopy(sender_ep(), AM_ID, NULL, 0, iov, iovcnt,
+                                     0, &comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        ASSERT_FALSE(UCS_STATUS_IS_ERR(status)) << ucs_status_string(status);
+        num_inprogress += (status == UCS_INPROGRESS);
+    }
+
+    flush();
+    wait_for_value(&m_am_count, num_sends, true);
+    EXPECT_EQ(num_sends, m_am_count);
+    EXPECT_EQ(comp_count - num_inprogress, comp.count);
+
+    status = uct_iface_set_am_handler(receiver().iface(), AM_ID, NULL, NULL, 0);
+    ASSERT_UCS_OK(status);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_tcp, stripe_send_failure,
+                     (variant() != STRIPES) ||
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY)) {
+    /* A chunk which is not sent on a stripe socket breaks the striped AM,
+     * so the error has to be returned and the EP has to be failed */
+    size_t length       = sender().iface_attr().cap.am.max_zcopy;
+    uct_tcp_ep_t *ep    = ucs_derived_of(sender_ep(), uct_tcp_ep_t);
+    ucs_time_t deadline = ucs::get_deadline();
+    mapped_buffer sendbuf(length, SEED1, sender());
+    uct_completion_t comp;
+    ucs_status_t status;
+
+    while (!stripes_connected(ep) && (ucs_get_time() < deadline)) {
+        progress();
+    }
+    ASSERT_TRUE(stripes_connected(ep));
+
+    ASSERT_EQ(0, shutdown(ep->stripe.tx_eps[0]->fd, SHUT_WR));
+
+    comp.func  = (uct_completion_callback_t)ucs_empty_function;
+    comp.count = 1;
+
+    UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, sendbuf.ptr(), length, sendbuf.memh(),
+                            1);
+
+    scoped_log_handler wrap_err(wrap_errors_logger);
+
+    status = uct_ep_am_zcopy(sender_ep(), AM_ID, NULL, 0, iov, iovcnt, 0,
+                             &comp);
+    EXPECT_TRUE(UCS_STATUS_IS_ERR(status)) << ucs_status_string(status);
+    EXPECT_EQ(1, comp.count);
+
+    /* the failed EP is moved to the failed interface */
+    while ((sender_ep()->iface == sender().iface()) &&
+           (ucs_get_time() < deadline)) {
+        progress();
+    }
+    EXPECT_NE(sender().iface(), sender_ep()->iface);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_tcp, io_uring_reconnect,
+                     (variant() != IO_URING) ||
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT)) {
+    /* The operations of a closed connection are completed on both sides,
+     * and a new connection posts its own ones */
+    unsigned num_iters = ucs_max(20 / ucs::test_time_multiplier(), 1);
+    mapped_buffer sendbuf(sizeof(uint64_t), SEED1, sender());
+    ucs_status_t status;
+
+    check_uring();
+
+    status = uct_iface_set_am_handler(receiver().iface(), AM_ID, am_handler,
+                                      this, 0);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < num_iters; ++i) {
+        reconnect();
+        am_short_wait(sendbuf);
+    }
+
+    status = uct_iface_set_am_handler(receiver().iface(), AM_ID, NULL, NULL, 0);
+    ASSERT_UCS_OK(status);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_tcp, io_uring_destroy_pending_ep,
+                     (variant() != IO_URING) ||
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT)) {
+    /* The EP is destroyed while its receive operation is posted to the ring,
+     * so it has to be canceled and completed without the EP */
+    unsigned num_iters = ucs_max(20 / ucs::test_time_multiplier(), 1);
+    mapped_buffer sendbuf(sizeof(uint64_t), SEED1, sender());
+    ucs_time_t deadline;
+    ucs_status_t status;
+    uct_tcp_ep_t *ep;
+
+    check_uring();
+
+    status = uct_iface_set_am_handler(receiver().iface(), AM_ID, am_handler,
+                                      this, 0);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < num_iters; ++i) {
+        am_short_wait(sendbuf);
+
+        ep       = ucs_derived_of(sender_ep(), uct_tcp_ep_t);
+        deadline = ucs::get_deadline();
+        while ((ep->uring.rx_op == NULL) && (ucs_get_time() < deadline)) {
+            progress();
+        }
+        ASSERT_TRUE(ep->uring.rx_op != NULL);
+
+        reconnect();
+    }
+
+    am_short_wait(sendbuf);
+
+    status = uct_iface_set_am_handler(receiver().iface(), AM_ID, NULL, NULL, 0);
+    ASSERT_UCS_OK(status);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(uct_p2p_am_tcp, tcp)
+
+class uct_p2p_am_mm_zcopy : public uct_p2p_am_test
+{
+public:
+    uct_p2p_am_mm_zcopy() : uct_p2p_am_test() {
+        modify_config("ZCOPY_THRESH", "0");
+    }
+
+    /* without a header the payload is delivered from the sender's segment */
+    ucs_status_t am_zcopy_no_hdr(uct_ep_h ep, const mapped_buffer& sendbuf,
+                                 const mapped_buffer& recvbuf)
+    {
+        UCS_TEST_GET_BUFFER_IOV(iov, iovcnt, sendbuf.ptr(), sendbuf.length(),
+                                sendbuf.memh(),
+                                sender().iface_attr().cap.am.max_iov);
+
+        return uct_ep_am_zcopy(ep, AM_ID, NULL, 0, iov, iovcnt, 0, comp());
+    }
+};
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_mm_zcopy, am_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_am_test::am_zcopy),
+                    0ul,
+                    sender().iface_attr().cap.am.max_zcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_mm_zcopy, am_zcopy_no_hdr,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP)) {
+    test_xfer_multi(static_cast<send_func_t>(
+                            &uct_p2p_am_mm_zcopy::am_zcopy_no_hdr),
+                    1ul, sender().iface_attr().cap.am.max_zcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(uct_p2p_am_mm_zcopy, posix)
+_UCT_INSTANTIATE_TEST_CASE(uct_p2p_am_mm_zcopy, sysv)
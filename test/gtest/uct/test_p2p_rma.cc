@@ -134,3 +134,58 @@ UCS_TEST_SKIP_COND_P(uct_p2p_rma_test, get_zcopy,
 }
 
 UCT_INSTANTIATE_TEST_CASE(uct_p2p_rma_test)
+_UCT_INSTANTIATE_TEST_CASE(uct_p2p_rma_test, posix)
+_UCT_INSTANTIATE_TEST_CASE(uct_p2p_rma_test, sysv)
+
+class uct_p2p_rma_async_copy : public uct_p2p_rma_test
+{
+public:
+    uct_p2p_rma_async_copy() : uct_p2p_rma_test() {
+        modify_config("ASYNC_COPY_THREADS", "4");
+        modify_config("ASYNC_COPY_THRESH", "1k");
+        modify_config("ASYNC_COPY_SEG_SIZE", "4k");
+    }
+};
+
+UCS_TEST_SKIP_COND_P(uct_p2p_rma_async_copy, put_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    0ul, sender().iface_attr().cap.put.max_zcopy,
+                    TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_rma_async_copy, get_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_GET_ZCOPY)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::get_zcopy),
+                    ucs_max(1ull, sender().iface_attr().cap.get.min_zcopy),
+                    sender().iface_attr().cap.get.max_zcopy,
+                    TEST_UCT_FLAG_RECV_ZCOPY);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(uct_p2p_rma_async_copy, cma)
+
+class uct_p2p_rma_tcp_stripes : public uct_p2p_rma_test
+{
+public:
+    uct_p2p_rma_tcp_stripes() : uct_p2p_rma_test() {
+        modify_config("SOCKETS_PER_EP", "4");
+        modify_config("STRIPE_THRESH", "1k");
+    }
+};
+
+UCS_TEST_SKIP_COND_P(uct_p2p_rma_tcp_stripes, put_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    0ul, sender().iface_attr().cap.put.max_zcopy,
+                    TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_rma_tcp_stripes, get_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_GET_ZCOPY)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::get_zcopy),
+                    ucs_max(1ull, sender().iface_attr().cap.get.min_zcopy),
+                    sender().iface_attr().cap.get.max_zcopy,
+                    TEST_UCT_FLAG_RECV_ZCOPY);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(uct_p2p_rma_tcp_stripes, tcp)